@@ -52,6 +52,24 @@ namespace casual
             //! @{
             namespace payload
             {
+               //! streaming json codec, without any intermediate document
+               namespace json
+               {
+                  //! @returns true if `protocol` is json
+                  bool protocol( const std::string& protocol);
+
+                  void stream( const common::buffer::Payload& buffer, std::ostream& stream);
+                  common::buffer::Payload stream( std::istream& stream);
+               } // json
+
+               //! codec via the generic serialize archives
+               namespace archive
+               {
+                  void stream( common::buffer::Payload buffer, std::ostream& stream, const std::string& protocol);
+                  common::buffer::Payload stream( std::istream& stream, const std::string& protocol);
+               } // archive
+
+               //! json uses the streaming codec, other protocols the archives
                void stream( common::buffer::Payload buffer, std::ostream& stream, const std::string& protocol);
                common::buffer::Payload stream( std::istream& stream, const std::string& protocol);
             } // payload
@@ -43,6 +43,18 @@
 #include <regex>
 #include <iostream>
 #include <sstream>
+#include <string_view>
+#include <charconv>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#if defined( __SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace casual
 {
@@ -1630,50 +1642,783 @@ namespace casual
 
             namespace payload
             {
-               void stream( common::buffer::Payload payload, std::ostream& stream, const std::string& protocol)
+               namespace json
                {
-                  const Trace trace{ "field::internal::stream out"};
+                  namespace local
+                  {
+                     namespace
+                     {
+                        namespace word
+                        {
+                           // SWAR (simd within a register), 8 bytes at the time, for the tail
+                           // or when SSE2 is not available
+                           using type = std::uint64_t;
+
+                           constexpr type ones = 0x0101010101010101;
+                           constexpr type high = 0x8080808080808080;
 
-                  const auto& buffer = pool_type::pool.get( pool_type::pool.insert( std::move( payload)));
+                           constexpr type repeat( char value) noexcept { return ones * static_cast< unsigned char>( value);}
 
-                  common::log::line( verbose::log, "buffer.payload.type: ", buffer.payload.type, " - protocol: ", protocol);
+                           //! @returns non zero if any byte in `value` is less than `n` (n <= 128)
+                           constexpr type less( type value, unsigned char n) noexcept { return ( value - ones * n) & ~value & high;}
 
-                  auto archive = common::serialize::create::writer::from( protocol);
+                           //! @returns non zero if any byte in `value` is equal to `c`
+                           constexpr type equal( type value, char c) noexcept { return less( value ^ repeat( c), 1);}
 
-                  std::vector< write> fields;
+                           inline type load( const char* data) noexcept
+                           {
+                              type result;
+                              std::memcpy( &result, data, sizeof( type));
+                              return result;
+                           }
+                        } // word
+
+                        namespace escape
+                        {
+                           //! @returns true if `c` has to be escaped in a json string
+                           constexpr bool special( char c) noexcept
+                           {
+                              return static_cast< unsigned char>( c) < 0x20 || c == '"' || c == '\\';
+                           }
+
+                           //! @returns the first character in [first, last) that has to be escaped, or `last`
+                           const char* clean( const char* first, const char* last) noexcept
+                           {
+#if defined( __SSE2__)
+                              const auto quote = _mm_set1_epi8( '"');
+                              const auto backslash = _mm_set1_epi8( '\\');
+                              const auto control = _mm_set1_epi8( 0x1f);
+
+                              for( ; last - first >= 16; first += 16)
+                              {
+                                 const auto value = _mm_loadu_si128( reinterpret_cast< const __m128i*>( first));
+                                 const auto mask = _mm_movemask_epi8( _mm_or_si128(
+                                    _mm_or_si128( _mm_cmpeq_epi8( value, quote), _mm_cmpeq_epi8( value, backslash)),
+                                    _mm_cmpeq_epi8( _mm_min_epu8( value, control), value)));
+
+                                 if( mask != 0)
+                                    return first + __builtin_ctz( mask);
+                              }
+#endif
+                              for( ; last - first >= 8; first += 8)
+                              {
+                                 const auto value = word::load( first);
+                                 if( word::less( value, 0x20) | word::equal( value, '"') | word::equal( value, '\\'))
+                                    break;
+                              }
+
+                              while( first != last && ! special( *first))
+                                 ++first;
+
+                              return first;
+                           }
+
+                           //! @returns true if [first, last) is 7-bit, and hence is the same in utf8 and all ascii-compatible codesets
+                           bool seven_bit( const char* first, const char* last) noexcept
+                           {
+#if defined( __SSE2__)
+                              for( ; last - first >= 16; first += 16)
+                                 if( _mm_movemask_epi8( _mm_loadu_si128( reinterpret_cast< const __m128i*>( first))) != 0)
+                                    return false;
+#endif
+                              for( ; last - first >= 8; first += 8)
+                                 if( word::load( first) & word::high)
+                                    return false;
+
+                              return std::all_of( first, last, []( char c){ return ( c & 0x80) == 0;});
+                           }
+
+                           void character( std::string& out, char c)
+                           {
+                              switch( c)
+                              {
+                                 case '"': out += R"(\")"; return;
+                                 case '\\': out += R"(\\)"; return;
+                                 case '\b': out += R"(\b)"; return;
+                                 case '\f': out += R"(\f)"; return;
+                                 case '\n': out += R"(\n)"; return;
+                                 case '\r': out += R"(\r)"; return;
+                                 case '\t': out += R"(\t)"; return;
+                              }
+
+                              constexpr auto hex = "0123456789abcdef";
+                              const auto value = static_cast< unsigned char>( c);
+                              out += R"(\u00)";
+                              out.push_back( hex[ value >> 4]);
+                              out.push_back( hex[ value & 0x0f]);
+                           }
+
+                           //! appends [first, last), that is utf8, as a json string
+                           void string( std::string& out, const char* first, const char* last)
+                           {
+                              out.push_back( '"');
+
+                              while( true)
+                              {
+                                 auto special = clean( first, last);
+                                 out.append( first, special);
+
+                                 if( special == last)
+                                    break;
+
+                                 character( out, *special);
+                                 first = special + 1;
+                              }
+
+                              out.push_back( '"');
+                           }
+                        } // escape
+
+                        namespace write
+                        {
+                           //! appends [first, last), that is encoded in the local codeset, as a json string
+                           void string( std::string& out, const char* first, const char* last)
+                           {
+                              if( escape::seven_bit( first, last))
+                                 return escape::string( out, first, last);
+
+                              const auto utf8 = common::transcode::utf8::encode( std::string( first, last));
+                              escape::string( out, utf8.data(), utf8.data() + utf8.size());
+                           }
+
+                           template< typename T>
+                           void number( std::string& out, T value)
+                           {
+                              if constexpr( std::is_floating_point_v< T>)
+                              {
+                                 if( ! std::isfinite( value))
+                                    common::code::raise::error( common::code::casual::invalid_document, "failed to write document - value: ", value, " is not representable in json");
+                              }
+
+#ifndef __cpp_lib_to_chars
+                              // no floating point std::to_chars (libc++), we use a stream with round trip precision
+                              if constexpr( std::is_floating_point_v< T>)
+                              {
+                                 std::ostringstream stream;
+                                 stream.imbue( std::locale::classic());
+                                 stream << std::setprecision( std::numeric_limits< T>::max_digits10) << value;
+                                 out += std::move( stream).str();
+                                 return;
+                              }
+#endif
+                              std::array< char, 64> buffer;
+                              const auto result = std::to_chars( buffer.data(), buffer.data() + buffer.size(), value);
+                              out.append( buffer.data(), result.ptr);
+                           }
+
+                           void binary( std::string& out, const_data_type data, size_type size)
+                           {
+                              const auto offset = out.size();
+                              out.resize( offset + 2 + common::transcode::base64::capacity::encoded( size));
+                              out[ offset] = '"';
+
+                              const auto encoded = common::transcode::base64::detail::encode(
+                                 { const_cast< data_type>( data), size},
+                                 { out.data() + offset + 1, static_cast< platform::size::type>( out.size() - offset - 1)});
+
+                              out.resize( offset + 1 + encoded);
+                              out.push_back( '"');
+                           }
+
+                           void value( std::string& out, item_type id, const_data_type data, size_type size)
+                           {
+                              switch( id / CASUAL_FIELD_TYPE_BASE)
+                              {
+                                 case CASUAL_FIELD_SHORT: number( out, decode< short>( data)); break;
+                                 case CASUAL_FIELD_LONG: number( out, decode< long>( data)); break;
+                                 case CASUAL_FIELD_CHAR: write::string( out, data, data + 1); break;
+                                 case CASUAL_FIELD_FLOAT: number( out, decode< float>( data)); break;
+                                 case CASUAL_FIELD_DOUBLE: number( out, decode< double>( data)); break;
+                                 case CASUAL_FIELD_STRING: write::string( out, data, data + std::strlen( data)); break;
+                                 case CASUAL_FIELD_BINARY:
+                                 default:
+                                    binary( out, data, size);
+                                    break;
+                              }
+                           }
+                        } // write
+
+                        namespace read
+                        {
+                           //! a minimal pull parser over the json document, hence we don't need
+                           //! any intermediate representation of the document.
+                           struct Parser
+                           {
+                              Parser( std::string_view json) : m_current{ json.data()}, m_last{ json.data() + json.size()} {}
+
+                              //! consumes `c` (after whitespace) if it is the next character
+                              bool consume( char c)
+                              {
+                                 whitespace();
+                                 if( m_current != m_last && *m_current == c)
+                                 {
+                                    ++m_current;
+                                    return true;
+                                 }
+                                 return false;
+                              }
+
+                              void expect( char c)
+                              {
+                                 if( ! consume( c))
+                                    error( "expected '", c, "'");
+                              }
+
+                              char peek()
+                              {
+                                 whitespace();
+                                 if( m_current == m_last)
+                                    error( "unexpected end of document");
+                                 return *m_current;
+                              }
+
+                              bool end()
+                              {
+                                 whitespace();
+                                 return m_current == m_last;
+                              }
+
+                              //! @returns the (unescaped) string, that refers to the document if there
+                              //!   is no escapes, otherwise to `scratch`
+                              std::string_view string( std::string& scratch)
+                              {
+                                 expect( '"');
+
+                                 auto first = m_current;
+                                 auto special = quote( first);
+
+                                 if( *special == '"')
+                                 {
+                                    m_current = special + 1;
+                                    return { first, static_cast< std::size_t>( special - first)};
+                                 }
+
+                                 scratch.assign( first, special);
+                                 m_current = special;
+
+                                 while( true)
+                                 {
+                                    if( *m_current == '"')
+                                    {
+                                       ++m_current;
+                                       return scratch;
+                                    }
+
+                                    // *m_current == '\\'
+                                    unescape( scratch);
+
+                                    auto special = quote( m_current);
+                                    scratch.append( m_current, special);
+                                    m_current = special;
+                                 }
+                              }
+
+                              //! @returns the number token, as is
+                              std::string_view number()
+                              {
+                                 whitespace();
+                                 auto first = m_current;
+
+                                 while( m_current != m_last && number( *m_current))
+                                    ++m_current;
+
+                                 if( first == m_current)
+                                    error( "expected a number");
+
+                                 return { first, static_cast< std::size_t>( m_current - first)};
+                              }
+
+                              //! skips the next value, regardless of type
+                              void skip( std::string& scratch)
+                              {
+                                 switch( peek())
+                                 {
+                                    case '"': string( scratch); return;
+                                    case '{':
+                                    {
+                                       expect( '{');
+                                       if( consume( '}'))
+                                          return;
+                                       do
+                                       {
+                                          string( scratch);
+                                          expect( ':');
+                                          skip( scratch);
+                                       }
+                                       while( consume( ','));
+                                       expect( '}');
+                                       return;
+                                    }
+                                    case '[':
+                                    {
+                                       expect( '[');
+                                       if( consume( ']'))
+                                          return;
+                                       do
+                                       {
+                                          skip( scratch);
+                                       }
+                                       while( consume( ','));
+                                       expect( ']');
+                                       return;
+                                    }
+                                    case 't': literal( "true"); return;
+                                    case 'f': literal( "false"); return;
+                                    case 'n': literal( "null"); return;
+                                    default: number(); return;
+                                 }
+                              }
+
+                              template< typename... Ts>
+                              [[noreturn]] void error( Ts&&... ts) const
+                              {
+                                 common::code::raise::error( common::code::casual::invalid_document, "failed to parse json - ", std::forward< Ts>( ts)...,
+                                    " - at: ", std::string_view{ m_current, static_cast< std::size_t>( std::min< std::ptrdiff_t>( m_last - m_current, 20))});
+                              }
+
+                           private:
+
+                              static constexpr bool number( char c) noexcept
+                              {
+                                 return ( c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+                              }
+
+                              void whitespace() noexcept
+                              {
+                                 while( m_current != m_last && ( *m_current == ' ' || *m_current == '\n' || *m_current == '\r' || *m_current == '\t'))
+                                    ++m_current;
+                              }
+
+                              void literal( std::string_view value)
+                              {
+                                 if( std::string_view{ m_current, std::min< std::size_t>( m_last - m_current, value.size())} != value)
+                                    error( "expected '", value, "'");
+                                 m_current += value.size();
+                              }
+
+                              //! @returns the first '"' or '\\' from `first`
+                              const char* quote( const char* first)
+                              {
+#if defined( __SSE2__)
+                                 const auto quote = _mm_set1_epi8( '"');
+                                 const auto backslash = _mm_set1_epi8( '\\');
+
+                                 for( ; m_last - first >= 16; first += 16)
+                                 {
+                                    const auto value = _mm_loadu_si128( reinterpret_cast< const __m128i*>( first));
+                                    const auto mask = _mm_movemask_epi8( _mm_or_si128( _mm_cmpeq_epi8( value, quote), _mm_cmpeq_epi8( value, backslash)));
+
+                                    if( mask != 0)
+                                       return first + __builtin_ctz( mask);
+                                 }
+#endif
+                                 for( ; m_last - first >= 8; first += 8)
+                                 {
+                                    const auto value = word::load( first);
+                                    if( word::equal( value, '"') | word::equal( value, '\\'))
+                                       break;
+                                 }
+
+                                 while( first != m_last && *first != '"' && *first != '\\')
+                                    ++first;
+
+                                 if( first == m_last)
+                                    error( "unterminated string");
+
+                                 return first;
+                              }
+
+                              unsigned hex()
+                              {
+                                 if( m_last - m_current < 4)
+                                    error( "invalid unicode escape");
 
-                  for( const auto& field : buffer.index)
+                                 unsigned result{};
+                                 const auto converted = std::from_chars( m_current, m_current + 4, result, 16);
+                                 if( converted.ptr != m_current + 4)
+                                    error( "invalid unicode escape");
+
+                                 m_current += 4;
+                                 return result;
+                              }
+
+                              //! unescapes the escape sequence at current position to `out`
+                              void unescape( std::string& out)
+                              {
+                                 // skip the '\\'
+                                 if( ++m_current == m_last)
+                                    error( "unterminated string");
+
+                                 switch( *m_current++)
+                                 {
+                                    case '"': out.push_back( '"'); return;
+                                    case '\\': out.push_back( '\\'); return;
+                                    case '/': out.push_back( '/'); return;
+                                    case 'b': out.push_back( '\b'); return;
+                                    case 'f': out.push_back( '\f'); return;
+                                    case 'n': out.push_back( '\n'); return;
+                                    case 'r': out.push_back( '\r'); return;
+                                    case 't': out.push_back( '\t'); return;
+                                    case 'u': break;
+                                    default: error( "invalid escape");
+                                 }
+
+                                 auto code = hex();
+
+                                 // surrogate pair
+                                 if( code >= 0xD800 && code <= 0xDBFF)
+                                 {
+                                    if( m_last - m_current < 2 || m_current[ 0] != '\\' || m_current[ 1] != 'u')
+                                       error( "invalid surrogate pair");
+                                    m_current += 2;
+                                    const auto low = hex();
+                                    if( low < 0xDC00 || low > 0xDFFF)
+                                       error( "invalid surrogate pair");
+                                    code = 0x10000 + ( ( code - 0xD800) << 10) + ( low - 0xDC00);
+                                 }
+
+                                 // utf8 encode
+                                 if( code < 0x80)
+                                    out.push_back( static_cast< char>( code));
+                                 else if( code < 0x800)
+                                 {
+                                    out.push_back( static_cast< char>( 0xC0 | ( code >> 6)));
+                                    out.push_back( static_cast< char>( 0x80 | ( code & 0x3F)));
+                                 }
+                                 else if( code < 0x10000)
+                                 {
+                                    out.push_back( static_cast< char>( 0xE0 | ( code >> 12)));
+                                    out.push_back( static_cast< char>( 0x80 | ( ( code >> 6) & 0x3F)));
+                                    out.push_back( static_cast< char>( 0x80 | ( code & 0x3F)));
+                                 }
+                                 else
+                                 {
+                                    out.push_back( static_cast< char>( 0xF0 | ( code >> 18)));
+                                    out.push_back( static_cast< char>( 0x80 | ( ( code >> 12) & 0x3F)));
+                                    out.push_back( static_cast< char>( 0x80 | ( ( code >> 6) & 0x3F)));
+                                    out.push_back( static_cast< char>( 0x80 | ( code & 0x3F)));
+                                 }
+                              }
+
+                              const char* m_current;
+                              const char* m_last;
+                           };
+
+                           //! the value of a field, until we know the type of the field
+                           struct Value
+                           {
+                              enum class Type : short
+                              {
+                                 absent,
+                                 string,
+                                 number,
+                              };
+
+                              Type type = Type::absent;
+                              std::string data;
+                           };
+
+                           //! @returns the string in local codeset
+                           std::string string( const Value& value, const std::string& name)
+                           {
+                              if( value.type != Value::Type::string)
+                                 common::code::raise::error( common::code::casual::invalid_node, "field: ", name, " - expected a string");
+
+                              if( escape::seven_bit( value.data.data(), value.data.data() + value.data.size()))
+                                 return value.data;
+
+                              return common::transcode::utf8::decode( value.data);
+                           }
+
+                           template< typename T>
+                           T number( const Value& value, const std::string& name)
+                           {
+                              if( value.type != Value::Type::number)
+                                 common::code::raise::error( common::code::casual::invalid_node, "field: ", name, " - expected a number");
+
+                              T result{};
+
+#ifndef __cpp_lib_to_chars
+                              // no floating point std::from_chars (libc++), we use a stream that has to consume all of the value
+                              if constexpr( std::is_floating_point_v< T>)
+                              {
+                                 std::istringstream stream{ value.data};
+                                 stream.imbue( std::locale::classic());
+
+                                 if( ! ( stream >> result) || stream.peek() != std::char_traits< char>::eof())
+                                    common::code::raise::error( common::code::casual::invalid_node, "field: ", name, " - invalid value: ", value.data);
+
+                                 return result;
+                              }
+#endif
+                              const auto last = value.data.data() + value.data.size();
+                              const auto converted = std::from_chars( value.data.data(), last, result);
+
+                              if( converted.ec != std::errc{} || converted.ptr != last)
+                                 common::code::raise::error( common::code::casual::invalid_node, "field: ", name, " - invalid value: ", value.data);
+
+                              return result;
+                           }
+
+                           template< typename B>
+                           void field( B& buffer, const std::string& name, const Value& value, platform::binary::type& scratch)
+                           {
+                              const auto found = name_to_id().find( name);
+
+                              if( found == std::end( name_to_id()))
+                              {
+                                 common::log::line( common::verbose::log, "field: ", name, " is not known - action: discard");
+                                 return;
+                              }
+
+                              const auto id = found->second;
+
+                              switch( id / CASUAL_FIELD_TYPE_BASE)
+                              {
+                                 case CASUAL_FIELD_SHORT: add::append( buffer, id, number< short>( value, name)); break;
+                                 case CASUAL_FIELD_LONG: add::append( buffer, id, number< long>( value, name)); break;
+                                 case CASUAL_FIELD_CHAR: add::append( buffer, id, *read::string( value, name).c_str()); break;
+                                 case CASUAL_FIELD_FLOAT: add::append( buffer, id, number< float>( value, name)); break;
+                                 case CASUAL_FIELD_DOUBLE: add::append( buffer, id, number< double>( value, name)); break;
+                                 case CASUAL_FIELD_STRING: add::append( buffer, id, read::string( value, name).c_str()); break;
+                                 case CASUAL_FIELD_BINARY:
+                                 default:
+                                 {
+                                    if( value.type != Value::Type::string)
+                                       common::code::raise::error( common::code::casual::invalid_node, "field: ", name, " - expected a base64 string");
+
+                                    // base64 decode needs some additional space
+                                    scratch.resize( ( value.data.size() / 4 + 1) * 3 + 4);
+                                    const auto last = common::transcode::base64::decode( value.data, std::begin( scratch), std::end( scratch));
+                                    add::append( buffer, id, scratch.data(), std::distance( std::begin( scratch), last));
+                                    break;
+                                 }
+                              }
+                           }
+
+                        } // read
+
+                        const std::vector< std::string>& protocols()
+                        {
+                           static const std::vector< std::string> singleton{ "json", ".json", "jsn", ".jsn", common::buffer::type::json()};
+                           return singleton;
+                        }
+
+                        common::buffer::Payload parse( std::string_view json)
+                        {
+                           Buffer buffer{ common::buffer::Payload{ common::buffer::type::combine( CASUAL_FIELD), {}}};
+                           buffer.capacity( json.size() / 2);
+
+                           read::Parser parser{ json};
+                           std::string scratch;
+                           std::string name;
+                           read::Value value;
+                           platform::binary::type binary;
+
+                           parser.expect( '{');
+
+                           if( ! parser.consume( '}'))
+                           {
+                              do
+                              {
+                                 if( parser.string( scratch) != "fields")
+                                 {
+                                    parser.expect( ':');
+                                    parser.skip( scratch);
+                                    continue;
+                                 }
+
+                                 parser.expect( ':');
+                                 parser.expect( '[');
+
+                                 if( parser.consume( ']'))
+                                    continue;
+
+                                 do
+                                 {
+                                    name.clear();
+                                    value.type = read::Value::Type::absent;
+
+                                    parser.expect( '{');
+
+                                    if( ! parser.consume( '}'))
+                                    {
+                                       do
+                                       {
+                                          auto key = parser.string( scratch);
+                                          parser.expect( ':');
+
+                                          if( key == "name")
+                                             name = parser.string( scratch);
+                                          else if( key == "value")
+                                          {
+                                             if( parser.peek() == '"')
+                                             {
+                                                value.type = read::Value::Type::string;
+                                                value.data = parser.string( scratch);
+                                             }
+                                             else
+                                             {
+                                                value.type = read::Value::Type::number;
+                                                value.data = parser.number();
+                                             }
+                                          }
+                                          else
+                                             parser.skip( scratch);
+                                       }
+                                       while( parser.consume( ','));
+
+                                       parser.expect( '}');
+                                    }
+
+                                    read::field( buffer, name, value, binary);
+                                 }
+                                 while( parser.consume( ','));
+
+                                 parser.expect( ']');
+                              }
+                              while( parser.consume( ','));
+
+                              parser.expect( '}');
+                           }
+
+                           if( ! parser.end())
+                              parser.error( "unexpected content after document");
+
+                           return std::move( buffer.payload);
+                        }
+
+                     } // <unnamed>
+                  } // local
+
+                  bool protocol( const std::string& protocol)
                   {
-                     for( const auto& occurrence : field.second)
+                     return ! common::algorithm::find( local::protocols(), protocol).empty();
+                  }
+
+                  void stream( const common::buffer::Payload& buffer, std::ostream& stream)
+                  {
+                     const Trace trace{ "field::internal::payload::json::stream out"};
+
+                     const auto& memory = buffer.memory;
+
+                     std::string out;
+                     out.reserve( memory.size() * 2 + 16);
+                     out += R"({"fields":[)";
+
+                     auto cursor = memory.data();
+                     const auto last = memory.data() + memory.size();
+
+                     while( cursor < last)
                      {
-                        fields.emplace_back( field.first, buffer.handle() + occurrence);
+                        if( last - cursor < data_offset)
+                           common::code::raise::error( common::code::xatmi::argument, "buffer is comprised");
+
+                        const auto id = decode< item_type>( cursor + item_offset);
+                        const auto size = decode< size_type>( cursor + size_offset);
+                        const auto data = cursor + data_offset;
+
+                        if( size < 0 || last - data < size)
+                           common::code::raise::error( common::code::xatmi::argument, "buffer is comprised");
+
+                        if( cursor != memory.data())
+                           out.push_back( ',');
+
+                        const auto found = id_to_name().find( id);
+
+                        if( found == std::end( id_to_name()))
+                           common::code::raise::error( common::code::casual::invalid_node, "field id: ", id, " has no name in the field repository");
+
+                        out += R"({"name":)";
+                        local::escape::string( out, found->second.data(), found->second.data() + found->second.size());
+                        out += R"(,"value":)";
+                        local::write::value( out, id, data, size);
+                        out.push_back( '}');
+
+                        cursor = data + size;
                      }
+
+                     out += "]}";
+
+                     stream.write( out.data(), out.size());
                   }
 
-                  archive << CASUAL_NAMED_VALUE( fields);
-                  archive.consume( stream);
-               }
+                  common::buffer::Payload stream( std::istream& stream)
+                  {
+                     const Trace trace{ "field::internal::payload::json::stream in"};
 
-               common::buffer::Payload stream( std::istream& stream, const std::string& protocol)
+                     std::ostringstream json;
+                     json << stream.rdbuf();
+
+                     return local::parse( json.str());
+                  }
+
+               } // json
+
+               namespace archive
                {
-                  Trace trace{ "field::internal::stream in"};
+                  void stream( common::buffer::Payload payload, std::ostream& stream, const std::string& protocol)
+                  {
+                     const Trace trace{ "field::internal::payload::archive::stream out"};
 
-                  common::log::line( common::verbose::log, "protocol: ", protocol);
+                     // the index gives us the fields ordered by id
+                     const Buffer buffer{ std::move( payload)};
 
-                  auto archive = common::serialize::create::reader::relaxed::from( protocol, stream);
+                     common::log::line( verbose::log, "buffer.payload.type: ", buffer.payload.type, " - protocol: ", protocol);
 
-                  std::vector< read> fields;
-                  archive >> CASUAL_NAMED_VALUE( fields);
-                  archive.validate();
+                     auto archive = common::serialize::create::writer::from( protocol);
 
-                  Dispatch dispatch;
+                     std::vector< write> fields;
+
+                     for( const auto& field : buffer.index)
+                     {
+                        for( const auto& occurrence : field.second)
+                        {
+                           fields.emplace_back( field.first, buffer.handle() + occurrence);
+                        }
+                     }
+
+                     archive << CASUAL_NAMED_VALUE( fields);
+                     archive.consume( stream);
+                  }
 
-                  for( auto& f : fields)
+                  common::buffer::Payload stream( std::istream& stream, const std::string& protocol)
                   {
-                     f.dispatch( dispatch);
+                     Trace trace{ "field::internal::payload::archive::stream in"};
+
+                     common::log::line( common::verbose::log, "protocol: ", protocol);
+
+                     auto archive = common::serialize::create::reader::relaxed::from( protocol, stream);
+
+                     std::vector< read> fields;
+                     archive >> CASUAL_NAMED_VALUE( fields);
+                     archive.validate();
+
+                     Dispatch dispatch;
+
+                     for( auto& f : fields)
+                     {
+                        f.dispatch( dispatch);
+                     }
+
+                     return dispatch.release();
                   }
+               } // archive
+
+               void stream( common::buffer::Payload payload, std::ostream& stream, const std::string& protocol)
+               {
+                  if( json::protocol( protocol))
+                     return json::stream( payload, stream);
+
+                  archive::stream( std::move( payload), stream, protocol);
+               }
+
+               common::buffer::Payload stream( std::istream& stream, const std::string& protocol)
+               {
+                  if( json::protocol( protocol))
+                     return json::stream( stream);
 
-                  return dispatch.release();
+                  return archive::stream( stream, protocol);
                }
             } // payload
 
@@ -15,9 +15,13 @@
 #include "common/buffer/pool.h"
 
 #include "common/environment.h"
+#include "common/code/casual.h"
 
 #include "xatmi.h"
 
+#include <sstream>
+#include <numeric>
+
 namespace casual
 {
    enum field : long
@@ -44,11 +48,11 @@ namespace casual
       //const auto FLD_DOUBLE2 = CASUAL_FIELD_DOUBLE * CASUAL_FIELD_TYPE_BASE + 2000 + 2;
       //const auto FLD_DOUBLE3 = CASUAL_FIELD_DOUBLE * CASUAL_FIELD_TYPE_BASE + 2000 + 3;
 
-      //const auto FLD_STRING1 = CASUAL_FIELD_STRING * CASUAL_FIELD_TYPE_BASE + 2000 + 1;
+      FLD_STRING1 = CASUAL_FIELD_STRING * CASUAL_FIELD_TYPE_BASE + 2000 + 1,
       //const auto FLD_STRING2 = CASUAL_FIELD_STRING * CASUAL_FIELD_TYPE_BASE + 2000 + 2;
       //const auto FLD_STRING3 = CASUAL_FIELD_STRING * CASUAL_FIELD_TYPE_BASE + 2000 + 3;
 
-      //const auto FLD_BINARY1 = CASUAL_FIELD_BINARY * CASUAL_FIELD_TYPE_BASE + 2000 + 1;
+      FLD_BINARY1 = CASUAL_FIELD_BINARY * CASUAL_FIELD_TYPE_BASE + 2000 + 1,
       //const auto FLD_BINARY2 = CASUAL_FIELD_BINARY * CASUAL_FIELD_TYPE_BASE + 2000 + 2;
       //const auto FLD_BINARY3 = CASUAL_FIELD_BINARY * CASUAL_FIELD_TYPE_BASE + 2000 + 3;
    };
@@ -64,6 +68,48 @@ namespace casual
             casual::common::environment::variable::set( "CASUAL_FIELD_TABLE", "./sample/field.ini");
          }
       };
+
+      namespace local
+      {
+         auto payload( const char* buffer)
+         {
+            return common::buffer::pool::holder().get( buffer).payload();
+         }
+
+         //! a buffer with a mix of field types, ordered by id, of at least `size` bytes
+         auto mixed( platform::size::type size)
+         {
+            auto buffer = tpalloc( CASUAL_FIELD, "", size);
+
+            const std::vector< char> binary( 64, 'B');
+            long index{};
+
+            while( local::payload( buffer).memory.size() < static_cast< std::size_t>( size))
+            {
+               casual_field_add_long( &buffer, field::FLD_LONG1, index * 4711);
+               casual_field_add_double( &buffer, field::FLD_DOUBLE1, index / 3.0);
+               casual_field_add_string( &buffer, field::FLD_STRING1, "some text that is \"quoted\" every now and then\n");
+               casual_field_add_binary( &buffer, field::FLD_BINARY1, binary.data(), binary.size());
+               ++index;
+            }
+
+            auto result = local::payload( buffer);
+            tpfree( buffer);
+            return result;
+         }
+
+         template< typename F>
+         auto measure( platform::size::type bytes, platform::size::type count, F&& functor)
+         {
+            const auto start = platform::time::clock::type::now();
+
+            for( auto index = count; index > 0; --index)
+               functor();
+
+            const auto elapsed = std::chrono::duration< double>( platform::time::clock::type::now() - start);
+            return static_cast< long>( bytes * count / elapsed.count());
+         }
+      } // local
    } //
 
 
@@ -132,4 +178,221 @@ namespace casual
       }
    }
 
+   TEST_F( casual_field_buffer_stream, json_all_types_with_escapes__roundtrip)
+   {
+      common::unittest::Trace trace;
+
+      const std::string text = "a \"quoted\" text with \\ and\ttab and\nnewline, \x01 control and a long tail without any escapes at all";
+      std::vector< char> binary( 256);
+      std::iota( std::begin( binary), std::end( binary), 0);
+
+      std::stringstream stream;
+      {
+         auto buffer = tpalloc( CASUAL_FIELD, "", 512);
+         ASSERT_TRUE( buffer != nullptr);
+
+         EXPECT_TRUE( casual_field_add_short( &buffer, field::FLD_SHORT1, -42) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( casual_field_add_long( &buffer, field::FLD_LONG1, 1234567890) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( casual_field_add_long( &buffer, field::FLD_LONG1, -1) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( casual_field_add_char( &buffer, field::FLD_CHAR1, '"') == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( casual_field_add_float( &buffer, field::FLD_FLOAT1, 0.42f) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( casual_field_add_double( &buffer, field::FLD_DOUBLE1, 1e-300) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( casual_field_add_string( &buffer, field::FLD_STRING1, text.c_str()) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( casual_field_add_string( &buffer, field::FLD_STRING1, "") == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( casual_field_add_binary( &buffer, field::FLD_BINARY1, binary.data(), binary.size()) == CASUAL_FIELD_SUCCESS);
+
+         buffer::field::internal::stream( buffer, stream, "json");
+
+         tpfree( buffer);
+      }
+
+      EXPECT_TRUE( stream.str().find( R"(\"quoted\")") != std::string::npos) << stream.str();
+      EXPECT_TRUE( stream.str().find( R"(\u0001)") != std::string::npos) << stream.str();
+
+      {
+         auto buffer = buffer::field::internal::stream( stream, "json");
+         ASSERT_TRUE( buffer != nullptr);
+
+         short short_{};
+         EXPECT_TRUE( casual_field_get_short( buffer, field::FLD_SHORT1, 0, &short_) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( short_ == -42);
+
+         long long_{};
+         EXPECT_TRUE( casual_field_get_long( buffer, field::FLD_LONG1, 0, &long_) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( long_ == 1234567890);
+         EXPECT_TRUE( casual_field_get_long( buffer, field::FLD_LONG1, 1, &long_) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( long_ == -1);
+
+         char char_{};
+         EXPECT_TRUE( casual_field_get_char( buffer, field::FLD_CHAR1, 0, &char_) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( char_ == '"');
+
+         // shortest representation, hence exact
+         float float_{};
+         EXPECT_TRUE( casual_field_get_float( buffer, field::FLD_FLOAT1, 0, &float_) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( float_ == 0.42f) << "float: " << float_;
+
+         double double_{};
+         EXPECT_TRUE( casual_field_get_double( buffer, field::FLD_DOUBLE1, 0, &double_) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( double_ == 1e-300) << "double: " << double_;
+
+         const char* string{};
+         EXPECT_TRUE( casual_field_get_string( buffer, field::FLD_STRING1, 0, &string) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( string == text) << string;
+         EXPECT_TRUE( casual_field_get_string( buffer, field::FLD_STRING1, 1, &string) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( string == std::string{});
+
+         const char* data{};
+         long count{};
+         EXPECT_TRUE( casual_field_get_binary( buffer, field::FLD_BINARY1, 0, &data, &count) == CASUAL_FIELD_SUCCESS);
+         EXPECT_TRUE( std::vector< char>( data, data + count) == binary) << "count: " << count << " - stream: " << stream.str();
+
+         tpfree( buffer);
+      }
+   }
+
+   TEST_F( casual_field_buffer_stream, json_reordered_and_unknown_keys__expect_known_fields)
+   {
+      common::unittest::Trace trace;
+
+      std::istringstream stream{ R"(
+{
+   "version" : 42,
+   "fields" : [
+      { "value" : 42, "name" : "FLD_LONG1", "comment" : { "some" : [ 1, true, null, "}"] } },
+      { "name" : "FLD_UNKNOWN", "value" : "discarded" },
+      { "name" : "FLD_STRING1", "value" : "\u0041\/\"\\" }
+   ]
+}
+)"};
+
+      auto buffer = buffer::field::internal::stream( stream, "json");
+      ASSERT_TRUE( buffer != nullptr);
+
+      long occurrences{};
+      EXPECT_TRUE( casual_field_occurrences_in_buffer( buffer, &occurrences) == CASUAL_FIELD_SUCCESS);
+      EXPECT_TRUE( occurrences == 2);
+
+      long long_{};
+      EXPECT_TRUE( casual_field_get_long( buffer, field::FLD_LONG1, 0, &long_) == CASUAL_FIELD_SUCCESS);
+      EXPECT_TRUE( long_ == 42);
+
+      const char* string{};
+      EXPECT_TRUE( casual_field_get_string( buffer, field::FLD_STRING1, 0, &string) == CASUAL_FIELD_SUCCESS);
+      EXPECT_TRUE( string == std::string{ R"(A/"\)"}) << string;
+
+      tpfree( buffer);
+   }
+
+   TEST_F( casual_field_buffer_stream, json_invalid_document__expect_nullptr)
+   {
+      common::unittest::Trace trace;
+
+      auto invalid = []( const char* json)
+      {
+         std::istringstream stream{ json};
+         return buffer::field::internal::stream( stream, "json") == nullptr;
+      };
+
+      EXPECT_TRUE( invalid( R"({ "fields" : [ { "name" : "FLD_LONG1", "value" : 42 })"));
+      EXPECT_TRUE( invalid( R"({ "fields" : [ { "name" : "FLD_LONG1", "value" : "42" } ] })"));
+      EXPECT_TRUE( invalid( R"({ "fields" : [ { "name" : "FLD_SHORT1", "value" : 4.2 } ] })"));
+      EXPECT_TRUE( invalid( R"({ "fields" : [ { "name" : "FLD_STRING1", "value" : "\x" } ] })"));
+      EXPECT_TRUE( invalid( R"({ "fields" : [] } trailing)"));
+   }
+
+   TEST_F( casual_field_buffer_stream, json_field_id_not_in_repository__expect_invalid_node)
+   {
+      common::unittest::Trace trace;
+
+      auto buffer = tpalloc( CASUAL_FIELD, "", 128);
+      ASSERT_TRUE( buffer != nullptr);
+
+      // a valid long id, that is not in the field repository
+      constexpr long unknown = CASUAL_FIELD_LONG * CASUAL_FIELD_TYPE_BASE + 9999;
+      EXPECT_TRUE( casual_field_add_long( &buffer, unknown, 42) == CASUAL_FIELD_SUCCESS);
+
+      auto payload = local::payload( buffer);
+      tpfree( buffer);
+
+      std::ostringstream stream;
+
+      EXPECT_CODE({
+         buffer::field::internal::payload::json::stream( payload, stream);
+      }, common::code::casual::invalid_node);
+   }
+
+   TEST_F( casual_field_buffer_stream, json_interoperability_with_archive)
+   {
+      common::unittest::Trace trace;
+
+      const auto origin = local::mixed( 1024);
+
+      // archive -> json
+      {
+         std::stringstream stream;
+         buffer::field::internal::payload::archive::stream( origin, stream, "json");
+         EXPECT_TRUE( buffer::field::internal::payload::json::stream( stream).memory == origin.memory);
+      }
+
+      // json -> archive
+      {
+         std::stringstream stream;
+         buffer::field::internal::payload::json::stream( origin, stream);
+         EXPECT_TRUE( buffer::field::internal::payload::archive::stream( stream, "json").memory == origin.memory);
+      }
+   }
+
+   TEST_F( casual_field_buffer_stream, json_benchmark)
+   {
+      common::unittest::Trace trace;
+
+      for( auto size : { 1024, 16 * 1024, 256 * 1024, 1024 * 1024})
+      {
+         const auto origin = local::mixed( size);
+         const auto bytes = origin.memory.size();
+         const auto count = std::max( 1024 * 1024 / size, 1);
+
+         std::string json;
+         {
+            std::ostringstream stream;
+            buffer::field::internal::payload::json::stream( origin, stream);
+            json = std::move( stream).str();
+         }
+
+         ASSERT_TRUE( [&]()
+         {
+            std::istringstream stream{ json};
+            return buffer::field::internal::payload::json::stream( stream).memory == origin.memory;
+         }());
+
+         const auto write = [&]( auto&& functor)
+         {
+            return local::measure( bytes, count, [&]()
+            {
+               std::ostringstream stream;
+               functor( stream);
+            });
+         };
+
+         const auto read = [&]( auto&& functor)
+         {
+            return local::measure( bytes, count, [&]()
+            {
+               std::istringstream stream{ json};
+               functor( stream);
+            });
+         };
+
+         const auto json_write = write( [&]( auto& stream){ buffer::field::internal::payload::json::stream( origin, stream);});
+         const auto archive_write = write( [&]( auto& stream){ buffer::field::internal::payload::archive::stream( origin, stream, "json");});
+         const auto json_read = read( [&]( auto& stream){ buffer::field::internal::payload::json::stream( stream);});
+         const auto archive_read = read( [&]( auto& stream){ buffer::field::internal::payload::archive::stream( stream, "json");});
+
+         common::log::line( common::unittest::log, "buffer: ", bytes, " bytes - json: ", json.size(), " bytes");
+         common::log::line( common::unittest::log, "  write - json: ", json_write, " bytes/s - archive: ", archive_write, " bytes/s");
+         common::log::line( common::unittest::log, "  read  - json: ", json_read, " bytes/s - archive: ", archive_read, " bytes/s");
+      }
+   }
+
 } // casual
@@ -98,6 +98,10 @@ namespace casual
             //! in a batch
             constexpr size::type recover = 8;
 
+            //! Max number of xa operations (prepare, commit, rollback) for the same
+            //! resource that are sent to a resource proxy in one message
+            constexpr size::type resource = 16;
+
          } // transaction
 
          //! Max number of statistics updates that will be done
@@ -127,6 +131,17 @@ namespace casual
             //! Max number of pending replies before 
             //! a persistent write
             constexpr size::type persistent = 100;
+
+            //! Max number of expired messages that are purged
+            //! per purge
+            constexpr size::type expired = 100;
+
+            namespace forward
+            {
+               //! Max number of messages a forward dequeues (and dispatches) in
+               //! one request to the queue group. Each message has its own transaction.
+               constexpr size::type prefetch = 8;
+            } // forward
          } // queue
 
          namespace service
@@ -144,6 +159,10 @@ namespace casual
 
             //! max number of 'cached' metrics.
             constexpr size::type metrics = 100;
+
+            //! max number of changed entities before the changes are 
+            //! pushed to the subscribers of the service-manager state.
+            constexpr size::type changes = 100;
          } // service
 
          namespace http
@@ -195,8 +214,23 @@ namespace casual
 
          } // transport
 
+         namespace send
+         {
+            //! default max bytes queued per destination, before the overflow policy is applied
+            constexpr size::type capacity = 1024 * 1024 * 4;
+         } // send
+
       } // ipc
 
+      namespace event
+      {
+         namespace ring
+         {
+            //! default bytes of the shared memory ring per event type, 0 -> events are only sent via ipc
+            constexpr size::type capacity = 256 * 1024;
+         } // ring
+      } // event
+
       namespace socket
       {
          namespace native
@@ -216,6 +250,10 @@ namespace casual
                constexpr size::type size = SSIZE_MAX;
                static_assert( size > 0, "tcp::message::max::size overflow");
 
+               //! default max size of a message from another domain, that is reassembled from
+               //! fragments or decompressed, hence allocated from a size the other domain provides.
+               constexpr size::type payload = 1024 * 1024 * 1024;
+
             } // max
             constexpr size::type size = 1024 * 16;
 
@@ -228,6 +266,32 @@ namespace casual
             constexpr int backlog = 10;               
          } // listen
 
+         namespace compression
+         {
+            //! payloads larger than this are compressed on interdomain connections (protocol 1.2)
+            constexpr size::type threshold = 1024;
+
+            //! zstd level, fast and still good for text-like payloads
+            constexpr int level = 1;
+
+            //! the compressed payload has to be at most this percentage of the original to be sent compressed
+            constexpr size::type ratio = 90;
+         } // compression
+
+         namespace stripe
+         {
+            //! the payload size of each fragment when large messages are interleaved over 
+            //! the stripes of a connection (protocol 1.3)
+            constexpr size::type fragment = 64 * 1024;
+         } // stripe
+
+         namespace flow
+         {
+            //! the number of requests an outbound connection is granted to have 'on the way' to, or 
+            //! pending in, the inbound, if the inbound has no message limit configured (protocol 1.4)
+            constexpr size::type window = 1024;
+         } // flow
+
          namespace connect::attempts
          {
             //! threshhold when to start wating a longer time before next connect attempt
@@ -257,6 +321,13 @@ namespace casual
             //! @attention do not use directly - use strong::process::id
             using type = pid_t;
          } // native
+
+         namespace zygote
+         {
+            //! max time to wait for a zygote to fork an instance, before falling back to spawn. The
+            //! zygote is discarded if it does not reply in time, so the spawner blocks this long at most once per zygote.
+            constexpr auto timeout = std::chrono::milliseconds{ 500};
+         } // zygote
       } // process
 
       namespace queue
@@ -267,6 +338,13 @@ namespace casual
             using type = size::type;
             constexpr type invalid = 0;
          } // native
+
+         namespace expire
+         {
+            //! interval between purges of expired messages in a queue group. A purge
+            //! that finds a full batch (batch::queue::expired) is directly followed by the next.
+            constexpr auto interval = std::chrono::seconds{ 1};
+         } // expire
       } // process
 
       //
@@ -9,6 +9,7 @@
 
 
 #include "common/communication/log.h"
+#include "common/communication/device/cache.h"
 
 #include "common/serialize/native/binary.h"
 #include "common/serialize/native/complete.h"
@@ -79,7 +80,7 @@ namespace casual
 
          ~Inbound()
          {
-            if( ! m_cache.empty() && log::category::warning)
+            if( ( ! m_cache.empty() || ! m_incomplete.empty()) && log::category::warning)
             {
                log::Stream warning{ "warning"};
                log::line( warning, "pending messages in cache - ", *this);
@@ -101,28 +102,43 @@ namespace casual
          template< typename P>
          [[nodiscard]] complete_type next( P&& policy)
          {
-            return select(
-               []( auto& m){ return true;},
-               std::forward< P>( policy));
+            // a prioritized message might be behind others on the device, we drain the 
+            // device to the cache so the priorities can take effect.
+            if( m_cache.ordered())
+               flush();
+
+            return find( 
+               std::forward< P>( policy),
+               []( auto& cache){ return cache.first();},
+               []( auto& complete){ return true;});
          }
 
-         //! @return the first complete message from the cache
+         //! @return the first complete message from the cache, prioritized types first
          [[nodiscard]] complete_type cached()
          {
-            auto is_complete = []( auto& message){ return message.complete();};
-
-            if( auto found = algorithm::find_if( m_cache, is_complete))
-               return algorithm::container::extract( m_cache, std::begin( found));
-
-            return {};
+            return m_cache.first();
          }
 
          //! @return true if message with `type` exists in the cache, and is a complete message.
          bool cached( common::message::Type type)
          {
-            auto has_type = [type]( auto& message) { return message.complete() && message.type() == type;};
+            return m_cache.contains( type);
+         }
+
+         //! Sets the message types that should be consumed before other messages. When
+         //! priorities (or deferred types) are set, the device is drained to the cache before
+         //! `next( policy)` picks a message, so messages that are not read yet are considered as well.
+         //! Lookups on a specific type or correlation is not affected.
+         void priorities( std::vector< common::message::Type> types)
+         {
+            m_cache.priorities( std::move( types));
+         }
 
-            return predicate::boolean( algorithm::find_if( m_cache, has_type));
+         //! Sets the message types that are consumed when there are no other messages, such as
+         //! metrics. Lookups on a specific type or correlation is not affected.
+         void deferred( std::vector< common::message::Type> types)
+         {
+            m_cache.deferred( std::move( types));
          }
 
          //! Tries to find the first logic complete message with a specific type
@@ -132,9 +148,10 @@ namespace casual
          template< typename P>
          [[nodiscard]] complete_type next( common::message::Type type, P&& policy)
          {
-            return select(
-               [type]( auto& complete){ return complete.type() == type;},
-               std::forward< P>( policy));
+            return find(
+               std::forward< P>( policy),
+               [type]( auto& cache){ return cache.first( type);},
+               [type]( auto& complete){ return complete.type() == type;});
          }
 
          //! Tries to find the first logic complete message with any of the types in @p types
@@ -147,9 +164,10 @@ namespace casual
             // `types` is a temple to enable other forms of containers than std::vector
             -> std::enable_if_t< traits::is::same_v< traits::remove_cvref_t< decltype( *std::begin( types))>, common::message::Type>, complete_type>
          {
-            return select(
-               [&types]( auto& complete){ return ! common::algorithm::find( types, complete.type()).empty();},
-               std::forward< P>( policy));
+            return find(
+               std::forward< P>( policy),
+               [&types]( auto& cache){ return cache.first_of( types);},
+               [&types]( auto& complete){ return ! common::algorithm::find( types, complete.type()).empty();});
          }
 
          // Added for completeness, there are variants that accepts a single type and correlation,
@@ -166,10 +184,12 @@ namespace casual
             // `types` is a temple to enable other forms of containers than std::vector
             -> std::enable_if_t< traits::is::same_v< traits::remove_cvref_t< decltype( *std::begin( types))>, common::message::Type>, complete_type>
          {
-            return select(
-               [&types, &correlation]( auto& complete){ return (! common::algorithm::find( types, complete.type()).empty()) 
-                                                  && complete.correlation() == correlation;},
-               std::forward< P>( policy));
+            auto has_type = [&types]( auto& complete){ return ! common::algorithm::find( types, complete.type()).empty();};
+
+            return find(
+               std::forward< P>( policy),
+               [&]( auto& cache){ return cache.select( correlation, has_type);},
+               [&]( auto& complete){ return has_type( complete) && complete.correlation() == correlation;});
          }
 
          //! Tries to find the logic complete message with correlation @p correlation
@@ -179,9 +199,10 @@ namespace casual
          template< typename P>
          [[nodiscard]] complete_type next( const correlation_type& correlation, P&& policy)
          {
-            return select(
-               [&correlation]( auto& complete){ return complete.correlation() == correlation;},
-               std::forward< P>( policy));
+            return find(
+               std::forward< P>( policy),
+               [&correlation]( auto& cache){ return cache.first( correlation);},
+               [&correlation]( auto& complete){ return complete.correlation() == correlation;});
          }
 
          //! Tries to find a logic complete message a specific type and correlation
@@ -191,9 +212,10 @@ namespace casual
          template< typename P>
          [[nodiscard]] complete_type next( common::message::Type type, const correlation_type& correlation, P&& policy)
          {
-            return select(
-               [type, &correlation]( auto& complete){ return complete.type() == type && complete.correlation() == correlation;},
-               std::forward< P>( policy));
+            return find(
+               std::forward< P>( policy),
+               [type, &correlation]( auto& cache){ return cache.first( type, correlation);},
+               [type, &correlation]( auto& complete){ return complete.type() == type && complete.correlation() == correlation;});
          }
 
          //! Tries to find a logic complete message that fulfills the predicate
@@ -203,16 +225,10 @@ namespace casual
          template< typename Predicate, typename Policy>
          [[nodiscard]] complete_type select( Predicate&& predicate, Policy&& policy)
          {
-            auto found = find(
-                  std::forward< Policy>( policy),
-                  predicate::make_and(
-                        []( const auto& message){ return message.complete();},
-                        std::forward< Predicate>( predicate)));
-
-            if( found)
-               return algorithm::container::extract( m_cache, std::begin( found));
-
-            return {};
+            return find(
+               std::forward< Policy>( policy),
+               [&predicate]( auto& cache){ return cache.select( predicate);},
+               predicate);
          }
 
          //! Tries to find a message with the same type as @p message
@@ -249,14 +265,13 @@ namespace casual
          {
             flush();
 
-            auto complete = algorithm::find_if( m_cache, [&]( auto& complete){ return complete.correlation() == correlation;});
+            if( m_cache.discard( correlation))
+               return;
 
-            if( complete)
+            if( auto incomplete = algorithm::find_if( m_incomplete, [&]( auto& complete){ return complete.correlation() == correlation;}))
             {
-               if( ! complete->complete())
-                  m_discarded.push_back( correlation);
-
-               m_cache.erase( complete.begin());
+               m_discarded.push_back( correlation);
+               m_incomplete.erase( std::begin( incomplete));
             }
             else
             {
@@ -274,13 +289,18 @@ namespace casual
 
             if constexpr( std::is_same_v< std::decay_t< M>, complete_type>)
             {
-               static_assert( std::is_rvalue_reference_v< M>, "complete_type needs to be a rvalue");
-               m_cache.push_back( std::move( message));
+               static_assert( ! std::is_lvalue_reference_v< M>, "complete_type needs to be a rvalue");
+               correlation_type correlation = message.correlation();
+               m_cache.push( std::move( message));
+               return correlation;
             }
             else
-               m_cache.push_back( serialize::native::complete< complete_type>( std::forward< M>( message)));
-
-             return m_cache.back().correlation();
+            {
+               auto complete = serialize::native::complete< complete_type>( std::forward< M>( message));
+               correlation_type correlation = complete.correlation();
+               m_cache.push( std::move( complete));
+               return correlation;
+            }
          }
 
          //! flushes the messages on the device into cache. (ie, make the device writable if it was full), if implemented.
@@ -293,33 +313,18 @@ namespace casual
          void clear()
          {
             flush();
-            std::exchange( m_cache, {});
+            m_cache.clear();
+            std::exchange( m_incomplete, {});
          }
 
          //! @returns the number of messages complete or incomplete in the cache
-         inline platform::size::type size() const noexcept { return m_cache.size();}
+         inline platform::size::type size() const noexcept { return complete() + incomplete();}
 
          //! @returns the number of complete messages in the cache
-         inline platform::size::type complete() const noexcept 
-         { 
-            return algorithm::accumulate( m_cache, platform::size::type{}, []( auto result, auto& message)
-            {
-               if( message.complete())
-                  return ++result;
-               return result;
-            });
-         }
+         inline platform::size::type complete() const noexcept { return m_cache.size();}
 
          //! @returns the number of incomplete messages in the cache
-         inline platform::size::type incomplete() const noexcept
-         { 
-            return algorithm::accumulate( m_cache, platform::size::type{}, []( auto result, auto& message)
-            {
-               if( ! message.complete())
-                  return ++result;
-               return result;
-            });
-         }
+         inline platform::size::type incomplete() const noexcept { return m_incomplete.size();}
 
          Connector& connector() { return m_connector;}
          const Connector& connector() const { return m_connector;}
@@ -328,6 +333,7 @@ namespace casual
          CASUAL_LOG_SERIALIZE(
             CASUAL_SERIALIZE_NAME( m_connector, "connector");
             CASUAL_SERIALIZE_NAME( m_cache, "cache");
+            CASUAL_SERIALIZE_NAME( m_incomplete, "incomplete");
             CASUAL_SERIALIZE_NAME( m_discarded, "discarded");
          )
 
@@ -363,25 +369,55 @@ namespace casual
          }
 
 
-         template< typename Policy, typename Predicate>
-         cache_range_type find( Policy&& policy, Predicate&& predicate)
+         //! @param lookup tries to find a message in the (indexed) cache
+         //! @param predicate is only applied to newly received complete messages, hence
+         //!   we never rescan the cache for each received message.
+         template< typename Policy, typename Lookup, typename Predicate>
+         complete_type find( Policy&& policy, Lookup&& lookup, Predicate&& predicate)
          {
             while( true)
             {
                try
                {
-                  auto found = algorithm::find_if( m_cache, predicate);
+                  if( auto found = lookup( m_cache))
+                     return found;
 
-                  while( ! found && ( found = policy.receive( m_connector, m_cache)))
+                  while( auto received = policy.receive( m_connector, m_incomplete))
                   {
-                     // Check if we should discard the message
-                     if( discard( *found))
-                        m_cache.erase( std::begin( found));
-
-                     // Try to find a massage that matches the predicate
-                     found = algorithm::find_if( m_cache, predicate);
+                     complete_type found;
+
+                     // one receive can complete several messages (read ahead), we take care of all
+                     // that got complete, and keep the rest for the next receive.
+                     auto index = std::distance( std::begin( m_incomplete), std::begin( received));
+                     auto count = received.size();
+
+                     while( count-- > 0)
+                     {
+                        auto current = std::begin( m_incomplete) + index;
+
+                        // wait for the rest of the message
+                        if( ! current->complete())
+                        {
+                           ++index;
+                           continue;
+                        }
+
+                        auto complete = algorithm::container::extract( m_incomplete, current);
+
+                        // Check if we should discard the message
+                        if( discard( complete))
+                           continue;
+
+                        if( ! found && predicate( complete))
+                           found = std::move( complete);
+                        else
+                           m_cache.push( std::move( complete));
+                     }
+
+                     if( found)
+                        return found;
                   }
-                  return found;
+                  return {};
                }
                catch( ...)
                {
@@ -394,7 +430,7 @@ namespace casual
          {
             auto found = algorithm::find( m_discarded, complete.correlation());
 
-            if( found && complete.complete())
+            if( found)
             {
                m_discarded.erase( std::begin( found));
                return true;
@@ -402,7 +438,10 @@ namespace casual
             return false;
          }
 
-         cache_type m_cache;
+         //! logical complete messages
+         cache::Index< complete_type> m_cache;
+         //! messages that we've only got parts of, the connector policies works on these.
+         cache_type m_incomplete;
          std::vector< correlation_type> m_discarded;
          Connector m_connector;
       };
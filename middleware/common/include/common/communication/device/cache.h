@@ -0,0 +1,317 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#pragma once
+
+#include "common/message/type.h"
+#include "common/strong/id.h"
+#include "common/algorithm.h"
+#include "common/algorithm/container.h"
+#include "common/serialize/macro.h"
+#include "casual/platform.h"
+
+#include <unordered_map>
+#include <deque>
+#include <vector>
+#include <optional>
+
+namespace casual
+{
+   namespace common::communication::device::cache
+   {
+      //! Holds logical complete messages in arrival order, indexed on type and correlation.
+      //!
+      //! Lookups on type and/or correlation is amortized constant time, no matter how many
+      //! messages that are cached. Messages with a type in `priorities` are consumed before
+      //! other messages when the lookup matches more than one message, and messages with a
+      //! type in `deferred` are consumed after other messages.
+      //!
+      //! The type and arrival indexes are _lazy_, extracted entries are removed when they
+      //! show up in the front, or when the indexes are compacted.
+      template< typename Complete>
+      struct Index
+      {
+         using complete_type = Complete;
+         using correlation_type = strong::correlation::id;
+         using sequence_type = platform::size::type;
+
+         void push( complete_type&& complete)
+         {
+            auto sequence = m_sequence++;
+
+            // deferred messages are only reachable via the type index
+            if( ! deferred( complete.type()))
+               m_arrival.push_back( sequence);
+
+            m_types[ complete.type()].push_back( sequence);
+            m_correlations[ complete.correlation()].push_back( sequence);
+            m_messages.emplace( sequence, std::move( complete));
+         }
+
+         //! @return the first message, prioritized types first and deferred types last.
+         //!         'empty' complete if the cache is empty
+         complete_type first()
+         {
+            if( auto sequence = prioritized())
+               return extract( *sequence);
+
+            if( auto sequence = front( m_arrival))
+               return extract( *sequence);
+
+            if( auto sequence = oldest( m_deferred))
+               return extract( *sequence);
+
+            return {};
+         }
+
+         //! @return the first message with `type`
+         complete_type first( common::message::Type type)
+         {
+            if( auto sequence = front( type))
+               return extract( *sequence);
+            return {};
+         }
+
+         //! @return the first message with `correlation`
+         complete_type first( const correlation_type& correlation)
+         {
+            if( auto found = m_correlations.find( correlation); found != std::end( m_correlations))
+               return extract( found->second.front());
+            return {};
+         }
+
+         //! @return the first message with `type` and `correlation`
+         complete_type first( common::message::Type type, const correlation_type& correlation)
+         {
+            return select( correlation, [type]( auto& complete){ return complete.type() == type;});
+         }
+
+         //! @return the first message with any of `types`, prioritized types first and deferred types last
+         template< typename R>
+         complete_type first_of( R&& types)
+         {
+            std::optional< sequence_type> result;
+            std::optional< sequence_type> last;
+
+            for( auto type : types)
+            {
+               auto sequence = front( type);
+               if( ! sequence)
+                  continue;
+
+               if( prioritized( type))
+                  return extract( *sequence);
+
+               auto& candidate = deferred( type) ? last : result;
+
+               if( ! candidate || *sequence < *candidate)
+                  candidate = sequence;
+            }
+
+            if( result)
+               return extract( *result);
+
+            if( last)
+               return extract( *last);
+
+            return {};
+         }
+
+         //! @return the first message with `correlation` that fulfills `predicate`
+         template< typename P>
+         complete_type select( const correlation_type& correlation, P&& predicate)
+         {
+            if( auto found = m_correlations.find( correlation); found != std::end( m_correlations))
+            {
+               if( auto sequence = algorithm::find_if( found->second, [&]( auto sequence){ return predicate( m_messages.at( sequence));}))
+                  return extract( *sequence);
+            }
+            return {};
+         }
+
+         //! @return the first message that fulfills `predicate`, prioritized types first.
+         //! @attention linear in the number of cached messages, use the type/correlation
+         //!   lookups if possible.
+         template< typename P>
+         complete_type select( P&& predicate)
+         {
+            auto match = [&]( auto sequence)
+            {
+               auto found = m_messages.find( sequence);
+               return found != std::end( m_messages) && predicate( found->second);
+            };
+
+            for( auto type : m_priorities)
+            {
+               if( auto found = m_types.find( type); found != std::end( m_types))
+                  if( auto sequence = algorithm::find_if( found->second, match))
+                     return extract( *sequence);
+            }
+
+            if( auto sequence = algorithm::find_if( m_arrival, match))
+               return extract( *sequence);
+
+            for( auto type : m_deferred)
+            {
+               if( auto found = m_types.find( type); found != std::end( m_types))
+                  if( auto sequence = algorithm::find_if( found->second, match))
+                     return extract( *sequence);
+            }
+
+            return {};
+         }
+
+         //! @return true if there is a message with `type`
+         bool contains( common::message::Type type) { return front( type).has_value();}
+
+         //! removes the first message with `correlation`
+         //! @return true if a message was removed
+         bool discard( const correlation_type& correlation)
+         {
+            if( auto found = m_correlations.find( correlation); found != std::end( m_correlations))
+            {
+               extract( found->second.front());
+               return true;
+            }
+            return false;
+         }
+
+         //! sets the types that are consumed first, in the given order
+         void priorities( std::vector< common::message::Type> types) { m_priorities = std::move( types);}
+         const std::vector< common::message::Type>& priorities() const noexcept { return m_priorities;}
+
+         //! sets the types that are consumed when no other message matches, in arrival order.
+         //! @attention only affects messages that are cached after the call
+         void deferred( std::vector< common::message::Type> types) { m_deferred = std::move( types);}
+         const std::vector< common::message::Type>& deferred() const noexcept { return m_deferred;}
+
+         //! @return true if the consume order differs from the arrival order
+         bool ordered() const noexcept { return ! m_priorities.empty() || ! m_deferred.empty();}
+
+         void clear()
+         {
+            m_messages.clear();
+            m_arrival.clear();
+            m_types.clear();
+            m_correlations.clear();
+            m_stale = 0;
+         }
+
+         inline platform::size::type size() const noexcept { return m_messages.size();}
+         inline bool empty() const noexcept { return m_messages.empty();}
+
+         CASUAL_LOG_SERIALIZE(
+            CASUAL_SERIALIZE_NAME( size(), "size");
+            CASUAL_SERIALIZE_NAME( m_priorities, "priorities");
+            CASUAL_SERIALIZE_NAME( m_deferred, "deferred");
+         )
+
+      private:
+
+         //! minimum number of stale index entries before we consider compaction
+         static constexpr platform::size::type compaction_threshold = 64;
+
+         std::optional< sequence_type> front( std::deque< sequence_type>& sequences)
+         {
+            while( ! sequences.empty())
+            {
+               if( m_messages.count( sequences.front()) > 0)
+                  return sequences.front();
+
+               sequences.pop_front();
+            }
+            return {};
+         }
+
+         std::optional< sequence_type> front( common::message::Type type)
+         {
+            if( auto found = m_types.find( type); found != std::end( m_types))
+               return front( found->second);
+            return {};
+         }
+
+         bool prioritized( common::message::Type type) const noexcept
+         {
+            return ! algorithm::find( m_priorities, type).empty();
+         }
+
+         bool deferred( common::message::Type type) const noexcept
+         {
+            return ! algorithm::find( m_deferred, type).empty();
+         }
+
+         //! @return the first (oldest) message with any of `types`
+         std::optional< sequence_type> oldest( const std::vector< common::message::Type>& types)
+         {
+            std::optional< sequence_type> result;
+
+            for( auto type : types)
+               if( auto sequence = front( type); sequence && ( ! result || *sequence < *result))
+                  result = sequence;
+
+            return result;
+         }
+
+         std::optional< sequence_type> prioritized()
+         {
+            for( auto type : m_priorities)
+               if( auto sequence = front( type))
+                  return sequence;
+            return {};
+         }
+
+         complete_type extract( sequence_type sequence)
+         {
+            auto found = m_messages.find( sequence);
+            auto result = std::move( found->second);
+            m_messages.erase( found);
+
+            // the correlation index is exact, there is (almost) always just one message per correlation
+            if( auto correlated = m_correlations.find( result.correlation()); correlated != std::end( m_correlations))
+            {
+               if( auto position = algorithm::find( correlated->second, sequence))
+                  correlated->second.erase( std::begin( position));
+
+               if( correlated->second.empty())
+                  m_correlations.erase( correlated);
+            }
+
+            if( ++m_stale > compaction_threshold && m_stale > size())
+               compact();
+
+            return result;
+         }
+
+         //! removes all extracted sequences from the lazy indexes. Amortized constant
+         //! since we only compact when there are more stale entries than messages.
+         void compact()
+         {
+            auto stale = [&]( auto sequence){ return m_messages.count( sequence) == 0;};
+
+            algorithm::container::trim( m_arrival, algorithm::remove_if( m_arrival, stale));
+
+            algorithm::container::erase_if( m_types, [&stale]( auto& pair)
+            {
+               algorithm::container::trim( pair.second, algorithm::remove_if( pair.second, stale));
+               return pair.second.empty();
+            });
+
+            m_stale = 0;
+         }
+
+         std::unordered_map< sequence_type, complete_type> m_messages;
+         std::deque< sequence_type> m_arrival;
+         std::unordered_map< common::message::Type, std::deque< sequence_type>> m_types;
+         std::unordered_map< correlation_type, std::deque< sequence_type>> m_correlations;
+         std::vector< common::message::Type> m_priorities;
+         std::vector< common::message::Type> m_deferred;
+         sequence_type m_sequence{};
+         platform::size::type m_stale{};
+      };
+
+   } // common::communication::device::cache
+} // casual
@@ -0,0 +1,211 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#pragma once
+
+#include "common/communication/ipc.h"
+#include "common/serialize/native/complete.h"
+#include "common/exception/handle.h"
+#include "common/metric.h"
+#include "common/pimpl.h"
+#include "common/strong/id.h"
+#include "common/serialize/macro.h"
+#include "common/message/type.h"
+#include "common/traits.h"
+
+#include "casual/platform.h"
+
+#include <iosfwd>
+#include <vector>
+
+namespace casual
+{
+   namespace common::communication::ipc::send
+   {
+      namespace overflow
+      {
+         //! what to do when a destination's outbound queue has reached its capacity
+         enum class Policy : short
+         {
+            //! flush the inbound (to the cache) until the destination has room, same as `ipc::flush::send`
+            block,
+            //! discard requests, replies are never discarded (they're queued regardless of the capacity)
+            shed,
+            //! raise `code::casual::communication_retry` to the caller
+            error,
+         };
+
+         std::ostream& operator << ( std::ostream& out, Policy value);
+
+         //! if the message may be discarded by the `shed` policy
+         enum class Discard : short
+         {
+            never,
+            allowed,
+         };
+
+         namespace discard
+         {
+            namespace detail
+            {
+               template< typename M>
+               using reverse = typename common::message::reverse::type_traits< M>::reverse_type;
+            } // detail
+
+            //! only requests (that has a reply type) may be discarded. The sender is told
+            //! via the 'empty' correlation, a reply is not known to be awaited by anyone.
+            template< typename M>
+            constexpr Discard policy() noexcept
+            {
+               if constexpr( traits::detect::is_detected_v< detail::reverse, std::decay_t< M>>)
+                  return Discard::allowed;
+               else
+                  return Discard::never;
+            }
+         } // discard
+
+      } // overflow
+
+      struct Settings
+      {
+         //! max bytes queued per destination before the overflow policy is applied
+         platform::size::type capacity = platform::ipc::send::capacity;
+         overflow::Policy overflow = overflow::Policy::block;
+
+         CASUAL_LOG_SERIALIZE(
+            CASUAL_SERIALIZE( capacity);
+            CASUAL_SERIALIZE( overflow);
+         )
+      };
+
+      namespace settings
+      {
+         //! @returns settings from `CASUAL_IPC_SEND_CAPACITY` and `CASUAL_IPC_SEND_OVERFLOW`, if set.
+         Settings environment();
+      } // settings
+
+      namespace destination
+      {
+         struct Metric
+         {
+            strong::ipc::id ipc;
+
+            struct
+            {
+               //! current number of queued messages
+               platform::size::type count{};
+               //! current queued bytes
+               platform::size::type size{};
+               //! the most bytes that has been queued
+               platform::size::type high{};
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( count);
+                  CASUAL_SERIALIZE( size);
+                  CASUAL_SERIALIZE( high);
+               )
+            } queue;
+
+            //! number of requests discarded due to overflow
+            platform::size::type shed{};
+
+            //! the durations the destination has had queued messages, that is, was not writable
+            common::Metric stall;
+
+            CASUAL_CONST_CORRECT_SERIALIZE(
+               CASUAL_SERIALIZE( ipc);
+               CASUAL_SERIALIZE( queue);
+               CASUAL_SERIALIZE( shed);
+               CASUAL_SERIALIZE( stall);
+            )
+         };
+      } // destination
+
+      //! Per destination outbound queues, with bounded memory.
+      //!
+      //! A message is sent directly if the destination has nothing queued and is writable, otherwise
+      //! it's queued (in order) for the destination. The write readiness of the destinations with
+      //! queued messages is multiplexed to `descriptor()` (epoll on linux, kqueue on platforms that
+      //! has kqueue), that is readable when any of them is writable, and is intended to be multiplexed
+      //! with the inbound in `communication::select`. Hence, a full destination does not stall the
+      //! owner, and messages to other destinations are not affected.
+      class Coordinator
+      {
+      public:
+         //! settings from `settings::environment()`
+         Coordinator();
+         explicit Coordinator( Settings settings);
+         ~Coordinator();
+
+         Coordinator( Coordinator&&) noexcept;
+         Coordinator& operator = ( Coordinator&&) noexcept;
+
+         //! sends or queues `message` to `destination`
+         //! @param discard if the message may be discarded by the `shed` policy, default only requests.
+         //! @returns the correlation of the message, 'empty' if the message (a request) is shed.
+         //! @throws `code::casual::communication_unavailable` if `destination` is gone,
+         //!   `code::casual::communication_retry` if the destination is full and the policy is `error`.
+         template< typename M>
+         strong::correlation::id send( const strong::ipc::id& destination, M&& message, overflow::Discard discard = overflow::discard::policy< M>())
+         {
+            if constexpr( std::is_same_v< std::decay_t< M>, message::Complete>)
+            {
+               if constexpr( std::is_rvalue_reference_v< M&&>)
+                  return send( destination, std::move( message), discard);
+               else
+                  return send( destination, message::Complete{ message.type(), message.correlation(), message::Complete::payload_type{ message.payload}}, discard);
+            }
+            else
+               return send( destination, serialize::native::complete< message::Complete>( std::forward< M>( message)), discard);
+         }
+
+         strong::correlation::id send( const strong::ipc::id& destination, message::Complete&& complete, overflow::Discard discard);
+
+         //! sends the queued messages to the destinations that are writable, without blocking.
+         //! Destinations that are drained, or gone, are discarded.
+         void send();
+
+         //! @returns the descriptor that is readable when any destination with queued messages is writable.
+         strong::file::descriptor::id descriptor() const noexcept;
+
+         //! @returns true if there are no queued messages
+         bool empty() const noexcept;
+
+         //! @returns the metrics for the destinations that has queued messages
+         std::vector< destination::Metric> metrics() const;
+
+         const Settings& settings() const noexcept;
+
+      private:
+         class Implementation;
+         move::basic_pimpl< Implementation> m_implementation;
+      };
+
+      namespace optional
+      {
+         //! sends or queues `message` to `destination` via `coordinator`. If `destination` is
+         //! unavailable 'empty' correlation is returned
+         template< typename M>
+         strong::correlation::id send( Coordinator& coordinator, const strong::ipc::id& destination, M&& message)
+         {
+            try
+            {
+               return coordinator.send( destination, std::forward< M>( message));
+            }
+            catch( ...)
+            {
+               if( exception::capture().code() != code::casual::communication_unavailable)
+                  throw;
+
+               log::line( communication::log, code::casual::communication_unavailable, " failed to send message - action: ignore");
+
+               return {};
+            }
+         }
+      } // optional
+
+   } // common::communication::ipc::send
+} // casual
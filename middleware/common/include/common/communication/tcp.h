@@ -21,6 +21,7 @@
 
 #include <string>
 #include <string_view>
+#include <system_error>
 
 namespace casual
 {
@@ -150,6 +151,37 @@ namespace casual
 
       using Duplex = communication::device::Duplex< Connector>;
 
+      namespace batch
+      {
+         //! Tries to send `completes`, in order, without blocking. The messages are gathered
+         //! into one system call, which reduces the overhead when there are a lot of small
+         //! messages waiting to be sent.
+         //!
+         //! @returns the number of messages from the start of `completes` that are completely
+         //!   sent. The next message might be partially sent.
+         //! @throws code::casual::communication_unavailable or code::casual::communication_refused 
+         //!   if the connection is lost.
+         platform::size::type send( const Socket& socket, range::type_t< std::vector< message::Complete>> completes);
+
+         //! a socket, and the messages that waits to be sent to it.
+         struct Destination
+         {
+            const Socket* socket = nullptr;
+            range::type_t< std::vector< message::Complete>> completes;
+
+            //! the number of messages from the start of `completes` that are completely sent
+            platform::size::type count = 0;
+            //! set if the send failed, the connection is lost
+            std::error_code error;
+         };
+
+         //! Tries to send to all `destinations`, as `send` above, without blocking. With io_uring, 
+         //! the sends to all destinations are submitted with one system call, otherwise it's one 
+         //! system call per destination. 
+         //! @attention at most one destination per socket
+         void send( range::type_t< std::vector< Destination>> destinations);
+      } // batch
+
    } // common::communication::tcp
 
 
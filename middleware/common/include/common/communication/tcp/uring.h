@@ -0,0 +1,101 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#pragma once
+
+#include "common/communication/socket.h"
+#include "common/range.h"
+
+#include "casual/platform.h"
+
+#include <sys/socket.h>
+
+#include <vector>
+
+namespace casual
+{
+   namespace common::communication::tcp::uring
+   {
+      //! @returns true if the kernel supports io_uring and we're allowed to register
+      //!   buffers. Probed once per thread.
+      bool supported() noexcept;
+
+      //! @returns true if tcp I/O shall use io_uring, which is the case if it's `supported()` and
+      //!   enabled via `environment::variable::name::tcp::io_uring` (`CASUAL_TCP_IO_URING`), or explicitly via `enable`.
+      bool enabled() noexcept;
+
+      //! explicitly enables/disables io_uring for tcp I/O in this process.
+      //! @attention has no effect if io_uring is not `supported()`
+      void enable( bool value) noexcept;
+
+      namespace read::ahead
+      {
+         //! size of each of the ring's receive buffers, and the most one `receive` returns.
+         constexpr platform::size::type size = 64 * 1024;
+         //! the number of receive buffers the ring provides to the kernel, shared by the sockets of the thread.
+         constexpr platform::size::type count = 16;
+         //! the most received buffers one socket keeps before its receive is paused, so a socket 
+         //! that is not read from (throttled) can't starve the others.
+         constexpr platform::size::type hold = 4;
+      } // read::ahead
+
+      //! The first `receive` on a socket arms a multishot receive, after that the kernel receives into
+      //! the ring's buffers as bytes arrive, and completions are reaped from the completion queue 
+      //! without system calls. A regular non blocking receive is only used if the ring has no buffers 
+      //! left, or the kernel does not support multishot receive.
+      //!
+      //! @returns the received bytes, valid until the next `receive` on this thread. Empty
+      //!   if nothing is received (yet).
+      //! @throws code::casual::communication_unavailable if the peer has performed an orderly shutdown
+      Range< const char*> receive( const Socket& socket);
+
+      //! blocks until there might be something to `receive` from the socket.
+      void wait( const Socket& socket);
+
+      //! the socket is about to be closed: cancels the armed receive, if any, and discards what's received.
+      void close( strong::socket::id descriptor) noexcept;
+
+      namespace dispatch
+      {
+         //! submits the queued operations, and reaps the completed receives.
+         //! @returns the descriptors, of `descriptors`, that have received bytes (or end of file) that waits
+         //!   to be consumed via `receive`
+         std::vector< strong::file::descriptor::id> ready( range::type_t< std::vector< strong::file::descriptor::id>> descriptors);
+
+         //! @returns true if the receives from `descriptor` are driven by the ring, hence the socket shall
+         //!   not be selected on.
+         bool armed( strong::file::descriptor::id descriptor) noexcept;
+
+         //! @returns the ring descriptor, to select for read, if any receive is armed, 'nil' otherwise.
+         strong::file::descriptor::id descriptor() noexcept;
+
+      } // dispatch
+
+      //! Sends `message` with one submission, without blocking.
+      //! @returns the number of bytes sent, 0 if the socket is not writable.
+      platform::size::type send( const Socket& socket, const ::msghdr& message);
+
+      namespace batch
+      {
+         struct Send
+         {
+            const Socket* socket = nullptr;
+            const ::msghdr* message = nullptr;
+            //! the number of bytes sent, or -errno
+            int result = 0;
+         };
+
+         //! Sends all `sends`, to different sockets, without blocking. The sends are submitted
+         //! with one system call (per 64 sends), and the completions are reaped in whatever order 
+         //! the kernel completes them. 
+         //! @attention at most one send per socket, since the kernel does not keep the order
+         //!   between submissions.
+         void send( range::type_t< std::vector< Send>> sends);
+      } // batch
+
+   } // common::communication::tcp::uring
+} // casual
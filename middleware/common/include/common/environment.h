@@ -249,6 +249,89 @@ namespace casual
                } // ipc
                //! @}
 
+               namespace ipc::send
+               {
+                  //! max bytes queued per destination, before the overflow policy is applied
+                  constexpr auto capacity = "CASUAL_IPC_SEND_CAPACITY";
+                  //! what to do when a destination is full: `block`, `shed` or `error`
+                  constexpr auto overflow = "CASUAL_IPC_SEND_OVERFLOW";
+               } // ipc::send
+
+               namespace tcp
+               {
+                  //! if `1`, interdomain tcp I/O uses io_uring, when the kernel supports it
+                  constexpr auto io_uring = "CASUAL_TCP_IO_URING";
+               } // tcp
+
+               namespace event
+               {
+                  namespace ring
+                  {
+                     //! bytes per shared memory event ring, `0` disables the rings
+                     constexpr auto capacity = "CASUAL_EVENT_RING_CAPACITY";
+                  } // ring
+               } // event
+
+               namespace domain
+               {
+                  namespace boot
+                  {
+                     //! max number of servers/executables that are spawned (and not ready) at the same time
+                     constexpr auto parallelism = "CASUAL_DOMAIN_BOOT_PARALLELISM";
+                  } // boot
+
+                  //! if "1", new server instances are forked from a pre-loaded zygote of the server
+                  constexpr auto zygote = "CASUAL_DOMAIN_ZYGOTE";
+               } // domain
+
+               namespace queue
+               {
+                  //! payloads larger than the threshold (bytes) are stored outside the queuebase
+                  constexpr auto blob = "CASUAL_QUEUE_BLOB_THRESHOLD";
+
+                  namespace forward
+                  {
+                     //! max number of messages a forward dequeues in one request
+                     constexpr auto prefetch = "CASUAL_QUEUE_FORWARD_PREFETCH";
+                  } // forward
+               } // queue
+
+               namespace transaction
+               {
+                  namespace resource
+                  {
+                     //! max number of xa operations the TM batches to a resource proxy in one message
+                     constexpr auto batch = "CASUAL_TRANSACTION_RESOURCE_BATCH";
+
+                     //! duration the TM waits for more xa operations before it sends a batch, default `0`
+                     constexpr auto linger = "CASUAL_TRANSACTION_RESOURCE_LINGER";
+                  } // resource
+               } // transaction
+
+               namespace gateway
+               {
+                  namespace compression
+                  {
+                     //! payloads larger than the threshold (bytes) are compressed on interdomain connections, `0` disables
+                     constexpr auto threshold = "CASUAL_GATEWAY_COMPRESSION_THRESHOLD";
+
+                     //! the zstd compression level
+                     constexpr auto level = "CASUAL_GATEWAY_COMPRESSION_LEVEL";
+                  } // compression
+
+                  namespace message
+                  {
+                     //! max bytes of a message that is reassembled or decompressed from another domain
+                     constexpr auto size = "CASUAL_GATEWAY_MESSAGE_MAX_SIZE";
+                  } // message
+               } // gateway
+
+               namespace service
+               {
+                  //! the priority class for service lookups from the process
+                  constexpr auto priority = "CASUAL_SERVICE_PRIORITY";
+               } // service
+
                namespace terminal
                {
                   constexpr auto precision = "CASUAL_TERMINAL_PRECISION";
@@ -9,12 +9,14 @@
 
 
 #include "common/message/event.h"
+#include "common/event/ring.h"
 
 #include "common/communication/ipc/message.h"
 #include "common/serialize/native/complete.h"
 #include "common/algorithm/container.h"
 
 #include "common/message/pending.h"
+#include "common/environment.h"
 
 namespace casual
 {
@@ -29,12 +31,21 @@ namespace casual
 
          inline const std::vector< common::process::Handle>& subscribers() const { return m_subscribers;}
 
+         //! creates a shared memory ring for the event `type`. Subscribers that reads the ring
+         //! are not sent the event via ipc.
+         void multicast( message::Type type, platform::size::type capacity);
+
+         inline const ring::Writer& multicast() const noexcept { return m_ring;}
+
       protected:
 
          common::message::pending::Message pending( complete_type&& complete) const;
 
          std::vector< common::process::Handle> m_subscribers;
 
+         //! written to when the event is created, hence mutable
+         mutable ring::Writer m_ring;
+
          template< typename ID>
          bool exists( ID id) const
          {
@@ -69,6 +80,9 @@ namespace casual
          template< typename ID>
          void remove( ID id)
          {
+            if constexpr( std::is_same_v< ID, strong::process::id>)
+               m_ring.remove( id);
+
             algorithm::container::trim( m_subscribers, algorithm::remove_if( m_subscribers, [id]( auto& process){
                return process == id;
             }));
@@ -90,6 +104,7 @@ namespace casual
          CASUAL_LOG_SERIALIZE(
             CASUAL_SERIALIZE_NAME( Event::type(), "event");
             CASUAL_SERIALIZE_NAME( m_subscribers, "subscribers");
+            CASUAL_SERIALIZE_NAME( m_ring, "ring");
          )
       };
 
@@ -130,6 +145,16 @@ namespace casual
             {
                do_remove( pid, Events{}...);
             }
+
+            //! creates shared memory rings for the events that can be published via rings
+            //! (@see ring::eligible), with the capacity from `CASUAL_EVENT_RING_CAPACITY`, if not 0.
+            void multicast()
+            {
+               auto capacity = environment::variable::get( environment::variable::name::event::ring::capacity, platform::event::ring::capacity);
+
+               if( capacity > 0)
+                  do_multicast( capacity, Events{}...);
+            }
             
             template< typename E>
             common::message::pending::Message operator () ( const E& event) const
@@ -161,6 +186,16 @@ namespace casual
 
             void do_remove( strong::process::id pid) { }
 
+            void do_multicast( platform::size::type capacity) { }
+
+            template< typename E, typename... Es>
+            void do_multicast( platform::size::type capacity, E&&, Es&&...)
+            {
+               if( ring::eligible( E::type()))
+                  event< E>().multicast( E::type(), capacity);
+               do_multicast( capacity, Es{}...);
+            }
+
 
             template< typename E, typename... Es>
             void do_remove( strong::process::id pid, E&&, Es&&...)
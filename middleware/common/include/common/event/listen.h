@@ -10,6 +10,7 @@
 
 #include "common/message/event.h"
 #include "common/message/handle.h"
+#include "common/event/ring.h"
 
 #include "common/communication/ipc.h"
 #include "common/execute.h"
@@ -29,8 +30,22 @@ namespace casual
 
          namespace detail
          {
+            //! subscribes to the events of `handler`, and reads them from the shared memory rings
+            //! when possible (the handler consumes the rings)
             handler_type subscribe( handler_type&& handler);
 
+            namespace ring
+            {
+               //! consumes the attached event rings, when the ring writer notifies us
+               inline auto notify()
+               {
+                  return []( const message::event::ring::Notify&)
+                  {
+                     event::ring::reader::consume();
+                  };
+               }
+            } // ring
+
          } // detail
 
          void subscribe( const process::Handle& process, std::vector< message::Type> types);
@@ -66,6 +81,7 @@ namespace casual
                   auto& device = communication::ipc::inbound::device();
                   auto handler = handler_type{ std::forward< Callback>( callbacks)...};
                   auto unsubscription = scope::unsubscribe( handler.types());
+                  handler.insert( detail::ring::notify());
                   common::message::dispatch::relaxed::pump( 
                      std::forward< C>( condition), 
                      common::message::handle::defaults( device) + std::move( handler),
@@ -87,7 +103,8 @@ namespace casual
             
             auto& device = communication::ipc::inbound::device();
             auto handler = handler_type{ std::forward< Callback>( callbacks)...};
-            auto subscription = scope::subscribe( handler.types());
+            auto unsubscription = scope::unsubscribe( handler.types());
+            handler = detail::subscribe( std::move( handler));
 
             common::message::dispatch::relaxed::pump( 
                std::forward< C>( condition),
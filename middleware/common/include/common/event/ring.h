@@ -0,0 +1,118 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#pragma once
+
+#include "common/message/type.h"
+#include "common/communication/ipc/message.h"
+#include "common/strong/id.h"
+#include "common/pimpl.h"
+#include "common/serialize/macro.h"
+
+#include "casual/platform.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace casual
+{
+   namespace common::event::ring
+   {
+      //! @returns the path to the ring of events of `type`
+      std::filesystem::path path( message::Type type);
+
+      //! @returns true if events of `type` can be published via a ring. A reader that is lapped
+      //! loses events, hence only metric events are eligible, control events (process exit,
+      //! spawn, ...) are always sent via ipc.
+      bool eligible( message::Type type) noexcept;
+
+      namespace reader
+      {
+         struct Metric
+         {
+            strong::process::id pid;
+            strong::ipc::id ipc;
+            //! bytes written to the ring that the reader has not consumed yet
+            platform::size::type lag{};
+            //! number of times the reader has been overrun, and lost events
+            platform::size::type lost{};
+
+            CASUAL_CONST_CORRECT_SERIALIZE(
+               CASUAL_SERIALIZE( pid);
+               CASUAL_SERIALIZE( ipc);
+               CASUAL_SERIALIZE( lag);
+               CASUAL_SERIALIZE( lost);
+            )
+         };
+      } // reader
+
+      //! The producer end of a shared memory ring of events of one type. There can only be one
+      //! writer per event type (the owner of the subscriptions for the type), and up to a fixed
+      //! number of readers, that reads at their own pace with their own cursor. A reader that is
+      //! lapped by the writer detects it, counts the loss, and skips to the most recent event.
+      //! Hence, only events that are `eligible` should be written to a ring.
+      //!
+      //! @attention The ring replaces the fan-out to the subscribers, not the hop to the writer.
+      //! Publishers still send their events to the owner (for service calls the service-manager,
+      //! that updates its own metrics from them), which batches and writes them to the ring once.
+      //!
+      //! Readers that has consumed all events waits for a (small) notification via ipc, that is
+      //! sent at most once per reader until the reader has consumed the ring again.
+      class Writer
+      {
+      public:
+         //! no ring, `operator bool` is false
+         Writer();
+
+         //! creates (or recreates) the ring for events of `type`, with at least `capacity` bytes
+         Writer( message::Type type, platform::size::type capacity);
+         ~Writer();
+
+         Writer( Writer&&) noexcept;
+         Writer& operator = ( Writer&&) noexcept;
+
+         //! writes `complete` to the ring, and notifies waiting readers
+         //! @returns false if `complete` is to large for the ring
+         bool write( const communication::ipc::message::Complete& complete);
+
+         //! @returns true if `ipc` reads the ring
+         bool reader( const strong::ipc::id& ipc) const noexcept;
+
+         //! @returns true if there are readers of the ring
+         bool active() const noexcept;
+
+         //! releases the reader slots held by `pid`
+         void remove( strong::process::id pid);
+
+         std::vector< reader::Metric> readers() const;
+
+         explicit operator bool() const noexcept;
+
+         friend std::ostream& operator << ( std::ostream& out, const Writer& value);
+
+      private:
+         class Implementation;
+         move::basic_pimpl< Implementation> m_implementation;
+      };
+
+      namespace reader
+      {
+         //! attaches the current process as a reader to the rings of `types` that exists, and
+         //! has a free reader slot.
+         //! @returns the types that the current process reads from rings
+         std::vector< message::Type> attach( const std::vector< message::Type>& types);
+
+         //! detaches the current process from the rings of `types`, if attached
+         void detach( const std::vector< message::Type>& types);
+
+         //! moves all available events from the attached rings to the cache of the
+         //! (global) inbound device, so they're dispatched as any other message.
+         void consume();
+
+      } // reader
+
+   } // common::event::ring
+} // casual
@@ -40,5 +40,12 @@ namespace casual
       //! @return the alias of the instance, if not present, basename is returned.
       std::string alias();
 
+      namespace detail
+      {
+         //! sets the instance information for processes that are forked from a zygote, and hence
+         //! don't get the information from the parent via the environment.
+         void information( Information value);
+      } // detail
+
    } // common::instance
 } // casual
\ No newline at end of file
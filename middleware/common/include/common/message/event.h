@@ -26,6 +26,12 @@ namespace casual
          // to decide if they are done.
          using Idle = message::basic_message< Type::event_idle>;
 
+         namespace ring
+         {
+            //! sent by the writer of an event ring to a waiting reader, when there are new events in the ring
+            using Notify = message::basic_message< Type::event_ring_notify>;
+         } // ring
+
          template< Type type> 
          using basic_event = message::basic_request< type>;
 
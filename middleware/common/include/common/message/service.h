@@ -309,15 +309,36 @@ namespace casual
                   return out << "unknown";
                }
 
+               //! priority class of the caller, used when the lookup has to wait for an idle instance.
+               enum class Priority : short
+               {
+                  interactive,
+                  regular,
+                  batch,
+               };
+
+               inline friend std::ostream& operator << ( std::ostream& out, const Request::Priority& value)
+               {
+                  switch( value)
+                  {
+                     case Request::Priority::interactive: return out << "interactive";
+                     case Request::Priority::regular: return out << "regular";
+                     case Request::Priority::batch: return out << "batch";
+                  }
+                  return out << "unknown";
+               }
+
                std::string requested;
                Context context = Context::regular;
                std::optional< platform::time::point::type> deadline{};
+               Priority priority = Priority::regular;
 
                CASUAL_CONST_CORRECT_SERIALIZE(
                   base_request::serialize( archive);
                   CASUAL_SERIALIZE( requested);
                   CASUAL_SERIALIZE( context);
                   CASUAL_SERIALIZE( deadline);
+                  CASUAL_SERIALIZE( priority);
                )
             };
 
@@ -331,7 +352,9 @@ namespace casual
                {
                   absent,
                   busy,
-                  idle
+                  idle,
+                  //! the projected wait for an idle instance exceeds the deadline of the caller
+                  rejected,
                };
 
                inline friend std::ostream& operator << ( std::ostream& out, State value)
@@ -341,6 +364,7 @@ namespace casual
                      case Reply::State::absent: return out << "absent";
                      case Reply::State::idle: return out << "idle";
                      case Reply::State::busy: return out << "busy";
+                     case Reply::State::rejected: return out << "rejected";
                   }
                   return out << "unknown";
                }
@@ -16,6 +16,8 @@
 #include "common/flag/xa.h"
 #include "common/process.h"
 
+#include <variant>
+
 
 namespace casual
 {
@@ -258,6 +260,21 @@ namespace casual
                         CASUAL_SERIALIZE( involved);
                      )
                   };
+
+                  //! 'fire and forget' version of the request, when the caller don't need to
+                  //! know about prior involvement. No reply.
+                  using base_notify = basic_transaction< Type::transaction_resource_involved_notify>;
+                  struct Notify : base_notify
+                  {
+                     using base_notify::base_notify;
+
+                     std::vector< strong::resource::id> involved;
+
+                     CASUAL_CONST_CORRECT_SERIALIZE(
+                        base_notify::serialize( archive);
+                        CASUAL_SERIALIZE( involved);
+                     )
+                  };
                } // involve
 
                template< message::Type type>
@@ -338,6 +355,50 @@ namespace casual
                   using Reply = basic_reply< Type::transaction_resource_rollback_reply>;
                } // rollback
 
+               //! Several xa operations for the same resource, that the resource proxy executes
+               //! in order, and replies to with one batch::Reply, with a reply per operation, in the same order.
+               //! Only used between the TM and (local) resource proxies.
+               namespace batch
+               {
+                  using base_request = message::basic_request< Type::transaction_resource_batch_request>;
+                  struct Request : base_request
+                  {
+                     using base_request::base_request;
+
+                     //! one xa operation
+                     using Operation = std::variant< prepare::Request, commit::Request, rollback::Request>;
+
+                     //! the operations, in the order the TM got them
+                     std::vector< Operation> operations;
+
+                     inline platform::size::type size() const noexcept { return operations.size();}
+
+                     CASUAL_CONST_CORRECT_SERIALIZE(
+                        base_request::serialize( archive);
+                        CASUAL_SERIALIZE( operations);
+                     )
+                  };
+
+                  using base_reply = message::basic_reply< Type::transaction_resource_batch_reply>;
+                  struct Reply : base_reply
+                  {
+                     using base_reply::base_reply;
+
+                     //! the reply to one xa operation
+                     using Operation = std::variant< prepare::Reply, commit::Reply, rollback::Reply>;
+
+                     id::type resource;
+                     //! the replies, in the same order as the requested operations
+                     std::vector< Operation> operations;
+
+                     CASUAL_CONST_CORRECT_SERIALIZE(
+                        base_reply::serialize( archive);
+                        CASUAL_SERIALIZE( resource);
+                        CASUAL_SERIALIZE( operations);
+                     )
+                  };
+               } // batch
+
                //! These request and replies are used between TM and resources when
                //! the context is of "external proxies", that is, when some other part
                //! act as a resource proxy. This semantic is used when:
@@ -391,6 +452,8 @@ namespace casual
             struct type_traits< transaction::resource::commit::Request> : detail::type< transaction::resource::commit::Reply> {};
             template<>
             struct type_traits< transaction::resource::rollback::Request> : detail::type< transaction::resource::rollback::Reply> {};
+            template<>
+            struct type_traits< transaction::resource::batch::Request> : detail::type< transaction::resource::batch::Reply> {};
 
             
 
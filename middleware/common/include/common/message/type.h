@@ -124,6 +124,7 @@ namespace casual
          event_subscription_begin = EVENT_BASE,
          event_subscription_end,
          event_idle,
+         event_ring_notify,
 
 
          EVENT_DOMAIN_BASE = 4100,
@@ -150,6 +151,8 @@ namespace casual
          EVENT_SERVICE_BASE = 4200,
          event_service_call = EVENT_SERVICE_BASE,
          event_service_calls,
+         // changes of the service-manager state, to admin subscribers
+         event_service_state,
          EVENT_SERVICE_BASE_END,
          
          EVENT_BASE_END = EVENT_SERVICE_BASE_END,
@@ -194,10 +197,14 @@ namespace casual
          transaction_resource_involved_request = TRANSACTION_BASE + 400,
          transaction_resource_involved_reply,
          transaction_external_resource_involved,
+         transaction_resource_involved_notify,
 
          transaction_resource_id_request = TRANSACTION_BASE + 500,
          transaction_resource_id_reply,
 
+         transaction_resource_batch_request = TRANSACTION_BASE + 600,
+         transaction_resource_batch_reply,
+
          // casual queue
          QUEUE_BASE = 6000,
 
@@ -281,6 +288,10 @@ namespace casual
          gateway_domain_connect_reply      = 7201,
          gateway_domain_disconnect_request = 7202,  // 1.1
          gateway_domain_disconnect_reply   = 7203,  // 1.1
+         gateway_domain_compressed         = 7210,  // 1.2
+         gateway_domain_stripe_join        = 7220,  // 1.3
+         gateway_domain_stripe_fragment    = 7221,  // 1.3
+         gateway_domain_flow_credit        = 7230,  // 1.4
 
          // part of domain-discovery, but we need to keep the pinned values.         
          domain_discovery_request   = 7300,
@@ -74,6 +74,13 @@ namespace casual
          //! @return process id (pid) for current process.
          strong::process::id id();
 
+         namespace detail
+         {
+            //! re-seeds the process global state (pid) in a forked, not exec:ed, process. 
+            //! @attention has to be done before the process handle is used.
+            void reseed();
+         } // detail
+
          inline strong::process::id id( const Handle& handle) { return handle.pid;}
          inline strong::process::id id( strong::process::id pid) { return pid;}
 
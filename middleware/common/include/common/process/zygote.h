@@ -0,0 +1,78 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#pragma once
+
+#include "common/communication/socket.h"
+#include "common/environment/variable.h"
+#include "common/instance.h"
+#include "common/strong/id.h"
+#include "common/serialize/macro.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace casual
+{
+   namespace common::process::zygote
+   {
+      //! @returns true if zygotes are supported on this platform. Forked instances are
+      //! reparented to the spawner (the domain-manager), which needs to be a 'sub-reaper'.
+      bool supported() noexcept;
+
+      //! The spawner's end of a zygote (template) process.
+      //!
+      //! The zygote is the server binary spawned as usual, that stops when it reaches `zygote::serve`,
+      //! that is, when the binary is loaded and the static initialization is done. New instances are
+      //! forked from the zygote on demand.
+      class Handle
+      {
+      public:
+         Handle() = default;
+
+         //! spawns `path` as a zygote, with the same arguments and environment as a regular instance.
+         //! The current process becomes the 'reaper' of its orphaned descendants, so the forked instances
+         //! are (direct) children of the current process.
+         Handle( const std::filesystem::path& path, std::vector< std::string> arguments, std::vector< environment::Variable> environment);
+
+         //! @returns true if the zygote has reached `zygote::serve` and is ready to fork instances
+         bool ready();
+
+         //! forks a new instance from the zygote with the instance information `information`.
+         //! @returns the pid of the new instance, or an invalid pid if the zygote failed or is not
+         //! ready. If the zygote failed, it's not usable anymore.
+         //! @attention blocks until the zygote replies with the pid, which it does as soon as fork(2) 
+         //!   returns. At most `platform::process::zygote::timeout` (500ms), then the zygote is discarded,
+         //!   hence a zygote can only stall the caller that long once.
+         strong::process::id fork( const instance::Information& information);
+
+         inline strong::process::id pid() const noexcept { return m_pid;}
+
+         //! @returns true if the zygote is usable
+         inline explicit operator bool() const noexcept { return ! m_socket.empty();}
+
+         CASUAL_LOG_SERIALIZE(
+            CASUAL_SERIALIZE_NAME( m_pid, "pid");
+            CASUAL_SERIALIZE_NAME( m_socket.descriptor(), "socket");
+            CASUAL_SERIALIZE_NAME( m_ready, "ready");
+         )
+
+      private:
+         strong::process::id m_pid;
+         communication::Socket m_socket;
+         bool m_ready = false;
+      };
+
+      //! If the process is started as a zygote, the process serves fork requests and
+      //! only returns in the forked instances, with the process state (pid, instance information)
+      //! re-seeded. If not started as a zygote, returns directly.
+      //!
+      //! @attention has to be called before any ipc is created or any threads are started.
+      void serve();
+
+   } // common::process::zygote
+} // casual
@@ -14,6 +14,7 @@
 #include "common/string/utf8.h"
 
 #include <optional>
+#include <variant>
 #include <system_error>
 #include <filesystem>
 
@@ -598,6 +599,55 @@ namespace casual
             }
          };
 
+         namespace detail
+         {
+            namespace variant
+            {
+               //! emplaces the alternative with `index` in `value`, and reads it from the archive
+               template< typename A, typename V, std::size_t... Is>
+               void read( A& archive, V& value, platform::size::type index, std::index_sequence< Is...>)
+               {
+                  auto alternative = [&]( auto candidate)
+                  {
+                     if( index != decltype( candidate)::value)
+                        return false;
+
+                     value::read( archive, value.template emplace< decltype( candidate)::value>(), "value");
+                     return true;
+                  };
+
+                  if( ! ( alternative( std::integral_constant< std::size_t, Is>{}) || ...))
+                     throw std::system_error{ std::make_error_code( std::errc::invalid_argument), "unexpected variant index"};
+               }
+            } // variant
+         } // detail
+
+         //! Specialization for variant, the index of the active alternative followed by the alternative
+         template< typename... Ts, typename A>
+         struct Value< std::variant< Ts...>, A>
+         {
+            static void write( A& archive, const std::variant< Ts...>& value, const char* name)
+            {
+               archive.composite_start( name);
+               value::write( archive, static_cast< platform::size::type>( value.index()), "index");
+               std::visit( [&archive]( auto& alternative){ value::write( archive, alternative, "value");}, value);
+               archive.composite_end( name);
+            }
+
+            static bool read( A& archive, std::variant< Ts...>& value, const char* name)
+            {
+               if( ! archive.composite_start( name))
+                  return false;
+
+               platform::size::type index{};
+               value::read( archive, index, "index");
+               detail::variant::read( archive, value, index, std::index_sequence_for< Ts...>{});
+
+               archive.composite_end( name);
+               return true;
+            }
+         };
+
          //! Specialization for time
          //! @{
 
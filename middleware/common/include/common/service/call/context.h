@@ -17,6 +17,8 @@
 
 
 #include <vector>
+#include <optional>
+#include <system_error>
 
 
 namespace casual
@@ -56,6 +58,36 @@ namespace casual
                };
             } // sync
 
+            namespace scatter
+            {
+               struct Request
+               {
+                  std::string service;
+                  common::buffer::payload::Send buffer;
+               };
+
+               struct Result
+               {
+                  //! the reserved descriptor, only valid if there is no error
+                  descriptor_type descriptor{};
+                  std::error_code code;
+
+                  explicit operator bool() const noexcept { return ! code;}
+               };
+            } // scatter
+
+            namespace gather
+            {
+               struct Result
+               {
+                  common::buffer::Payload buffer;
+                  long user = 0;
+                  descriptor_type descriptor{};
+                  //! the outcome of the call, for example `code::xatmi::service_fail`
+                  std::error_code code;
+               };
+            } // gather
+
             //! Will be thrown if service fails (application error)
             struct Fail
             {
@@ -84,6 +116,23 @@ namespace casual
 
                sync::Result sync( const std::string& service, common::buffer::payload::Send buffer, sync::Flags flags);
 
+               //! Calls all services in @p requests as one batch. All lookups are sent to the service-manager
+               //! before any of them are awaited, and all calls share the same @p deadline, if any.
+               //! A failing call does not affect the others, the error is reported in the corresponding result.
+               //!
+               //! @return one result per request, in the same order as @p requests
+               std::vector< scatter::Result> scatter( 
+                  std::vector< scatter::Request> requests, 
+                  async::Flags flags, 
+                  std::optional< platform::time::point::type> deadline = {});
+
+               //! Waits for the first of the calls in @p descriptors to reply. The descriptor is unreserved.
+               //! A service-fail is reported in the result, not as an exception.
+               //!
+               //! @throws code::xatmi::no_message if `no_block` and none of the replies has arrived
+               //! @throws code::xatmi::timeout if the shared deadline of the calls has passed
+               gather::Result gather( const std::vector< descriptor_type>& descriptors, reply::Flags flags);
+
                void cancel( descriptor_type descriptor);
 
                void clean();
@@ -96,6 +145,14 @@ namespace casual
                Context();
                bool receive( message::service::call::Reply& reply, descriptor_type descriptor, reply::Flags);
 
+               //! the timeout of the call is restricted to the time remaining until @p deadline, if any
+               descriptor_type async( 
+                  service::Lookup&& lookup, 
+                  common::buffer::payload::Send buffer, 
+                  service::header::Fields header, 
+                  async::Flags flags, 
+                  std::optional< platform::time::point::type> deadline);
+
                State m_state;
 
             };
@@ -12,6 +12,12 @@
 #include "common/service/type.h"
 #include "common/message/type.h"
 
+#include <optional>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
 namespace casual
 {
    namespace common::service::call
@@ -22,6 +28,15 @@ namespace casual
       struct State
       {
 
+         //! Slot table for pending replies.
+         //!
+         //! A descriptor is the slot index (+1) tagged with the slot generation in the high bits, which
+         //! is bumped when the slot is unreserved. Hence, a stale descriptor is not mistaken for a 
+         //! reused slot, and descriptors are bounded by the number of concurrent calls, not the total.
+         //! Replies are mapped to their slot via a correlation index.
+         //!
+         //! The table is guarded, so several threads can reserve and unreserve. A reserved 
+         //! descriptor is owned by the thread that reserved it.
          struct Pending
          {
             struct Descriptor
@@ -36,6 +51,8 @@ namespace casual
                correlation_type correlation;
                common::strong::process::id target{};
                Contract contract{ Contract::linger};
+               //! shared deadline for calls made in a _scatter_ batch, if any
+               std::optional< platform::time::point::type> deadline;
 
                friend bool operator == ( descriptor_type cd, const Descriptor& d) { return cd == d.descriptor;}
                friend bool operator == ( const Descriptor& d, descriptor_type cd) { return cd == d.descriptor;}
@@ -45,15 +62,20 @@ namespace casual
             Pending();
 
             //! Reserves a descriptor and associates it to message-correlation
-            Descriptor& reserve( const correlation_type& correlation);
+            //! @returns a copy of the reserved descriptor
+            Descriptor reserve( const correlation_type& correlation);
 
             void unreserve( descriptor_type descriptor);
 
             bool active( descriptor_type descriptor) const;
 
-            const Descriptor& get( descriptor_type descriptor) const;
-            const Descriptor& get( const correlation_type& correlation) const;
-            Descriptor& get( descriptor_type descriptor);
+            //! @returns a copy of the active descriptor, the slot could be reused by another thread
+            //!   as soon as the lock is released.
+            Descriptor get( descriptor_type descriptor) const;
+            Descriptor get( const correlation_type& correlation) const;
+
+            //! sets the shared _scatter_ deadline of the active descriptor
+            void deadline( descriptor_type descriptor, std::optional< platform::time::point::type> deadline);
 
             //! Tries to discard descriptor, throws if fail.
             void discard( descriptor_type descriptor);
@@ -62,11 +84,26 @@ namespace casual
             //!  Thus, it's ok to do a service-forward
             bool empty() const;
 
+            //! @returns the number of reserved descriptors
+            platform::size::type size() const;
+
          private:
 
-            Descriptor& reserve();
+            using lock_type = std::lock_guard< std::mutex>;
+
+            //! @returns the slot index of `descriptor`, if it's a valid (not stale) descriptor
+            std::optional< platform::size::type> index( descriptor_type descriptor) const noexcept;
+
+            //! @returns the active slot of `descriptor`, throws otherwise. 
+            //! @attention the lock has to be held
+            platform::size::type active_index( descriptor_type descriptor) const;
 
-            std::vector< Descriptor> m_descriptors;
+            mutable std::mutex m_mutex;
+            //! slots, indexed by the descriptor index. Only accessed with the lock held.
+            std::deque< Descriptor> m_slots;
+            //! unreserved slot indexes, ready to be reused, in the order they were unreserved
+            std::deque< platform::size::type> m_free;
+            std::unordered_map< correlation_type, platform::size::type> m_correlations;
 
          } pending;
       };
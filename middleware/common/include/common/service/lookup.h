@@ -18,6 +18,13 @@ namespace casual
 {
    namespace common::service
    {
+      namespace lookup
+      {
+         //! @returns the priority class for lookups from this process, set via 
+         //!   `CASUAL_SERVICE_PRIORITY` [interactive, regular, batch]. Default: regular
+         message::service::lookup::Request::Priority priority();
+      } // lookup
+
       namespace detail
       {
          struct Lookup
@@ -68,6 +75,7 @@ namespace casual
          //!    if busy, a second invocation will block until it's idle
          //!
          //! @throws common::exception::xatmi::service::no::Entry if the service is not present or discovered
+         //! @throws code::xatmi::no_message (TPEBLOCK) if the projected wait for an idle instance exceeds the deadline
          const Reply& operator () ();
       };
 
@@ -0,0 +1,62 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#pragma once
+
+#include "common/strong/id.h"
+#include "common/serialize/macro.h"
+
+#include "casual/platform.h"
+
+#include <optional>
+
+namespace casual
+{
+   namespace common::timer
+   {
+      //! A timer that is signaled via a file descriptor, that becomes readable when
+      //! the timer expires. Hence, the timer can be multiplexed with other descriptors
+      //! in `communication::select`, and does not interrupt any system calls.
+      //!
+      //! Uses `timerfd` on linux, and a `kqueue` timer on platforms that has kqueue.
+      class Descriptor
+      {
+      public:
+         Descriptor();
+         ~Descriptor();
+
+         Descriptor( Descriptor&& other) noexcept;
+         Descriptor& operator = ( Descriptor&& other) noexcept;
+
+         //! arms the timer to expire at `deadline`. Replaces current deadline, if any.
+         //! @note a `deadline` that has passed expires the timer directly
+         void set( platform::time::point::type deadline);
+
+         //! disarms the timer, if armed
+         void unset();
+
+         //! @returns the current deadline, if armed
+         inline const std::optional< platform::time::point::type>& deadline() const noexcept { return m_deadline;}
+
+         //! consumes the expiration of the timer, if any, without blocking.
+         //! @returns true if the timer has expired, and is now disarmed
+         bool consume();
+
+         inline strong::file::descriptor::id descriptor() const noexcept { return m_descriptor;}
+
+         CASUAL_LOG_SERIALIZE(
+            CASUAL_SERIALIZE_NAME( m_descriptor, "descriptor");
+            CASUAL_SERIALIZE_NAME( m_deadline, "deadline");
+         )
+
+      private:
+         strong::file::descriptor::id m_descriptor;
+         std::optional< platform::time::point::type> m_deadline;
+      };
+
+   } // common::timer
+} // casual
@@ -0,0 +1,312 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#pragma once
+
+#include "common/algorithm.h"
+#include "common/algorithm/container.h"
+#include "common/serialize/macro.h"
+
+#include "casual/platform.h"
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <optional>
+
+namespace casual
+{
+   namespace common::timer
+   {
+      namespace wheel
+      {
+         //! number of slots per level, and the bits the slot index spans
+         constexpr platform::size::type bits = 6;
+         constexpr platform::size::type slots = 1 << bits;
+
+         //! number of levels. With millisecond resolution the wheel spans ~4.6 hours,
+         //! deadlines further away are kept in an overflow that is re-distributed when
+         //! the top level wraps around.
+         constexpr platform::size::type levels = 4;
+
+         using id = platform::size::type;
+
+      } // wheel
+
+      //! A hierarchical timing wheel that holds `T`s that expire at a given time point.
+      //!
+      //! `add` and `cancel` are constant time, and `expired` is (amortized) constant time per
+      //! elapsed tick and expired entry. Expired entries are never early, but could be
+      //! up to one `Resolution` late.
+      //!
+      //! The wheel does not own any timer, the user is responsible for calling `expired`,
+      //! at the latest at `next()`.
+      template< typename T, typename Resolution = std::chrono::milliseconds>
+      class Wheel
+      {
+      public:
+         using value_type = T;
+         using time_point = platform::time::point::type;
+
+         explicit Wheel( time_point now = platform::time::clock::type::now())
+            : m_current{ floor( now)} {}
+
+         //! adds `value` that will expire at `when`
+         //! @returns id that can be used to `cancel`
+         wheel::id add( time_point when, value_type value)
+         {
+            auto id = ++m_id;
+            auto tick = ceil( when);
+            m_entries.emplace( id, Entry{ tick, std::move( value)});
+            place( id, tick);
+            return id;
+         }
+
+         //! cancels the entry with `id`, if not expired yet.
+         //! @returns true if the entry was removed.
+         bool cancel( wheel::id id)
+         {
+            // the slot reference is removed when the slot is processed
+            if( m_entries.erase( id) == 0)
+               return false;
+
+            m_stale = true;
+            return true;
+         }
+
+         //! advances the wheel to `now`
+         //! @returns the values that has expired, in tick order.
+         std::vector< value_type> expired( time_point now = platform::time::clock::type::now())
+         {
+            std::vector< value_type> result;
+
+            auto target = floor( now);
+
+            // entries that was added with a deadline that already has passed
+            expire( m_due, result);
+
+            while( m_current < target && ! m_entries.empty())
+            {
+               // no entries in level 0, we can jump to the next cascade point
+               if( m_lowest == 0)
+                  m_current = std::max( m_current, std::min( target, ( m_current / wheel::slots + 1) * wheel::slots) - 1);
+
+               ++m_current;
+
+               // cascade from the highest level that has wrapped, so the entries
+               // could end up in level 0 for the current tick
+               for( auto level = levels_to_cascade(); level > 0; --level)
+                  cascade( level);
+
+               expire( m_due, result);
+
+               auto& slot = m_levels[ 0][ index( m_current, 0)];
+               m_lowest -= slot.size();
+               expire( slot, result);
+            }
+
+            if( m_entries.empty())
+            {
+               // nothing to cascade, we jump directly to target.
+               m_current = std::max( m_current, target);
+               clear();
+            }
+
+            return result;
+         }
+
+         //! @returns the time point when the wheel should be advanced next, if any entries.
+         //! @attention could be earlier than the earliest deadline, when entries in higher
+         //!   levels need to be cascaded.
+         std::optional< time_point> next()
+         {
+            if( m_entries.empty())
+               return {};
+
+            if( live( m_due))
+               return point( m_current);
+
+            std::optional< tick_type> result;
+
+            auto candidate = [&result]( tick_type tick)
+            {
+               if( ! result || tick < *result)
+                  result = tick;
+            };
+
+            for( platform::size::type level = 0; level < wheel::levels; ++level)
+            {
+               auto span = tick_type{ 1} << ( wheel::bits * level);
+
+               // level 0 holds the exact ticks, the higher levels needs to be cascaded at the 
+               // start of the slot
+               auto tick = level == 0 ? m_current + 1 : ( m_current / span + 1) * span;
+
+               for( platform::size::type count = 0; count < wheel::slots; ++count, tick += span)
+               {
+                  if( live( level, tick))
+                  {
+                     candidate( tick);
+                     break;
+                  }
+               }
+            }
+
+            if( live( m_overflow))
+            {
+               // we need to wake when the top level wraps
+               auto span = tick_type{ 1} << ( wheel::bits * wheel::levels);
+               candidate( ( m_current / span + 1) * span);
+            }
+
+            if( result)
+               return point( *result);
+
+            return {};
+         }
+
+         inline platform::size::type size() const noexcept { return m_entries.size();}
+         inline bool empty() const noexcept { return m_entries.empty();}
+
+         CASUAL_LOG_SERIALIZE(
+            CASUAL_SERIALIZE_NAME( m_current, "current");
+            CASUAL_SERIALIZE_NAME( size(), "size");
+         )
+
+      private:
+         using tick_type = platform::size::type;
+         using slot_type = std::vector< wheel::id>;
+
+         struct Entry
+         {
+            tick_type tick;
+            value_type value;
+         };
+
+         static tick_type floor( time_point value) noexcept
+         {
+            return std::chrono::floor< Resolution>( value.time_since_epoch()).count();
+         }
+
+         static tick_type ceil( time_point value) noexcept
+         {
+            return std::chrono::ceil< Resolution>( value.time_since_epoch()).count();
+         }
+
+         static time_point point( tick_type tick) noexcept
+         {
+            return time_point{ std::chrono::duration_cast< platform::time::unit>( Resolution{ tick})};
+         }
+
+         static platform::size::type index( tick_type tick, platform::size::type level) noexcept
+         {
+            return ( tick >> ( wheel::bits * level)) & ( wheel::slots - 1);
+         }
+
+         //! @returns the highest level that has wrapped at `m_current`, 0 if none
+         platform::size::type levels_to_cascade() const noexcept
+         {
+            platform::size::type level = 0;
+            while( level < wheel::levels && index( m_current, level) == 0)
+               ++level;
+            return level;
+         }
+
+         void place( wheel::id id, tick_type tick)
+         {
+            if( tick <= m_current)
+            {
+               m_due.push_back( id);
+               return;
+            }
+
+            auto delta = tick - m_current;
+
+            for( platform::size::type level = 0; level < wheel::levels; ++level)
+            {
+               if( delta < ( tick_type{ 1} << ( wheel::bits * ( level + 1))))
+               {
+                  m_levels[ level][ index( tick, level)].push_back( id);
+                  if( level == 0)
+                     ++m_lowest;
+                  return;
+               }
+            }
+
+            m_overflow.push_back( id);
+         }
+
+         void cascade( platform::size::type level)
+         {
+            auto& slot = level == wheel::levels ? m_overflow : m_levels[ level][ index( m_current, level)];
+
+            for( auto id : std::exchange( slot, {}))
+               if( auto found = m_entries.find( id); found != std::end( m_entries))
+                  place( id, found->second.tick);
+         }
+
+         void expire( slot_type& slot, std::vector< value_type>& result)
+         {
+            for( auto id : std::exchange( slot, {}))
+            {
+               if( auto found = m_entries.find( id); found != std::end( m_entries))
+               {
+                  result.push_back( std::move( found->second.value));
+                  m_entries.erase( found);
+               }
+            }
+         }
+
+         //! removes cancelled references in `slot`
+         //! @returns true if there are any 'live' entries in the slot
+         bool live( slot_type& slot)
+         {
+            algorithm::container::trim( slot, algorithm::remove_if( slot, [&]( auto id){ return m_entries.count( id) == 0;}));
+            return ! slot.empty();
+         }
+
+         bool live( platform::size::type level, tick_type tick)
+         {
+            auto& slot = m_levels[ level][ index( tick, level)];
+            auto size = slot.size();
+
+            auto result = live( slot);
+
+            if( level == 0)
+               m_lowest -= size - slot.size();
+
+            return result;
+         }
+
+         //! there are no entries, just (possible) references to cancelled entries
+         void clear()
+         {
+            if( ! std::exchange( m_stale, false))
+               return;
+
+            for( auto& level : m_levels)
+               for( auto& slot : level)
+                  slot.clear();
+
+            m_overflow.clear();
+            m_due.clear();
+            m_lowest = 0;
+         }
+
+         tick_type m_current = 0;
+         wheel::id m_id = 0;
+         std::unordered_map< wheel::id, Entry> m_entries;
+         std::array< std::array< slot_type, wheel::slots>, wheel::levels> m_levels;
+         slot_type m_overflow;
+         slot_type m_due;
+         //! number of references in level 0
+         platform::size::type m_lowest = 0;
+         bool m_stale = false;
+      };
+
+   } // common::timer
+} // casual
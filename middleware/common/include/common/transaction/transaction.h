@@ -57,6 +57,12 @@ namespace casual
             for( auto id : range) involve( id);
          }  
 
+         //! @return involved rm:s that the TM has not been notified about (yet)
+         std::vector< strong::resource::id> unnotified() const;
+
+         //! the TM has been notified about all involved rm:s
+         void notified();
+
          //! dynamic associated rm:s to this transaction, a subset to `involved`
          inline const std::vector< strong::resource::id>& dynamic() const { return m_dynamic;}
          
@@ -105,6 +111,7 @@ namespace casual
             CASUAL_SERIALIZE( deadline);
             CASUAL_SERIALIZE( state);
             CASUAL_SERIALIZE_NAME( m_involved, "involved");
+            CASUAL_SERIALIZE_NAME( m_notified, "notified");
             CASUAL_SERIALIZE_NAME( m_pending, "pending");
             CASUAL_SERIALIZE_NAME( m_dynamic, "dynamic");
             CASUAL_SERIALIZE_NAME( m_external, "external");
@@ -113,6 +120,8 @@ namespace casual
 
       private:
          std::vector< strong::resource::id> m_involved;
+         //! number of `m_involved` the TM knows about
+         platform::size::type m_notified = 0;
          std::vector< correlation_type> m_pending;
          std::vector< strong::resource::id> m_dynamic;
          bool m_external = false;
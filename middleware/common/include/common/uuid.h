@@ -18,6 +18,8 @@
 
 #include <string>
 #include <string_view>
+#include <cstring>
+#include <functional>
 
 namespace casual
 {
@@ -77,6 +79,21 @@ namespace casual
 
 } // casual
 
+namespace std
+{
+   template<>
+   struct hash< casual::common::Uuid>
+   {
+      //! uuids are random, hence the leading bytes are as good a hash as any
+      std::size_t operator()( const casual::common::Uuid& value) const noexcept
+      {
+         std::size_t result;
+         std::memcpy( &result, value.get(), sizeof( result));
+         return result;
+      }
+   };
+} // std
+
 casual::common::Uuid operator"" _uuid ( const char* data);
 
 
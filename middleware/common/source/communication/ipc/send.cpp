@@ -0,0 +1,525 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#include "common/communication/ipc/send.h"
+#include "common/communication/log.h"
+
+#include "common/environment.h"
+#include "common/result.h"
+#include "common/algorithm.h"
+#include "common/algorithm/container.h"
+#include "common/code/raise.h"
+#include "common/code/casual.h"
+#include "common/log.h"
+
+#include <deque>
+#include <ostream>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <sys/event.h>
+#else
+#include <sys/epoll.h>
+#endif
+
+namespace casual
+{
+   namespace common::communication::ipc::send
+   {
+      namespace local
+      {
+         namespace
+         {
+            struct Message
+            {
+               message::Complete complete;
+               //! the offset of the next part to send
+               platform::size::type offset{};
+
+               platform::size::type size() const noexcept { return complete.size();}
+            };
+
+            namespace connected
+            {
+               //! @returns a socket connected to `destination`, which write readiness reflects
+               //!   if the destination is able to receive
+               Socket socket( const Address& destination)
+               {
+                  auto result = native::detail::create::domain::socket();
+
+                  if( ::connect( result.descriptor().value(), destination.native_pointer(), destination.native_size()) == -1)
+                  {
+                     auto code = code::system::last::error();
+
+                     if( code == std::errc::no_such_file_or_directory || code == std::errc::connection_refused)
+                        code::raise::error( code::casual::communication_unavailable, "destination: ", destination);
+
+                     code::raise::error( code::casual::communication_unavailable, "failed to connect to destination: ", destination, " - ", std::make_error_code( code));
+                  }
+
+                  return result;
+               }
+
+               //! @returns true if sent, false if the destination is full
+               bool send( const Socket& socket, const ipc::message::Transport& transport)
+               {
+                  if( ::send( socket.descriptor().value(), transport.data(), transport.size(), MSG_DONTWAIT) != -1)
+                     return true;
+
+                  switch( auto code = code::system::last::error())
+                  {
+                     case std::errc::resource_unavailable_try_again:
+#if EAGAIN != EWOULDBLOCK
+                     case std::errc::operation_would_block:
+#endif
+#ifdef __APPLE__
+                     case std::errc::no_buffer_space:
+#endif
+                        return false;
+                     case std::errc::no_such_file_or_directory:
+                     case std::errc::connection_refused:
+                        code::raise::error( code::casual::communication_unavailable, "socket: ", socket);
+                     default:
+                        code::raise::error( code::casual::communication_unavailable, "socket: ", socket, " - ", std::make_error_code( code));
+                  }
+               }
+            } // connected
+
+            //! sends the remaining parts of `message`, non blocking, to `destination`, or via
+            //! `socket` if connected.
+            //! @returns true if the message is sent, false if the destination is full
+            bool send( const Address& destination, const Socket& socket, Message& message)
+            {
+               auto& complete = message.complete;
+
+               ipc::message::Transport transport{ complete.type(), complete.size()};
+               complete.correlation().value().copy( transport.correlation());
+
+               do
+               {
+                  auto first = std::begin( complete.payload) + message.offset;
+                  auto last = std::distance( first, std::end( complete.payload)) > ipc::message::transport::max_payload_size() ?
+                     first + ipc::message::transport::max_payload_size() : std::end( complete.payload);
+
+                  transport.assign( range::make( first, last));
+                  transport.message.header.offset = message.offset;
+
+                  auto sent = socket ? connected::send( socket, transport)
+                     : native::non::blocking::send( native::detail::outbound::socket(), destination, transport);
+
+                  if( ! sent)
+                     return false;
+
+                  message.offset += std::distance( first, last);
+               }
+               while( message.offset < message.size());
+
+               return true;
+            }
+
+            struct Destination
+            {
+               explicit Destination( const strong::ipc::id& ipc) : address{ ipc}
+               {
+                  metric.ipc = ipc;
+               }
+
+               Address address;
+               //! connected to the destination while messages are queued, to get the write readiness
+               Socket socket;
+               std::deque< Message> queue;
+               //! when the queue became non empty
+               platform::time::point::type stalled;
+               destination::Metric metric;
+
+               bool empty() const noexcept { return queue.empty();}
+
+               void push( Message&& message)
+               {
+                  if( queue.empty())
+                     stalled = platform::time::clock::type::now();
+
+                  ++metric.queue.count;
+                  metric.queue.size += message.size();
+                  metric.queue.high = std::max( metric.queue.high, metric.queue.size);
+
+                  queue.push_back( std::move( message));
+               }
+
+               //! sends queued messages, in order, until the destination is full.
+               //! @returns true if all queued messages has been sent
+               bool flush()
+               {
+                  if( queue.empty())
+                     return true;
+
+                  while( ! queue.empty())
+                  {
+                     if( ! local::send( address, socket, queue.front()))
+                        return false;
+
+                     --metric.queue.count;
+                     metric.queue.size -= queue.front().size();
+                     queue.pop_front();
+                  }
+
+                  metric.stall += platform::time::clock::type::now() - stalled;
+                  return true;
+               }
+
+               friend bool operator == ( const Destination& lhs, const strong::ipc::id& rhs) { return lhs.metric.ipc == rhs;}
+
+               CASUAL_LOG_SERIALIZE(
+                  CASUAL_SERIALIZE( address);
+                  CASUAL_SERIALIZE( metric);
+               )
+            };
+
+            bool unavailable()
+            {
+               return exception::capture().code() == code::casual::communication_unavailable;
+            }
+
+            //! Multiplexes the write readiness of sockets to one descriptor, that is readable when
+            //! any of the sockets is writable (level triggered).
+            class Writable
+            {
+            public:
+               Writable() : m_descriptor{ create()}
+               {
+                  log::line( verbose::log, "send::Writable created: ", m_descriptor);
+               }
+
+               ~Writable()
+               {
+                  posix::log::result( ::close( m_descriptor.value()), "send::Writable close - descriptor: ", m_descriptor);
+               }
+
+               Writable( const Writable&) = delete;
+               Writable& operator = ( const Writable&) = delete;
+
+#ifdef __APPLE__
+               void add( strong::socket::id socket)
+               {
+                  struct kevent event{};
+                  EV_SET( &event, socket.value(), EVFILT_WRITE, EV_ADD, 0, 0, nullptr);
+                  posix::result( ::kevent( m_descriptor.value(), &event, 1, nullptr, 0, nullptr), "send::Writable::add");
+               }
+
+               void remove( strong::socket::id socket)
+               {
+                  struct kevent event{};
+                  EV_SET( &event, socket.value(), EVFILT_WRITE, EV_DELETE, 0, 0, nullptr);
+                  posix::log::result( ::kevent( m_descriptor.value(), &event, 1, nullptr, 0, nullptr), "send::Writable::remove");
+               }
+
+               //! @returns the writable sockets, without blocking
+               std::vector< strong::socket::id> ready( platform::size::type size)
+               {
+                  std::vector< struct kevent> events( size);
+                  ::timespec zero{};
+                  auto count = posix::result( ::kevent( m_descriptor.value(), nullptr, 0, events.data(), events.size(), &zero), "send::Writable::ready");
+
+                  return algorithm::transform( range::make( std::begin( events), count), []( auto& event)
+                  {
+                     return strong::socket::id{ static_cast< int>( event.ident)};
+                  });
+               }
+#else
+               void add( strong::socket::id socket)
+               {
+                  ::epoll_event event{};
+                  event.events = EPOLLOUT;
+                  event.data.fd = socket.value();
+                  posix::result( ::epoll_ctl( m_descriptor.value(), EPOLL_CTL_ADD, socket.value(), &event), "send::Writable::add");
+               }
+
+               void remove( strong::socket::id socket)
+               {
+                  posix::log::result( ::epoll_ctl( m_descriptor.value(), EPOLL_CTL_DEL, socket.value(), nullptr), "send::Writable::remove");
+               }
+
+               //! @returns the writable sockets, without blocking
+               std::vector< strong::socket::id> ready( platform::size::type size)
+               {
+                  std::vector< ::epoll_event> events( size);
+                  auto count = posix::result( ::epoll_wait( m_descriptor.value(), events.data(), events.size(), 0), "send::Writable::ready");
+
+                  return algorithm::transform( range::make( std::begin( events), count), []( auto& event)
+                  {
+                     return strong::socket::id{ event.data.fd};
+                  });
+               }
+#endif
+               strong::file::descriptor::id descriptor() const noexcept { return m_descriptor;}
+
+            private:
+               static strong::file::descriptor::id create()
+               {
+#ifdef __APPLE__
+                  return strong::file::descriptor::id{ posix::result( ::kqueue(), "send::Writable::create")};
+#else
+                  return strong::file::descriptor::id{ posix::result( ::epoll_create1( EPOLL_CLOEXEC), "send::Writable::create")};
+#endif
+               }
+
+               strong::file::descriptor::id m_descriptor;
+            };
+
+         } // <unnamed>
+      } // local
+
+      namespace overflow
+      {
+         std::ostream& operator << ( std::ostream& out, Policy value)
+         {
+            switch( value)
+            {
+               case Policy::block: return out << "block";
+               case Policy::shed: return out << "shed";
+               case Policy::error: return out << "error";
+            }
+            return out << "<unknown>";
+         }
+      } // overflow
+
+      namespace settings
+      {
+         Settings environment()
+         {
+            Settings result;
+
+            result.capacity = common::environment::variable::get( common::environment::variable::name::ipc::send::capacity, result.capacity);
+
+            auto policy = common::environment::variable::get( common::environment::variable::name::ipc::send::overflow, std::string{});
+
+            if( policy == "shed")
+               result.overflow = overflow::Policy::shed;
+            else if( policy == "error")
+               result.overflow = overflow::Policy::error;
+            else if( ! policy.empty() && policy != "block")
+               log::line( log::category::error, code::casual::invalid_configuration, " unknown ", common::environment::variable::name::ipc::send::overflow, ": ", policy, " - action: use block");
+
+            return result;
+         }
+      } // settings
+
+      class Coordinator::Implementation
+      {
+      public:
+         Implementation( Settings settings) : m_settings{ std::move( settings)} {}
+
+         strong::correlation::id send( const strong::ipc::id& ipc, message::Complete&& complete, overflow::Discard discard)
+         {
+            local::Message message{ std::move( complete)};
+            auto correlation = message.complete.correlation();
+
+            auto found = algorithm::find( m_destinations, ipc);
+
+            // messages are only sent directly if nothing is queued for the destination, to keep the order
+            if( ! found || found->empty())
+            {
+               try
+               {
+                  if( local::send( found ? found->address : Address{ ipc}, {}, message))
+                     return correlation;
+               }
+               catch( ...)
+               {
+                  if( found && local::unavailable())
+                     erase( std::begin( found));
+                  throw;
+               }
+            }
+
+            auto& destination = found ? *found : m_destinations.emplace_back( ipc);
+
+            // a partly sent message has to be completed, regardless of the capacity
+            if( message.offset == 0 && ! destination.empty() && destination.metric.queue.size + message.size() > m_settings.capacity)
+            {
+               switch( m_settings.overflow)
+               {
+                  case overflow::Policy::shed:
+                  {
+                     if( discard == overflow::Discard::never)
+                     {
+                        log::line( communication::log, "outbound queue is full - destination: ", destination.address, " - action: queue reply: ", correlation);
+                        break;
+                     }
+
+                     ++destination.metric.shed;
+                     log::line( log::category::error, code::casual::communication_retry, " outbound queue is full - destination: ", destination.address, " - action: discard request: ", correlation);
+                     return {};
+                  }
+                  case overflow::Policy::error:
+                  {
+                     code::raise::error( code::casual::communication_retry, "outbound queue is full - destination: ", destination.address);
+                  }
+                  case overflow::Policy::block:
+                  {
+                     log::line( communication::log, "outbound queue is full - destination: ", destination.address, " - action: flush inbound until drained");
+
+                     destination.push( std::move( message));
+                     block( destination);
+                     return correlation;
+                  }
+               }
+            }
+
+            destination.push( std::move( message));
+
+            try
+            {
+               watch( destination);
+            }
+            catch( ...)
+            {
+               if( local::unavailable())
+                  erase( std::begin( algorithm::find( m_destinations, ipc)));
+               throw;
+            }
+
+            log::line( communication::verbose::log, "queued: ", destination);
+
+            return correlation;
+         }
+
+         void send()
+         {
+            for( auto socket : m_writable.ready( std::max( m_destinations.size(), std::size_t{ 1})))
+            {
+               auto found = algorithm::find_if( m_destinations, [socket]( auto& destination){ return destination.socket.descriptor() == socket;});
+
+               if( ! found)
+                  continue;
+
+               try
+               {
+                  // drained destinations are removed, we don't keep anything for callers that might be gone
+                  if( found->flush())
+                     erase( std::begin( found));
+               }
+               catch( ...)
+               {
+                  if( ! local::unavailable())
+                     throw;
+
+                  log::line( communication::log, code::casual::communication_unavailable, " destination is gone: ", found->address, " - action: discard ", found->metric.queue.count, " queued messages");
+                  erase( std::begin( found));
+               }
+            }
+         }
+
+         strong::file::descriptor::id descriptor() const noexcept { return m_writable.descriptor();}
+
+         bool empty() const noexcept
+         {
+            return algorithm::all_of( m_destinations, []( auto& destination){ return destination.empty();});
+         }
+
+         std::vector< destination::Metric> metrics() const
+         {
+            return algorithm::transform( m_destinations, []( auto& destination){ return destination.metric;});
+         }
+
+         const Settings& settings() const noexcept { return m_settings;}
+
+      private:
+
+         using iterator = std::deque< local::Destination>::iterator;
+
+         //! connects to the destination, if not already, and adds it's write readiness to our descriptor
+         void watch( local::Destination& destination)
+         {
+            if( destination.socket)
+               return;
+
+            destination.socket = local::connected::socket( destination.address);
+            m_writable.add( destination.socket.descriptor());
+         }
+
+         //! the destination is done, we don't need the write readiness any more
+         void unwatch( local::Destination& destination)
+         {
+            if( ! destination.socket)
+               return;
+
+            m_writable.remove( destination.socket.descriptor());
+            destination.socket = {};
+         }
+
+         void erase( iterator destination)
+         {
+            unwatch( *destination);
+            m_destinations.erase( destination);
+         }
+
+         //! same semantics as `ipc::flush::send`, we flush the inbound until the destination is drained
+         void block( local::Destination& destination)
+         {
+            auto& inbound = ipc::inbound::device();
+
+            try
+            {
+               while( ! destination.flush())
+                  inbound.flush();
+
+               erase( std::begin( algorithm::find( m_destinations, destination.metric.ipc)));
+            }
+            catch( ...)
+            {
+               if( local::unavailable())
+                  erase( std::begin( algorithm::find( m_destinations, destination.metric.ipc)));
+               throw;
+            }
+         }
+
+         Settings m_settings;
+         std::deque< local::Destination> m_destinations;
+         local::Writable m_writable;
+      };
+
+      Coordinator::Coordinator() : Coordinator{ settings::environment()} {}
+      Coordinator::Coordinator( Settings settings) : m_implementation{ std::move( settings)} {}
+      Coordinator::~Coordinator() = default;
+
+      Coordinator::Coordinator( Coordinator&&) noexcept = default;
+      Coordinator& Coordinator::operator = ( Coordinator&&) noexcept = default;
+
+      strong::correlation::id Coordinator::send( const strong::ipc::id& destination, message::Complete&& complete, overflow::Discard discard)
+      {
+         return m_implementation->send( destination, std::move( complete), discard);
+      }
+
+      void Coordinator::send()
+      {
+         m_implementation->send();
+      }
+
+      strong::file::descriptor::id Coordinator::descriptor() const noexcept
+      {
+         return m_implementation->descriptor();
+      }
+
+      bool Coordinator::empty() const noexcept
+      {
+         return m_implementation->empty();
+      }
+
+      std::vector< destination::Metric> Coordinator::metrics() const
+      {
+         return m_implementation->metrics();
+      }
+
+      const Settings& Coordinator::settings() const noexcept
+      {
+         return m_implementation->settings();
+      }
+
+   } // common::communication::ipc::send
+} // casual
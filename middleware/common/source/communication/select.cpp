@@ -1,5 +1,6 @@
 #include "common/communication/select.h"
 #include "common/communication/device.h"
+#include "common/communication/tcp/uring.h"
 
 #include "common/signal.h"
 #include "common/result.h"
@@ -66,7 +67,8 @@ namespace casual
                   }
                   
                   //! takes care of atomic signals...
-                  void select( strong::file::descriptor::id highest, ::fd_set* read, ::fd_set* write)
+                  //! @param poll if true, we don't block
+                  void select( strong::file::descriptor::id highest, ::fd_set* read, ::fd_set* write, bool poll = false)
                   {
                      // block all signals
                      signal::thread::scope::Block block;
@@ -75,10 +77,12 @@ namespace casual
                      if( signal::pending( block.previous()))
                         code::raise::error( code::casual::interupted);
                   
+                     const ::timespec timeout{};
+
                      posix::result( 
                         // will set previous signal mask atomically 
                         // note: first argument: nfds is the highest-numbered file descriptor in any of the three sets, plus 1.
-                        ::pselect( highest.value() + 1, read, write, nullptr, nullptr, &block.previous().set));
+                        ::pselect( highest.value() + 1, read, write, nullptr, poll ? &timeout : nullptr, &block.previous().set));
                   }
 
                } // <unnamed>
@@ -94,20 +98,38 @@ namespace casual
                local::fd_zero( read);
                local::fd_zero( write);
 
-               auto set_set = []( auto&& descriptors, auto& set)
+               // sockets with io_uring receives armed are not selected, their bytes are received via
+               // the ring, and we select on the ring descriptor instead.
+               std::vector< strong::file::descriptor::id> received;
+               strong::file::descriptor::id ring;
+
+               if( tcp::uring::enabled())
+               {
+                  received = tcp::uring::dispatch::ready( directive.read.descriptors());
+                  ring = tcp::uring::dispatch::descriptor();
+               }
+
+               auto set_set = []( auto&& descriptors, auto& set, auto predicate)
                {
                   for( auto descriptor : descriptors)
                   {
                      assert( descriptor);
-                     FD_SET( descriptor.value(), &set);
+                     if( predicate( descriptor))
+                        FD_SET( descriptor.value(), &set);
                   }
                };
 
-               set_set( directive.read.descriptors(), read);
-               set_set( directive.write.descriptors(), write);
+               set_set( directive.read.descriptors(), read, [ring]( auto descriptor){ return ! ring || ! tcp::uring::dispatch::armed( descriptor);});
+               set_set( directive.write.descriptors(), write, []( auto){ return true;});
+
+               if( ring)
+                  FD_SET( ring.value(), &read);
 
-               // takes care of atomic signals...
-               local::select( directive.highest(), &read, &write);
+               // takes care of atomic signals... We don't block if we've already got received bytes.
+               local::select( std::max( directive.highest(), ring), &read, &write, ! received.empty());
+
+               if( ring && FD_ISSET( ring.value(), &read))
+                  received = tcp::uring::dispatch::ready( directive.read.descriptors());
 
                auto filter_ready = []( auto&& descriptors, auto& set)
                {
@@ -117,8 +139,21 @@ namespace casual
                   });
                };
 
+               if( received.empty())
+               {
+                  return directive::Ready{
+                     filter_ready( directive.read.descriptors(), read),
+                     filter_ready( directive.write.descriptors(), write),
+                  };
+               }
+
+               // the ready sockets and the ones the ring has received bytes for
+               for( auto descriptor : filter_ready( directive.read.descriptors(), read))
+                  if( ! algorithm::find( received, descriptor))
+                     received.push_back( descriptor);
+
                return directive::Ready{
-                  filter_ready( directive.read.descriptors(), read),
+                  range::make( received),
                   filter_ready( directive.write.descriptors(), write),
                };
             }
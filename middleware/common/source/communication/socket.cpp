@@ -4,6 +4,7 @@
 
 #include "common/communication/socket.h"
 #include "common/communication/log.h"
+#include "common/communication/tcp/uring.h"
 
 #include "common/result.h"
 #include "common/flag.h"
@@ -53,6 +54,9 @@ namespace casual
          {
             if( *this)
             {
+               // the io_uring, if used, keeps the socket open until its receive is canceled
+               tcp::uring::close( m_descriptor);
+
                if( posix::log::result( ::close( m_descriptor.value()), "failed to close socket"))
                   common::log::line( log, "Socket::close - descriptor: ", m_descriptor);
             }
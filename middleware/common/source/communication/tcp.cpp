@@ -6,6 +6,7 @@
 
 
 #include "common/communication/tcp.h"
+#include "common/communication/tcp/uring.h"
 #include "common/communication/log.h"
 #include "common/communication/select.h"
 
@@ -419,60 +420,56 @@ namespace casual
                   non_blocking = platform::flag::value( platform::flag::tcp::no_wait)
                };
 
-               auto send( const Socket& socket, policy::complete_type& complete, common::Flags< Flag> flags)
+               //! adds the parts of `complete` that are not sent yet
+               void parts( policy::complete_type& complete, std::vector< ::iovec>& parts)
                {
-                  Trace trace{ "common::communication::tcp::policy::local::send"};
-                  log::line( verbose::log, "complete: ", complete, ", flags: ", flags);
-
-                  try
+                  if( complete.offset < message::header::size)
                   {
-                     auto send_message = []( auto& socket, const ::msghdr* message, auto flags)
-                     {
-                        log::line( verbose::log, "socket: ", socket, ", flags: ", flags);
-
-                        return posix::alternative( 
-                           ::sendmsg( socket.descriptor().value(), message, flags.underlaying()),
-                           0,
-                           std::errc::resource_unavailable_try_again, std::errc::operation_would_block);
-                     };
-
-                     if( complete.offset >= message::header::size)
-                     {
-                        // we've sent the header already. Send the rest of the paylad.
+                     // part/all of the header is not sent. 
+                     parts.push_back( ::iovec{ 
+                        reinterpret_cast< char*>( &complete.header()) + complete.offset, 
+                        static_cast< std::size_t>( message::header::size - complete.offset)});
+                  }
 
-                        ::iovec part{};
+                  auto offset = std::max( complete.offset - message::header::size, platform::size::type{});
 
-                        auto offset = complete.offset - message::header::size;
+                  if( offset < range::size( complete.payload))
+                  {
+                     parts.push_back( ::iovec{ 
+                        const_cast< char*>( complete.payload.data()) + offset, 
+                        static_cast< std::size_t>( complete.payload.size() - offset)});
+                  }
+               }
 
-                        part.iov_base = const_cast< char*>( complete.payload.data()) + offset;
-                        part.iov_len = complete.payload.size() - offset;
+               //! @returns the number of bytes sent, 0 if the socket is not writable
+               platform::size::type send( const Socket& socket, const ::msghdr& message, common::Flags< Flag> flags)
+               {
+                  log::line( verbose::log, "socket: ", socket, ", flags: ", flags);
 
-                        ::msghdr message{};
-                        message.msg_iov = &part;
-                        message.msg_iovlen = 1;
+                  if( flags.exist( Flag::non_blocking) && uring::enabled())
+                     return uring::send( socket, message);
 
-                        complete.offset += send_message( socket, &message, flags);
-                     }
-                     else
-                     {
-                        // part/all of the header is not sent. 
-                        std::array< ::iovec, 2> parts{};
+                  return posix::alternative( 
+                     ::sendmsg( socket.descriptor().value(), &message, flags.underlaying()),
+                     0,
+                     std::errc::resource_unavailable_try_again, std::errc::operation_would_block);
+               }
 
-                        // First we set the header
-                        auto& header = complete.header();
-                        parts[ 0].iov_base = &header + complete.offset;
-                        parts[ 0].iov_len = message::header::size - complete.offset;
+               auto send( const Socket& socket, policy::complete_type& complete, common::Flags< Flag> flags)
+               {
+                  Trace trace{ "common::communication::tcp::policy::local::send"};
+                  log::line( verbose::log, "complete: ", complete, ", flags: ", flags);
 
-                        // then we set the payload
-                        parts[ 1].iov_base = const_cast< char*>( complete.payload.data());
-                        parts[ 1].iov_len = complete.payload.size();
+                  try
+                  {
+                     std::vector< ::iovec> parts;
+                     local::parts( complete, parts);
 
-                        ::msghdr message{};
-                        message.msg_iov = parts.data();
-                        message.msg_iovlen = parts.size();
+                     ::msghdr message{};
+                     message.msg_iov = parts.data();
+                     message.msg_iovlen = parts.size();
 
-                        complete.offset += send_message( socket, &message, flags);
-                     }
+                     complete.offset += local::send( socket, message, flags);
 
                      log::line( log, "tcp send ---> descriptor: ", socket.descriptor(), ", complete: ", complete);
 
@@ -547,10 +544,80 @@ namespace casual
                }
 
 
+               namespace uring
+               {
+                  //! fills `complete` with as much of `bytes` it needs.
+                  //! @returns the bytes that are left
+                  Range< const char*> fill( policy::complete_type& complete, Range< const char*> bytes)
+                  {
+                     if( complete.offset < message::header::size)
+                     {
+                        auto count = std::min( message::header::size - complete.offset, bytes.size());
+                        algorithm::copy( range::make( std::begin( bytes), count), reinterpret_cast< char*>( &complete.header()) + complete.offset);
+                        complete.offset += count;
+                        bytes.advance( count);
+
+                        if( complete.offset < message::header::size)
+                           return bytes;
+
+                        // we've got the header, set up the paylad
+                        complete.payload.resize( complete.size());
+                     }
+
+                     auto offset = complete.offset - message::header::size;
+                     auto count = std::min( range::size( complete.payload) - offset, bytes.size());
+                     algorithm::copy( range::make( std::begin( bytes), count), complete.payload.data() + offset);
+                     complete.offset += count;
+                     bytes.advance( count);
+
+                     return bytes;
+                  }
+
+                  //! takes what the ring has received from the socket, and assembles the received bytes 
+                  //! to (possible several) messages in the cache.
+                  //! @returns the range of messages that got bytes, complete or not.
+                  policy::cache_range_type receive( const Socket& socket, policy::cache_type& cache, common::Flags< Flag> flags)
+                  {
+                     Trace trace{ "common::communication::tcp::policy::local::uring::receive"};
+
+                     auto bytes = tcp::uring::receive( socket);
+
+                     // the ring receives non blocking, wait until there might be something for the socket.
+                     while( bytes.empty() && ! flags.exist( Flag::non_blocking))
+                     {
+                        tcp::uring::wait( socket);
+                        bytes = tcp::uring::receive( socket);
+                     }
+
+                     if( bytes.empty())
+                        return {};
+
+                     // the first message that gets bytes is the 'incomplete' last one, if any
+                     auto first = range::size( cache);
+                     if( ! cache.empty() && ! cache.back().complete())
+                        --first;
+
+                     while( ! bytes.empty())
+                     {
+                        if( cache.empty() || cache.back().complete())
+                           cache.emplace_back();
+
+                        bytes = fill( cache.back(), bytes);
+                     }
+
+                     log::line( log, "tcp receive <---- descriptor: ", socket.descriptor(), " , last: ", cache.back());
+
+                     return range::make( std::begin( cache) + first, std::end( cache));
+                  }
+               } // uring
+
                policy::cache_range_type receive( const Socket& socket, policy::cache_type& cache, common::Flags< Flag> flags)
                {
                   Trace trace{ "common::communication::tcp::policy::local::receive cache"};
 
+                  if( tcp::uring::enabled())
+                     return uring::receive( socket, cache, flags);
+
                   auto range_last = []( auto& range)
                   {
                      return policy::cache_range_type{ std::end( range) - 1, std::end( range)};
@@ -620,6 +687,141 @@ namespace casual
 
       } // policy
 
+      namespace batch
+      {
+         namespace local
+         {
+            namespace
+            {
+               // we gather at most this many messages into one system call, with two parts each,
+               // which keeps us well within IOV_MAX
+               constexpr platform::size::type max = 256;
+
+               //! @returns the parts of `completes` that are not sent yet, from at most `max` messages
+               std::vector< ::iovec> parts( range::type_t< std::vector< message::Complete>> completes)
+               {
+                  std::vector< ::iovec> parts;
+                  parts.reserve( std::min( completes.size(), max) * 2);
+
+                  for( auto& complete : range::make( std::begin( completes), std::min( completes.size(), max)))
+                     policy::local::parts( complete, parts);
+
+                  return parts;
+               }
+
+               ::msghdr message( std::vector< ::iovec>& parts)
+               {
+                  ::msghdr message{};
+                  message.msg_iov = parts.data();
+                  message.msg_iovlen = parts.size();
+                  return message;
+               }
+
+               //! distributes the sent bytes over the messages
+               //! @returns the number of messages that are completely sent
+               platform::size::type distribute( range::type_t< std::vector< message::Complete>> completes, platform::size::type bytes)
+               {
+                  platform::size::type count = 0;
+
+                  for( auto& complete : completes)
+                  {
+                     auto total = message::header::size + range::size( complete.payload);
+                     auto sent = std::min( total - complete.offset, bytes);
+
+                     complete.offset += sent;
+                     bytes -= sent;
+
+                     if( ! complete.complete())
+                        break;
+
+                     ++count;
+                  }
+
+                  return count;
+               }
+
+            } // <unnamed>
+         } // local
+
+         platform::size::type send( const Socket& socket, range::type_t< std::vector< message::Complete>> completes)
+         {
+            Trace trace{ "common::communication::tcp::batch::send"};
+
+            auto parts = local::parts( completes);
+            auto message = local::message( parts);
+
+            auto bytes = policy::local::send( socket, message, policy::local::Flag::non_blocking);
+
+            log::line( verbose::log, "tcp batch send ---> descriptor: ", socket.descriptor(), ", messages: ", completes.size(), ", bytes: ", bytes);
+
+            return local::distribute( completes, bytes);
+         }
+
+         void send( range::type_t< std::vector< Destination>> destinations)
+         {
+            Trace trace{ "common::communication::tcp::batch::send destinations"};
+
+            if( ! uring::enabled())
+            {
+               for( auto& destination : destinations)
+               {
+                  try
+                  {
+                     destination.count = send( *destination.socket, destination.completes);
+                  }
+                  catch( ...)
+                  {
+                     destination.error = exception::capture().code();
+                  }
+               }
+               return;
+            }
+
+            std::vector< std::vector< ::iovec>> parts;
+            std::vector< ::msghdr> messages;
+            std::vector< uring::batch::Send> sends;
+
+            // the sends refers to the messages, that refers to the parts, no reallocation.
+            parts.reserve( destinations.size());
+            messages.reserve( destinations.size());
+            sends.reserve( destinations.size());
+
+            for( auto& destination : destinations)
+            {
+               parts.push_back( local::parts( destination.completes));
+               messages.push_back( local::message( parts.back()));
+               sends.push_back( uring::batch::Send{ destination.socket, &messages.back(), 0});
+            }
+
+            uring::batch::send( range::make( sends));
+
+            for( platform::size::type index = 0; index < range::size( sends); ++index)
+            {
+               auto& destination = *( std::begin( destinations) + index);
+               auto& send = sends[ index];
+
+               try
+               {
+                  if( send.result < 0)
+                     errno = -send.result;
+
+                  auto bytes = posix::alternative(
+                     send.result < 0 ? -1 : send.result,
+                     0,
+                     std::errc::resource_unavailable_try_again, std::errc::operation_would_block);
+
+                  log::line( verbose::log, "tcp batch send ---> descriptor: ", destination.socket->descriptor(), ", messages: ", destination.completes.size(), ", bytes: ", bytes);
+
+                  destination.count = local::distribute( destination.completes, bytes);
+               }
+               catch( ...)
+               {
+                  destination.error = exception::capture().code();
+               }
+            }
+         }
+      } // batch
+
       Connector::Connector() noexcept = default;
 
       Connector::Connector( Socket&& socket) noexcept
@@ -0,0 +1,795 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#include "common/communication/tcp/uring.h"
+#include "common/communication/select.h"
+#include "common/communication/log.h"
+
+#include "common/environment.h"
+#include "common/result.h"
+#include "common/code/raise.h"
+#include "common/code/casual.h"
+#include "common/exception/handle.h"
+
+#include <atomic>
+#include <memory>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <cerrno>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace casual
+{
+   namespace common::communication::tcp::uring
+   {
+      namespace local
+      {
+         namespace
+         {
+#ifdef __linux__
+
+            namespace system
+            {
+               // we use the system calls directly, to not depend on liburing
+               int setup( unsigned entries, ::io_uring_params& params)
+               {
+                  return ::syscall( __NR_io_uring_setup, entries, &params);
+               }
+
+               int enter( int descriptor, unsigned submit, unsigned complete, unsigned flags)
+               {
+                  return ::syscall( __NR_io_uring_enter, descriptor, submit, complete, flags, nullptr, 0);
+               }
+            } // system
+
+            struct Mapping
+            {
+               Mapping() = default;
+               Mapping( int descriptor, platform::size::type size, std::uint64_t offset)
+                  : address{ ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor, offset)}, size{ size}
+               {
+                  if( address == MAP_FAILED)
+                     address = nullptr;
+               }
+
+               ~Mapping()
+               {
+                  if( address)
+                     ::munmap( address, size);
+               }
+
+               Mapping( Mapping&& other) noexcept
+                  : address{ std::exchange( other.address, nullptr)}, size{ other.size} {}
+
+               Mapping& operator = ( Mapping&& other) noexcept
+               {
+                  std::swap( address, other.address);
+                  std::swap( size, other.size);
+                  return *this;
+               }
+
+               template< typename T>
+               T* at( std::uint32_t offset) const noexcept { return reinterpret_cast< T*>( static_cast< char*>( address) + offset);}
+
+               explicit operator bool() const noexcept { return address != nullptr;}
+
+               void* address = nullptr;
+               platform::size::type size = 0;
+            };
+
+            //! what a submission is, encoded in the high bits of its user data
+            namespace kind
+            {
+               constexpr std::uint64_t shift = 56;
+               constexpr std::uint64_t send = 1;
+               constexpr std::uint64_t receive = 2;
+               //! provide buffers and cancel, we're only interested in failures.
+               constexpr std::uint64_t other = 3;
+
+               constexpr std::uint64_t mask = ( std::uint64_t{ 1} << shift) - 1;
+            } // kind
+
+            //! A minimal io_uring, with a group of receive buffers that the kernel selects from.
+            //!
+            //! Sends are submitted in batches, and waited for (they're non blocking, hence 'immediate').
+            //! Receives are multishot, armed once per socket, and the completions are reaped, without
+            //! system calls, whenever the ring is used, which the select dispatch does when the ring
+            //! descriptor is readable.
+            class Ring
+            {
+            public:
+
+               //! the most submissions we queue before we need to submit
+               static constexpr std::uint32_t capacity = 64;
+
+               //! @returns a ring, or nullptr if io_uring (or provided buffers) is not supported
+               static std::unique_ptr< Ring> create() noexcept
+               {
+                  auto ring = std::unique_ptr< Ring>{ new Ring};
+                  if( ring->m_descriptor == -1)
+                     return nullptr;
+                  return ring;
+               }
+
+               ~Ring()
+               {
+                  if( m_descriptor != -1)
+                     ::close( m_descriptor);
+               }
+
+               Ring( const Ring&) = delete;
+               Ring& operator = ( const Ring&) = delete;
+
+               auto descriptor() const noexcept { return m_descriptor;}
+
+               //! @returns true if any receive is armed
+               bool armed() const noexcept { return m_armed > 0;}
+
+               //! submits the queued sqe:s, without waiting for completions.
+               void submit()
+               {
+                  while( m_unsubmitted > 0)
+                     enter( 0);
+               }
+
+               //! reaps all completions, without system calls.
+               void reap()
+               {
+                  auto head = *m_completion.head;
+                  auto tail = __atomic_load_n( m_completion.tail, __ATOMIC_ACQUIRE);
+
+                  for( ; head != tail; ++head)
+                  {
+                     auto& cqe = m_completion.entries[ head & *m_completion.mask];
+
+                     switch( cqe.user_data >> kind::shift)
+                     {
+                        case kind::send:
+                        {
+                           m_sent.at( cqe.user_data & kind::mask) = cqe.res;
+                           --m_outstanding;
+                           break;
+                        }
+                        case kind::receive:
+                        {
+                           received( cqe);
+                           break;
+                        }
+                        default:
+                        {
+                           if( cqe.res < 0 && cqe.res != -ENOENT && cqe.res != -EALREADY)
+                              log::line( log::category::error, code::casual::internal_unexpected_value, " io_uring operation failed - errno: ", -cqe.res);
+                           break;
+                        }
+                     }
+                  }
+
+                  __atomic_store_n( m_completion.head, head, __ATOMIC_RELEASE);
+               }
+
+               //! sends all `sends` with one submission, and waits for the completions, in whatever
+               //! order the kernel completes them.
+               //! @attention at most `capacity` sends
+               void send( range::type_t< std::vector< batch::Send>> sends)
+               {
+                  m_sent.assign( sends.size(), -EAGAIN);
+                  m_outstanding = sends.size();
+
+                  std::uint64_t index = 0;
+                  for( auto& send : sends)
+                  {
+                     queue( ( kind::send << kind::shift) | index++, [&send]( ::io_uring_sqe& sqe)
+                     {
+                        sqe.opcode = IORING_OP_SENDMSG;
+                        sqe.fd = send.socket->descriptor().value();
+                        sqe.addr = reinterpret_cast< std::uint64_t>( send.message);
+                        sqe.msg_flags = MSG_DONTWAIT;
+                     });
+                  }
+
+                  // the sends are non blocking, the completions are 'immediate'
+                  while( true)
+                  {
+                     reap();
+
+                     if( m_outstanding == 0 && m_unsubmitted == 0)
+                        break;
+
+                     enter( m_outstanding);
+                  }
+
+                  index = 0;
+                  for( auto& send : sends)
+                     send.result = m_sent[ index++];
+               }
+
+               //! @returns the next received bytes from `descriptor`, arms the receive if needed.
+               //!   Empty if nothing is received (yet).
+               Range< const char*> receive( int descriptor)
+               {
+                  // what we lent out the last time is consumed, give it back to the kernel.
+                  if( m_lent)
+                     provide( *std::exchange( m_lent, std::nullopt));
+
+                  reap();
+
+                  auto& receiver = this->receiver( descriptor);
+
+                  if( receiver.received.empty() && ! receiver.end && ! receiver.error && ! receiver.active)
+                  {
+                     if( m_multishot && m_available > 0)
+                     {
+                        arm( descriptor, receiver);
+                        submit();
+                        reap();
+                     }
+                     else
+                        return fallback( descriptor);
+                  }
+
+                  if( ! receiver.received.empty())
+                  {
+                     auto buffer = receiver.received.front();
+                     receiver.received.pop_front();
+                     m_lent = buffer.id;
+                     return range::make( static_cast< const char*>( this->buffer( buffer.id)), buffer.size);
+                  }
+
+                  if( receiver.end)
+                     code::raise::error( code::casual::communication_unavailable);
+
+                  if( receiver.error)
+                  {
+                     errno = std::exchange( receiver.error, 0);
+                     posix::alternative( -1, -1, std::errc::resource_unavailable_try_again, std::errc::operation_would_block);
+                  }
+
+                  return {};
+               }
+
+               //! @returns true if `descriptor` has something to consume via `receive`
+               bool ready( int descriptor) const noexcept
+               {
+                  if( auto found = m_receivers.find( descriptor); found != std::end( m_receivers))
+                     return ! found->second.received.empty() || found->second.end || found->second.error;
+                  return false;
+               }
+
+               //! @returns true if the receives from `descriptor` are driven by the ring
+               bool armed( int descriptor) const noexcept
+               {
+                  if( auto found = m_receivers.find( descriptor); found != std::end( m_receivers))
+                     return found->second.active;
+                  return false;
+               }
+
+               //! cancels the armed receive for `descriptor`, if any, and gives back what's received.
+               void close( int descriptor)
+               {
+                  auto found = m_receivers.find( descriptor);
+                  if( found == std::end( m_receivers))
+                     return;
+
+                  for( auto& buffer : found->second.received)
+                     provide( buffer.id);
+
+                  if( found->second.active)
+                  {
+                     cancel( descriptor, found->second);
+                     --m_armed;
+                  }
+
+                  m_receivers.erase( found);
+
+                  // the kernel keeps the socket open until the receive is canceled
+                  submit();
+               }
+
+            private:
+               Ring() noexcept
+               {
+                  ::io_uring_params params{};
+
+                  m_descriptor = system::setup( capacity, params);
+                  if( m_descriptor == -1)
+                     return;
+
+                  auto failed = [&]()
+                  {
+                     ::close( std::exchange( m_descriptor, -1));
+                  };
+
+                  // we need to have the ring 'single mmap', that is kernel >= 5.4
+                  if( ! ( params.features & IORING_FEAT_SINGLE_MMAP))
+                  {
+                     failed();
+                     return;
+                  }
+
+                  auto size = std::max(
+                     params.sq_off.array + params.sq_entries * sizeof( std::uint32_t),
+                     params.cq_off.cqes + params.cq_entries * sizeof( ::io_uring_cqe));
+
+                  m_ring = Mapping{ m_descriptor, static_cast< platform::size::type>( size), IORING_OFF_SQ_RING};
+                  m_entries = Mapping{ m_descriptor, static_cast< platform::size::type>( params.sq_entries * sizeof( ::io_uring_sqe)), IORING_OFF_SQES};
+
+                  if( ! m_ring || ! m_entries)
+                  {
+                     failed();
+                     return;
+                  }
+
+                  m_submission.tail = m_ring.at< std::uint32_t>( params.sq_off.tail);
+                  m_submission.mask = m_ring.at< std::uint32_t>( params.sq_off.ring_mask);
+                  m_submission.array = m_ring.at< std::uint32_t>( params.sq_off.array);
+                  m_submission.entries = static_cast< ::io_uring_sqe*>( m_entries.address);
+
+                  m_completion.head = m_ring.at< std::uint32_t>( params.cq_off.head);
+                  m_completion.tail = m_ring.at< std::uint32_t>( params.cq_off.tail);
+                  m_completion.mask = m_ring.at< std::uint32_t>( params.cq_off.ring_mask);
+                  m_completion.entries = m_ring.at< ::io_uring_cqe>( params.cq_off.cqes);
+
+                  m_buffers = std::make_unique< char[]>( read::ahead::size * read::ahead::count);
+
+                  // provide all buffers, and wait for the result, the kernel needs to be >= 5.7
+                  queue( kind::other << kind::shift, [&]( ::io_uring_sqe& sqe)
+                  {
+                     sqe.opcode = IORING_OP_PROVIDE_BUFFERS;
+                     sqe.fd = read::ahead::count;
+                     sqe.addr = reinterpret_cast< std::uint64_t>( m_buffers.get());
+                     sqe.len = read::ahead::size;
+                     sqe.off = 0;
+                     sqe.buf_group = group;
+                  });
+
+                  if( system::enter( m_descriptor, 1, 1, IORING_ENTER_GETEVENTS) != 1)
+                  {
+                     failed();
+                     return;
+                  }
+
+                  auto head = *m_completion.head;
+                  auto result = m_completion.entries[ head & *m_completion.mask].res;
+                  __atomic_store_n( m_completion.head, head + 1, __ATOMIC_RELEASE);
+                  m_unsubmitted = 0;
+
+                  if( result < 0)
+                  {
+                     failed();
+                     return;
+                  }
+
+                  m_available = read::ahead::count;
+               }
+
+               //! the buffer group the receive buffers are provided in
+               static constexpr std::uint16_t group = 0;
+
+               //! the receive state of a socket
+               struct Receiver
+               {
+                  struct Buffer
+                  {
+                     std::uint16_t id{};
+                     platform::size::type size{};
+                  };
+
+                  //! to tell completions from a closed socket, from a new one with the same descriptor
+                  std::uint32_t generation{};
+                  //! a multishot receive is in flight, until we get a completion without 'more'
+                  bool active = false;
+                  //! a cancel of the receive is submitted, since we hold too many buffers
+                  bool paused = false;
+                  //! the peer has performed an orderly shutdown
+                  bool end = false;
+                  int error = 0;
+                  std::deque< Buffer> received;
+               };
+
+               Receiver& receiver( int descriptor)
+               {
+                  auto found = m_receivers.find( descriptor);
+                  if( found != std::end( m_receivers))
+                     return found->second;
+
+                  auto& receiver = m_receivers[ descriptor];
+                  receiver.generation = ++m_generation & 0xffffff;
+                  return receiver;
+               }
+
+               static std::uint64_t data( int descriptor, const Receiver& receiver) noexcept
+               {
+                  return ( kind::receive << kind::shift)
+                     | ( static_cast< std::uint64_t>( receiver.generation) << 32)
+                     | static_cast< std::uint32_t>( descriptor);
+               }
+
+               void arm( int descriptor, Receiver& receiver)
+               {
+                  queue( data( descriptor, receiver), [descriptor]( ::io_uring_sqe& sqe)
+                  {
+                     sqe.opcode = IORING_OP_RECV;
+                     sqe.fd = descriptor;
+                     sqe.flags = IOSQE_BUFFER_SELECT;
+                     sqe.buf_group = group;
+                     sqe.ioprio = IORING_RECV_MULTISHOT;
+                  });
+
+                  receiver.active = true;
+                  receiver.paused = false;
+                  ++m_armed;
+               }
+
+               void cancel( int descriptor, const Receiver& receiver)
+               {
+                  auto target = data( descriptor, receiver);
+                  queue( kind::other << kind::shift, [target]( ::io_uring_sqe& sqe)
+                  {
+                     sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                     sqe.fd = -1;
+                     sqe.addr = target;
+                  });
+               }
+
+               void provide( std::uint16_t id)
+               {
+                  queue( kind::other << kind::shift, [&]( ::io_uring_sqe& sqe)
+                  {
+                     sqe.opcode = IORING_OP_PROVIDE_BUFFERS;
+                     sqe.fd = 1;
+                     sqe.addr = reinterpret_cast< std::uint64_t>( buffer( id));
+                     sqe.len = read::ahead::size;
+                     sqe.off = id;
+                     sqe.buf_group = group;
+                  });
+
+                  ++m_available;
+               }
+
+               void received( const ::io_uring_cqe& cqe)
+               {
+                  auto descriptor = static_cast< int>( cqe.user_data & 0xffffffff);
+                  auto generation = static_cast< std::uint32_t>( ( cqe.user_data & kind::mask) >> 32);
+
+                  auto found = m_receivers.find( descriptor);
+                  auto receiver = found != std::end( m_receivers) && found->second.generation == generation ? &found->second : nullptr;
+
+                  if( cqe.flags & IORING_CQE_F_BUFFER)
+                  {
+                     auto id = static_cast< std::uint16_t>( cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                     --m_available;
+
+                     if( receiver && cqe.res > 0)
+                        receiver->received.push_back( Receiver::Buffer{ id, cqe.res});
+                     else
+                        provide( id);
+                  }
+
+                  // a closed socket, we've already forgotten about it
+                  if( ! receiver)
+                     return;
+
+                  if( cqe.flags & IORING_CQE_F_MORE)
+                  {
+                     // hold too many buffers, we pause the receive until the socket is consumed.
+                     if( ! receiver->paused && range::size( receiver->received) >= read::ahead::hold)
+                     {
+                        cancel( descriptor, *receiver);
+                        receiver->paused = true;
+                     }
+                     return;
+                  }
+
+                  // the receive is done, we arm it again when the received is consumed
+                  receiver->active = false;
+                  --m_armed;
+
+                  if( cqe.res == 0)
+                     receiver->end = true;
+                  else if( cqe.res == -EINVAL && ! receiver->paused)
+                  {
+                     // the kernel does not support multishot receive (< 6.0)
+                     log::line( verbose::log, "io_uring multishot receive is not supported - action: use regular receive");
+                     m_multishot = false;
+                  }
+                  else if( cqe.res < 0 && cqe.res != -ENOBUFS && cqe.res != -ECANCELED)
+                     receiver->error = -cqe.res;
+               }
+
+               //! the kernel does not support multishot, or the ring has no buffers left.
+               Range< const char*> fallback( int descriptor)
+               {
+                  if( ! m_fallback)
+                     m_fallback = std::make_unique< char[]>( read::ahead::size);
+
+                  auto bytes = posix::alternative(
+                     ::recv( descriptor, m_fallback.get(), read::ahead::size, MSG_DONTWAIT),
+                     -1,
+                     std::errc::resource_unavailable_try_again, std::errc::operation_would_block);
+
+                  // _The return value will be 0 when the peer has performed an orderly shutdown_
+                  if( bytes == 0)
+                     code::raise::error( code::casual::communication_unavailable);
+                  else if( bytes == -1)
+                     return {};
+
+                  return range::make( static_cast< const char*>( m_fallback.get()), bytes);
+               }
+
+               char* buffer( std::uint16_t id) noexcept { return m_buffers.get() + id * read::ahead::size;}
+
+               //! queues the `prepare`d sqe, tagged with `data`, which the completion is correlated with.
+               template< typename P>
+               void queue( std::uint64_t data, P&& prepare)
+               {
+                  if( m_unsubmitted == capacity)
+                     submit();
+
+                  auto tail = *m_submission.tail;
+                  auto index = tail & *m_submission.mask;
+
+                  auto& sqe = m_submission.entries[ index];
+                  sqe = ::io_uring_sqe{};
+                  prepare( sqe);
+                  sqe.user_data = data;
+                  m_submission.array[ index] = index;
+
+                  __atomic_store_n( m_submission.tail, tail + 1, __ATOMIC_RELEASE);
+                  ++m_unsubmitted;
+               }
+
+               //! submits what's not submitted, and waits for `complete` completions, if any
+               void enter( std::uint32_t complete)
+               {
+                  auto consumed = system::enter( m_descriptor, m_unsubmitted, complete, complete > 0 ? IORING_ENTER_GETEVENTS : 0);
+
+                  if( consumed >= 0)
+                  {
+                     m_unsubmitted -= std::min< std::uint32_t>( m_unsubmitted, consumed);
+                     return;
+                  }
+
+                  switch( errno)
+                  {
+                     // interrupted, or the completion queue is full, we reap and try again
+                     case EINTR:
+                     case EAGAIN:
+                     case EBUSY:
+                        reap();
+                        return;
+                     default:
+                        code::raise::error( code::casual::internal_unexpected_value, "io_uring_enter failed - errno: ", errno);
+                  }
+               }
+
+               int m_descriptor = -1;
+               std::uint32_t m_unsubmitted = 0;
+               Mapping m_ring;
+               Mapping m_entries;
+
+               struct
+               {
+                  std::uint32_t* tail = nullptr;
+                  std::uint32_t* mask = nullptr;
+                  std::uint32_t* array = nullptr;
+                  ::io_uring_sqe* entries = nullptr;
+               } m_submission;
+
+               struct
+               {
+                  std::uint32_t* head = nullptr;
+                  std::uint32_t* tail = nullptr;
+                  std::uint32_t* mask = nullptr;
+                  ::io_uring_cqe* entries = nullptr;
+               } m_completion;
+
+               std::unique_ptr< char[]> m_buffers;
+               //! the number of buffers the kernel has to receive into
+               platform::size::type m_available = 0;
+               //! the buffer the last `receive` returned
+               std::optional< std::uint16_t> m_lent;
+               std::unique_ptr< char[]> m_fallback;
+
+               std::unordered_map< int, Receiver> m_receivers;
+               std::uint32_t m_generation = 0;
+               platform::size::type m_armed = 0;
+               bool m_multishot = true;
+
+               std::vector< int> m_sent;
+               platform::size::type m_outstanding = 0;
+            };
+
+            //! the ring of the thread, if it's created
+            thread_local Ring* current = nullptr;
+
+            Ring* ring() noexcept
+            {
+               thread_local auto ring = Ring::create();
+               current = ring.get();
+               return current;
+            }
+
+#else
+            struct Ring {};
+
+            Ring* ring() noexcept { return nullptr;}
+#endif
+
+            auto& enabled()
+            {
+               static std::atomic< bool> enabled{ common::environment::variable::get( common::environment::variable::name::tcp::io_uring, 0) == 1};
+               return enabled;
+            }
+
+         } // <unnamed>
+      } // local
+
+      bool supported() noexcept
+      {
+         return local::ring() != nullptr;
+      }
+
+      bool enabled() noexcept
+      {
+         return local::enabled().load( std::memory_order_relaxed) && supported();
+      }
+
+      void enable( bool value) noexcept
+      {
+         local::enabled().store( value);
+      }
+
+#ifdef __linux__
+
+      Range< const char*> receive( const Socket& socket)
+      {
+         auto bytes = local::ring()->receive( socket.descriptor().value());
+
+         if( ! bytes.empty())
+            log::line( verbose::log, "uring receive - descriptor: ", socket.descriptor(), ", bytes: ", bytes.size());
+
+         return bytes;
+      }
+
+      void wait( const Socket& socket)
+      {
+         auto ring = local::ring();
+
+         if( ring->armed( socket.descriptor().value()))
+         {
+            ring->submit();
+            communication::select::block::read( strong::file::descriptor::id{ ring->descriptor()});
+         }
+         else
+            communication::select::block::read( socket.descriptor());
+      }
+
+      void close( strong::socket::id descriptor) noexcept
+      {
+         if( ! local::current || ! local::enabled().load( std::memory_order_relaxed))
+            return;
+
+         try
+         {
+            local::current->close( descriptor.value());
+         }
+         catch( ...)
+         {
+            exception::sink();
+         }
+      }
+
+      namespace dispatch
+      {
+         std::vector< strong::file::descriptor::id> ready( range::type_t< std::vector< strong::file::descriptor::id>> descriptors)
+         {
+            auto ring = local::current;
+            if( ! ring)
+               return {};
+
+            ring->submit();
+            ring->reap();
+
+            return range::to_vector( algorithm::filter( descriptors, [ring]( auto descriptor)
+            {
+               return ring->ready( descriptor.value());
+            }));
+         }
+
+         bool armed( strong::file::descriptor::id descriptor) noexcept
+         {
+            return local::current && local::current->armed( descriptor.value());
+         }
+
+         strong::file::descriptor::id descriptor() noexcept
+         {
+            if( local::current && local::current->armed())
+               return strong::file::descriptor::id{ local::current->descriptor()};
+            return {};
+         }
+
+      } // dispatch
+
+      platform::size::type send( const Socket& socket, const ::msghdr& message)
+      {
+         std::vector< batch::Send> sends{ batch::Send{ &socket, &message, 0}};
+         batch::send( range::make( sends));
+
+         if( sends.front().result < 0)
+            errno = -sends.front().result;
+
+         auto bytes = posix::alternative(
+            sends.front().result < 0 ? -1 : sends.front().result,
+            0,
+            std::errc::resource_unavailable_try_again, std::errc::operation_would_block);
+
+         log::line( verbose::log, "uring send - descriptor: ", socket.descriptor(), ", bytes: ", bytes);
+
+         return bytes;
+      }
+
+      namespace batch
+      {
+         void send( range::type_t< std::vector< Send>> sends)
+         {
+            while( ! sends.empty())
+            {
+               auto chunk = range::make( std::begin( sends), std::min< platform::size::type>( sends.size(), local::Ring::capacity));
+
+               local::ring()->send( chunk);
+
+               log::line( verbose::log, "uring batch send - sends: ", chunk.size());
+
+               sends.advance( chunk.size());
+            }
+         }
+      } // batch
+
+#else
+      Range< const char*> receive( const Socket& socket)
+      {
+         code::raise::error( code::casual::invalid_semantics, "io_uring is not supported");
+      }
+
+      void wait( const Socket& socket)
+      {
+         code::raise::error( code::casual::invalid_semantics, "io_uring is not supported");
+      }
+
+      void close( strong::socket::id descriptor) noexcept {}
+
+      namespace dispatch
+      {
+         std::vector< strong::file::descriptor::id> ready( range::type_t< std::vector< strong::file::descriptor::id>> descriptors) { return {};}
+         bool armed( strong::file::descriptor::id descriptor) noexcept { return false;}
+         strong::file::descriptor::id descriptor() noexcept { return {};}
+      } // dispatch
+
+      platform::size::type send( const Socket& socket, const ::msghdr& message)
+      {
+         code::raise::error( code::casual::invalid_semantics, "io_uring is not supported");
+      }
+
+      namespace batch
+      {
+         void send( range::type_t< std::vector< Send>> sends)
+         {
+            code::raise::error( code::casual::invalid_semantics, "io_uring is not supported");
+         }
+      } // batch
+#endif
+
+   } // common::communication::tcp::uring
+} // casual
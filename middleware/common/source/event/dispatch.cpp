@@ -21,11 +21,27 @@ namespace casual
          {
             Trace trace{ "common::event::base_dispatch::pending"};
 
+            // readers of the ring gets the event from the ring, if it fits
+            if( m_ring.active() && m_ring.write( complete))
+            {
+               auto destinations = m_subscribers;
+               algorithm::container::erase_if( destinations, [&]( auto& process){ return m_ring.reader( process.ipc);});
+
+               return common::message::pending::Message{ std::move( complete), std::move( destinations)};
+            }
+
             return common::message::pending::Message{
                std::move( complete),
                m_subscribers};
          }
 
+         void base_dispatch::multicast( message::Type type, platform::size::type capacity)
+         {
+            Trace trace{ "common::event::base_dispatch::multicast"};
+
+            m_ring = ring::Writer{ type, capacity};
+         }
+
       } // event
    } // common
 } // casual
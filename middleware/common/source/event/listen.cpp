@@ -82,7 +82,13 @@ namespace casual
             {
                Trace trace{ "common::event::detail::subscribe"};
 
-               local::subscribe( process::handle(), handler.types());
+               // we read the events from the shared memory rings, if the rings exists, since
+               // the handler consumes the rings when we're notified.
+               auto types = handler.types();
+               log::line( log::debug, "ring types: ", event::ring::reader::attach( types));
+               handler.insert( ring::notify());
+
+               local::subscribe( process::handle(), std::move( types));
 
                return std::move( handler);
             }
@@ -104,6 +110,8 @@ namespace casual
             message::event::subscription::End request;
             request.process = process;
 
+            if( process == process::handle())
+               ring::reader::detach( types);
 
             local::location::domain( request, types);
             local::location::service( request, types);
@@ -0,0 +1,549 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#include "common/event/ring.h"
+
+#include "common/message/event.h"
+#include "common/communication/ipc.h"
+#include "common/communication/device.h"
+#include "common/environment.h"
+#include "common/process.h"
+#include "common/exception/handle.h"
+#include "common/code/raise.h"
+#include "common/code/casual.h"
+#include "common/result.h"
+#include "common/algorithm.h"
+#include "common/log.h"
+
+#include <atomic>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace casual
+{
+   namespace common::event::ring
+   {
+      namespace local
+      {
+         namespace
+         {
+            constexpr std::uint64_t magic = 0x676e69722d6c6163; // 'cal-ring'
+
+            //! max number of readers per ring
+            constexpr platform::size::type readers = 64;
+
+            namespace slot
+            {
+               enum State : std::uint32_t
+               {
+                  free,
+                  claimed,
+                  active,
+               };
+            } // slot
+
+            static_assert( std::atomic< std::uint64_t>::is_always_lock_free, "ring needs lock free atomics in shared memory");
+            static_assert( std::atomic< std::uint32_t>::is_always_lock_free, "ring needs lock free atomics in shared memory");
+
+            //! a reader slot, owned by the reader while `active`
+            struct Reader
+            {
+               std::atomic< std::uint32_t> state;
+               //! 1 if the reader has consumed the ring and waits for a notification
+               std::atomic< std::uint32_t> waiting;
+               std::atomic< std::int64_t> pid;
+               Uuid::uuid_type ipc;
+               std::atomic< std::uint64_t> cursor;
+               std::atomic< std::uint64_t> lost;
+            };
+
+            //! The shared memory layout, followed by the data area of `capacity` bytes.
+            //! Positions are monotonically increasing byte offsets, the offset in the data
+            //! area is `position & ( capacity - 1)`.
+            struct alignas( 64) Header
+            {
+               std::uint64_t magic;
+               std::uint64_t capacity;
+               //! the position the writer is writing up to, everything before `reserved - capacity` is intact
+               std::atomic< std::uint64_t> reserved;
+               //! the position of the end of the last written event
+               std::atomic< std::uint64_t> head;
+               Reader readers[ local::readers];
+            };
+
+            struct Record
+            {
+               //! size of the payload
+               std::uint64_t size;
+               std::int64_t type;
+               Uuid::uuid_type correlation;
+            };
+
+            constexpr std::uint64_t align( std::uint64_t size) { return ( size + 7) & ~std::uint64_t{ 7};}
+
+            std::uint64_t capacity( platform::size::type wanted)
+            {
+               std::uint64_t result = 4096;
+               while( result < static_cast< std::uint64_t>( wanted))
+                  result <<= 1;
+               return result;
+            }
+
+            class Mapping
+            {
+            public:
+               Mapping() = default;
+
+               Mapping( int descriptor, platform::size::type size) : m_size{ size}
+               {
+                  auto address = ::mmap( nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+                  ::close( descriptor);
+
+                  if( address == MAP_FAILED)
+                     code::raise::error( code::casual::invalid_path, "failed to map event ring - errno: ", errno);
+
+                  m_address = address;
+               }
+
+               ~Mapping()
+               {
+                  if( m_address)
+                     ::munmap( m_address, m_size);
+               }
+
+               Mapping( Mapping&& other) noexcept
+                  : m_address{ std::exchange( other.m_address, nullptr)}, m_size{ other.m_size} {}
+
+               Mapping& operator = ( Mapping&& other) noexcept
+               {
+                  std::swap( m_address, other.m_address);
+                  std::swap( m_size, other.m_size);
+                  return *this;
+               }
+
+               explicit operator bool() const noexcept { return m_address != nullptr;}
+
+               Header& header() const noexcept { return *static_cast< Header*>( m_address);}
+               char* data() const noexcept { return static_cast< char*>( m_address) + sizeof( Header);}
+
+               void write( std::uint64_t position, const void* source, std::uint64_t size) const noexcept
+               {
+                  auto capacity = header().capacity;
+                  auto offset = position & ( capacity - 1);
+                  auto first = std::min( size, capacity - offset);
+
+                  std::memcpy( data() + offset, source, first);
+                  std::memcpy( data(), static_cast< const char*>( source) + first, size - first);
+               }
+
+               void read( std::uint64_t position, void* destination, std::uint64_t size) const noexcept
+               {
+                  auto capacity = header().capacity;
+                  auto offset = position & ( capacity - 1);
+                  auto first = std::min( size, capacity - offset);
+
+                  std::memcpy( destination, data() + offset, first);
+                  std::memcpy( static_cast< char*>( destination) + first, data(), size - first);
+               }
+
+            private:
+               void* m_address = nullptr;
+               platform::size::type m_size = 0;
+            };
+
+            namespace notify
+            {
+               void reader( Reader& reader)
+               {
+                  if( reader.state.load() != slot::active || reader.waiting.exchange( 0) == 0)
+                     return;
+
+                  strong::ipc::id ipc{ Uuid{ reader.ipc}};
+
+                  try
+                  {
+                     // if the reader is full, it'll be notified on the next write
+                     if( ! communication::device::non::blocking::send( ipc, message::event::ring::Notify{}))
+                        reader.waiting.store( 1);
+                  }
+                  catch( ...)
+                  {
+                     if( exception::capture().code() != code::casual::communication_unavailable)
+                        throw;
+
+                     log::line( verbose::log, "event ring reader is gone: ", ipc, " - action: release slot");
+                     reader.state.store( slot::free);
+                  }
+               }
+            } // notify
+
+            namespace attached
+            {
+               struct Ring
+               {
+                  message::Type type;
+                  Mapping mapping;
+                  Reader* slot = nullptr;
+                  std::uint64_t cursor = 0;
+
+                  //! @returns true if we still own the slot
+                  bool owner() const noexcept
+                  {
+                     return slot->state.load() == slot::active && slot->pid.load() == process::id().value();
+                  }
+
+                  friend bool operator == ( const Ring& lhs, message::Type rhs) { return lhs.type == rhs;}
+               };
+
+               std::vector< Ring>& rings()
+               {
+                  static std::vector< Ring> singleton;
+                  return singleton;
+               }
+
+               //! moves available events to `device`
+               void drain( Ring& ring, communication::ipc::inbound::Device& device)
+               {
+                  auto& header = ring.mapping.header();
+                  auto head = header.head.load();
+
+                  auto overrun = [&]()
+                  {
+                     ring.slot->lost.fetch_add( 1);
+                     ring.cursor = header.head.load();
+                     log::line( log::category::error, code::casual::invalid_semantics, " event ring reader overrun - type: ", ring.type, " - action: skip to the most recent event");
+                  };
+
+                  while( ring.cursor != head)
+                  {
+                     if( head - ring.cursor > header.capacity)
+                        return overrun();
+
+                     Record record;
+                     ring.mapping.read( ring.cursor, &record, sizeof( Record));
+
+                     if( record.size > header.capacity - sizeof( Record))
+                        return overrun();
+
+                     communication::ipc::message::Complete complete{
+                        static_cast< message::Type>( record.type),
+                        strong::correlation::id{ Uuid{ record.correlation}},
+                        communication::ipc::message::Complete::payload_type( record.size)};
+
+                     ring.mapping.read( ring.cursor + sizeof( Record), complete.payload.data(), record.size);
+
+                     // make sure the writer has not started to overwrite what we've read
+                     std::atomic_thread_fence( std::memory_order_acquire);
+                     if( header.reserved.load( std::memory_order_relaxed) - ring.cursor > header.capacity)
+                        return overrun();
+
+                     ring.cursor += local::align( sizeof( Record) + record.size);
+                     device.push( std::move( complete));
+                  }
+               }
+
+               void consume( Ring& ring, communication::ipc::inbound::Device& device)
+               {
+                  while( true)
+                  {
+                     drain( ring, device);
+                     ring.slot->cursor.store( ring.cursor);
+
+                     // we wait for a notification, unless the writer has written while we've drained
+                     ring.slot->waiting.store( 1);
+                     if( ring.mapping.header().head.load() == ring.cursor)
+                        return;
+
+                     ring.slot->waiting.store( 0);
+                  }
+               }
+
+            } // attached
+
+         } // <unnamed>
+      } // local
+
+      std::filesystem::path path( message::Type type)
+      {
+         // next to the domain singleton file, so domains on the same host has their own rings
+         return environment::domain::singleton::file().parent_path() / string::compose( "event.", cast::underlying( type), ".ring");
+      }
+
+      bool eligible( message::Type type) noexcept
+      {
+         return type == message::Type::event_service_calls;
+      }
+
+      class Writer::Implementation
+      {
+      public:
+         Implementation() = default;
+
+         Implementation( message::Type type, platform::size::type capacity) : m_type{ type}
+         {
+            auto path = ring::path( type);
+            auto size = local::capacity( capacity);
+
+            // readers of a previous ring keeps their mapping of the old file, and will not get any more
+            // events from it.
+            std::filesystem::remove( path);
+
+            auto descriptor = posix::result( ::open( path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR), "open event ring: ", path);
+
+            if( ::ftruncate( descriptor, sizeof( local::Header) + size) == -1)
+            {
+               ::close( descriptor);
+               code::raise::error( code::casual::invalid_path, "failed to size event ring: ", path, " - errno: ", errno);
+            }
+
+            m_mapping = local::Mapping{ descriptor, static_cast< platform::size::type>( sizeof( local::Header) + size)};
+
+            auto& header = m_mapping.header();
+            header.capacity = size;
+
+            // the magic is the last thing, readers does not attach to a ring without it.
+            std::atomic_thread_fence( std::memory_order_release);
+            header.magic = local::magic;
+
+            log::line( verbose::log, "event ring created: ", path, " - capacity: ", size);
+         }
+
+         bool write( const communication::ipc::message::Complete& complete)
+         {
+            auto& header = m_mapping.header();
+            auto size = local::align( sizeof( local::Record) + complete.size());
+
+            if( size > header.capacity / 2)
+               return false;
+
+            auto position = header.head.load( std::memory_order_relaxed);
+
+            header.reserved.store( position + size, std::memory_order_relaxed);
+
+            // readers must not observe any of the writes below before `reserved`
+            std::atomic_thread_fence( std::memory_order_release);
+
+            local::Record record{ static_cast< std::uint64_t>( complete.size()), cast::underlying( complete.type()), {}};
+            complete.correlation().value().copy( record.correlation);
+
+            m_mapping.write( position, &record, sizeof( local::Record));
+            m_mapping.write( position + sizeof( local::Record), complete.payload.data(), complete.size());
+
+            header.head.store( position + size);
+
+            for( auto& reader : header.readers)
+               local::notify::reader( reader);
+
+            return true;
+         }
+
+         bool reader( const strong::ipc::id& ipc) const noexcept
+         {
+            return algorithm::any_of( m_mapping.header().readers, [&ipc]( auto& reader)
+            {
+               return reader.state.load() == local::slot::active && ipc.value() == reader.ipc;
+            });
+         }
+
+         bool active() const noexcept
+         {
+            return algorithm::any_of( m_mapping.header().readers, []( auto& reader){ return reader.state.load() == local::slot::active;});
+         }
+
+         void remove( strong::process::id pid)
+         {
+            for( auto& reader : m_mapping.header().readers)
+            {
+               if( reader.pid.load() == pid.value() && reader.state.load() == local::slot::active)
+                  reader.state.store( local::slot::free);
+            }
+         }
+
+         std::vector< reader::Metric> readers() const
+         {
+            auto& header = m_mapping.header();
+            std::vector< reader::Metric> result;
+
+            for( auto& reader : header.readers)
+            {
+               if( reader.state.load() != local::slot::active)
+                  continue;
+
+               auto& metric = result.emplace_back();
+               metric.pid = strong::process::id{ static_cast< platform::process::native::type>( reader.pid.load())};
+               metric.ipc = strong::ipc::id{ Uuid{ reader.ipc}};
+               metric.lag = header.head.load() - reader.cursor.load();
+               metric.lost = reader.lost.load();
+            }
+
+            return result;
+         }
+
+         explicit operator bool() const noexcept { return static_cast< bool>( m_mapping);}
+
+         friend std::ostream& operator << ( std::ostream& out, const Implementation& value)
+         {
+            if( ! value.m_mapping)
+               return out << "{}";
+
+            return stream::write( out, "{ type: ", value.m_type, ", head: ", value.m_mapping.header().head.load(), ", readers: ", value.readers(), '}');
+         }
+
+      private:
+         message::Type m_type{};
+         local::Mapping m_mapping;
+      };
+
+      Writer::Writer() = default;
+      Writer::Writer( message::Type type, platform::size::type capacity) : m_implementation{ type, capacity} {}
+      Writer::~Writer() = default;
+
+      Writer::Writer( Writer&&) noexcept = default;
+      Writer& Writer::operator = ( Writer&&) noexcept = default;
+
+      bool Writer::write( const communication::ipc::message::Complete& complete)
+      {
+         return m_implementation->write( complete);
+      }
+
+      bool Writer::reader( const strong::ipc::id& ipc) const noexcept
+      {
+         return *m_implementation && m_implementation->reader( ipc);
+      }
+
+      bool Writer::active() const noexcept
+      {
+         return *m_implementation && m_implementation->active();
+      }
+
+      void Writer::remove( strong::process::id pid)
+      {
+         if( *m_implementation)
+            m_implementation->remove( pid);
+      }
+
+      std::vector< reader::Metric> Writer::readers() const
+      {
+         if( ! *m_implementation)
+            return {};
+         return m_implementation->readers();
+      }
+
+      Writer::operator bool() const noexcept
+      {
+         return static_cast< bool>( *m_implementation);
+      }
+
+      std::ostream& operator << ( std::ostream& out, const Writer& value)
+      {
+         return out << *value.m_implementation;
+      }
+
+      namespace reader
+      {
+         std::vector< message::Type> attach( const std::vector< message::Type>& types)
+         {
+            Trace trace{ "common::event::ring::reader::attach"};
+
+            auto& rings = local::attached::rings();
+
+            for( auto type : types)
+            {
+               if( algorithm::find( rings, type))
+                  continue;
+
+               auto path = ring::path( type);
+
+               auto descriptor = ::open( path.c_str(), O_RDWR | O_CLOEXEC);
+               if( descriptor == -1)
+                  continue;
+
+               struct ::stat status{};
+               if( ::fstat( descriptor, &status) == -1 || status.st_size <= static_cast< decltype( status.st_size)>( sizeof( local::Header)))
+               {
+                  ::close( descriptor);
+                  continue;
+               }
+
+               local::attached::Ring ring{ type, local::Mapping{ descriptor, static_cast< platform::size::type>( status.st_size)}};
+               auto& header = ring.mapping.header();
+
+               if( header.magic != local::magic || sizeof( local::Header) + header.capacity != static_cast< std::uint64_t>( status.st_size))
+                  continue;
+
+               std::atomic_thread_fence( std::memory_order_acquire);
+
+               // claim a free slot
+               auto found = algorithm::find_if( header.readers, []( auto& reader)
+               {
+                  auto expected = static_cast< std::uint32_t>( local::slot::free);
+                  return reader.state.compare_exchange_strong( expected, local::slot::claimed);
+               });
+
+               if( ! found)
+               {
+                  log::line( log::category::warning, "no free reader slot in event ring: ", path, " - action: use ipc");
+                  continue;
+               }
+
+               ring.slot = &( *found);
+               ring.cursor = header.head.load();
+
+               ring.slot->pid.store( process::id().value());
+               process::handle().ipc.value().copy( ring.slot->ipc);
+               ring.slot->cursor.store( ring.cursor);
+               ring.slot->lost.store( 0);
+               ring.slot->waiting.store( 1);
+               ring.slot->state.store( local::slot::active);
+
+               log::line( verbose::log, "attached to event ring: ", path);
+
+               rings.push_back( std::move( ring));
+            }
+
+            return algorithm::transform( rings, []( auto& ring){ return ring.type;});
+         }
+
+         void detach( const std::vector< message::Type>& types)
+         {
+            Trace trace{ "common::event::ring::reader::detach"};
+
+            algorithm::container::erase_if( local::attached::rings(), [&types]( auto& ring)
+            {
+               if( ! algorithm::find( types, ring.type))
+                  return false;
+
+               if( ring.owner())
+                  ring.slot->state.store( local::slot::free);
+
+               return true;
+            });
+         }
+
+         void consume()
+         {
+            Trace trace{ "common::event::ring::reader::consume"};
+
+            auto& device = communication::ipc::inbound::device();
+
+            algorithm::container::erase_if( local::attached::rings(), [&device]( auto& ring)
+            {
+               // the writer has released our slot, we'll get events via ipc from now on
+               if( ! ring.owner())
+                  return true;
+
+               local::attached::consume( ring, device);
+               return false;
+            });
+         }
+      } // reader
+
+   } // common::event::ring
+} // casual
@@ -45,6 +45,12 @@ namespace casual
 
                   return { std::move( instance)};
                }
+
+               std::optional< Information>& singleton()
+               {
+                  static auto singleton = local::information();
+                  return singleton;
+               }
             } // <unnamed>
          } // local
 
@@ -62,8 +68,7 @@ namespace casual
 
          const std::optional< Information>& information()
          {
-            static const auto singleton = local::information();
-            return singleton;
+            return local::singleton();
          }
 
          std::string alias()
@@ -74,6 +79,14 @@ namespace casual
             return process::path().filename();
          }
 
+         namespace detail
+         {
+            void information( Information value)
+            {
+               local::singleton() = std::move( value);
+            }
+         } // detail
+
       } // instance
    } // common
 } // casual
\ No newline at end of file
@@ -71,6 +71,7 @@ namespace casual
             case Type::event_subscription_begin: return out << "event_subscription_begin";
             case Type::event_subscription_end: return out << "event_subscription_end";
             case Type::event_idle: return out << "event_idle";
+            case Type::event_ring_notify: return out << "event_ring_notify";
             case Type::event_task: return out << "event_task";
             case Type::event_sub_task: return out << "event_sub_task";
             case Type::event_error: return out << "event_error";
@@ -83,6 +84,7 @@ namespace casual
             case Type::event_domain_information: return out << "event_domain_information";
             case Type::event_service_call: return out << "event_service_call";
             case Type::event_service_calls: return out << "event_service_calls";
+            case Type::event_service_state: return out << "event_service_state";
             case Type::transaction_client_connect_request: return out << "transaction_client_connect_request";
             case Type::transaction_client_connect_reply: return out << "transaction_client_connect_reply";
             case Type::transaction_manager_connect_request: return out << "transaction_manager_connect_request";
@@ -112,8 +114,11 @@ namespace casual
             case Type::transaction_resource_involved_request: return out << "transaction_resource_involved_request";
             case Type::transaction_resource_involved_reply: return out << "transaction_resource_involved_reply";
             case Type::transaction_external_resource_involved: return out << "transaction_external_resource_involved";
+            case Type::transaction_resource_involved_notify: return out << "transaction_resource_involved_notify";
             case Type::transaction_resource_id_request: return out << "transaction_resource_id_request";
             case Type::transaction_resource_id_reply: return out << "transaction_resource_id_reply";
+            case Type::transaction_resource_batch_request: return out << "transaction_resource_batch_request";
+            case Type::transaction_resource_batch_reply: return out << "transaction_resource_batch_reply";
             case Type::queue_manager_queue_advertise: return out << "queue_manager_queue_advertise";
             case Type::queue_manager_queue_lookup_request: return out << "queue_manager_queue_lookup_request";
             case Type::queue_manager_queue_lookup_reply: return out << "queue_manager_queue_lookup_reply";
@@ -167,6 +172,10 @@ namespace casual
             case Type::gateway_domain_connect_reply: return out << "gateway_domain_connect_reply";
             case Type::gateway_domain_disconnect_request: return out << "gateway_domain_disconnect_request";
             case Type::gateway_domain_disconnect_reply: return out << "gateway_domain_disconnect_reply";
+            case Type::gateway_domain_compressed: return out << "gateway_domain_compressed";
+            case Type::gateway_domain_stripe_join: return out << "gateway_domain_stripe_join";
+            case Type::gateway_domain_stripe_fragment: return out << "gateway_domain_stripe_fragment";
+            case Type::gateway_domain_flow_credit: return out << "gateway_domain_flow_credit";
             case Type::gateway_domain_connected: return out << "gateway_domain_connected";
             case Type::domain_discovery_request: return out << "domain_discovery_request";
             case Type::domain_discovery_reply: return out << "domain_discovery_reply";
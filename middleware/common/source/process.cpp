@@ -83,7 +83,7 @@ namespace casual
 
                namespace global
                {
-                  const auto pid = strong::process::id{ ::getpid()};
+                  auto pid = strong::process::id{ ::getpid()};
                   
                } // global
 
@@ -119,6 +119,14 @@ namespace casual
             return local::handle();
          }
 
+         namespace detail
+         {
+            void reseed()
+            {
+               local::global::pid = strong::process::id{ ::getpid()};
+            }
+         } // detail
+
          void sleep( platform::time::unit time)
          {
             log::line( verbose::log, "process::sleep time: ", time);
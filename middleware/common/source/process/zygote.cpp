@@ -0,0 +1,287 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#include "common/process/zygote.h"
+
+#include "common/process.h"
+#include "common/signal.h"
+#include "common/result.h"
+#include "common/environment.h"
+#include "common/string.h"
+#include "common/log.h"
+
+#include <cstring>
+#include <optional>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+namespace casual
+{
+   namespace common::process::zygote
+   {
+      namespace local
+      {
+         namespace
+         {
+            namespace variable
+            {
+               //! the zygote's end of the socket to the spawner
+               constexpr auto descriptor = "CASUAL_ZYGOTE_DESCRIPTOR";
+            } // variable
+
+            // The protocol between the spawner and the zygote:
+            //  zygote -> spawner: pid of the zygote when it's ready
+            //  spawner -> zygote: instance index followed by the alias
+            //  zygote -> spawner: pid of the forked instance, -1 if failed
+            using pid_type = std::int64_t;
+
+            template< typename F>
+            auto retry( F&& function)
+            {
+               while( true)
+               {
+                  auto result = function();
+                  if( result != -1 || errno != EINTR)
+                     return result;
+               }
+            }
+
+            bool write( const communication::Socket& socket, const void* data, platform::size::type size)
+            {
+               return retry( [&](){ return ::send( socket.descriptor().value(), data, size, 0);}) == size;
+            }
+
+            //! @returns the pid, or 0 if the other end is closed
+            pid_type read( const communication::Socket& socket)
+            {
+               pid_type result{};
+               if( retry( [&](){ return ::recv( socket.descriptor().value(), &result, sizeof( result), 0);}) != sizeof( result))
+                  return 0;
+               return result;
+            }
+
+            bool readable( const communication::Socket& socket, platform::time::unit timeout)
+            {
+               ::pollfd descriptor{ socket.descriptor().value(), POLLIN, 0};
+               auto milliseconds = std::chrono::duration_cast< std::chrono::milliseconds>( timeout).count();
+               return retry( [&](){ return ::poll( &descriptor, 1, milliseconds);}) > 0;
+            }
+
+            void close_in_child( const communication::Socket& socket)
+            {
+               posix::result( ::fcntl( socket.descriptor().value(), F_SETFD, FD_CLOEXEC), "fcntl FD_CLOEXEC");
+            }
+
+            void reaper()
+            {
+#ifdef __linux__
+               posix::result( ::prctl( PR_SET_CHILD_SUBREAPER, 1, 0, 0, 0), "prctl PR_SET_CHILD_SUBREAPER");
+#endif
+            }
+
+            //! forks a new instance via an intermediate process, so the instance is reparented to
+            //! the spawner when the intermediate exits.
+            //! @returns the pid of the new instance in the zygote, empty in the new instance.
+            std::optional< pid_type> fork( const instance::Information& information)
+            {
+               // we don't want to handle any signals (child) while we fork
+               signal::thread::scope::Block block;
+
+               int pipe[ 2];
+               if( ::pipe( pipe) == -1)
+                  return -1;
+
+               auto intermediate = ::fork();
+
+               if( intermediate == 0)
+               {
+                  auto child = ::fork();
+
+                  if( child == 0)
+                  {
+                     ::close( pipe[ 0]);
+                     ::close( pipe[ 1]);
+
+                     // same as spawned instances, own process group
+                     ::setpgid( 0, 0);
+
+                     // we're not exec:ed, re-seed the process global state. The ipc-device is created
+                     // on demand, hence a new ipc id. Uuids are generated from the system random source,
+                     // which doesn't carry any state from the zygote.
+                     process::detail::reseed();
+                     instance::detail::information( information);
+                     signal::clear();
+
+                     return {};
+                  }
+
+                  pid_type pid = child;
+                  retry( [&](){ return ::write( pipe[ 1], &pid, sizeof( pid));});
+                  ::_exit( child == -1 ? EXIT_FAILURE : EXIT_SUCCESS);
+               }
+
+               ::close( pipe[ 1]);
+
+               pid_type result = -1;
+
+               if( intermediate != -1)
+               {
+                  if( retry( [&](){ return ::read( pipe[ 0], &result, sizeof( result));}) != sizeof( result))
+                     result = -1;
+
+                  retry( [&](){ return ::waitpid( intermediate, nullptr, 0);});
+               }
+
+               ::close( pipe[ 0]);
+
+               return result;
+            }
+
+         } // <unnamed>
+      } // local
+
+      bool supported() noexcept
+      {
+#ifdef __linux__
+         return true;
+#else
+         return false;
+#endif
+      }
+
+      Handle::Handle( const std::filesystem::path& path, std::vector< std::string> arguments, std::vector< environment::Variable> environment)
+      {
+         Trace trace{ "common::process::zygote::Handle::Handle"};
+
+         local::reaper();
+
+         int descriptors[ 2];
+         posix::result( ::socketpair( AF_UNIX, SOCK_SEQPACKET, 0, descriptors), "socketpair");
+
+         m_socket = communication::Socket{ strong::socket::id{ descriptors[ 0]}};
+         local::close_in_child( m_socket);
+
+         // our copy of the zygote's end is closed when we're done
+         communication::Socket zygote{ strong::socket::id{ descriptors[ 1]}};
+
+         environment.emplace_back( string::compose( local::variable::descriptor, '=', descriptors[ 1]));
+
+         m_pid = process::spawn( path.string(), std::move( arguments), std::move( environment));
+
+         log::line( log::debug, "process::zygote spawned: ", *this);
+      }
+
+      bool Handle::ready()
+      {
+         if( m_ready)
+            return true;
+
+         if( m_socket.empty() || ! local::readable( m_socket, {}))
+            return false;
+
+         if( local::read( m_socket) <= 0)
+         {
+            log::line( log::debug, "process::zygote failed to start: ", *this);
+            m_socket = {};
+            return false;
+         }
+
+         return m_ready = true;
+      }
+
+      strong::process::id Handle::fork( const instance::Information& information)
+      {
+         Trace trace{ "common::process::zygote::Handle::fork"};
+
+         if( ! ready())
+            return {};
+
+         std::vector< char> request( sizeof( local::pid_type) + information.alias.size());
+         local::pid_type index = information.index;
+         std::memcpy( request.data(), &index, sizeof( index));
+         std::memcpy( request.data() + sizeof( index), information.alias.data(), information.alias.size());
+
+         if( ! local::write( m_socket, request.data(), request.size()) || ! local::readable( m_socket, platform::process::zygote::timeout))
+         {
+            log::line( log::category::error, code::casual::invalid_semantics, " zygote failed to respond: ", *this, " - action: discard zygote");
+            m_socket = {};
+            return {};
+         }
+
+         auto pid = local::read( m_socket);
+
+         if( pid <= 0)
+         {
+            log::line( log::category::error, code::casual::invalid_semantics, " zygote failed to fork: ", *this, " - action: discard zygote");
+            m_socket = {};
+            return {};
+         }
+
+         log::line( log::debug, "process::zygote forked pid: ", pid);
+
+         return strong::process::id{ static_cast< platform::process::native::type>( pid)};
+      }
+
+      void serve()
+      {
+         auto value = environment::variable::consume( local::variable::descriptor, {});
+
+         if( value.empty())
+            return;
+
+         Trace trace{ "common::process::zygote::serve"};
+
+         communication::Socket socket{ strong::socket::id{ std::stoi( value)}};
+         local::close_in_child( socket);
+
+         // we're loaded and initialized, let the spawner know
+         {
+            local::pid_type pid = process::id().value();
+            local::write( socket, &pid, sizeof( pid));
+         }
+
+         std::vector< char> request( sizeof( local::pid_type) + platform::size::max::path);
+
+         while( true)
+         {
+            auto count = local::retry( [&](){ return ::recv( socket.descriptor().value(), request.data(), request.size(), 0);});
+
+            if( count < static_cast< decltype( count)>( sizeof( local::pid_type)))
+            {
+               // the spawner has discarded us, or is gone.
+               log::line( verbose::log, "zygote socket closed - action: exit");
+               std::exit( EXIT_SUCCESS);
+            }
+
+            instance::Information information;
+            {
+               local::pid_type index{};
+               std::memcpy( &index, request.data(), sizeof( index));
+               information.index = index;
+               information.alias.assign( request.data() + sizeof( index), count - sizeof( index));
+            }
+
+            auto pid = local::fork( information);
+
+            // we're the new instance
+            if( ! pid)
+               return;
+
+            log::line( verbose::log, "forked: ", information, " - pid: ", pid.value());
+            local::write( socket, &pid.value(), sizeof( local::pid_type));
+         }
+      }
+
+   } // common::process::zygote
+} // casual
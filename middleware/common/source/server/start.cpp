@@ -11,6 +11,7 @@
 #include "common/server/handle/call.h"
 #include "common/server/handle/conversation.h"
 #include "common/message/handle.h"
+#include "common/process/zygote.h"
 
 namespace casual
 {
@@ -67,6 +68,9 @@ namespace casual
                   {
                      Trace trace{ "common::server::start"};
 
+                     // if we're spawned as a zygote, we only get back here in the forked instances
+                     process::zygote::serve();
+
                      auto& inbound = communication::ipc::inbound::device();
 
                      struct 
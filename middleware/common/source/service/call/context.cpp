@@ -11,6 +11,7 @@
 
 #include "common/communication/ipc.h"
 #include "common/communication/instance.h"
+#include "common/communication/select.h"
 
 #include "common/log.h"
 
@@ -20,6 +21,7 @@
 #include "common/environment.h"
 #include "common/flag.h"
 #include "common/signal.h"
+#include "common/timer/descriptor.h"
 
 #include "common/code/raise.h"
 #include "common/code/xatmi.h"
@@ -118,7 +120,7 @@ namespace casual
                   {
                      log::line( log::debug, "descriptor reservation - flags: ", flags);
 
-                     auto& descriptor = state.pending.reserve( message.correlation);
+                     auto descriptor = state.pending.reserve( message.correlation);
 
                      auto& transaction = common::transaction::context().current();
 
@@ -132,6 +134,19 @@ namespace casual
                      return Reply{ descriptor.descriptor, std::move( message) };
                   }
                }
+
+               //! restricts the timeout of the service to the time remaining until `deadline`, so the callee
+               //! does not work on a call the caller has given up on.
+               void timeout( message::service::Timeout& timeout, const platform::time::point::type& deadline)
+               {
+                  // the instance is reserved, so we call it even if the deadline has passed, with the least timeout.
+                  auto remaining = std::max( 
+                     std::chrono::duration_cast< platform::time::unit>( deadline - platform::time::clock::type::now()), 
+                     platform::time::unit{ 1});
+
+                  if( timeout.duration == platform::time::unit::zero() || remaining < timeout.duration)
+                     timeout.duration = remaining;
+               }
             } // prepare
          } // <unnamed>
       } // local
@@ -140,10 +155,20 @@ namespace casual
 
       
       descriptor_type Context::async( service::Lookup&& service, common::buffer::payload::Send buffer, service::header::Fields header, async::Flags flags)
+      {
+         return async( std::move( service), std::move( buffer), std::move( header), flags, {});
+      }
+
+      descriptor_type Context::async( 
+         service::Lookup&& service, 
+         common::buffer::payload::Send buffer, 
+         service::header::Fields header, 
+         async::Flags flags, 
+         std::optional< platform::time::point::type> deadline)
       {
          Trace trace( "service::call::Context::async lookup");
 
-         log::line( log::debug, "service: ", service, ", buffer: ", buffer, " flags: ", flags);
+         log::line( log::debug, "service: ", service, ", buffer: ", buffer, " flags: ", flags, ", deadline: ", deadline);
 
          auto start = platform::time::clock::type::now();
 
@@ -171,6 +196,9 @@ namespace casual
             prepared.message.service = target.service;
             prepared.message.pending = target.pending;
 
+            if( deadline)
+               local::prepare::timeout( prepared.message.service.timeout, *deadline);
+
             log::line( log::debug, "async - message: ", prepared.message);
 
             communication::device::blocking::send( target.process.ipc, prepared.message);
@@ -241,7 +269,7 @@ namespace casual
             }
             else
             {
-               auto& pending = m_state.pending.get( descriptor);
+               auto pending = m_state.pending.get( descriptor);
 
                if( ! local::receive( reply, flags, pending.correlation))
                   code::raise::error( code::xatmi::no_message);
@@ -306,6 +334,156 @@ namespace casual
       }
 
 
+      std::vector< scatter::Result> Context::scatter( 
+         std::vector< scatter::Request> requests, 
+         async::Flags flags, 
+         std::optional< platform::time::point::type> deadline)
+      {
+         Trace trace( "service::call::Context::scatter");
+         log::line( log::debug, "requests: ", requests.size(), ", flags: ", flags, ", deadline: ", deadline);
+
+         if( flags.exist( async::Flag::no_reply))
+            code::raise::error( code::xatmi::argument, "TPNOREPLY is not valid for scatter");
+
+         // the calls shares the earliest of the explicit deadline and the transaction deadline
+         if( auto& transaction = common::transaction::Context::instance().current(); transaction && ! flags.exist( async::Flag::no_transaction))
+         {
+            if( transaction.deadline && ( ! deadline || transaction.deadline < deadline))
+               deadline = transaction.deadline;
+         }
+
+         std::vector< scatter::Result> result( requests.size());
+
+         // send all lookups before we wait for any of them, hence the service-manager
+         // can work on all of them while we wait for the first one.
+         std::vector< service::Lookup> lookups;
+         lookups.reserve( requests.size());
+
+         for( auto index = 0UL; index < requests.size(); ++index)
+         {
+            try
+            {
+               lookups.emplace_back( requests[ index].service, service::Lookup::Context::regular, deadline);
+            }
+            catch( ...)
+            {
+               result[ index].code = exception::capture().code();
+               lookups.emplace_back();
+            }
+         }
+
+         for( auto index = 0UL; index < requests.size(); ++index)
+         {
+            if( result[ index].code)
+               continue;
+
+            try
+            {
+               // the service-manager lookup and the call are bound by the deadline
+               result[ index].descriptor = async( std::move( lookups[ index]), requests[ index].buffer, service::header::fields(), flags, deadline);
+               m_state.pending.deadline( result[ index].descriptor, deadline);
+            }
+            catch( ...)
+            {
+               result[ index].code = exception::capture().code();
+            }
+         }
+
+         log::line( verbose::log, "scatter - dispatched: ", algorithm::count_if( result, []( auto& r){ return r.descriptor != 0;}));
+
+         return result;
+      }
+
+      gather::Result Context::gather( const std::vector< descriptor_type>& descriptors, reply::Flags flags)
+      {
+         Trace trace( "service::call::Context::gather");
+         log::line( log::debug, "descriptors: ", descriptors, ", flags: ", flags);
+
+         if( descriptors.empty())
+            code::raise::error( code::xatmi::descriptor, "no descriptors to gather");
+
+         std::vector< correlation_type> correlations;
+         correlations.reserve( descriptors.size());
+
+         std::optional< platform::time::point::type> deadline;
+
+         for( auto descriptor : descriptors)
+         {
+            auto pending = m_state.pending.get( descriptor);
+            correlations.push_back( pending.correlation);
+
+            if( pending.deadline && ( ! deadline || pending.deadline < deadline))
+               deadline = pending.deadline;
+         }
+
+         auto predicate = [&correlations]( auto& complete)
+         {
+            return complete.type() == message::Type::service_reply && algorithm::find( correlations, complete.correlation());
+         };
+
+         auto& device = communication::ipc::inbound::device();
+
+         auto complete = [&]()
+         {
+            if( flags.exist( reply::Flag::no_block))
+               return device.select( predicate, communication::device::policy::non::blocking( device));
+
+            if( ! deadline || flags.exist( reply::Flag::no_time))
+               return communication::device::blocking::select( device, predicate);
+
+            // the deadline is a timer descriptor that we select on together with the inbound
+            // device, no process wide SIGALRM is involved.
+            timer::Descriptor timer;
+            timer.set( *deadline);
+
+            communication::select::Directive directive;
+            directive.read.add( device.connector().descriptor());
+            directive.read.add( timer.descriptor());
+
+            while( true)
+            {
+               // take care of replies that are cached or already in the socket
+               if( auto found = device.select( predicate, communication::device::policy::non::blocking( device)))
+                  return found;
+
+               try
+               {
+                  auto ready = communication::select::dispatch::detail::select( directive);
+
+                  if( algorithm::find( ready.read, timer.descriptor()) && timer.consume())
+                     code::raise::error( code::xatmi::timeout, "gather - deadline has passed: ", deadline);
+               }
+               catch( ...)
+               {
+                  communication::device::handle::error();
+               }
+            }
+         }();
+
+         if( ! complete)
+            code::raise::error( code::xatmi::no_message);
+
+         message::service::call::Reply reply;
+         serialize::native::complete( complete, reply);
+
+         log::line( log::debug, "reply: ", reply);
+
+         gather::Result result;
+         result.descriptor = descriptors[ std::distance( std::begin( correlations), std::begin( algorithm::find( correlations, reply.correlation)))];
+
+         // We unreserve pending (at end of scope, regardless of outcome)
+         auto discard = execute::scope( [&](){ m_state.pending.unreserve( result.descriptor);});
+
+         // Update transaction state
+         common::transaction::Context::instance().update( reply);
+
+         result.user = reply.code.user;
+         result.code = reply.code.result;
+         result.buffer = std::move( reply.buffer);
+
+         return result;
+      }
+
       void Context::cancel( descriptor_type descriptor)
       {
          m_state.pending.discard( descriptor);
@@ -337,7 +515,7 @@ namespace casual
          }
          else
          {
-            auto& correlation = m_state.pending.get( descriptor).correlation;
+            auto correlation = m_state.pending.get( descriptor).correlation;
 
             return local::receive( reply, flags, correlation);
          }
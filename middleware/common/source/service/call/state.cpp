@@ -19,90 +19,160 @@ namespace casual
    namespace common::service::call
    {
 
+      namespace local
+      {
+         namespace
+         {
+            namespace descriptor
+            {
+               // descriptor: [ generation | index + 1 ], keeps it positive, non-zero and below 2^30
+               // regardless of how many calls the process makes
+               constexpr descriptor_type index_bits = 20;
+               constexpr descriptor_type index_mask = ( 1 << index_bits) - 1;
+               constexpr descriptor_type generation_mask = ( 1 << 10) - 1;
+
+               constexpr descriptor_type make( platform::size::type index, descriptor_type generation) noexcept
+               {
+                  return ( generation << index_bits) | static_cast< descriptor_type>( index + 1);
+               }
+
+               constexpr platform::size::type index( descriptor_type descriptor) noexcept
+               {
+                  return ( descriptor & index_mask) - 1;
+               }
+
+               constexpr descriptor_type next( descriptor_type descriptor) noexcept
+               {
+                  return make( index( descriptor), ( ( descriptor >> index_bits) + 1) & generation_mask);
+               }
+
+               static_assert( index( make( 0, 0)) == 0 && make( 0, 0) == 1);
+               static_assert( index( next( make( 42, generation_mask))) == 42 && next( make( 42, generation_mask)) == 43);
+
+            } // descriptor
+         } // <unnamed>
+      } // local
+
       State::Pending::Pending()
-         : m_descriptors{
-         { 1, false },
-         { 2, false },
-         { 3, false },
-         { 4, false },
-         { 5, false },
-         { 6, false },
-         { 7, false },
-         { 8, false }}
-      {}
-
-      State::Pending::Descriptor& State::Pending::reserve( const correlation_type& correlation)
       {
-         auto& descriptor = reserve();
+         constexpr platform::size::type initial = 8;
 
-         descriptor.correlation = correlation;
+         m_correlations.reserve( initial);
 
-         return descriptor;
+         for( platform::size::type index = 0; index < initial; ++index)
+         {
+            m_slots.emplace_back( local::descriptor::make( index, 0), false);
+            m_free.push_back( index);
+         }
       }
 
-      State::Pending::Descriptor& State::Pending::reserve()
+      State::Pending::Descriptor State::Pending::reserve( const correlation_type& correlation)
       {
-         auto found = algorithm::find_if( m_descriptors, predicate::negate( std::mem_fn( &Descriptor::active)));
+         lock_type lock{ m_mutex};
 
-         if( found)
-         {
-            found->active = true;
-            found->target = {};
-            return *found;
-         }
-         else
+         if( m_free.empty())
          {
-            m_descriptors.emplace_back( m_descriptors.back().descriptor + 1, true);
-            return m_descriptors.back();
+            if( static_cast< descriptor_type>( m_slots.size()) >= local::descriptor::index_mask)
+               code::raise::error( code::xatmi::limit, "maximum number of pending descriptors reached: ", m_slots.size());
+
+            m_free.push_back( m_slots.size());
+            m_slots.emplace_back( local::descriptor::make( m_slots.size(), 0), false);
          }
+
+         // the least recently unreserved slot is reused, so the generations of the slots
+         // wraps as seldom as possible
+         auto& descriptor = m_slots[ m_free.front()];
+         m_correlations.emplace( correlation, m_free.front());
+         m_free.pop_front();
+
+         descriptor.active = true;
+         descriptor.correlation = correlation;
+         descriptor.target = {};
+         descriptor.deadline = {};
+
+         return descriptor;
+      }
+
+      std::optional< platform::size::type> State::Pending::index( descriptor_type descriptor) const noexcept
+      {
+         auto index = local::descriptor::index( descriptor);
+
+         if( descriptor < 1 || index < 0 || index >= static_cast< platform::size::type>( m_slots.size()))
+            return {};
+
+         // stale descriptor from an earlier generation of the slot
+         if( m_slots[ index].descriptor != descriptor)
+            return {};
+
+         return index;
+      }
+
+      platform::size::type State::Pending::active_index( descriptor_type descriptor) const
+      {
+         auto index = this->index( descriptor);
+         if( ! index || ! m_slots[ *index].active)
+            code::raise::error( code::xatmi::descriptor, "invalid call descriptor: ", descriptor);
+
+         return *index;
       }
 
       void State::Pending::unreserve( descriptor_type descriptor)
       {
-         if( auto found = algorithm::find( m_descriptors, descriptor))
-            found->active = false;
-         else
+         lock_type lock{ m_mutex};
+
+         auto index = this->index( descriptor);
+         
+         if( ! index)
             code::raise::error( code::xatmi::descriptor, "invalid call descriptor: ", descriptor);
+
+         auto& slot = m_slots[ *index];
+
+         if( slot.active)
+         {
+            m_correlations.erase( slot.correlation);
+            m_free.push_back( *index);
+
+            slot.active = false;
+            slot.descriptor = local::descriptor::next( descriptor);
+         }
       }
 
       bool State::Pending::active( descriptor_type descriptor) const
       {
-         if( auto found = algorithm::find( m_descriptors, descriptor))
-            return found->active;
+         lock_type lock{ m_mutex};
+
+         if( auto index = this->index( descriptor))
+            return m_slots[ *index].active;
          
          return false;
       }
 
-      const State::Pending::Descriptor& State::Pending::get( descriptor_type descriptor) const
+      State::Pending::Descriptor State::Pending::get( descriptor_type descriptor) const
       {
-         auto found = algorithm::find( m_descriptors, descriptor);
-         if( ! found || ! found->active)
-            code::raise::error( code::xatmi::descriptor, "invalid call descriptor: ", descriptor);
-
-         return *found;
+         lock_type lock{ m_mutex};
+         return m_slots[ active_index( descriptor)];
       }
 
-      State::Pending::Descriptor& State::Pending::get( descriptor_type descriptor)
+      State::Pending::Descriptor State::Pending::get( const correlation_type& correlation) const
       {
-         auto found = algorithm::find( m_descriptors, descriptor);
-         if( ! found || ! found->active)
-            code::raise::error( code::xatmi::descriptor, "invalid call descriptor: ", descriptor);
+         lock_type lock{ m_mutex};
 
-         return *found;
+         auto found = m_correlations.find( correlation);
+         if( found == std::end( m_correlations))
+            code::raise::error( code::xatmi::descriptor, "failed to locate pending from correlation: ", correlation);
+            
+         return m_slots[ found->second];
       }
 
-      const State::Pending::Descriptor& State::Pending::get( const correlation_type& correlation) const
+      void State::Pending::deadline( descriptor_type descriptor, std::optional< platform::time::point::type> deadline)
       {
-         auto found = algorithm::find_if( m_descriptors, [&]( const auto& d){ return d.correlation == correlation;});
-         if( ! ( found && found->active))
-            code::raise::error( code::xatmi::descriptor, "failed to locate pending from correlation: ", correlation);
-            
-         return *found;
+         lock_type lock{ m_mutex};
+         m_slots[ active_index( descriptor)].deadline = std::move( deadline);
       }
 
       void State::Pending::discard( descriptor_type descriptor)
       {
-         const auto& holder = get( descriptor);
+         auto holder = get( descriptor);
 
          // Can't be associated with a transaction
          if( common::transaction::Context::instance().associated( holder.correlation))
@@ -116,7 +186,13 @@ namespace casual
 
       bool State::Pending::empty() const
       {
-         return algorithm::all_of( m_descriptors, predicate::negate( std::mem_fn( &Descriptor::active)));
+         return size() == 0;
+      }
+
+      platform::size::type State::Pending::size() const
+      {
+         lock_type lock{ m_mutex};
+         return m_slots.size() - m_free.size();
       }
 
 
@@ -7,12 +7,40 @@
 #include "common/service/lookup.h"
 
 #include "common/communication/instance.h"
+#include "common/environment.h"
 
 
 namespace casual
 {
    namespace common::service
    {
+      namespace lookup
+      {
+         namespace local
+         {
+            namespace
+            {
+               auto priority()
+               {
+                  using Priority = message::service::lookup::Request::Priority;
+                  auto value = environment::variable::get( environment::variable::name::service::priority, std::string{ "regular"});
+
+                  if( value == "interactive")
+                     return Priority::interactive;
+                  if( value == "batch")
+                     return Priority::batch;
+                  return Priority::regular;
+               }
+            } // <unnamed>
+         } // local
+
+         message::service::lookup::Request::Priority priority()
+         {
+            static const auto priority = local::priority();
+            return priority;
+         }
+      } // lookup
+
       namespace detail
       {
          Lookup::Lookup() noexcept {};
@@ -26,6 +54,7 @@ namespace casual
             request.requested = m_service;
             request.context = context;
             request.deadline = std::move( deadline);
+            request.priority = lookup::priority();
 
             m_correlation = communication::device::blocking::send( communication::instance::outbound::service::manager::device(), request);
          }
@@ -107,6 +136,10 @@ namespace casual
                case State::busy:
                   m_reply = std::move( reply);
                   break;
+               case State::rejected:
+                  m_correlation = {};
+                  code::raise::error( code::xatmi::no_message, "lookup: ", *this, " - projected wait exceeds deadline");
+                  break;
             }
             return false;
          }
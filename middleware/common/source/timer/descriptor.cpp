@@ -0,0 +1,154 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#include "common/timer/descriptor.h"
+
+#include "common/result.h"
+#include "common/log.h"
+
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <sys/event.h>
+#else
+#include <sys/timerfd.h>
+#endif
+
+namespace casual
+{
+   namespace common::timer
+   {
+      namespace local
+      {
+         namespace
+         {
+#ifdef __APPLE__
+            constexpr std::uintptr_t identifier = 1;
+
+            auto create()
+            {
+               return strong::file::descriptor::id{ posix::result( ::kqueue(), "timer::Descriptor::create")};
+            }
+
+            void set( strong::file::descriptor::id descriptor, platform::time::point::type deadline)
+            {
+               auto offset = std::max(
+                  std::chrono::duration_cast< std::chrono::microseconds>( deadline - platform::time::clock::type::now()),
+                  std::chrono::microseconds{ 0});
+
+               struct kevent event{};
+               EV_SET( &event, identifier, EVFILT_TIMER, EV_ADD | EV_ONESHOT, NOTE_USECONDS, offset.count(), nullptr);
+               posix::result( ::kevent( descriptor.value(), &event, 1, nullptr, 0, nullptr), "timer::Descriptor::set");
+            }
+
+            void unset( strong::file::descriptor::id descriptor)
+            {
+               struct kevent event{};
+               EV_SET( &event, identifier, EVFILT_TIMER, EV_DELETE, 0, 0, nullptr);
+               // ENOENT if the timer has already fired
+               posix::alternative( ::kevent( descriptor.value(), &event, 1, nullptr, 0, nullptr), -1, std::errc::no_such_file_or_directory);
+            }
+
+            bool consume( strong::file::descriptor::id descriptor)
+            {
+               struct kevent event{};
+               ::timespec zero{};
+               return posix::result( ::kevent( descriptor.value(), nullptr, 0, &event, 1, &zero), "timer::Descriptor::consume") > 0;
+            }
+#else
+            auto create()
+            {
+               return strong::file::descriptor::id{ posix::result(
+                  ::timerfd_create( CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC), "timer::Descriptor::create")};
+            }
+
+            void settime( strong::file::descriptor::id descriptor, const ::itimerspec& value)
+            {
+               posix::result( ::timerfd_settime( descriptor.value(), TFD_TIMER_ABSTIME, &value, nullptr), "timer::Descriptor::set");
+            }
+
+            void set( strong::file::descriptor::id descriptor, platform::time::point::type deadline)
+            {
+               auto since = deadline.time_since_epoch();
+               auto seconds = std::chrono::duration_cast< std::chrono::seconds>( since);
+
+               ::itimerspec value{};
+               value.it_value.tv_sec = seconds.count();
+               value.it_value.tv_nsec = std::chrono::duration_cast< std::chrono::nanoseconds>( since - seconds).count();
+
+               // all zeros would disarm the timer
+               if( value.it_value.tv_sec <= 0 && value.it_value.tv_nsec <= 0)
+                  value.it_value.tv_nsec = 1;
+
+               settime( descriptor, value);
+            }
+
+            void unset( strong::file::descriptor::id descriptor)
+            {
+               settime( descriptor, ::itimerspec{});
+            }
+
+            bool consume( strong::file::descriptor::id descriptor)
+            {
+               std::uint64_t expirations{};
+               return posix::alternative(
+                  ::read( descriptor.value(), &expirations, sizeof( expirations)),
+                  -1,
+                  std::errc::resource_unavailable_try_again, std::errc::operation_would_block) > 0;
+            }
+#endif
+         } // <unnamed>
+      } // local
+
+      Descriptor::Descriptor() : m_descriptor{ local::create()}
+      {
+         log::line( verbose::log, "timer::Descriptor created: ", m_descriptor);
+      }
+
+      Descriptor::~Descriptor()
+      {
+         if( m_descriptor)
+            posix::log::result( ::close( m_descriptor.value()), "timer::Descriptor close - descriptor: ", m_descriptor);
+      }
+
+      Descriptor::Descriptor( Descriptor&& other) noexcept
+         : m_descriptor{ std::exchange( other.m_descriptor, {})}, m_deadline{ std::exchange( other.m_deadline, {})}
+      {}
+
+      Descriptor& Descriptor::operator = ( Descriptor&& other) noexcept
+      {
+         std::swap( m_descriptor, other.m_descriptor);
+         std::swap( m_deadline, other.m_deadline);
+         return *this;
+      }
+
+      void Descriptor::set( platform::time::point::type deadline)
+      {
+         local::set( m_descriptor, deadline);
+         m_deadline = deadline;
+      }
+
+      void Descriptor::unset()
+      {
+         if( ! m_deadline)
+            return;
+
+         local::unset( m_descriptor);
+         m_deadline.reset();
+      }
+
+      bool Descriptor::consume()
+      {
+         if( ! local::consume( m_descriptor))
+            return false;
+
+         m_deadline.reset();
+         return true;
+      }
+
+   } // common::timer
+} // casual
@@ -223,6 +223,30 @@ namespace casual
 
                      return std::move( reply.involved);
                   }
+
+                  //! notifies TM about involved resources not yet known by the TM, 'fire and forget'.
+                  void notify( Transaction& transaction)
+                  {
+                     if( ! transaction)
+                        return;
+
+                     auto involved = transaction.unnotified();
+
+                     if( involved.empty())
+                        return;
+
+                     Trace trace{ "transaction::local::resource::notify"};
+
+                     message::transaction::resource::involved::Notify message;
+                     message.process = process::handle();
+                     message.trid = transaction.trid;
+                     message.involved = std::move( involved);
+
+                     log::line( log::category::transaction, "involved notify: ", message);
+
+                     communication::device::blocking::send( communication::instance::outbound::transaction::manager::device(), message);
+                     transaction.notified();
+                  }
                } // resource
 
                auto raise_if_not_ok = []( auto code, auto&& context)
@@ -429,22 +453,21 @@ namespace casual
                   }
 
 
-                  // Notify TM about resources involved in this transaction
-                  /*
-                  {
-                     auto& transaction = found.front();
-                     auto involved = resources();
-                     algorithm::append( transaction.resources, involved);
-
-                     if( transaction && ! involved.empty())
-                     {
-                        Context::involved( transaction.trid, std::move( involved));
-                     }
-                  }
-                  */
-
                   // end resource
                   resources_end( *not_owner, flag::xa::Flag::success);
+
+                  // The fixed resources are notified when they're started. Notify TM about the rest (if any), the 
+                  // notification is in TM's queue before the caller gets the reply, hence before any commit/rollback 
+                  // from the owner.
+                  try
+                  {
+                     local::resource::notify( *not_owner);
+                  }
+                  catch( ...)
+                  {
+                     result.state = message::service::Transaction::State::error;
+                     log::line( log::category::error, exception::capture(), " failed to notify TM about involved resources - trid: ", not_owner->trid);
+                  }
                }
 
 
@@ -483,8 +506,10 @@ namespace casual
                if( transaction.local())
                   return code::ax::ok;
 
-               // we need to correlate with TM
-               auto involved = local::resource::involved( transaction.trid, { rmid});
+               // we need to correlate with TM, the rm needs to know if it should join. We take the opportunity
+               // to notify the TM about the other involved resources as well.
+               auto involved = local::resource::involved( transaction.trid, transaction.unnotified());
+               transaction.notified();
                return algorithm::find( involved, rmid).empty() ? code::ax::ok : code::ax::join;
             }
 
@@ -934,27 +959,25 @@ namespace casual
 
             
 
-            if( transaction.local())
-            {
-               log::line( log::category::transaction, "local transaction: ", transaction, " - flags: ", flags);
-               
-               // local transaction, we don't need to corralate with TM
-               check_results( algorithm::transform( m_resources.fixed, start_functor( transaction.involved())));
-            }
-            else 
-            {
-               log::line( log::category::transaction, "distributed transaction: ", transaction, " - flags: ", flags);
-
-               // coordinate with TM, so we know if we need to add `join` flag or not.
-               auto involved = local::resource::involved( transaction.trid, 
-                  algorithm::transform( m_resources.fixed, transform_rmid));
+            log::line( log::category::transaction, "transaction: ", transaction, " - flags: ", flags);
 
-               check_results( algorithm::transform( m_resources.fixed, start_functor( involved)));
-            }
+            // what's involved before this start, which decides if we join
+            auto involved = transaction.involved();
 
             // involve all static resources
             transaction.involve( algorithm::transform( m_resources.fixed, transform_rmid));
 
+            // A distributed transaction: we notify the TM before the branches are started in the rm:s, 
+            // so the TM knows about them even if we crash before the service returns. If we crash before
+            // xa_start, the rm:s reply XAER_NOTA to the TM, which is treated as read only. 
+            // The owner piggy-back it's involvement on the commit/rollback request.
+            if( ! transaction.local())
+               local::resource::notify( transaction);
+
+            // We don't correlate with TM. If the rm is involved by another process, the rm reports
+            // duplicate xid, and the resource tries to join instead (see Resource::start).
+            check_results( algorithm::transform( m_resources.fixed, start_functor( involved)));
+
             // TODO semantics: throw if some of the rm:s report an error?
             //   don't think so. prepare, commit or rollback will take care of eventual errors.
          }
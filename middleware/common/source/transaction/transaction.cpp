@@ -40,6 +40,16 @@ namespace casual
             algorithm::append_unique_value( id, m_involved);
          }
 
+         std::vector< strong::resource::id> Transaction::unnotified() const
+         {
+            return { std::next( std::begin( m_involved), m_notified), std::end( m_involved)};
+         }
+
+         void Transaction::notified()
+         {
+            m_notified = m_involved.size();
+         }
+
          bool Transaction::associate_dynamic( strong::resource::id id)
          {
             return algorithm::append_unique_value( id, m_dynamic); 
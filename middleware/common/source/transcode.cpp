@@ -13,6 +13,7 @@
 #include "common/exception/handle.h"
 
 #include "common/result.h"
+#include "common/algorithm.h"
 
 #include <cppcodec/base64_rfc4648.hpp>
 
@@ -30,6 +31,15 @@
 #include <cerrno>
 #include <cstdlib>
 #include <cassert>
+#include <cstring>
+#include <cstdint>
+#include <numeric>
+#include <memory>
+#include <vector>
+
+#if defined( __SSE2__)
+#include <emmintrin.h>
+#endif
 
 
 namespace casual
@@ -88,14 +98,44 @@ namespace casual
          {
             namespace
             {
+               namespace ascii
+               {
+                  //! @return true if all bytes in @p value are 7-bit, and hence is represented
+                  //!  the same in all ascii-compatible codesets
+                  bool seven_bit( const std::string& value)
+                  {
+                     auto first = value.data();
+                     const auto last = first + value.size();
+
+#if defined( __SSE2__)
+                     for( ; last - first >= 16; first += 16)
+                        if( _mm_movemask_epi8( _mm_loadu_si128( reinterpret_cast< const __m128i*>( first))) != 0)
+                           return false;
+#endif
+                     constexpr std::uint64_t high = 0x8080808080808080;
+
+                     for( ; last - first >= 8; first += 8)
+                     {
+                        std::uint64_t word;
+                        std::memcpy( &word, first, sizeof( word));
+                        if( word & high)
+                           return false;
+                     }
+
+                     return std::all_of( first, last, []( auto c){ return ( c & 0x80) == 0;});
+                  }
+               } // ascii
+
                class converter
                {
                public:
                   converter( std::string_view source, std::string_view target)
-                     : m_descriptor( iconv_open( target.data(), source.data()))
+                     : m_source{ source}, m_target{ target}, m_descriptor( iconv_open( m_target.c_str(), m_source.c_str()))
                   {
                      if( m_descriptor == reinterpret_cast< iconv_t>( -1))
                         code::raise::error( code::casual::failed_transcoding, "iconv_open - errc: ", code::system::last::error());
+
+                     m_ascii_compatible = probe();
                   }
 
                   ~converter()
@@ -103,16 +143,39 @@ namespace casual
                      posix::log::result( iconv_close( m_descriptor), "iconv_close");
                   }
 
+                  converter( const converter&) = delete;
+                  converter& operator = ( const converter&) = delete;
+
                   std::string transcode( const std::string& value) const
                   {
+                     // 7-bit is the same in both codesets, no need to involve iconv
+                     if( m_ascii_compatible && ascii::seven_bit( value))
+                        return value;
+
+                     return convert( value);
+                  }
+
+                  bool equal( std::string_view source, std::string_view target) const noexcept
+                  {
+                     return m_source == source && m_target == target;
+                  }
+
+               private:
+
+                  std::string convert( const std::string& value) const
+                  {
+                     // reset the conversion state, the descriptor is reused between calls
+                     iconv( m_descriptor, nullptr, nullptr, nullptr, nullptr);
+
                      auto source = const_cast<char*>( value.c_str());
                      auto size = value.size();
 
                      std::string result;
+                     result.reserve( value.size());
 
                      do
                      {
-                        char buffer[32];
+                        char buffer[ 256];
                         auto left = sizeof buffer;
                         char* target = buffer;
 
@@ -135,8 +198,27 @@ namespace casual
                      return result;
                   }
 
-               private:
+                  //! @return true if all 7-bit characters are represented the same in source and target
+                  bool probe() const
+                  {
+                     std::string ascii( 127, '\0');
+                     std::iota( std::begin( ascii), std::end( ascii), 1);
+
+                     try
+                     {
+                        return convert( ascii) == ascii;
+                     }
+                     catch( ...)
+                     {
+                        exception::sink();
+                        return false;
+                     }
+                  }
+
+                  std::string m_source;
+                  std::string m_target;
                   const iconv_t m_descriptor;
+                  bool m_ascii_compatible = false;
                };
 
                namespace locale::name
@@ -146,6 +228,23 @@ namespace casual
                   
                } // locale::name
 
+               namespace cache
+               {
+                  //! @return a converter for source -> target, that is reused for the rest
+                  //!  of the thread's lifetime
+                  const converter& get( std::string_view source, std::string_view target)
+                  {
+                     // iconv descriptors are not thread safe, hence one cache per thread
+                     thread_local std::vector< std::unique_ptr< converter>> converters;
+
+                     if( auto found = algorithm::find_if( converters, [&]( auto& c){ return c->equal( source, target);}))
+                        return **found;
+
+                     converters.push_back( std::make_unique< converter>( source, target));
+                     return *converters.back();
+                  }
+               } // cache
+
             } // <unnamed>
          } // local
 
@@ -175,7 +274,7 @@ namespace casual
             {
                try
                {
-                  local::converter{ codeset, local::locale::name::current};
+                  local::cache::get( codeset, local::locale::name::current);
                }
                catch( ...)
                {
@@ -190,12 +289,12 @@ namespace casual
 
             std::string encode( const std::string& value, std::string_view codeset)
             {
-               return local::converter( codeset, local::locale::name::utf8).transcode( value);
+               return local::cache::get( codeset, local::locale::name::utf8).transcode( value);
             }
 
             std::string decode( const std::string& value, std::string_view codeset)
             {
-               return local::converter( local::locale::name::utf8, codeset).transcode( value);
+               return local::cache::get( local::locale::name::utf8, codeset).transcode( value);
             }
 
          } // utf8
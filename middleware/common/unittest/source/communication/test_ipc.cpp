@@ -10,6 +10,7 @@
 #include "common/communication/ipc.h"
 #include "common/message/domain.h"
 #include "common/message/service.h"
+#include "common/message/event.h"
 #include "common/unittest/eventually/send.h"
 
 #include <random>
@@ -413,6 +414,134 @@ namespace casual
          } // <unnamed>
       } // local
 
+      TEST( common_communication_ipc, device_cache__priorities__expect_prioritized_first)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device device;
+         device.priorities( { common::message::Type::shutdown_request});
+
+         device.push( unittest::Message{});
+         device.push( common::message::domain::process::lookup::Reply{});
+         device.push( common::message::shutdown::Request{});
+
+         EXPECT_TRUE( device.next( ipc::policy::non::Blocking{}).type() == common::message::Type::shutdown_request);
+
+         // lookups on a specific type is not affected
+         EXPECT_TRUE( device.next( common::message::Type::domain_process_lookup_reply, ipc::policy::non::Blocking{}));
+
+         EXPECT_TRUE( device.next( ipc::policy::non::Blocking{}).type() == common::message::Type::unittest_message);
+         EXPECT_TRUE( device.size() == 0);
+      }
+
+      TEST( common_communication_ipc, device_cache__deferred__expect_consumed_last)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device device;
+         device.deferred( { common::message::Type::event_service_calls});
+
+         device.push( common::message::event::service::Calls{});
+         device.push( unittest::Message{});
+         device.push( common::message::domain::process::lookup::Reply{});
+
+         EXPECT_TRUE( device.next( ipc::policy::non::Blocking{}).type() == common::message::Type::unittest_message);
+         EXPECT_TRUE( device.next( ipc::policy::non::Blocking{}).type() == common::message::Type::domain_process_lookup_reply);
+         EXPECT_TRUE( device.next( ipc::policy::non::Blocking{}).type() == common::message::Type::event_service_calls);
+         EXPECT_TRUE( device.size() == 0);
+      }
+
+      TEST( common_communication_ipc, device_priorities__not_read_messages__expect_prioritized_first)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device device;
+         device.priorities( { common::message::Type::shutdown_request});
+
+         auto destination = device.connector().handle().ipc();
+
+         device::blocking::send( destination, unittest::Message{});
+         device::blocking::send( destination, unittest::Message{});
+         device::blocking::send( destination, common::message::shutdown::Request{});
+
+         EXPECT_TRUE( device.next( ipc::policy::non::Blocking{}).type() == common::message::Type::shutdown_request);
+         EXPECT_TRUE( device.next( ipc::policy::non::Blocking{}).type() == common::message::Type::unittest_message);
+         EXPECT_TRUE( device.next( ipc::policy::non::Blocking{}).type() == common::message::Type::unittest_message);
+         EXPECT_TRUE( ! device.next( ipc::policy::non::Blocking{}));
+      }
+
+      TEST( common_communication_ipc, device_cache__types__expect_fifo_order)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device device;
+
+         auto first = device.push( common::message::domain::process::lookup::Reply{});
+         device.push( unittest::Message{});
+         auto second = device.push( common::message::domain::process::lookup::Reply{});
+
+         const std::vector< common::message::Type> types{ common::message::Type::shutdown_request, common::message::Type::domain_process_lookup_reply};
+
+         EXPECT_TRUE( device.next( types, ipc::policy::non::Blocking{}).correlation() == first);
+         EXPECT_TRUE( device.next( types, ipc::policy::non::Blocking{}).correlation() == second);
+         EXPECT_TRUE( ! device.next( types, ipc::policy::non::Blocking{}));
+         EXPECT_TRUE( device.complete() == 1);
+      }
+
+      TEST( common_communication_ipc, device_cache__discard__expect_removed)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device device;
+
+         auto correlation = device.push( unittest::Message{});
+         device.discard( correlation);
+
+         EXPECT_TRUE( device.size() == 0);
+         EXPECT_TRUE( ! device.next( correlation, ipc::policy::non::Blocking{}));
+      }
+
+      TEST( common_communication_ipc, device_cache__10k_backlog__consume_by_correlation_in_reverse_and_by_type)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device device;
+         device.priorities( { common::message::Type::shutdown_request});
+
+         constexpr auto count = 10000;
+
+         std::vector< strong::correlation::id> correlations;
+         for( auto index = 0; index < count; ++index)
+            correlations.push_back( device.push( unittest::Message{}));
+
+         device.push( common::message::shutdown::Request{});
+         
+         for( auto index = 0; index < count; ++index)
+            device.push( common::message::domain::process::lookup::Reply{});
+
+         EXPECT_TRUE( device.complete() == 2 * count + 1);
+
+         auto start = platform::time::clock::type::now();
+
+         // control message is consumed before the backlog
+         EXPECT_TRUE( device.next( ipc::policy::non::Blocking{}).type() == common::message::Type::shutdown_request);
+
+         for( auto& correlation : range::reverse( correlations))
+         {
+            ASSERT_TRUE( device.next( correlation, ipc::policy::non::Blocking{}).correlation() == correlation);
+         }
+
+         for( auto index = 0; index < count; ++index)
+         {
+            ASSERT_TRUE( device.next( common::message::Type::domain_process_lookup_reply, ipc::policy::non::Blocking{}));
+         }
+
+         common::log::line( common::unittest::log, "10k backlog - consumed ", 2 * count + 1, " messages: ",
+            std::chrono::duration_cast< std::chrono::microseconds>( platform::time::clock::type::now() - start).count(), "us");
+
+         EXPECT_TRUE( device.size() == 0);
+      }
+
       TEST( common_communication_ipc, send_receive_100_messages__1kB)
       {
          common::unittest::Trace trace;
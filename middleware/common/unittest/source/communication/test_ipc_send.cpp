@@ -0,0 +1,215 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#include "common/unittest.h"
+
+#include "common/communication/ipc/send.h"
+#include "common/message/service.h"
+#include "common/code/casual.h"
+
+#include <poll.h>
+
+namespace casual
+{
+   namespace common::communication::ipc
+   {
+      namespace local
+      {
+         namespace
+         {
+            //! sends messages until the destination is full and messages are queued
+            auto fill( send::Coordinator& coordinator, const strong::ipc::id& destination)
+            {
+               std::vector< strong::correlation::id> result;
+
+               while( coordinator.empty())
+                  result.push_back( coordinator.send( destination, unittest::Message{ 10 * 1024}));
+
+               return result;
+            }
+
+            bool readable( strong::file::descriptor::id descriptor)
+            {
+               ::pollfd value{ descriptor.value(), POLLIN, 0};
+               return ::poll( &value, 1, 0) == 1;
+            }
+         } // <unnamed>
+      } // local
+
+      TEST( common_communication_ipc_send, destination_full__expect_queued__drained_in_order)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device destination;
+         send::Coordinator coordinator{ send::Settings{}};
+
+         auto correlations = local::fill( coordinator, destination.connector().handle().ipc());
+
+         // a few more, that are queued directly
+         for( auto count = 10; count > 0; --count)
+            correlations.push_back( coordinator.send( destination.connector().handle().ipc(), unittest::Message{ 10 * 1024}));
+
+         {
+            auto metrics = coordinator.metrics();
+            ASSERT_TRUE( metrics.size() == 1);
+            EXPECT_TRUE( metrics.at( 0).ipc == destination.connector().handle().ipc());
+            EXPECT_TRUE( metrics.at( 0).queue.count >= 10) << CASUAL_NAMED_VALUE( metrics);
+            EXPECT_TRUE( metrics.at( 0).queue.high >= metrics.at( 0).queue.size);
+         }
+
+         for( auto& correlation : correlations)
+         {
+            unittest::Message message;
+
+            while( ! device::non::blocking::receive( destination, message))
+               coordinator.send();
+
+            EXPECT_TRUE( message.correlation == correlation);
+         }
+
+         EXPECT_TRUE( coordinator.empty());
+
+         // the drained destination is discarded
+         EXPECT_TRUE( coordinator.metrics().empty()) << CASUAL_NAMED_VALUE( coordinator.metrics());
+      }
+
+      TEST( common_communication_ipc_send, 3_destinations_full__drained___expect_no_destinations)
+      {
+         common::unittest::Trace trace;
+
+         std::vector< ipc::inbound::Device> destinations( 3);
+         send::Coordinator coordinator{ send::Settings{}};
+
+         for( auto& destination : destinations)
+         {
+            auto queued = [&]()
+            {
+               return algorithm::any_of( coordinator.metrics(), [ipc = destination.connector().handle().ipc()]( auto& metric){ return metric.ipc == ipc;});
+            };
+
+            while( ! queued())
+               coordinator.send( destination.connector().handle().ipc(), unittest::Message{ 10 * 1024});
+         }
+
+         EXPECT_TRUE( coordinator.metrics().size() == 3) << CASUAL_NAMED_VALUE( coordinator.metrics());
+
+         for( auto& destination : destinations)
+         {
+            unittest::Message message;
+            while( device::non::blocking::receive( destination, message))
+               ;
+         }
+
+         while( ! coordinator.empty())
+         {
+            coordinator.send();
+
+            for( auto& destination : destinations)
+            {
+               unittest::Message message;
+               while( device::non::blocking::receive( destination, message))
+                  ;
+            }
+         }
+
+         EXPECT_TRUE( coordinator.metrics().empty()) << CASUAL_NAMED_VALUE( coordinator.metrics());
+         EXPECT_TRUE( ! local::readable( coordinator.descriptor()));
+      }
+
+      TEST( common_communication_ipc_send, destination_full__expect_descriptor_readable_when_destination_writable)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device destination;
+         send::Coordinator coordinator{ send::Settings{}};
+
+         local::fill( coordinator, destination.connector().handle().ipc());
+         EXPECT_TRUE( ! local::readable( coordinator.descriptor()));
+
+         // make room in the destination
+         unittest::Message message;
+         while( device::non::blocking::receive( destination, message))
+            ;
+
+         EXPECT_TRUE( local::readable( coordinator.descriptor()));
+
+         coordinator.send();
+         EXPECT_TRUE( coordinator.empty());
+         EXPECT_TRUE( ! local::readable( coordinator.descriptor()));
+      }
+
+      TEST( common_communication_ipc_send, overflow_shed__expect_request_discarded)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device destination;
+         send::Coordinator coordinator{ send::Settings{ 1, send::overflow::Policy::shed}};
+
+         local::fill( coordinator, destination.connector().handle().ipc());
+
+         EXPECT_TRUE( ! coordinator.send( destination.connector().handle().ipc(), common::message::service::lookup::Request{ process::handle()}));
+
+         auto metrics = coordinator.metrics();
+         ASSERT_TRUE( metrics.size() == 1);
+         EXPECT_TRUE( metrics.at( 0).shed == 1);
+         EXPECT_TRUE( metrics.at( 0).queue.count == 1);
+      }
+
+      TEST( common_communication_ipc_send, overflow_shed__expect_reply_queued)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device destination;
+         send::Coordinator coordinator{ send::Settings{ 1, send::overflow::Policy::shed}};
+
+         local::fill( coordinator, destination.connector().handle().ipc());
+
+         EXPECT_TRUE( coordinator.send( destination.connector().handle().ipc(), common::message::service::lookup::Reply{}));
+
+         auto metrics = coordinator.metrics();
+         ASSERT_TRUE( metrics.size() == 1);
+         EXPECT_TRUE( metrics.at( 0).shed == 0);
+         EXPECT_TRUE( metrics.at( 0).queue.count == 2);
+      }
+
+      TEST( common_communication_ipc_send, overflow_error__expect_communication_retry)
+      {
+         common::unittest::Trace trace;
+
+         ipc::inbound::Device destination;
+         send::Coordinator coordinator{ send::Settings{ 1, send::overflow::Policy::error}};
+
+         local::fill( coordinator, destination.connector().handle().ipc());
+
+         EXPECT_CODE(
+         {
+            coordinator.send( destination.connector().handle().ipc(), unittest::Message{ 10 * 1024});
+         }, code::casual::communication_retry);
+      }
+
+      TEST( common_communication_ipc_send, destination_gone__expect_queue_discarded)
+      {
+         common::unittest::Trace trace;
+
+         send::Coordinator coordinator{ send::Settings{}};
+         strong::ipc::id id;
+
+         {
+            ipc::inbound::Device destination;
+            id = destination.connector().handle().ipc();
+            local::fill( coordinator, id);
+         }
+
+         coordinator.send();
+
+         EXPECT_TRUE( coordinator.empty());
+         EXPECT_TRUE( coordinator.metrics().empty());
+         EXPECT_TRUE( ! send::optional::send( coordinator, id, unittest::Message{}));
+      }
+
+   } // common::communication::ipc
+} // casual
@@ -8,10 +8,15 @@
 #include "common/unittest/thread.h"
 
 #include "common/communication/tcp.h"
+#include "common/communication/tcp/uring.h"
+#include "common/communication/select.h"
 #include "common/exception/handle.h"
+#include "common/execute.h"
 
 #include "common/message/service.h"
 
+#include <array>
+
 
 namespace casual
 {
@@ -388,5 +393,253 @@ namespace casual
             EXPECT_TRUE( common::algorithm::equal( receive_message.payload, send_message.payload));
          }
       }
+
+      namespace local
+      {
+         namespace
+         {
+            namespace backend
+            {
+               //! enables io_uring, if supported, until the returned scope is destroyed
+               auto uring()
+               {
+                  tcp::uring::enable( true);
+
+                  if( ! tcp::uring::enabled())
+                     log::line( unittest::log, "io_uring is not supported - skip");
+
+                  return execute::scope( [](){ tcp::uring::enable( false);});
+               }
+            } // backend
+
+            auto complete( platform::size::type size)
+            {
+               return tcp::message::Complete{ 
+                  common::message::Type::process_lookup_request, 
+                  strong::correlation::id{ uuid::make()}, 
+                  unittest::random::binary( size)};
+            }
+
+            namespace test
+            {
+               void batch_send( std::string_view backend)
+               {
+                  const auto address = local::address();
+
+                  unittest::Thread server{ &local::echo::server, address};
+
+                  tcp::Duplex tcp{ tcp::retry::connect( address, { { std::chrono::milliseconds{ 1}, 0}})};
+
+                  auto origin = algorithm::generate_n< 100>( [](){ return local::complete( 128);});
+                  auto unsent = origin;
+
+                  while( ! unsent.empty())
+                  {
+                     auto sent = tcp::batch::send( tcp.connector().socket(), range::make( unsent));
+                     unsent.erase( std::begin( unsent), std::begin( unsent) + sent);
+                  }
+
+                  for( auto& expected : origin)
+                  {
+                     auto complete = device::blocking::next( tcp);
+                     ASSERT_TRUE( complete.correlation() == expected.correlation()) << backend;
+                     ASSERT_TRUE( complete.payload == expected.payload) << backend;
+                  }
+
+                  EXPECT_TRUE( tcp.size() == 0) << backend;
+               }
+
+               void batch_send_destinations( std::string_view backend)
+               {
+                  const auto first = local::address();
+                  const auto second = local::address();
+
+                  unittest::Thread server_first{ &local::echo::server, first};
+                  unittest::Thread server_second{ &local::echo::server, second};
+
+                  std::array< tcp::Duplex, 2> devices{ 
+                     tcp::Duplex{ tcp::retry::connect( first, { { std::chrono::milliseconds{ 1}, 0}})},
+                     tcp::Duplex{ tcp::retry::connect( second, { { std::chrono::milliseconds{ 1}, 0}})}};
+
+                  auto origin = algorithm::generate_n< 100>( [](){ return local::complete( 128);});
+                  std::array< std::vector< tcp::message::Complete>, 2> unsent{ origin, origin};
+
+                  while( ! unsent[ 0].empty() || ! unsent[ 1].empty())
+                  {
+                     std::vector< tcp::batch::Destination> destinations{
+                        { &devices[ 0].connector().socket(), range::make( unsent[ 0]), 0, {}},
+                        { &devices[ 1].connector().socket(), range::make( unsent[ 1]), 0, {}}};
+
+                     tcp::batch::send( range::make( destinations));
+
+                     for( auto index : { 0, 1})
+                     {
+                        ASSERT_TRUE( ! destinations[ index].error) << backend;
+                        unsent[ index].erase( std::begin( unsent[ index]), std::begin( unsent[ index]) + destinations[ index].count);
+                     }
+                  }
+
+                  for( auto& device : devices)
+                  {
+                     for( auto& expected : origin)
+                     {
+                        auto complete = device::blocking::next( device);
+                        ASSERT_TRUE( complete.correlation() == expected.correlation()) << backend;
+                        ASSERT_TRUE( complete.payload == expected.payload) << backend;
+                     }
+                  }
+               }
+
+               void benchmark( std::string_view backend)
+               {
+                  const auto address = local::address();
+
+                  unittest::Thread server{ &local::echo::server, address};
+
+                  tcp::Duplex tcp{ tcp::retry::connect( address, { { std::chrono::milliseconds{ 1}, 0}})};
+
+                  constexpr auto count = 1000;
+
+                  // latency: one message at the time
+                  {
+                     auto message = local::complete( 128);
+                     auto start = platform::time::clock::type::now();
+
+                     for( auto index = 0; index < count; ++index)
+                     {
+                        device::blocking::send( tcp, tcp::message::Complete{ message});
+                        ASSERT_TRUE( device::blocking::next( tcp, message.correlation()));
+                     }
+
+                     auto elapsed = std::chrono::duration_cast< std::chrono::microseconds>( platform::time::clock::type::now() - start);
+
+                     log::line( unittest::log, backend, " - round trip latency: ", elapsed.count() / count, "us");
+                  }
+
+                  // throughput: pipelined batches of 100 messages, 4kB each
+                  {
+                     auto start = platform::time::clock::type::now();
+
+                     for( auto batch = 0; batch < count / 100; ++batch)
+                     {
+                        auto unsent = algorithm::generate_n< 100>( [](){ return local::complete( 4 * 1024);});
+
+                        while( ! unsent.empty())
+                        {
+                           auto sent = tcp::batch::send( tcp.connector().socket(), range::make( unsent));
+                           unsent.erase( std::begin( unsent), std::begin( unsent) + sent);
+                        }
+
+                        for( auto index = 0; index < 100; ++index)
+                           ASSERT_TRUE( device::blocking::next( tcp));
+                     }
+
+                     auto elapsed = std::chrono::duration_cast< std::chrono::microseconds>( platform::time::clock::type::now() - start);
+
+                     log::line( unittest::log, backend, " - throughput: ", count * 4 * 1024 * 2 / std::max( elapsed.count(), decltype( elapsed.count()){ 1}), " bytes/us");
+                  }
+               }
+            } // test
+         } // <unnamed>
+      } // local
+
+      TEST( common_communication_tcp, echo_server__batch_send_100__receive_100__expect_same_order)
+      {
+         common::unittest::Trace trace;
+
+         local::test::batch_send( "regular");
+      }
+
+      TEST( common_communication_tcp, io_uring__echo_server__batch_send_100__receive_100__expect_same_order)
+      {
+         common::unittest::Trace trace;
+
+         auto scope = local::backend::uring();
+         if( tcp::uring::enabled())
+            local::test::batch_send( "io_uring");
+      }
+
+      TEST( common_communication_tcp, two_echo_servers__batch_send_100_to_each__receive_100_from_each__expect_same_order)
+      {
+         common::unittest::Trace trace;
+
+         local::test::batch_send_destinations( "regular");
+      }
+
+      TEST( common_communication_tcp, io_uring__two_echo_servers__batch_send_100_to_each__receive_100_from_each__expect_same_order)
+      {
+         common::unittest::Trace trace;
+
+         auto scope = local::backend::uring();
+         if( tcp::uring::enabled())
+            local::test::batch_send_destinations( "io_uring");
+      }
+
+      TEST( common_communication_tcp, io_uring__echo_server__select_dispatch__expect_receive_via_ring_same_order)
+      {
+         common::unittest::Trace trace;
+
+         auto scope = local::backend::uring();
+         if( ! tcp::uring::enabled())
+            return;
+
+         const auto address = local::address();
+         unittest::Thread server{ &local::echo::server, address};
+
+         tcp::Duplex tcp{ tcp::retry::connect( address, { { std::chrono::milliseconds{ 1}, 0}})};
+         const auto descriptor = tcp.connector().descriptor();
+
+         auto origin = algorithm::generate_n< 100>( [](){ return local::complete( 128);});
+         for( auto& complete : origin)
+            device::blocking::send( tcp, tcp::message::Complete{ complete});
+
+         std::vector< tcp::message::Complete> received;
+
+         select::Directive directive;
+         directive.read.add( descriptor);
+
+         select::dispatch::pump(
+            select::dispatch::condition::compose( 
+               select::dispatch::condition::done( [&](){ return received.size() == origin.size();})),
+            directive,
+            [&]( strong::file::descriptor::id ready, select::tag::read)
+            {
+               if( ready != descriptor)
+                  return false;
+
+               while( auto complete = device::non::blocking::next( tcp))
+                  received.push_back( std::move( complete));
+
+               return true;
+            });
+
+         // the receives are driven by the ring, not by selecting on the socket
+         EXPECT_TRUE( tcp::uring::dispatch::armed( descriptor));
+         EXPECT_TRUE( tcp::uring::dispatch::descriptor());
+
+         ASSERT_TRUE( received.size() == origin.size());
+         for( platform::size::type index = 0; index < range::size( origin); ++index)
+         {
+            EXPECT_TRUE( received[ index].correlation() == origin[ index].correlation());
+            EXPECT_TRUE( received[ index].payload == origin[ index].payload);
+         }
+      }
+
+      TEST( common_communication_tcp, echo_server__loopback_benchmark)
+      {
+         common::unittest::Trace trace;
+
+         local::test::benchmark( "regular");
+      }
+
+      TEST( common_communication_tcp, io_uring__echo_server__loopback_benchmark)
+      {
+         common::unittest::Trace trace;
+
+         auto scope = local::backend::uring();
+         if( tcp::uring::enabled())
+            local::test::benchmark( "io_uring");
+      }
+
    } // common::communication
 } // casual
@@ -0,0 +1,147 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#include "common/unittest.h"
+
+#include "common/event/ring.h"
+#include "common/message/event.h"
+#include "common/communication/ipc.h"
+#include "common/serialize/native/complete.h"
+
+namespace casual
+{
+   namespace common
+   {
+      namespace local
+      {
+         namespace
+         {
+            auto event( platform::size::type size = 0)
+            {
+               message::event::Notification event{ process::handle()};
+               event.message = std::string( size, 'a');
+               return serialize::native::complete< communication::ipc::message::Complete>( event);
+            }
+
+            struct Scope
+            {
+               ~Scope() { event::ring::reader::detach( { message::event::Notification::type()});}
+            };
+         } // <unnamed>
+      } // local
+
+      TEST( common_event_ring, no_ring__expect_no_attach)
+      {
+         common::unittest::Trace trace;
+
+         std::filesystem::remove( event::ring::path( message::event::Notification::type()));
+
+         EXPECT_TRUE( event::ring::reader::attach( { message::event::Notification::type()}).empty());
+      }
+
+      TEST( common_event_ring, write__expect_notify__consume_to_inbound)
+      {
+         common::unittest::Trace trace;
+
+         event::ring::Writer writer{ message::event::Notification::type(), 64 * 1024};
+         local::Scope scope;
+
+         EXPECT_TRUE( ! writer.active());
+         auto types = event::ring::reader::attach( { message::event::Notification::type()});
+         ASSERT_TRUE( types.size() == 1);
+         EXPECT_TRUE( writer.active());
+         EXPECT_TRUE( writer.reader( process::handle().ipc));
+
+         auto complete = local::event();
+         EXPECT_TRUE( writer.write( complete));
+         // no notify until we've consumed the ring
+         EXPECT_TRUE( writer.write( local::event()));
+
+         auto& device = communication::ipc::inbound::device();
+
+         message::event::ring::Notify notify;
+         communication::device::blocking::receive( device, notify);
+         EXPECT_TRUE( ! communication::device::non::blocking::receive( device, notify));
+
+         event::ring::reader::consume();
+
+         message::event::Notification event;
+         EXPECT_TRUE( communication::device::non::blocking::receive( device, event));
+         EXPECT_TRUE( event.correlation == complete.correlation());
+         EXPECT_TRUE( event.process == process::handle());
+         EXPECT_TRUE( communication::device::non::blocking::receive( device, event));
+         EXPECT_TRUE( ! communication::device::non::blocking::receive( device, event));
+
+         auto readers = writer.readers();
+         ASSERT_TRUE( readers.size() == 1);
+         EXPECT_TRUE( readers.at( 0).lag == 0);
+         EXPECT_TRUE( readers.at( 0).lost == 0);
+      }
+
+      TEST( common_event_ring, reader_lapped__expect_lost__skip_to_head)
+      {
+         common::unittest::Trace trace;
+
+         event::ring::Writer writer{ message::event::Notification::type(), 4 * 1024};
+         local::Scope scope;
+
+         ASSERT_TRUE( event::ring::reader::attach( { message::event::Notification::type()}).size() == 1);
+
+         for( auto count = 20; count > 0; --count)
+            EXPECT_TRUE( writer.write( local::event( 500)));
+
+         EXPECT_TRUE( writer.readers().at( 0).lag > 4 * 1024);
+
+         auto& device = communication::ipc::inbound::device();
+
+         message::event::ring::Notify notify;
+         communication::device::blocking::receive( device, notify);
+         event::ring::reader::consume();
+
+         message::event::Notification event;
+         EXPECT_TRUE( ! communication::device::non::blocking::receive( device, event));
+
+         auto readers = writer.readers();
+         ASSERT_TRUE( readers.size() == 1);
+         EXPECT_TRUE( readers.at( 0).lag == 0);
+         EXPECT_TRUE( readers.at( 0).lost == 1);
+
+         // we get the next one
+         EXPECT_TRUE( writer.write( local::event()));
+         communication::device::blocking::receive( device, notify);
+         event::ring::reader::consume();
+         EXPECT_TRUE( communication::device::non::blocking::receive( device, event));
+      }
+
+      TEST( common_event_ring, event_larger_than_half_the_ring__expect_false)
+      {
+         common::unittest::Trace trace;
+
+         event::ring::Writer writer{ message::event::Notification::type(), 4 * 1024};
+
+         EXPECT_TRUE( ! writer.write( local::event( 3 * 1024)));
+      }
+
+      TEST( common_event_ring, remove_reader_pid__expect_detached)
+      {
+         common::unittest::Trace trace;
+
+         event::ring::Writer writer{ message::event::Notification::type(), 4 * 1024};
+         local::Scope scope;
+
+         ASSERT_TRUE( event::ring::reader::attach( { message::event::Notification::type()}).size() == 1);
+
+         writer.remove( process::id());
+         EXPECT_TRUE( ! writer.active());
+
+         // the reader discovers that it's not attached any more
+         event::ring::reader::consume();
+         EXPECT_TRUE( event::ring::reader::attach( {}).empty());
+      }
+
+   } // common
+} // casual
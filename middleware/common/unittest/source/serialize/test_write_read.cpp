@@ -463,6 +463,20 @@ namespace casual
             << "document: " << TestFixture::string_document( value);
       }
 
+      TYPED_TEST( common_serialize_write_read, type_variant)
+      {
+         unittest::Trace trace;
+
+         using variant_type = std::variant< long, std::string, std::vector< short>>;
+
+         for( auto& value : { variant_type{ 42l}, variant_type{ std::string{ "casual"}}, variant_type{ std::vector< short>{ 1, 2, 3}}})
+         {
+            auto result = TestFixture::write_read( value);
+            EXPECT_TRUE( result == value) << "index: " << value.index() << ", result index: " << result.index() << "\n"
+               << "document: " << TestFixture::string_document( value);
+         }
+      }
+
       namespace local
       {
          namespace
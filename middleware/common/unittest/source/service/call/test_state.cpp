@@ -0,0 +1,211 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#include "common/unittest.h"
+
+#include "common/service/call/state.h"
+#include "common/code/xatmi.h"
+
+#include <thread>
+#include <deque>
+#include <set>
+
+namespace casual
+{
+   namespace common::service::call
+   {
+
+      TEST( common_service_call_state, reserve__expect_descriptor_1)
+      {
+         common::unittest::Trace trace;
+
+         State state;
+         auto correlation = strong::correlation::id::emplace( uuid::make());
+
+         auto descriptor = state.pending.reserve( correlation);
+         EXPECT_TRUE( descriptor.descriptor == 1);
+         EXPECT_TRUE( descriptor.active);
+
+         EXPECT_TRUE( state.pending.get( 1).correlation == correlation);
+         EXPECT_TRUE( state.pending.get( correlation).descriptor == 1);
+         EXPECT_TRUE( ! state.pending.empty());
+      }
+
+      TEST( common_service_call_state, reserve_unreserve__expect_empty)
+      {
+         common::unittest::Trace trace;
+
+         State state;
+         auto correlation = strong::correlation::id::emplace( uuid::make());
+
+         auto descriptor = state.pending.reserve( correlation).descriptor;
+         state.pending.unreserve( descriptor);
+
+         EXPECT_TRUE( state.pending.empty());
+         EXPECT_TRUE( ! state.pending.active( descriptor));
+
+         EXPECT_CODE({
+            state.pending.get( correlation);
+         }, code::xatmi::descriptor);
+      }
+
+      TEST( common_service_call_state, reserve_unreserve_reserve__expect_stale_descriptor_invalid)
+      {
+         common::unittest::Trace trace;
+
+         State state;
+
+         auto first = state.pending.reserve( strong::correlation::id::emplace( uuid::make())).descriptor;
+         state.pending.unreserve( first);
+
+         // the slot is reused, with a new generation
+         auto second = state.pending.reserve( strong::correlation::id::emplace( uuid::make())).descriptor;
+         EXPECT_TRUE( first != second);
+         EXPECT_TRUE( state.pending.active( second));
+         EXPECT_TRUE( ! state.pending.active( first));
+
+         EXPECT_CODE({
+            state.pending.get( first);
+         }, code::xatmi::descriptor);
+
+         EXPECT_CODE({
+            state.pending.unreserve( first);
+         }, code::xatmi::descriptor);
+      }
+
+      TEST( common_service_call_state, reserve_unreserve_100000__2_outstanding___expect_recycled_bounded_descriptors)
+      {
+         common::unittest::Trace trace;
+
+         State state;
+
+         std::deque< descriptor_type> outstanding;
+         std::set< descriptor_type> indexes;
+
+         for( auto count = 0; count < 100000; ++count)
+         {
+            auto descriptor = state.pending.reserve( strong::correlation::id::emplace( uuid::make())).descriptor;
+            ASSERT_TRUE( descriptor > 0 && descriptor < ( 1 << 30)) << "descriptor: " << descriptor;
+
+            // the index is in the low bits
+            indexes.insert( descriptor & (( 1 << 20) - 1));
+
+            outstanding.push_back( descriptor);
+            if( outstanding.size() > 2)
+            {
+               state.pending.unreserve( outstanding.front());
+               outstanding.pop_front();
+            }
+         }
+
+         // the initial slots are recycled, the table has not grown
+         EXPECT_TRUE( indexes.size() <= 8) << CASUAL_NAMED_VALUE( indexes);
+         EXPECT_TRUE( state.pending.size() == 2);
+      }
+
+      TEST( common_service_call_state, reserve_set_deadline__unreserve__expect_deadline_not_settable)
+      {
+         common::unittest::Trace trace;
+
+         State state;
+
+         auto descriptor = state.pending.reserve( strong::correlation::id::emplace( uuid::make())).descriptor;
+         auto deadline = platform::time::clock::type::now();
+
+         state.pending.deadline( descriptor, deadline);
+         EXPECT_TRUE( state.pending.get( descriptor).deadline == deadline);
+
+         state.pending.unreserve( descriptor);
+
+         EXPECT_CODE({
+            state.pending.deadline( descriptor, deadline);
+         }, code::xatmi::descriptor);
+      }
+
+      TEST( common_service_call_state, invalid_descriptors__expect_throw)
+      {
+         common::unittest::Trace trace;
+
+         State state;
+
+         for( auto descriptor : { -1, 0, 1, 8, 9, 1 << 20})
+         {
+            EXPECT_CODE({
+               state.pending.get( descriptor);
+            }, code::xatmi::descriptor) << "descriptor: " << descriptor;
+         }
+      }
+
+      TEST( common_service_call_state, reserve_1000__get_by_correlation__unreserve_in_reverse___expect_empty)
+      {
+         common::unittest::Trace trace;
+
+         State state;
+
+         std::vector< std::pair< correlation_type, descriptor_type>> pending;
+
+         auto start = platform::time::clock::type::now();
+
+         for( auto count = 0; count < 1000; ++count)
+         {
+            auto correlation = strong::correlation::id::emplace( uuid::make());
+            pending.emplace_back( correlation, state.pending.reserve( correlation).descriptor);
+         }
+
+         EXPECT_TRUE( state.pending.size() == 1000);
+
+         for( auto& [ correlation, descriptor] : range::reverse( pending))
+         {
+            ASSERT_TRUE( state.pending.get( correlation).descriptor == descriptor);
+            state.pending.unreserve( descriptor);
+         }
+
+         common::log::line( common::unittest::log, "1000 reserve/get/unreserve: ",
+            std::chrono::duration_cast< std::chrono::microseconds>( platform::time::clock::type::now() - start).count(), "us");
+
+         EXPECT_TRUE( state.pending.empty());
+      }
+
+      TEST( common_service_call_state, 4_threads_reserve_unreserve_1000___expect_empty)
+      {
+         common::unittest::Trace trace;
+
+         State state;
+
+         auto worker = [&state]()
+         {
+            std::vector< descriptor_type> descriptors;
+
+            for( auto count = 0; count < 1000; ++count)
+            {
+               descriptors.push_back( state.pending.reserve( strong::correlation::id::emplace( uuid::make())).descriptor);
+
+               if( count % 3 == 0)
+               {
+                  state.pending.unreserve( descriptors.back());
+                  descriptors.pop_back();
+               }
+            }
+
+            for( auto descriptor : descriptors)
+               state.pending.unreserve( descriptor);
+         };
+
+         {
+            std::vector< std::thread> threads;
+            for( auto count = 0; count < 4; ++count)
+               threads.emplace_back( worker);
+
+            for( auto& thread : threads)
+               thread.join();
+         }
+
+         EXPECT_TRUE( state.pending.empty()) << "size: " << state.pending.size();
+      }
+
+   } // common::service::call
+} // casual
@@ -7,6 +7,7 @@
 
 #include "common/argument.h"
 #include "common/process.h"
+#include "common/process/zygote.h"
 
 #include "common/exception/guard.h"
 
@@ -17,10 +18,15 @@ int main( int argc, char** argv)
    try
    {
       int return_value = 0;
+      bool zygote = false;
       argument::Parse{ "", 
-         argument::Option( std::tie( return_value), {"-r"}, "bla")
+         argument::Option( std::tie( return_value), {"-r"}, "bla"),
+         argument::Option( std::tie( zygote), {"--zygote"}, "serve as a zygote (if spawned as one)")
       }( argc, argv);
 
+      if( zygote)
+         process::zygote::serve();
+
       process::sleep( std::chrono::milliseconds( 100));
 
       return return_value;
@@ -8,10 +8,16 @@
 #include "common/unittest.h"
 
 #include "common/process.h"
+#include "common/process/zygote.h"
 
 #include "common/code/signal.h"
 #include "common/code/casual.h"
 #include "common/signal.h"
+#include "common/execute.h"
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
 
 
 namespace casual
@@ -26,6 +32,19 @@ namespace casual
             {
                return std::filesystem::path{ __FILE__}.parent_path().parent_path().parent_path() / "bin" / "simple_process";
             }
+
+            //! the zygote makes the (unittest) process a 'sub-reaper', we restore the previous
+            //! setting when the returned scope is destroyed.
+            auto reaper()
+            {
+#ifdef __linux__
+               int previous = 0;
+               ::prctl( PR_GET_CHILD_SUBREAPER, &previous, 0, 0, 0);
+               return execute::scope( [ previous](){ ::prctl( PR_SET_CHILD_SUBREAPER, previous, 0, 0, 0);});
+#else
+               return execute::scope( [](){});
+#endif
+            }
          }
       }
 
@@ -137,6 +156,36 @@ namespace casual
          }, code::casual::invalid_path);
       }
 
+      TEST( common_process, zygote_fork__expect_forked_instance_as_child)
+      {
+         common::unittest::Trace trace;
+
+         if( ! process::zygote::supported())
+            return;
+
+         signal::thread::scope::Block block{ { code::signal::child}};
+         auto reaper = local::reaper();
+
+         process::zygote::Handle zygote{ local::processPath(), { "--zygote", "1", "-r", "42"}, {}};
+
+         for( auto count = 0; ! zygote.ready() && count < 500; ++count)
+            std::this_thread::sleep_for( std::chrono::milliseconds{ 10});
+
+         ASSERT_TRUE( zygote.ready()) << CASUAL_NAMED_VALUE( zygote);
+
+         auto pid = zygote.fork( instance::Information{ "a", 1});
+         ASSERT_TRUE( pid);
+         EXPECT_TRUE( pid != zygote.pid());
+
+         // the forked instance continues from where the zygote stopped
+         EXPECT_TRUE( process::wait( pid) == 42);
+
+         // the zygote exits when it's discarded
+         auto zygote_pid = zygote.pid();
+         zygote = {};
+         EXPECT_TRUE( process::wait( zygote_pid) == 0);
+      }
+
    }
 }
 
@@ -153,6 +153,63 @@ namespace casual
          }
       }
 
+      TEST( casual_common_transcode_utf8, encode_decode_7bit__expect_same)
+      {
+         common::unittest::Trace trace;
+
+         // long enough to span the vectorized ascii check
+         const std::string source{ "The quick brown fox jumps over the lazy dog - 0123456789 {}[]()"};
+
+         EXPECT_TRUE( transcode::utf8::encode( source) == source);
+         EXPECT_TRUE( transcode::utf8::decode( source) == source);
+         EXPECT_TRUE( transcode::utf8::encode( source, "UTF-8") == source);
+         EXPECT_TRUE( transcode::utf8::encode( std::string{}) == std::string{});
+      }
+
+      TEST( casual_common_transcode_utf8, UTF8_encode_exotic_character_at_different_positions__expect_transcoded)
+      {
+         common::unittest::Trace trace;
+
+         if( transcode::utf8::exist( "ISO-8859-1"))
+         {
+            const auto ascii = std::string( 40, 'a');
+
+            // exotic character at every position, to make sure the ascii fast path never misses one
+            for( std::size_t position = 0; position <= ascii.size(); ++position)
+            {
+               auto source = ascii;
+               source.insert( position, 1, static_cast<std::string::value_type>(0xE5));
+
+               auto expect = ascii;
+               expect.insert( position, u8"å");
+
+               // do it twice to use the cached converter
+               EXPECT_TRUE( transcode::utf8::encode( source, "ISO-8859-1") == expect) << "position: " << position;
+               EXPECT_TRUE( transcode::utf8::encode( source, "ISO-8859-1") == expect) << "position: " << position;
+               EXPECT_TRUE( transcode::utf8::decode( expect, "ISO-8859-1") == source) << "position: " << position;
+            }
+         }
+         else
+         {
+            GTEST_LOG_(WARNING);
+         }
+      }
+
+      TEST( casual_common_transcode_utf8, UTF8_decode_to_non_ascii_compatible_codeset__expect_transcoded)
+      {
+         common::unittest::Trace trace;
+
+         if( transcode::utf8::exist( "UTF-16LE"))
+         {
+            const std::string expect{ 'a', 0, 'b', 0};
+            EXPECT_TRUE( transcode::utf8::decode( "ab", "UTF-16LE") == expect);
+         }
+         else
+         {
+            GTEST_LOG_(WARNING);
+         }
+      }
+
       TEST( casual_common_transcode_hex, encode)
       {
          common::unittest::Trace trace;
@@ -0,0 +1,215 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#include "common/unittest.h"
+
+#include "common/timer/wheel.h"
+#include "common/timer/descriptor.h"
+#include "common/communication/select.h"
+
+#include <random>
+
+namespace casual
+{
+   namespace common::timer
+   {
+      namespace local
+      {
+         namespace
+         {
+            // a start point where all levels wraps, so we know where the slots starts
+            const auto origin = platform::time::point::type{ std::chrono::milliseconds{ ( 1L << 24) * 100000}};
+         } // <unnamed>
+      } // local
+
+      TEST( common_timer_wheel, empty)
+      {
+         common::unittest::Trace trace;
+
+         Wheel< int> wheel{ local::origin};
+
+         EXPECT_TRUE( wheel.empty());
+         EXPECT_TRUE( ! wheel.next());
+         EXPECT_TRUE( wheel.expired( local::origin + std::chrono::hours{ 1}).empty());
+      }
+
+      TEST( common_timer_wheel, add_passed_deadline__expect_expired_directly)
+      {
+         common::unittest::Trace trace;
+
+         Wheel< int> wheel{ local::origin};
+         wheel.add( local::origin - std::chrono::seconds{ 1}, 42);
+
+         EXPECT_TRUE( wheel.next() == local::origin);
+         EXPECT_TRUE( wheel.expired( local::origin) == std::vector< int>{ 42});
+         EXPECT_TRUE( wheel.empty());
+      }
+
+      TEST( common_timer_wheel, add_3__expect_expired_in_order__never_early)
+      {
+         common::unittest::Trace trace;
+
+         Wheel< int> wheel{ local::origin};
+         wheel.add( local::origin + std::chrono::milliseconds{ 30}, 3);
+         wheel.add( local::origin + std::chrono::milliseconds{ 10}, 1);
+         wheel.add( local::origin + std::chrono::milliseconds{ 20}, 2);
+
+         EXPECT_TRUE( wheel.next() == local::origin + std::chrono::milliseconds{ 10});
+
+         EXPECT_TRUE( wheel.expired( local::origin + std::chrono::milliseconds{ 9}).empty());
+         EXPECT_TRUE( wheel.expired( local::origin + std::chrono::milliseconds{ 20}) == ( std::vector< int>{ 1, 2}));
+         EXPECT_TRUE( wheel.next() == local::origin + std::chrono::milliseconds{ 30});
+         EXPECT_TRUE( wheel.expired( local::origin + std::chrono::hours{ 1}) == std::vector< int>{ 3});
+         EXPECT_TRUE( wheel.empty());
+      }
+
+      TEST( common_timer_wheel, cancel__expect_not_expired)
+      {
+         common::unittest::Trace trace;
+
+         Wheel< int> wheel{ local::origin};
+         auto id = wheel.add( local::origin + std::chrono::milliseconds{ 10}, 1);
+         wheel.add( local::origin + std::chrono::milliseconds{ 20}, 2);
+
+         EXPECT_TRUE( wheel.cancel( id));
+         EXPECT_TRUE( ! wheel.cancel( id));
+         EXPECT_TRUE( wheel.size() == 1);
+         EXPECT_TRUE( wheel.next() == local::origin + std::chrono::milliseconds{ 20});
+         EXPECT_TRUE( wheel.expired( local::origin + std::chrono::seconds{ 1}) == std::vector< int>{ 2});
+      }
+
+      TEST( common_timer_wheel, deadlines_in_all_levels_and_overflow__expect_expired_in_order)
+      {
+         common::unittest::Trace trace;
+
+         // start in the 'middle' of the slots, so we cascade across wraps
+         auto start = local::origin + std::chrono::milliseconds{ 4000};
+         Wheel< platform::size::type> wheel{ start};
+
+         const std::vector< std::chrono::milliseconds> offsets{
+            std::chrono::milliseconds{ 1},
+            std::chrono::milliseconds{ 63},
+            std::chrono::milliseconds{ 100},
+            std::chrono::seconds{ 5},
+            std::chrono::minutes{ 5},
+            std::chrono::hours{ 2},
+            std::chrono::hours{ 24}};
+
+         for( auto& offset : range::reverse( offsets))
+            wheel.add( start + offset, offset.count());
+
+         for( auto& offset : offsets)
+         {
+            // the wheel could ask us to wake up earlier, to cascade
+            auto next = wheel.next();
+            ASSERT_TRUE( next);
+            EXPECT_TRUE( next.value() <= start + offset);
+
+            EXPECT_TRUE( wheel.expired( start + offset - std::chrono::milliseconds{ 1}).empty()) << "offset: " << offset.count();
+            EXPECT_TRUE( wheel.expired( start + offset) == std::vector< platform::size::type>{ offset.count()}) << "offset: " << offset.count();
+         }
+
+         EXPECT_TRUE( wheel.empty());
+      }
+
+      TEST( common_timer_wheel, next__earlier_in_higher_level_than_level_0__expect_higher_level)
+      {
+         common::unittest::Trace trace;
+
+         Wheel< int> wheel{ local::origin};
+
+         // ends up in level 1, slot starts at 64
+         wheel.add( local::origin + std::chrono::milliseconds{ 66}, 66);
+
+         wheel.expired( local::origin + std::chrono::milliseconds{ 60});
+
+         // ends up in level 0
+         wheel.add( local::origin + std::chrono::milliseconds{ 70}, 70);
+
+         EXPECT_TRUE( wheel.next() == local::origin + std::chrono::milliseconds{ 64});
+         EXPECT_TRUE( wheel.expired( local::origin + std::chrono::milliseconds{ 66}) == std::vector< int>{ 66});
+         EXPECT_TRUE( wheel.next() == local::origin + std::chrono::milliseconds{ 70});
+      }
+
+      TEST( common_timer_wheel, random_10k__expect_all_expired__never_early)
+      {
+         common::unittest::Trace trace;
+
+         Wheel< platform::time::point::type> wheel{ local::origin};
+
+         std::mt19937 engine{ 42};
+         std::uniform_int_distribution< int> distribution{ 0, 60 * 1000};
+
+         for( auto count = 0; count < 10000; ++count)
+         {
+            auto when = local::origin + std::chrono::milliseconds{ distribution( engine)};
+            auto id = wheel.add( when, when);
+
+            // cancel every third
+            if( count % 3 == 0)
+               wheel.cancel( id);
+         }
+
+         platform::size::type expired{};
+         auto now = local::origin;
+
+         while( auto next = wheel.next())
+         {
+            now = next.value();
+            for( auto& when : wheel.expired( now))
+            {
+               ASSERT_TRUE( when <= now);
+               ASSERT_TRUE( now - when < std::chrono::milliseconds{ 1});
+               ++expired;
+            }
+         }
+
+         EXPECT_TRUE( expired == 10000 - 3334) << "expired: " << expired;
+      }
+
+      TEST( common_timer_descriptor, set__select_read__expect_expired)
+      {
+         common::unittest::Trace trace;
+
+         Descriptor timer;
+         EXPECT_TRUE( ! timer.consume());
+
+         timer.set( platform::time::clock::type::now() + std::chrono::milliseconds{ 1});
+         EXPECT_TRUE( timer.deadline());
+
+         communication::select::block::read( timer.descriptor());
+
+         EXPECT_TRUE( timer.consume());
+         EXPECT_TRUE( ! timer.deadline());
+         EXPECT_TRUE( ! timer.consume());
+      }
+
+      TEST( common_timer_descriptor, set_passed_deadline__expect_expired)
+      {
+         common::unittest::Trace trace;
+
+         Descriptor timer;
+         timer.set( platform::time::clock::type::now() - std::chrono::seconds{ 1});
+
+         communication::select::block::read( timer.descriptor());
+         EXPECT_TRUE( timer.consume());
+      }
+
+      TEST( common_timer_descriptor, set_unset__expect_not_expired)
+      {
+         common::unittest::Trace trace;
+
+         Descriptor timer;
+         timer.set( platform::time::clock::type::now() + std::chrono::milliseconds{ 1});
+         timer.unset();
+
+         process::sleep( std::chrono::milliseconds{ 5});
+         EXPECT_TRUE( ! timer.consume());
+      }
+
+   } // common::timer
+} // casual
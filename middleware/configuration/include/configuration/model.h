@@ -465,6 +465,8 @@ namespace casual::configuration
                std::string address;
                std::vector< std::string> services;
                std::vector< std::string> queues;
+               //! number of parallel tcp connections (stripes) to the address
+               platform::size::type stripes = 1;
                std::string note;
 
                Connection& operator += ( Connection rhs);
@@ -474,11 +476,12 @@ namespace casual::configuration
                   CASUAL_SERIALIZE( address);
                   CASUAL_SERIALIZE( services);
                   CASUAL_SERIALIZE( queues);
+                  CASUAL_SERIALIZE( stripes);
                )
 
                inline explicit operator bool () const { return ! ( services.empty() && queues.empty());}
 
-               inline auto tie() const { return std::tie( address, services, queues, note);}
+               inline auto tie() const { return std::tie( address, services, queues, stripes, note);}
             };
 
             struct Group : common::Compare< Group>
@@ -469,6 +469,7 @@ namespace casual
                   std::string address;
                   std::optional< std::vector< std::string>> services;
                   std::optional< std::vector< std::string>> queues;
+                  std::optional< platform::size::type> stripes;
                   std::optional< std::string> note;
 
 
@@ -477,6 +478,7 @@ namespace casual
                      CASUAL_SERIALIZE( note);
                      CASUAL_SERIALIZE( services);
                      CASUAL_SERIALIZE( queues);
+                     CASUAL_SERIALIZE( stripes);
                   ) 
                };
 
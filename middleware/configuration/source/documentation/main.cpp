@@ -257,6 +257,11 @@ limit.size     | the maximum allowed size of all inflight messages. If reached,
 limit.messages | the maximum allowed number of inflight messages. If reached, _inbound-group_ will stop taking more request until below the limit
 connections    | all the connections for this group
 
+When a limit is reached, each connection gets a fair share of the limit, and only the connections that use 
+more than their share are throttled (not read from), so one busy remote domain can't starve the others. 
+Outbounds that 'speak' protocol `1.4` are granted credit, one request per credit, based on the share of 
+`limit.messages` (1024 if not set), and will hold back requests until the inbound grants more.
+
 ##### domain.gateway.inbound.groups.connection
 
 
@@ -298,12 +303,18 @@ property       | description
 address        | the address to connect to, `host:port` 
 services       | services we're expecting to find on the other side 
 queues         | queues we're expecting to find on the other side 
+stripes        | number of parallel tcp connections to the address (default `1`)
 
 `services` and `queues` is used as an _optimization_ to do a _build_ discovery during startup. `casual`
 will find these services later lazily otherwise. It can also be used to do some rudimentary load balancing 
 to make sure lower prioritized connections are used for `services` and `queues` that could be discovered in
 higher prioritized connections.
 
+`stripes` > 1 makes the _outbound group_ establish that many connections to the same address. Calls are load balanced
+over the stripes as any other connections, and large messages are fragmented and interleaved over the stripes, so 
+one large transfer does not block smaller messages behind it. Fragmentation requires that the other domain 
+supports protocol version `1003`. Has no effect for _reverse_ outbounds.
+
 )";
 
                   examples( out, example::user::part::domain::gateway());
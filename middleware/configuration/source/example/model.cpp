@@ -317,6 +317,7 @@ domain:
                      services:
                         -  s1
                         -  s2
+                     stripes: 4
                   -  address: a46.domain.host.org:7779
                      note: we expect to find queues 'q1' and 'q2' and service 's1'
                      services:
@@ -245,6 +245,7 @@ namespace casual
                Connection& Connection::operator += ( Connection rhs)
                {
                   note = algorithm::coalesce( std::move( rhs.note), std::move( note));
+                  stripes = rhs.stripes;
 
                   algorithm::append_unique( rhs.services, services);
                   algorithm::append_unique( rhs.queues, queues);
@@ -426,6 +426,7 @@ namespace casual
                            result.address = connection.address;
                            result.services = local::empty_if_null( std::move( connection.services));
                            result.queues = local::empty_if_null( std::move( connection.queues));
+                           result.stripes = connection.stripes.value_or( result.stripes);
                            return result;
                         });
 
@@ -808,6 +809,8 @@ namespace casual
                         result.note = null_if_empty( value.note);
                         result.services = null_if_empty( value.services);
                         result.queues = null_if_empty( value.queues);
+                        if( value.stripes > 1)
+                           result.stripes = value.stripes;
                         return result;
                      });
                      return result;
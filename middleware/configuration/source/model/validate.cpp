@@ -48,6 +48,16 @@ namespace casual
             {
                algorithm::for_each( group.services, local::validate::instances);
             });
+
+            // gateway
+            algorithm::for_each( model.gateway.outbound.groups, []( auto& group)
+            {
+               algorithm::for_each( group.connections, []( auto& connection)
+               {
+                  if( connection.stripes < 1)
+                     code::raise::error( code::casual::invalid_configuration, "number of stripes has to be at least 1 - address: ", connection.address);
+               });
+            });
          }
       } // model
       
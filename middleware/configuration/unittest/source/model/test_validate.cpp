@@ -62,6 +62,23 @@ domain:
          EXPECT_NO_THROW( local::configuration( configuration));
          
       }
+
+      TEST( configuration_model_validate, gateway_outbound_stripes_0__expect_throw_invalid_configuration)
+      {
+         constexpr auto configuration = R"(
+domain:
+  name: model
+  gateway:
+    outbound:
+      groups:
+        - connections:
+          - address: localhost:7777
+            stripes: 0
+
+)";
+
+         EXPECT_THROW( local::configuration( configuration), std::system_error);
+      }
       
    } // configuration::model
 } // casual
\ No newline at end of file
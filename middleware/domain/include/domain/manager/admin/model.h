@@ -108,6 +108,29 @@ namespace casual
             }
          } // instance
 
+         struct Metric
+         {
+            platform::size::type count = 0;
+            platform::time::unit total = platform::time::unit::zero();
+
+            struct Limit 
+            {
+               platform::time::unit min = platform::time::unit::zero();
+               platform::time::unit max = platform::time::unit::zero();
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( min);
+                  CASUAL_SERIALIZE( max);
+               )
+            } limit;
+
+            CASUAL_CONST_CORRECT_SERIALIZE(
+               CASUAL_SERIALIZE( count);
+               CASUAL_SERIALIZE( total);
+               CASUAL_SERIALIZE( limit);
+            )
+         };
+
          template< typename H>
          struct Instance
          {
@@ -147,11 +170,25 @@ namespace casual
             std::vector< std::string> resources;
             std::vector< std::string> restriction;
 
+            //! time from spawn to connect of the instances
+            struct Startup
+            {
+               model::Metric spawn;
+               //! instances forked from a zygote
+               model::Metric zygote;
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( spawn);
+                  CASUAL_SERIALIZE( zygote);
+               )
+            } startup;
+
             CASUAL_CONST_CORRECT_SERIALIZE(
                Process::serialize( archive);
                CASUAL_SERIALIZE( instances);
                CASUAL_SERIALIZE( resources);
                CASUAL_SERIALIZE( restriction);
+               CASUAL_SERIALIZE( startup);
             )
          };
 
@@ -167,6 +204,57 @@ namespace casual
             )
          };
 
+         namespace boot
+         {
+            struct Process
+            {
+               std::string alias;
+               common::strong::process::id pid;
+               platform::time::point::type spawned;
+               //! zero if the process is not ready (yet)
+               platform::time::point::type ready;
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( alias);
+                  CASUAL_SERIALIZE( pid);
+                  CASUAL_SERIALIZE( spawned);
+                  CASUAL_SERIALIZE( ready);
+               )
+            };
+
+            struct Group
+            {
+               std::string name;
+               std::vector< std::string> dependencies;
+               platform::time::point::type start;
+               //! zero if the group is not done (yet)
+               platform::time::point::type done;
+               std::vector< boot::Process> processes;
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( name);
+                  CASUAL_SERIALIZE( dependencies);
+                  CASUAL_SERIALIZE( start);
+                  CASUAL_SERIALIZE( done);
+                  CASUAL_SERIALIZE( processes);
+               )
+            };
+
+            //! readiness timings of the boot of the domain
+            struct Profile
+            {
+               platform::time::point::type start;
+               platform::time::point::type done;
+               std::vector< boot::Group> groups;
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( start);
+                  CASUAL_SERIALIZE( done);
+                  CASUAL_SERIALIZE( groups);
+               )
+            };
+         } // boot
+
          namespace state
          {
             enum class Runlevel : int
@@ -220,6 +308,8 @@ namespace casual
 
             } event;
 
+            model::boot::Profile boot;
+
             CASUAL_CONST_CORRECT_SERIALIZE({
                CASUAL_SERIALIZE( runlevel);
                CASUAL_SERIALIZE( version);
@@ -229,6 +319,7 @@ namespace casual
                CASUAL_SERIALIZE( servers);
                CASUAL_SERIALIZE( tasks);
                CASUAL_SERIALIZE( event);
+               CASUAL_SERIALIZE( boot);
             })
 
          };
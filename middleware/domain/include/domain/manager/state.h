@@ -18,6 +18,8 @@
 #include "common/uuid.h"
 #include "common/state/machine.h"
 #include "common/process.h"
+#include "common/process/zygote.h"
+#include "common/metric.h"
 
 #include "common/event/dispatch.h"
 
@@ -153,6 +155,8 @@ namespace casual
             handle_type handle;
             state_type state = state_type::scale_out;
             platform::time::point::type spawnpoint = platform::time::point::limit::zero();
+            //! true if the instance is forked from a zygote
+            bool zygote = false;
             
             void spawned( common::strong::process::id pid)
             {
@@ -167,6 +171,7 @@ namespace casual
                CASUAL_SERIALIZE( handle);
                CASUAL_SERIALIZE( state);
                CASUAL_SERIALIZE( spawnpoint);
+               CASUAL_SERIALIZE( zygote);
             )
          };
 
@@ -255,34 +260,125 @@ namespace casual
 
             bool connect( const common::process::Handle& process);
 
+            //! time from spawn to connect of the instances
+            struct
+            {
+               common::Metric spawn;
+               //! instances forked from a zygote
+               common::Metric zygote;
+
+               CASUAL_LOG_SERIALIZE(
+                  CASUAL_SERIALIZE( spawn);
+                  CASUAL_SERIALIZE( zygote);
+               )
+            } startup;
+
             friend bool operator == ( const Server& lhs, common::strong::process::id rhs);
             inline friend bool operator == ( common::strong::process::id lhs, const Server& rhs) { return rhs == lhs;}
 
             CASUAL_LOG_SERIALIZE({
                Process::serialize( archive);;
                CASUAL_SERIALIZE( instances);
+               CASUAL_SERIALIZE( startup);
             })
          };
 
+         //! A pre-loaded 'template' process of a server, that new instances are forked from
+         struct Zygote
+         {
+            Server::id_type id;
+            common::process::zygote::Handle handle;
+
+            inline friend bool operator == ( const Zygote& lhs, Server::id_type rhs) { return lhs.id == rhs;}
+            inline friend bool operator == ( const Zygote& lhs, common::strong::process::id rhs) { return lhs.handle.pid() == rhs;}
+
+            CASUAL_LOG_SERIALIZE(
+               CASUAL_SERIALIZE( id);
+               CASUAL_SERIALIZE( handle);
+            )
+         };
+
          namespace dependency
          {
             struct Group
             {
+               //! the group this dependency group represent, if any
+               strong::group::id id;
                std::string description;
                std::vector< Server::id_type> servers;
                std::vector< Executable::id_type> executables;
 
+               //! the dependency groups that has to be done before this one is started.
+               //! No dependencies -> can be started directly.
+               std::vector< strong::group::id> dependencies;
+
                inline explicit operator bool() const noexcept { return ! servers.empty() || ! executables.empty();}
 
+               inline friend bool operator == ( const Group& lhs, strong::group::id rhs) { return lhs.id == rhs;}
+
                CASUAL_LOG_SERIALIZE(
+                  CASUAL_SERIALIZE( id);
                   CASUAL_SERIALIZE( description);
                   CASUAL_SERIALIZE( executables);
                   CASUAL_SERIALIZE( servers);
+                  CASUAL_SERIALIZE( dependencies);
                )
             };
             
          } // dependency
 
+         namespace boot
+         {
+            struct Process
+            {
+               std::string alias;
+               common::strong::process::id pid;
+               platform::time::point::type spawned = platform::time::point::limit::zero();
+               //! when the process is ready (server connected, executable spawned), zero if not ready
+               platform::time::point::type ready = platform::time::point::limit::zero();
+
+               inline friend bool operator == ( const Process& lhs, common::strong::process::id rhs) { return lhs.pid == rhs;}
+
+               CASUAL_LOG_SERIALIZE(
+                  CASUAL_SERIALIZE( alias);
+                  CASUAL_SERIALIZE( pid);
+                  CASUAL_SERIALIZE( spawned);
+                  CASUAL_SERIALIZE( ready);
+               )
+            };
+
+            struct Group
+            {
+               std::string name;
+               std::vector< std::string> dependencies;
+               platform::time::point::type start = platform::time::point::limit::zero();
+               platform::time::point::type done = platform::time::point::limit::zero();
+               std::vector< boot::Process> processes;
+
+               CASUAL_LOG_SERIALIZE(
+                  CASUAL_SERIALIZE( name);
+                  CASUAL_SERIALIZE( dependencies);
+                  CASUAL_SERIALIZE( start);
+                  CASUAL_SERIALIZE( done);
+                  CASUAL_SERIALIZE( processes);
+               )
+            };
+
+            //! the timings of the (latest) boot of the domain
+            struct Profile
+            {
+               platform::time::point::type start = platform::time::point::limit::zero();
+               platform::time::point::type done = platform::time::point::limit::zero();
+               std::vector< boot::Group> groups;
+
+               CASUAL_LOG_SERIALIZE(
+                  CASUAL_SERIALIZE( start);
+                  CASUAL_SERIALIZE( done);
+                  CASUAL_SERIALIZE( groups);
+               )
+            };
+         } // boot
+
 
          namespace is
          {
@@ -324,6 +420,9 @@ namespace casual
          //! this process.
          std::vector< common::process::Handle> grandchildren;
 
+         //! zygotes of the servers that has zygote mode enabled, see `CASUAL_DOMAIN_ZYGOTE`
+         std::vector< state::Zygote> zygotes;
+
          //! executable id of this domain manager
          state::Server::id_type manager_id;
 
@@ -387,6 +486,9 @@ namespace casual
          //! the 'singleton' file for the domain
          common::file::scoped::Path singleton_file;
 
+         //! readiness timings of the domain boot
+         state::boot::Profile boot;
+
 
          //! Cleans up an exit (server or executable).
          //!
@@ -441,6 +543,7 @@ namespace casual
             CASUAL_SERIALIZE( groups);
             CASUAL_SERIALIZE( servers);
             CASUAL_SERIALIZE( executables);
+            CASUAL_SERIALIZE( zygotes);
             CASUAL_SERIALIZE( group_id);
             CASUAL_SERIALIZE( whitelisted);
             CASUAL_SERIALIZE( configuration);
@@ -668,12 +668,120 @@ for all servers and executables
                   } // state
                } // global
 
+               namespace boot::profile
+               {
+                  struct Step
+                  {
+                     const admin::model::boot::Group* group = nullptr;
+                     //! the process in the group that took the longest time to be ready, if any
+                     const admin::model::boot::Process* slowest = nullptr;
+                  };
+
+                  //! @returns the critical path of the boot. The group that was done last, and (recursive) the 
+                  //! dependency of the group that was done last. 
+                  auto critical( const admin::model::boot::Profile& profile)
+                  {
+                     std::vector< Step> result;
+
+                     auto later = []( auto& group, auto current){ return group.done != platform::time::point::limit::zero() && ( ! current || group.done > current->done);};
+
+                     const admin::model::boot::Group* current = nullptr;
+
+                     for( auto& group : profile.groups)
+                        if( later( group, current))
+                           current = &group;
+
+                     while( current)
+                     {
+                        Step step;
+                        step.group = current;
+
+                        for( auto& process : current->processes)
+                        {
+                           if( process.ready == platform::time::point::limit::zero())
+                              continue;
+
+                           if( ! step.slowest || process.ready - process.spawned > step.slowest->ready - step.slowest->spawned)
+                              step.slowest = &process;
+                        }
+
+                        result.push_back( step);
+
+                        auto dependencies = current->dependencies;
+                        current = nullptr;
+
+                        for( auto& group : profile.groups)
+                           if( algorithm::find( dependencies, group.name) && later( group, current))
+                              current = &group;
+                     }
+
+                     return algorithm::reverse( result);
+                  }
+
+                  void invoke()
+                  {
+                     auto state = call::state();
+
+                     if( state.boot.start == platform::time::point::limit::zero())
+                        return;
+
+                     using second_t = std::chrono::duration< double>;
+                     auto seconds = []( auto duration){ return std::chrono::duration_cast< second_t>( duration).count();};
+
+                     auto origin = state.boot.start;
+
+                     auto format_group = []( auto& step) { return step.group->name;};
+                     auto format_start = [&]( auto& step) { return seconds( step.group->start - origin);};
+                     auto format_done = [&]( auto& step) { return seconds( step.group->done - origin);};
+                     auto format_duration = [&]( auto& step) { return seconds( step.group->done - step.group->start);};
+                     auto format_processes = []( auto& step) { return step.group->processes.size();};
+                     auto format_slowest = []( auto& step) -> std::string { return step.slowest ? step.slowest->alias : "-";};
+                     auto format_ready = [&]( auto& step) { return step.slowest ? seconds( step.slowest->ready - step.slowest->spawned) : 0.0;};
+
+                     auto formatter = terminal::format::formatter< Step>::construct(
+                        terminal::format::column( "group", format_group, terminal::color::yellow, terminal::format::Align::left),
+                        terminal::format::column( "start", format_start, terminal::color::no_color, terminal::format::Align::right),
+                        terminal::format::column( "done", format_done, terminal::color::no_color, terminal::format::Align::right),
+                        terminal::format::column( "duration", format_duration, terminal::color::red, terminal::format::Align::right),
+                        terminal::format::column( "P", format_processes, terminal::color::white, terminal::format::Align::right),
+                        terminal::format::column( "slowest", format_slowest, terminal::color::cyan, terminal::format::Align::left),
+                        terminal::format::column( "ready", format_ready, terminal::color::red, terminal::format::Align::right)
+                     );
+
+                     formatter.print( std::cout, critical( state.boot));
+                  }
+
+                  constexpr auto description = R"(the critical path of the latest domain boot
+
+The group that was done last, and recursive the dependency of the group that was done last.
+All times are in seconds, start and done are relative to the start of the boot.
+)";
+
+                  constexpr auto legend = R"(
+   group:
+      the name of the group on the critical path
+   start:
+      when the group was started (all dependencies done), relative to the start of the boot
+   done:
+      when all processes in the group was ready, relative to the start of the boot
+   duration:
+      the time from start to done of the group
+   P:
+      number of processes spawned in the group
+   slowest:
+      the alias of the process in the group that took the longest time to be ready
+   ready:
+      the time from spawn to ready of the slowest process
+)";
+               } // boot::profile
+
                namespace legend
                {
                   const std::map< std::string, const char*> legends{
                      { "list-servers", action::list::servers::legend},
                      { "list-executables", action::list::executables::legend},
                      { "ping", action::ping::legend},
+                     { "boot-profile", action::boot::profile::legend},
                   };
                   
                   
@@ -728,6 +836,27 @@ note: not all options has legend, use 'auto complete' to find out which legends
                         });
                      };
 
+                     using second_t = std::chrono::duration< double>;
+
+                     auto startup = []( auto& servers, auto extract) -> second_t
+                     {
+                        auto metric = algorithm::accumulate( servers, manager::admin::model::Metric{}, [&extract]( auto result, auto& server)
+                        {
+                           auto& value = extract( server.startup);
+                           result.count += value.count;
+                           result.total += value.total;
+                           return result;
+                        });
+
+                        if( metric.count == 0)
+                           return {};
+
+                        return std::chrono::duration_cast< second_t>( metric.total / metric.count);
+                     };
+
+                     auto spawn = []( auto& startup) -> auto& { return startup.spawn;};
+                     auto zygote = []( auto& startup) -> auto& { return startup.zygote;};
+
                      return {
                         { "version.casual", state.version.casual},
                         { "version.compiler", state.version.compiler},
@@ -741,6 +870,8 @@ note: not all options has legend, use 'auto complete' to find out which legends
                         { "domain.manager.server.instances.scale.out", string::compose( instances_count( state.servers, scale_out))},
                         { "domain.manager.server.instances.scale.in", string::compose( instances_count( state.servers, scale_in))},
                         { "domain.manager.server.restarts", string::compose( restarts( state.servers))},
+                        { "domain.manager.server.startup.spawn.average", string::compose( startup( state.servers, spawn))},
+                        { "domain.manager.server.startup.zygote.average", string::compose( startup( state.servers, zygote))},
                         { "domain.manager.executable.instances.configured",string::compose( instances_count( state.executables, all))},
                         { "domain.manager.executable.instances.running",string::compose( instances_count( state.executables, running))},
                         { "domain.manager.executable.instances.scale.out", string::compose( instances_count( state.executables, scale_out))},
@@ -1174,6 +1305,7 @@ The semantics are similar to http PUT:
                argument::Option( &local::action::global::state::invoke, local::action::global::state::complete(), { "--instance-global-state"}, local::action::global::state::description),
                argument::Option( &local::action::legend::invoke, local::action::legend::complete(), { "--legend"}, local::action::legend::description),
                argument::Option( &local::action::information::invoke, { "--information"}, local::action::information::description),
+               argument::Option( &local::action::boot::profile::invoke, { "--boot-profile"}, local::action::boot::profile::description),
                argument::Option( &local::action::state, state_format, { "--state"}, "domain state (as provided format)"),
 
                local::option::log::reopen(),
@@ -140,6 +140,15 @@ namespace casual
                      return manager::task::create::scale::aliases( { std::move( group)});
                   }
 
+                  //! discards the zygotes of the servers, they're spawned with the old configuration
+                  void discard( State& state, const std::vector< state::Server::id_type>& servers)
+                  {
+                     algorithm::container::trim( state.zygotes, algorithm::remove_if( state.zygotes, [&servers]( auto& zygote)
+                     {
+                        return algorithm::contains( servers, zygote.id);
+                     }));
+                  }
+
                   manager::Task remove( State& state, const Change& change)
                   {
                      auto scale_and_get_id = []( auto& entities, auto& removed)
@@ -158,6 +167,8 @@ namespace casual
                      group.servers = scale_and_get_id( state.servers, change.servers.removed);
                      group.executables = scale_and_get_id( state.executables, change.executables.removed);
 
+                     entity::discard( state, group.servers);
+
                      return manager::task::create::remove::aliases( { std::move( group)});
                   }
 
@@ -184,6 +195,8 @@ namespace casual
                      group.servers = modify_and_get_id( state.servers, change.servers.modified);
                      group.executables = modify_and_get_id( state.executables, change.executables.modified);
 
+                     entity::discard( state, group.servers);
+
                      return manager::task::create::scale::aliases( { std::move( group)});
                   }
 
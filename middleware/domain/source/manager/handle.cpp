@@ -23,6 +23,7 @@
 #include "common/environment.h"
 #include "common/algorithm/compare.h"
 #include "common/algorithm.h"
+#include "common/array.h"
 
 #include "common/instance.h"
 
@@ -49,6 +50,68 @@ namespace casual
 
                   return common::process::spawn( executable.path, executable.arguments, std::move( variables));
                }
+
+               namespace zygote
+               {
+                  //! @returns true if instances of `server` should be forked from a zygote
+                  bool enabled( const State& state, const state::Server& server, const std::vector< environment::Variable>& variables)
+                  {
+                     if( ! common::process::zygote::supported())
+                        return false;
+
+                     // we keep casual's own servers as is
+                     auto internal = array::make( state.group_id.core, state.group_id.master, state.group_id.transaction, state.group_id.queue, state.group_id.gateway);
+                     if( algorithm::find_first_of( server.memberships, internal))
+                        return false;
+
+                     auto found = algorithm::find_if( variables, []( auto& variable)
+                     { 
+                        return variable.name() == environment::variable::name::domain::zygote;
+                     });
+
+                     return found && found->value() == "1";
+                  }
+
+                  //! @returns the pid of the instance forked from the zygote of `server`, if any and ready
+                  //! @attention blocks until the zygote replies, bounded by `platform::process::zygote::timeout`
+                  //!   once per zygote, see `common::process::zygote::Handle::fork`.
+                  strong::process::id fork( State& state, const state::Server& server, const instance::Information& instance)
+                  {
+                     if( auto found = algorithm::find( state.zygotes, server.id))
+                        return found->handle.fork( instance);
+
+                     return {};
+                  }
+
+                  strong::process::id fork( State&, const state::Executable&, const instance::Information&)
+                  {
+                     return {};
+                  }
+
+                  //! spawns the zygote for `server`, if enabled. Only one attempt is made, if the zygote
+                  //! fails it's not replaced until the server is (re)configured.
+                  void prepare( State& state, const state::Server& server, const std::vector< environment::Variable>& variables)
+                  {
+                     if( algorithm::find( state.zygotes, server.id) || ! zygote::enabled( state, server, variables))
+                        return;
+
+                     try
+                     {
+                        state.zygotes.push_back( state::Zygote{ server.id, common::process::zygote::Handle{ server.path, server.arguments, variables}});
+                        log::line( verbose::log, "zygote: ", state.zygotes.back());
+                     }
+                     catch( ...)
+                     {
+                        log::line( log::category::error, exception::capture(), " failed to spawn zygote: ", server.path);
+                        state.zygotes.push_back( state::Zygote{ server.id, common::process::zygote::Handle{}});
+                     }
+                  }
+
+                  void prepare( State&, const state::Executable&, const std::vector< environment::Variable>&)
+                  {
+                  }
+
+               } // zygote
                
 
                template< typename E>
@@ -78,7 +141,10 @@ namespace casual
 
                      try 
                      {
-                        range->spawned( scale::spawn( entity, instance, variables));
+                        auto pid = zygote::fork( state, entity, instance);
+                        range->zygote = pid.valid();
+
+                        range->spawned( pid ? pid : scale::spawn( entity, instance, variables));
                      }
                      catch( ...)
                      {
@@ -112,6 +178,9 @@ namespace casual
                      ipc::push( message);
                   }
 
+                  // next scale out could be forked from the zygote
+                  zygote::prepare( state, entity, variables);
+
                   log::line( verbose::log, "entity: ", entity);
                }
 
@@ -272,6 +341,9 @@ namespace casual
          // abort all abortble running or pending task
          state.tasks.abort( state);
 
+         // zygotes exits when the socket is closed
+         state.zygotes.clear();
+
          // prepare scaling to 0
          auto prepare_shutdown = []( auto& entity)
          {
@@ -932,6 +1004,15 @@ namespace casual
                         return;
                      }
 
+                     if( auto found = algorithm::find( state.zygotes, message.process.pid))
+                     {
+                        // the binary did not stop in zygote mode, hence it can't be used as one
+                        log::line( log::category::error, code::casual::invalid_semantics, " zygote connected as a regular process: ", *found, " - action: deny connect, discard zygote");
+                        found->handle = {};
+                        detail::send::reply( state, Directive::denied, message);
+                        return;
+                     }
+
                      if( detail::singleton::connect( state, message))
                         return; // singleton, and handled.
                  
@@ -248,8 +248,16 @@ namespace casual
          {
             if( auto found = algorithm::find( instances, process.pid))
             {
+               // first connect of the spawned instance
+               if( found->state == instance::State::spawned)
+               {
+                  auto duration = platform::time::clock::type::now() - found->spawnpoint;
+                  ( found->zygote ? startup.zygote : startup.spawn) += duration;
+               }
+
                found->handle = process;
                found->state = instance::State::running;
+
                return true;
             }
             return false;
@@ -319,6 +327,13 @@ namespace casual
 
          algorithm::container::trim( configuration.suppliers, algorithm::remove( configuration.suppliers, pid));
 
+         if( auto found = algorithm::find( zygotes, pid))
+         {
+            // we keep the entry, so we don't try to spawn a new zygote for the server
+            log::line( log, "zygote exited: ", *found);
+            found->handle = {};
+         }
+
          using result_type = std::tuple< state::Server*, state::Executable*>;
 
          // Check if it's a server
@@ -7,6 +7,8 @@
 #include "domain/manager/state/order.h"
 
 #include "common/algorithm.h"
+#include "common/algorithm/container.h"
+#include "common/array.h"
 
 namespace casual
 {
@@ -15,6 +17,76 @@ namespace casual
    namespace domain::manager::state::order
    {
 
+      namespace local
+      {
+         namespace
+         {
+            namespace dependencies
+            {
+               //! @returns the 'raw' group dependencies for `group`, that is, the dependencies of the 
+               //! group and of all the other memberships of the entities in the group
+               auto raw( const State& state, const state::dependency::Group& group)
+               {
+                  std::vector< strong::group::id> result;
+
+                  auto add_dependencies = [&]( auto id)
+                  {
+                     if( auto found = algorithm::find( state.groups, id))
+                        algorithm::append( found->dependencies, result);
+                  };
+
+                  add_dependencies( group.id);
+
+                  auto add_memberships = [&]( auto id)
+                  {
+                     for( auto membership : state.entity( id).memberships)
+                        if( membership != group.id)
+                           add_dependencies( membership);
+                  };
+
+                  algorithm::for_each( group.servers, add_memberships);
+                  algorithm::for_each( group.executables, add_memberships);
+
+                  // casual's own managers are booted in 'layers', user groups are 
+                  // implicitly dependent on them, even if not explicitly configured.
+                  auto internal = array::make( state.group_id.core, state.group_id.master, state.group_id.transaction, state.group_id.queue);
+
+                  if( ! algorithm::find( internal, group.id))
+                     algorithm::append( internal, result);
+
+                  return result;
+               }
+
+               //! resolves `ids` to the groups that are part of `groups`. The (empty) groups 
+               //! that are not part of `groups` are transitive replaced with their dependencies.
+               auto resolve( const State& state, const std::vector< state::dependency::Group>& groups, std::vector< strong::group::id> ids)
+               {
+                  std::vector< strong::group::id> result;
+                  std::vector< strong::group::id> visited;
+
+                  while( ! ids.empty())
+                  {
+                     auto id = ids.back();
+                     ids.pop_back();
+
+                     if( algorithm::find( visited, id))
+                        continue;
+
+                     visited.push_back( id);
+
+                     if( algorithm::find( groups, id))
+                        result.push_back( id);
+                     else if( auto found = algorithm::find( state.groups, id))
+                        algorithm::append( found->dependencies, ids);
+                  }
+
+                  return algorithm::sort( result);
+               }
+
+            } // dependencies
+         } // <unnamed>
+      } // local
+
       std::vector< state::dependency::Group> boot(
          const State& state,
          const std::vector< Server>& source_servers, 
@@ -36,6 +108,7 @@ namespace casual
          auto batch_transform = [&]( const Group& group)
          {
             state::dependency::Group dependency;
+            dependency.id = group.id;
             dependency.description = group.name;
 
             auto extract = [&]( auto& entities, auto& output)
@@ -68,7 +141,17 @@ namespace casual
          algorithm::container::trim( result, algorithm::remove_if( result, []( auto& group){ return group.servers.empty() && group.executables.empty();}));
 
          // We reverse the result so the dependency order is correct
-         return algorithm::reverse( result);
+         algorithm::reverse( result);
+
+         // take care of the dependencies between the (non empty) groups, so the groups 
+         // can be booted as a DAG
+         for( auto& group : result)
+         {
+            group.dependencies = local::dependencies::resolve( state, result, local::dependencies::raw( state, group));
+            algorithm::container::trim( group.dependencies, algorithm::remove( group.dependencies, group.id));
+         }
+
+         return result;
       }
 
 
@@ -79,7 +162,22 @@ namespace casual
 
       std::vector< state::dependency::Group> shutdown( const State& state)
       {
-         return algorithm::reverse( boot( state));
+         auto groups = boot( state);
+
+         // invert the dependencies, a group has to wait for the groups that depends on it.
+         auto dependents = algorithm::transform( groups, [&groups]( auto& group)
+         {
+            std::vector< strong::group::id> result;
+            for( auto& other : groups)
+               if( algorithm::find( other.dependencies, group.id))
+                  result.push_back( other.id);
+            return result;
+         });
+
+         for( auto index = 0; index < range::size( groups); ++index)
+            groups[ index].dependencies = std::move( dependents[ index]);
+
+         return algorithm::reverse( groups);
       }
 
 
@@ -16,6 +16,7 @@
 #include "common/algorithm/compare.h"
 #include "common/algorithm/container.h"
 #include "common/log/stream.h"
+#include "common/environment.h"
 
 
 namespace casual
@@ -353,129 +354,327 @@ namespace casual
          {
             namespace 
             {
+               namespace entity
+               {
+                  template< typename ID>
+                  bool done( State& state, ID id)
+                  {
+                     return algorithm::none_of( state.entity( id).instances, []( auto& i)
+                     {
+                        using Enum = decltype( i.state);
+                        return algorithm::compare::any( i.state, Enum::scale_out, Enum::scale_in, Enum::spawned);
+                     });
+                  }
+
+                  auto& ids( const state::dependency::Group& group, state::Server::id_type) { return group.servers;}
+                  auto& ids( const state::dependency::Group& group, state::Executable::id_type) { return group.executables;}
+               } // entity
+
                namespace group
                {
                   auto done( State& state, const state::dependency::Group& group)
                   {
-                     auto is_done = [&state]( auto id)
+                     auto is_done = [&state]( auto id){ return entity::done( state, id);};
+
+                     return algorithm::all_of( group.servers, is_done) && algorithm::all_of( group.executables, is_done);
+                  };
+
+                  //! Scales the groups as a DAG. A group is started as soon as all its dependencies are done,
+                  //! and the entities of the started groups are scaled as long as the number of entities that
+                  //! are not done is within the parallelism (0 -> unbounded).
+                  struct Progress
+                  {
+                     struct Pending
                      {
-                        auto& entity = state.entity( id);
+                        state::dependency::Group group;
+                        bool started = false;
+
+                        CASUAL_LOG_SERIALIZE(
+                           CASUAL_SERIALIZE( group);
+                           CASUAL_SERIALIZE( started);
+                        )
+                     };
+
+                     struct Entities
+                     {
+                        std::vector< state::Server::id_type> servers;
+                        std::vector< state::Executable::id_type> executables;
+
+                        auto size() const noexcept { return range::size( servers) + range::size( executables);}
+                        bool empty() const noexcept { return servers.empty() && executables.empty();}
+
+                        CASUAL_LOG_SERIALIZE(
+                           CASUAL_SERIALIZE( servers);
+                           CASUAL_SERIALIZE( executables);
+                        )
+                     };
+
+                     Progress( std::vector< state::dependency::Group> groups, platform::size::type parallelism, bool profile)
+                        : groups{ algorithm::transform( groups, []( auto& group){ return Pending{ std::move( group)};})},
+                        parallelism{ parallelism}, profile{ profile}
+                     {}
+
+                     //! removes the groups that are already done, and starts the profiling, if any.
+                     //! @returns true if there is nothing to do
+                     bool prepare( State& state)
+                     {
+                        algorithm::container::trim( groups, algorithm::remove_if( groups, [&state]( auto& pending){ return group::done( state, pending.group);}));
+
+                        if( profile)
+                        {
+                           state.boot = {};
+                           state.boot.start = platform::time::clock::type::now();
+                           if( groups.empty())
+                              state.boot.done = state.boot.start;
+                        }
+
+                        return groups.empty();
+                     }
+
+                     //! @returns true if all groups are done
+                     bool operator () ( State& state, const manager::task::Context& context)
+                     {
+                        // scaled entities could be done directly (executables), hence we loop until
+                        // there is nothing more to scale.
+                        do
+                        {
+                           done( state, context);
+                           start( state);
+                        }
+                        while( scale( state));
+                        
+                        if( ! groups.empty())
+                           return false;
+
+                        if( profile)
+                           state.boot.done = platform::time::clock::type::now();
+
+                        return true;
+                     }
+
+                     //! the process is ready (server connected)
+                     void ready( State& state, common::strong::process::id pid)
+                     {
+                        if( ! profile)
+                           return;
+
+                        for( auto& group : state.boot.groups)
+                           if( auto found = algorithm::find( group.processes, pid))
+                              if( found->ready == platform::time::point::limit::zero())
+                                 found->ready = platform::time::clock::type::now();
+                     }
 
-                        return algorithm::none_of( entity.instances, []( auto& i)
+                     std::vector< Pending> groups;
+                     platform::size::type parallelism{};
+                     bool profile = false;
+
+                     //! entities of started groups that are not scaled yet
+                     Entities queued;
+                     //! scaled entities that are not done
+                     Entities scaling;
+
+                     CASUAL_LOG_SERIALIZE(
+                        CASUAL_SERIALIZE( groups);
+                        CASUAL_SERIALIZE( parallelism);
+                        CASUAL_SERIALIZE( profile);
+                        CASUAL_SERIALIZE( queued);
+                        CASUAL_SERIALIZE( scaling);
+                     )
+
+                  private:
+
+                     void done( State& state, const manager::task::Context& context)
+                     {
+                        auto entity_done = [&state]( auto id){ return entity::done( state, id);};
+                        algorithm::container::trim( scaling.servers, algorithm::remove_if( scaling.servers, entity_done));
+                        algorithm::container::trim( scaling.executables, algorithm::remove_if( scaling.executables, entity_done));
+
+                        auto is_active = [&]( auto& pending)
+                        {
+                           return ! pending.started
+                              || algorithm::find_first_of( pending.group.servers, queued.servers)
+                              || algorithm::find_first_of( pending.group.executables, queued.executables)
+                              || ! group::done( state, pending.group);
+                        };
+
+                        auto [ active, done] = algorithm::stable::partition( groups, is_active);
+
+                        algorithm::for_each( done, [&]( auto& pending)
                         {
-                           using Enum = decltype( i.state);
-                           return algorithm::compare::any( i.state, Enum::scale_out, Enum::scale_in, Enum::spawned);
+                           log::line( verbose::log, "group done: ", pending.group);
+
+                           if( profile)
+                              if( auto found = algorithm::find_if( state.boot.groups, [&pending]( auto& group){ return group.name == pending.group.description;}))
+                                 found->done = platform::time::clock::type::now();
+
+                           manager::task::event::dispatch( state, [&]()
+                           {
+                              common::message::event::sub::Task event{ common::process::handle()};
+                              event.correlation = context.id;
+                              event.description = pending.group.description;
+                              event.state = decltype( event.state)::done;
+                              return event;
+                           });
                         });
-                     };
 
-                     return algorithm::all_of( group.servers, is_done) && algorithm::all_of( group.executables, is_done);
-                  };
+                        algorithm::container::trim( groups, active);
+                     }
 
-                  auto scale( State& state, const state::dependency::Group& group)
-                  {
-                     auto scale_entity = [&state]( auto id)
+                     void start( State& state)
+                     {
+                        auto is_pending = [&]( auto id)
+                        {
+                           return predicate::boolean( algorithm::find_if( groups, [id]( auto& pending){ return pending.group.id == id;}));
+                        };
+
+                        for( auto& pending : groups)
+                        {
+                           if( pending.started || algorithm::any_of( pending.group.dependencies, is_pending))
+                              continue;
+
+                           log::line( verbose::log, "start group: ", pending.group);
+
+                           pending.started = true;
+                           algorithm::append( pending.group.servers, queued.servers);
+                           algorithm::append( pending.group.executables, queued.executables);
+
+                           if( profile)
+                           {
+                              auto& group = state.boot.groups.emplace_back();
+                              group.name = pending.group.description;
+                              group.dependencies = algorithm::transform( pending.group.dependencies, [&state]( auto id){ return state.group( id).name;});
+                              group.start = platform::time::clock::type::now();
+                           }
+                        }
+                     }
+
+                     //! @returns true if any entity was scaled
+                     bool scale( State& state)
+                     {
+                        auto room = [&](){ return parallelism == 0 || scaling.size() < parallelism;};
+
+                        auto scale_front = [&]( auto& queued, auto& scaling)
+                        {
+                           auto id = queued.front();
+                           queued.erase( std::begin( queued));
+                           scale( state, id);
+                           scaling.push_back( id);
+                        };
+
+                        bool result = false;
+
+                        while( ! queued.empty() && room())
+                        {
+                           if( ! queued.servers.empty())
+                              scale_front( queued.servers, scaling.servers);
+                           else
+                              scale_front( queued.executables, scaling.executables);
+
+                           result = true;
+                        }
+
+                        return result;
+                     }
+
+                     template< typename ID>
+                     void scale( State& state, ID id)
                      {
-                        Trace trace{ "domain::manager::task::create::local::scale::group::scale"};
+                        Trace trace{ "domain::manager::task::create::local::scale::group::Progress::scale"};
 
                         auto& entity = state.entity( id);
                         log::line( verbose::log, "entity: ", entity);
 
+                        auto pids = algorithm::transform( entity.instances, []( auto& instance){ return common::process::id( instance.handle);});
+
                         // scale it
                         handle::scale::instances( state, entity);
-                     };
 
-                     algorithm::for_each( group.servers, scale_entity);
-                     algorithm::for_each( group.executables, scale_entity);
-                  }
+                        if( ! profile)
+                           return;
+
+                        auto has_entity = [id]( auto& pending){ return predicate::boolean( algorithm::find( entity::ids( pending.group, id), id));};
+
+                        auto pending = algorithm::find_if( groups, has_entity);
+                        if( ! pending)
+                           return;
+
+                        auto group = algorithm::find_if( state.boot.groups, [&pending]( auto& group){ return group.name == pending->group.description;});
+                        if( ! group)
+                           return;
+
+                        for( auto& instance : entity.instances)
+                        {
+                           auto pid = common::process::id( instance.handle);
+
+                           if( ! pid || algorithm::find( pids, pid))
+                              continue;
+
+                           auto& process = group->processes.emplace_back();
+                           process.alias = entity.alias;
+                           process.pid = pid;
+                           process.spawned = instance.spawnpoint;
+
+                           // executables are ready when they're spawned
+                           if( instance.state == decltype( instance.state)::running)
+                              process.ready = instance.spawnpoint;
+                        }
+                     }
+                  };
 
                   //! `done_callback` will be called when the task is done
                   template< typename Done> 
-                  auto task( std::vector< state::dependency::Group> groups, Done done_callback)
+                  auto task( std::vector< state::dependency::Group> groups, Done done_callback, platform::size::type parallelism = 0, bool profile = false)
                   {
                      Trace trace{ "domain::manager::task::create::local::scale::group::task create"};
                      log::line( verbose::log, "groups", groups);
 
-                     return [done_callback = std::move( done_callback), groups = std::move( groups)]( State& state, const manager::task::Context& context) mutable 
+                     return [done_callback = std::move( done_callback), progress = Progress{ std::move( groups), parallelism, profile}]( State& state, const manager::task::Context& context) mutable 
                         -> std::vector< manager::task::event::Callback>
                      {
                         Trace trace{ "domain::manager::task::create::local::scale::group::task start"};
 
-                        // we remove all 'groups' that are done.
-                        algorithm::container::trim( groups, algorithm::remove_if( groups, [&state]( auto& group){ return group::done( state, group);}));
-
-                        // TODO remove!
-                        log::line( verbose::log, "groups", groups);
-
                         // we could be done directly
-                        if( groups.empty())
+                        if( progress.prepare( state))
                            return {};
 
-                        // we take state and groups by reference since we know that the task
+                        log::line( verbose::log, "progress: ", progress);
+
+                        // we take state and progress by reference since we know that the task
                         // will outlive the callbacks
-                        auto progress = [context, &state, &groups, &done_callback]()
+                        auto invoke = [context, &state, &progress, &done_callback]()
                         {
-                           // returns true if groups are done
-                           auto consume = [&state, &context]( auto& groups)
-                           {
-                              auto [ done, remain] = algorithm::divide_if( groups, [&state]( auto& group){ return ! group::done( state, group);});
-
-                              // send sub-events, if any
-                              algorithm::for_each( done, [&]( auto& group)
-                              {
-                                 manager::task::event::dispatch( state, [&]()
-                                 {
-                                    common::message::event::sub::Task event{ common::process::handle()};
-                                    event.correlation = context.id;
-                                    event.description = group.description;
-                                    event.state = decltype( event.state)::done;
-                                    return event;
-                                 });
-                              });
-                              algorithm::container::trim( groups, remain);
-                              return ! done.empty() && ! groups.empty();
-                           };
-
-                           while( consume( groups))
-                           {
-                              // we've made progress, done's are removed, we scale next
-                              group::scale( state, groups.front());
-                           }
-                           
-                           // if groups are empty, we're 'done'
-                           if( ! groups.empty())
+                           if( ! progress( state, context))
                               return false;
-                           
+
                            done_callback( state);
-                           return true;                   
+                           return true;
                         };
 
-                        // we scale the first group (the back)
-                        group::scale( state, groups.front());
-
-                        // check the progress.
-                        if( progress())
+                        // we start the groups that has no dependencies, and check the progress.
+                        if( invoke())
                            return {};
 
                         return create::local::callbacks( 
-                           [ progress]( const common::message::event::process::Exit& message)
+                           [ invoke]( const common::message::event::process::Exit& message)
                            {
                               log::line( verbose::log, "process exit: ", message);
-                              return progress();
+                              return invoke();
                            },
-                           [ progress]( const common::message::event::process::Spawn& message)
+                           [ invoke]( const common::message::event::process::Spawn& message)
                            {
                               log::line( verbose::log, "process spawn: ", message);
-                              return progress();
+                              return invoke();
                            },
-                           [ progress]( const common::message::domain::process::connect::Request& message)
+                           [ invoke, &state, &progress]( const common::message::domain::process::connect::Request& message)
                            {
                               log::line( verbose::log, "server connect: ", message);
-                              return progress();
+                              progress.ready( state, message.process.pid);
+                              return invoke();
                            },
-                           [ progress]( const common::message::event::Idle& message)
+                           [ invoke]( const common::message::event::Idle& message)
                            {
                               log::line( verbose::log, "idle: ", message);
-                              return progress();
+                              return invoke();
                            }
                         );
 
@@ -486,6 +685,11 @@ namespace casual
                   {
                      return task( std::move( groups), []( auto& state){});
                   }
+
+                  auto parallelism()
+                  {
+                     return environment::variable::get( environment::variable::name::domain::boot::parallelism, platform::size::type{ 0});
+                  }
                   
                } // group  
             } // <unnamed>
@@ -506,7 +710,7 @@ namespace casual
 
             auto description = string::compose( "boot domain ", common::domain::identity().name);
 
-            return manager::Task{ correlation, std::move( description), local::group::task( std::move( groups), std::move( done_callback)),
+            return manager::Task{ correlation, std::move( description), local::group::task( std::move( groups), std::move( done_callback), local::group::parallelism(), true),
             {
                Task::Property::Execution::sequential,
                Task::Property::Completion::mandatory
@@ -518,7 +722,7 @@ namespace casual
          {
             Trace trace{ "domain::manager::task::create::scale::shutdown"};
 
-            return manager::Task{ "shutdown domain", local::group::task( std::move( groups)),
+            return manager::Task{ "shutdown domain", local::group::task( std::move( groups), []( auto& state){}, local::group::parallelism()),
             {
                Task::Property::Execution::sequential,
                Task::Property::Completion::mandatory
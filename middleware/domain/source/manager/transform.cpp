@@ -229,6 +229,19 @@ namespace casual
                   {
                      auto result = detail::transform< manager::admin::model::Server>( value);
 
+                     auto metric = []( const common::Metric& value)
+                     {
+                        manager::admin::model::Metric result;
+                        result.count = value.count;
+                        result.total = value.total;
+                        result.limit.min = value.limit.min;
+                        result.limit.max = value.limit.max;
+                        return result;
+                     };
+
+                     result.startup.spawn = metric( value.startup.spawn);
+                     result.startup.zygote = metric( value.startup.zygote);
+
                      return result;
                   };
                }
@@ -252,6 +265,34 @@ namespace casual
                   return result;
                }
 
+               auto boot( const manager::state::boot::Profile& profile)
+               {
+                  manager::admin::model::boot::Profile result;
+                  result.start = profile.start;
+                  result.done = profile.done;
+
+                  result.groups = algorithm::transform( profile.groups, []( auto& group)
+                  {
+                     manager::admin::model::boot::Group result;
+                     result.name = group.name;
+                     result.dependencies = group.dependencies;
+                     result.start = group.start;
+                     result.done = group.done;
+                     result.processes = algorithm::transform( group.processes, []( auto& process)
+                     {
+                        manager::admin::model::boot::Process result;
+                        result.alias = process.alias;
+                        result.pid = process.pid;
+                        result.spawned = process.spawned;
+                        result.ready = process.ready;
+                        return result;
+                     });
+                     return result;
+                  });
+
+                  return result;
+               }
+
             } // model
 
          } // <unnamed>
@@ -286,6 +327,7 @@ namespace casual
          result.executables = algorithm::transform( state.executables, local::model::excecutable());
          //result.event = local::model::event( state.event);
          result.tasks = local::model::tasks( state.tasks);
+         result.boot = local::model::boot( state.boot);
 
          return result;
       }
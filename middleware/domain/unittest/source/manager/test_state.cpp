@@ -209,6 +209,50 @@ domain:
             }
          }
 
+         TEST( domain_state_boot_order, group_a_b_c__c_depend_on_a__expect_c_to_only_wait_for_a)
+         {
+            common::unittest::Trace trace;
+
+            auto state = local::configure( R"(
+domain:
+  
+  name: unittest-domain
+
+  groups:
+    - name: a
+    - name: b
+    - name: c
+      dependencies: [ a]
+
+  executables:
+    - path: exe_a
+      memberships: [ a]
+    - path: exe_b
+      memberships: [ b]
+    - path: exe_c
+      memberships: [ c]
+
+)" );
+
+            auto id = [&state]( auto name){ return common::algorithm::find( state.groups, std::string{ name})->id;};
+
+            {
+               auto bootorder = state::order::boot( state);
+
+               EXPECT_TRUE( local::find_batch( state, bootorder, "a").dependencies.empty()) << CASUAL_NAMED_VALUE( bootorder);
+               EXPECT_TRUE( local::find_batch( state, bootorder, "b").dependencies.empty()) << CASUAL_NAMED_VALUE( bootorder);
+               EXPECT_TRUE( local::find_batch( state, bootorder, "c").dependencies == std::vector< strong::group::id>{ id( "a")}) << CASUAL_NAMED_VALUE( bootorder);
+            }
+
+            {
+               auto shutdownorder = state::order::shutdown( state);
+
+               EXPECT_TRUE( local::find_batch( state, shutdownorder, "a").dependencies == std::vector< strong::group::id>{ id( "c")}) << CASUAL_NAMED_VALUE( shutdownorder);
+               EXPECT_TRUE( local::find_batch( state, shutdownorder, "b").dependencies.empty()) << CASUAL_NAMED_VALUE( shutdownorder);
+               EXPECT_TRUE( local::find_batch( state, shutdownorder, "c").dependencies.empty()) << CASUAL_NAMED_VALUE( shutdownorder);
+            }
+         }
+
          TEST( domain_state_instances, executable_default)
          {
             common::unittest::Trace trace;
@@ -26,6 +26,11 @@ namespace casual
                   void fill( gateway::message::domain::disconnect::Request& message);
                   void fill( gateway::message::domain::disconnect::Reply& message);
 
+                  void fill( gateway::message::domain::Compressed& message);
+                  void fill( gateway::message::domain::stripe::Join& message);
+                  void fill( gateway::message::domain::stripe::Fragment& message);
+                  void fill( gateway::message::domain::flow::Credit& message);
+
                   void fill( gateway::message::domain::discovery::Request& message);
                   void fill( gateway::message::domain::discovery::Reply& message);
 
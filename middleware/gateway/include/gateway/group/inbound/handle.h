@@ -32,6 +32,22 @@ namespace casual
          
       } // connection
 
+      namespace flow
+      {
+         //! throttles (stops reading from) the connection if it uses more than its share of a congested 
+         //! pending buffer, resumes it when it does not. Grants the outbound more credit when half 
+         //! of its window is used.
+         void update( State& state, common::strong::file::descriptor::id descriptor);
+
+         //! a pending request from `descriptor` is consumed: updates the connection, and the
+         //! throttled connections that might be resumed since the pending buffer has shrunk.
+         void consumed( State& state, common::strong::file::descriptor::id descriptor);
+
+         //! updates all connections, used when a connection is lost
+         void update( State& state);
+         
+      } // flow
+
       //! take care of pending tasks, when message dispatch is idle.
       void idle( State& state);
       
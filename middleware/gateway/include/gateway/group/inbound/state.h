@@ -21,6 +21,7 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 namespace casual
 {
@@ -54,18 +55,33 @@ namespace casual
 
                   return m_limits.messages > 0 && static_cast< platform::size::type>( m_services.size() + m_complete.size()) > m_limits.messages;
                }
+
+               //! @returns the fair share of the limits for one of `connections` connections
+               pending::Limit share( platform::size::type connections) const noexcept;
+
+               //! @returns true if the buffer is congested, and the connection uses more than its share
+               bool congested( common::strong::file::descriptor::id descriptor, platform::size::type connections) const noexcept;
+
+               //! @returns the number of pending requests from the connection
+               platform::size::type messages( common::strong::file::descriptor::id descriptor) const noexcept;
+
+               //! @returns the number of bytes the pending requests from the connection uses
+               platform::size::type size( common::strong::file::descriptor::id descriptor) const noexcept;
+
+               //! @returns the connection the pending request `correlation` came from, if any
+               common::strong::file::descriptor::id descriptor( const common::strong::correlation::id& correlation) const noexcept;
                
                template< typename M>
-               inline auto add( M&& message)
+               inline auto add( common::strong::file::descriptor::id descriptor, M&& message)
                {
                   static_assert( ! std::is_same_v< std::decay_t< M>, common::message::service::call::callee::Request>);
                   m_complete.push_back( common::serialize::native::complete< complete_type>( std::forward< M>( message)));
-                  m_size += m_complete.back().size();
+                  Requests::charge( Entry{ m_complete.back().correlation(), descriptor, m_complete.back().size()});
                }
 
-               inline void add( common::message::service::call::callee::Request&& message)
+               inline void add( common::strong::file::descriptor::id descriptor, common::message::service::call::callee::Request&& message)
                {
-                  m_size += Requests::size( message);
+                  Requests::charge( Entry{ message.correlation, descriptor, Requests::size( message)});
                   m_services.push_back( std::move( message));
                }
 
@@ -85,6 +101,8 @@ namespace casual
                CASUAL_LOG_SERIALIZE( 
                   CASUAL_SERIALIZE_NAME( m_services, "services");
                   CASUAL_SERIALIZE_NAME( m_complete, "complete");
+                  CASUAL_SERIALIZE_NAME( m_entries, "entries");
+                  CASUAL_SERIALIZE_NAME( m_usage, "usage");
                   CASUAL_SERIALIZE_NAME( m_size, "size");
                   CASUAL_SERIALIZE_NAME( m_limits, "limits");
                )
@@ -96,8 +114,43 @@ namespace casual
                   return sizeof( message) + message.buffer.memory.size() + message.buffer.type.size();
                }
 
+               //! keeps track of which connection the pending request came from
+               struct Entry
+               {
+                  common::strong::correlation::id correlation;
+                  common::strong::file::descriptor::id descriptor;
+                  platform::size::type size{};
+
+                  inline friend bool operator == ( const Entry& lhs, const common::strong::correlation::id& rhs) { return lhs.correlation == rhs;}
+                  inline friend bool operator == ( const Entry& lhs, common::strong::file::descriptor::id rhs) { return lhs.descriptor == rhs;}
+
+                  CASUAL_LOG_SERIALIZE( 
+                     CASUAL_SERIALIZE( correlation);
+                     CASUAL_SERIALIZE( descriptor);
+                     CASUAL_SERIALIZE( size);
+                  )
+               };
+
+               //! what the pending requests from one connection uses
+               struct Usage
+               {
+                  platform::size::type messages{};
+                  platform::size::type size{};
+
+                  CASUAL_LOG_SERIALIZE( 
+                     CASUAL_SERIALIZE( messages);
+                     CASUAL_SERIALIZE( size);
+                  )
+               };
+
+               void charge( Entry entry);
+               void release( const common::strong::correlation::id& correlation);
+               void release( const Entry& entry);
+
                std::vector< common::message::service::call::callee::Request> m_services;
                std::vector< complete_type> m_complete;
+               std::vector< Entry> m_entries;
+               std::unordered_map< common::strong::file::descriptor::id, Usage> m_usage;
                platform::size::type m_size = 0;
                pending::Limit m_limits;
                
@@ -153,10 +206,13 @@ namespace casual
          {
             state::pending::Requests requests;
             std::vector< common::strong::file::descriptor::id> disconnects;
+            //! connections that are not read from, due to the memory budget
+            std::vector< common::strong::file::descriptor::id> throttled;
             
             CASUAL_LOG_SERIALIZE( 
                CASUAL_SERIALIZE( requests);
                CASUAL_SERIALIZE( disconnects);
+               CASUAL_SERIALIZE( throttled);
             )
          } pending;
          
@@ -193,12 +249,15 @@ namespace casual
                result.descriptor = descriptor;
                result.address.local = common::communication::tcp::socket::address::host( descriptor);
                result.address.peer = common::communication::tcp::socket::address::peer( descriptor);
+               result.compression = connection.compression();
 
                if( auto found = external.information( descriptor))
                {
                   result.domain = found->domain;
                   result.configuration = found->configuration;
                   result.created = found->created;
+                  result.flow.credit = found->credit;
+                  result.flow.throttled = found->throttle.total();
                }
 
                return result;
@@ -204,6 +204,9 @@ namespace casual
 
          //! holds all connections that has been requested to disconnect.
          std::vector< common::strong::file::descriptor::id> disconnecting;
+
+         //! the stripe set for each configured address that has more than one stripe
+         std::unordered_map< std::string, common::Uuid> stripes;
          
          struct
          {
@@ -234,12 +237,15 @@ namespace casual
                result.descriptor = descriptor;
                result.address.local = common::communication::tcp::socket::address::host( descriptor);
                result.address.peer = common::communication::tcp::socket::address::peer( descriptor);
+               result.compression = connection.compression();
 
                if( auto found = common::algorithm::find( external.information(), descriptor))
                {
                   result.domain = found->domain;
                   result.configuration = found->configuration;
                   result.created = found->created;
+                  result.flow.credit = found->credit;
+                  result.flow.throttled = found->throttle.total();
                }
 
                return result;
@@ -303,6 +309,7 @@ namespace casual
             CASUAL_SERIALIZE( route);
             CASUAL_SERIALIZE( lookup);
             CASUAL_SERIALIZE( disconnecting);
+            CASUAL_SERIALIZE( stripes);
             CASUAL_SERIALIZE( coordinate);
             CASUAL_SERIALIZE( alias);
             CASUAL_SERIALIZE( order);
@@ -14,8 +14,10 @@
 #include "common/algorithm.h"
 #include "common/signal/timer.h"
 #include "common/environment.h"
+#include "common/pimpl.h"
 
 #include <chrono>
+#include <map>
 
 namespace casual
 {
@@ -148,6 +150,185 @@ namespace casual
 
       } // listener::dispatch
 
+      namespace compression
+      {
+         //! compresses and decompresses the payloads of a connection, and keeps the metrics
+         class Context
+         {
+         public:
+            using complete_type = common::communication::tcp::message::Complete;
+
+            Context();
+            ~Context();
+            Context( Context&&) noexcept;
+            Context& operator = ( Context&&) noexcept;
+
+            //! replaces `complete` with a compressed message, if it's larger than the threshold and 
+            //!   compresses well enough, otherwise `complete` is left as is.
+            void compress( complete_type& complete);
+
+            //! replaces `complete` with the original message, if `complete` is a compressed message, 
+            //!   otherwise `complete` is left as is.
+            void decompress( complete_type& complete);
+
+            const manager::admin::model::connection::Compression& metric() const noexcept;
+
+            CASUAL_LOG_SERIALIZE( 
+               CASUAL_SERIALIZE_NAME( metric(), "metric");
+            )
+
+         private:
+            struct Implementation;
+            common::move::basic_pimpl< Implementation> m_implementation;
+         };
+         
+      } // compression
+
+      namespace stripe
+      {
+         using complete_type = common::communication::tcp::message::Complete;
+
+         namespace fragment
+         {
+            //! @returns true if the message can be fragmented over stripes. That is, messages that the 
+            //!   sender waits for a reply on, hence the order relative to other messages is not important.
+            bool eligible( const complete_type& complete) noexcept;
+
+            //! @returns `complete` split into fragment messages, with a payload of at most `size` each
+            std::vector< complete_type> split( const complete_type& complete, platform::size::type size);
+            
+         } // fragment
+
+         //! reassembles fragments to the original messages. The payload of a partial message grows as its
+         //! fragments arrive, and the bytes of the partials from one stripe set (or from one connection that
+         //! is not part of a stripe) are bounded by the capacity.
+         struct Reassembly
+         {
+            //! capacity from `CASUAL_GATEWAY_MESSAGE_MAX_SIZE`, if set
+            Reassembly();
+            explicit Reassembly( platform::size::type capacity) : m_capacity{ capacity} {}
+
+            //! adds the fragment, received on the connection `descriptor` that is part of `stripe` (if any), to its message
+            //! @returns the original message if all fragments are received, otherwise an empty complete
+            //! @throws code::casual::communication_protocol if the fragment is out of bounds, overlaps received 
+            //!   fragments, does not match its message, or the partials from the stripe set would exceed the capacity
+            complete_type add( const common::Uuid& stripe, common::strong::file::descriptor::id descriptor, complete_type&& fragment);
+
+            //! discards all partial messages from the `stripe`
+            void discard( const common::Uuid& stripe);
+
+            //! discards all partial messages from the connection `descriptor`, that is not part of a stripe
+            void discard( common::strong::file::descriptor::id descriptor);
+
+            //! @returns the bytes allocated for the partials from the `stripe` set, or from the connection 
+            //!   `descriptor` if `stripe` is empty
+            platform::size::type size( const common::Uuid& stripe, common::strong::file::descriptor::id descriptor) const noexcept;
+
+            inline auto empty() const noexcept { return m_partials.empty();}
+
+            CASUAL_LOG_SERIALIZE( 
+               CASUAL_SERIALIZE_NAME( m_capacity, "capacity");
+               CASUAL_SERIALIZE_NAME( m_partials, "partials");
+               CASUAL_SERIALIZE_NAME( m_usage, "usage");
+            )
+
+         private:
+            struct Partial
+            {
+               common::Uuid stripe;
+               common::strong::file::descriptor::id descriptor;
+               complete_type complete;
+               //! the size of the original message
+               platform::size::type size{};
+               platform::size::type received{};
+               //! received ranges, offset -> end
+               std::map< platform::size::type, platform::size::type> ranges;
+
+               inline friend bool operator == ( const Partial& lhs, const common::strong::correlation::id& rhs) { return lhs.complete.correlation() == rhs;}
+
+               CASUAL_LOG_SERIALIZE( 
+                  CASUAL_SERIALIZE( stripe);
+                  CASUAL_SERIALIZE( descriptor);
+                  CASUAL_SERIALIZE( complete);
+                  CASUAL_SERIALIZE( size);
+                  CASUAL_SERIALIZE( received);
+               )
+            };
+
+            //! the bytes allocated for the partials of a stripe set, or a connection that is not part of a stripe
+            struct Usage
+            {
+               common::Uuid stripe;
+               common::strong::file::descriptor::id descriptor;
+               platform::size::type size{};
+
+               inline bool match( const common::Uuid& other, common::strong::file::descriptor::id descriptor) const noexcept
+               {
+                  if( stripe || other)
+                     return stripe == other;
+                  return this->descriptor == descriptor;
+               }
+
+               CASUAL_LOG_SERIALIZE( 
+                  CASUAL_SERIALIZE( stripe);
+                  CASUAL_SERIALIZE( descriptor);
+                  CASUAL_SERIALIZE( size);
+               )
+            };
+
+            Usage& usage( const common::Uuid& stripe, common::strong::file::descriptor::id descriptor);
+            void release( const Partial& partial);
+
+            platform::size::type m_capacity{};
+            std::vector< Partial> m_partials;
+            std::vector< Usage> m_usage;
+         };
+         
+      } // stripe
+
+      namespace flow
+      {
+         //! @returns true if the message is a request that the inbound has to keep pending, hence
+         //!   subject to credit based flow control (protocol 1.4 and above)
+         bool controlled( common::message::Type type) noexcept;
+
+         //! accumulates the time a connection is throttled
+         struct Throttle
+         {
+            inline void start() noexcept
+            {
+               if( ! m_since)
+                  m_since = platform::time::clock::type::now();
+            }
+
+            inline void stop() noexcept
+            {
+               if( m_since)
+                  m_total += platform::time::clock::type::now() - *std::exchange( m_since, {});
+            }
+
+            inline bool active() const noexcept { return m_since.has_value();}
+
+            //! @returns the total throttled time, including the ongoing, if any
+            inline platform::time::unit total() const noexcept
+            {
+               if( m_since)
+                  return m_total + ( platform::time::clock::type::now() - *m_since);
+               return m_total;
+            }
+
+            CASUAL_LOG_SERIALIZE( 
+               CASUAL_SERIALIZE_NAME( m_since, "since");
+               CASUAL_SERIALIZE_NAME( m_total, "total");
+            )
+
+         private:
+            std::optional< platform::time::point::type> m_since;
+            platform::time::unit m_total{};
+         };
+         
+      } // flow
+
       struct Connection
       {
          using complete_type = common::communication::tcp::message::Complete;
@@ -159,7 +340,13 @@ namespace casual
          inline auto descriptor() const noexcept { return m_device.connector().descriptor();}
 
          //! tries to send as much of unsent as possible, if any.
+         //! @throws code::casual::communication_unavailable or code::casual::communication_refused if the connection is lost
          void unsent( common::communication::select::Directive& directive);
+
+         friend std::vector< common::strong::file::descriptor::id> unsent( 
+            common::communication::select::Directive& directive, 
+            std::vector< Connection>& connections,
+            common::strong::file::descriptor::id descriptor);
          
          template< typename M>
          auto send( common::communication::select::Directive& directive, M&& message)
@@ -167,34 +354,55 @@ namespace casual
             return send( directive, common::serialize::native::complete< complete_type>( std::forward< M>( message)));
          }
 
-         inline auto next()
-         {
-            return common::communication::device::non::blocking::next( m_device);
-         }
+         //! sends the already serialized message, or queues it if the connection is not writable.
+         common::strong::correlation::id send( common::communication::select::Directive& directive, complete_type&& complete);
+
+         //! @returns the next message, if any. Compressed messages are decompressed.
+         complete_type next();
+
+         //! @returns the number of payload bytes that waits to be sent
+         platform::size::type queued() const noexcept;
+
+         //! @returns true if there are complete messages already received (read ahead) from the
+         //!   connection, which will not trigger `select`.
+         inline bool cached() const noexcept { return m_device.complete() > 0;}
 
          inline auto protocol() const noexcept { return m_protocol;}
          inline void protocol( message::domain::protocol::Version protocol) noexcept { m_protocol = protocol;}
 
+         inline const auto& compression() const noexcept { return m_compression.metric();}
+
          inline friend bool operator == ( const Connection& lhs, common::strong::file::descriptor::id rhs) { return lhs.descriptor() == rhs;}
          
          CASUAL_LOG_SERIALIZE( 
             CASUAL_SERIALIZE_NAME( m_device, "device");
             CASUAL_SERIALIZE_NAME( m_unsent, "unsent");
             CASUAL_SERIALIZE_NAME( m_protocol, "protocol");
+            CASUAL_SERIALIZE_NAME( m_compression, "compression");
          )
 
       private:
-         
-         common::strong::correlation::id send( common::communication::select::Directive& directive, complete_type&& complete);
 
          std::vector< complete_type> m_unsent;
          common::communication::tcp::Duplex m_device;
          message::domain::protocol::Version m_protocol;
+         compression::Context m_compression;
       };
 
+      //! tries to send as much of unsent as possible, of all `connections` that have unsent messages. 
+      //! With io_uring the sends to all the connections are submitted together, otherwise only the
+      //! connection `descriptor` (that is writable) is tried.
+      //! @returns the descriptors of the connections that are lost
+      std::vector< common::strong::file::descriptor::id> unsent( 
+         common::communication::select::Directive& directive, 
+         std::vector< Connection>& connections,
+         common::strong::file::descriptor::id descriptor);
+
       template< typename Configuration>
       struct External
       {
+         using complete_type = Connection::complete_type;
+
          struct Information
          {
             Information( common::strong::file::descriptor::id descriptor,
@@ -207,6 +415,15 @@ namespace casual
             common::domain::Identity domain;
             Configuration configuration;
             platform::time::point::type created = platform::time::clock::type::now();
+            //! the stripe set the connection is part of, if any
+            common::Uuid stripe;
+            //! the number of requests the outbound is granted to send over the connection, protocol 1.4 and above.
+            //! Outbound: what we've got left. Inbound: what we think the outbound has left.
+            platform::size::type credit{};
+            //! outbound: waits for credit, inbound: the connection is not read from.
+            flow::Throttle throttle;
+            //! inbound: the number of requests the outbound has sent without credit
+            platform::size::type overrun{};
 
             inline friend bool operator == ( const Information& lhs, common::strong::file::descriptor::id rhs) { return lhs.descriptor == rhs;} 
 
@@ -215,6 +432,10 @@ namespace casual
                CASUAL_SERIALIZE( domain);
                CASUAL_SERIALIZE( configuration);
                CASUAL_SERIALIZE( created);
+               CASUAL_SERIALIZE( stripe);
+               CASUAL_SERIALIZE( credit);
+               CASUAL_SERIALIZE( throttle);
+               CASUAL_SERIALIZE( overrun);
             )
          };
 
@@ -258,14 +479,193 @@ namespace casual
             return nullptr;
          }
 
+         Information* information( common::strong::file::descriptor::id descriptor) noexcept
+         {
+            if( auto found = common::algorithm::find( m_information, descriptor))
+               return found.data();
+            return nullptr;
+         }
+
+         //! @returns the information of the connection `descriptor`, and all the connections in the same stripe set
+         std::vector< Information*> set( common::strong::file::descriptor::id descriptor)
+         {
+            std::vector< Information*> result;
+
+            auto information = this->information( descriptor);
+            if( ! information)
+               return result;
+
+            if( ! information->stripe)
+               return { information};
+
+            for( auto& other : m_information)
+               if( other.stripe == information->stripe)
+                  result.push_back( &other);
+
+            return result;
+         }
+
+         //! makes the connection part of the `stripe` set, and let the other side know. 
+         //! Has no effect if the connection does not 'speak' protocol 1.3 or later.
+         void join( 
+            common::communication::select::Directive& directive, 
+            common::strong::file::descriptor::id descriptor, 
+            const common::Uuid& stripe)
+         {
+            auto connection = this->connection( descriptor);
+            auto information = common::algorithm::find( m_information, descriptor);
+
+            if( ! connection || ! information || connection->protocol() < message::domain::protocol::Version::version_1_3)
+               return;
+
+            information->stripe = stripe;
+
+            message::domain::stripe::Join message;
+            message.stripe = stripe;
+            connection->send( directive, message);
+         }
+
+         //! sends the message over the `connection`. Large messages are fragmented and interleaved 
+         //! over the stripes the connection is part of, if any. Requests are throttled (kept) if the
+         //! inbound has not granted credit for them.
+         template< typename M>
+         common::strong::correlation::id send( common::communication::select::Directive& directive, Connection& connection, M&& message)
+         {
+            auto complete = common::serialize::native::complete< complete_type>( std::forward< M>( message));
+
+            if( connection.protocol() >= message::domain::protocol::Version::version_1_4 && flow::controlled( complete.type()))
+            {
+               auto throttled = common::algorithm::find_if( m_throttled, in( set( connection.descriptor())));
+               auto granted = credited( connection.descriptor());
+
+               // we keep the order of the requests, hence no 'overtaking' of the throttled ones
+               if( throttled || ! granted)
+               {
+                  common::log::line( verbose::log, "throttled: ", complete.correlation(), " descriptor: ", connection.descriptor());
+
+                  if( auto information = this->information( connection.descriptor()))
+                     information->throttle.start();
+
+                  m_throttled.push_back( Throttled{ connection.descriptor(), std::move( complete)});
+                  return m_throttled.back().complete.correlation();
+               }
+
+               --granted->credit;
+            }
+
+            return transmit( directive, connection, std::move( complete));
+         }
+
+         //! adds `messages` credit, granted by the inbound, to the connection and sends throttled requests, if any.
+         void credit( 
+            common::communication::select::Directive& directive, 
+            common::strong::file::descriptor::id descriptor,
+            platform::size::type messages)
+         {
+            auto information = this->information( descriptor);
+            if( ! information)
+               return;
+
+            information->credit += messages;
+
+            auto throttled = in( set( descriptor));
+
+            while( auto found = common::algorithm::find_if( m_throttled, throttled))
+            {
+               auto credited = this->credited( descriptor);
+               if( ! credited)
+                  return;
+
+               --credited->credit;
+               auto request = common::algorithm::container::extract( m_throttled, std::begin( found));
+
+               if( auto connection = this->connection( request.descriptor))
+                  transmit( directive, *connection, std::move( request.complete));
+            }
+
+            for( auto information : set( descriptor))
+               information->throttle.stop();
+         }
+
+         //! grants the outbound `messages` more requests over the connection. 
+         //! Has no effect if the connection does not 'speak' protocol 1.4 or later.
+         void grant( 
+            common::communication::select::Directive& directive, 
+            common::strong::file::descriptor::id descriptor,
+            platform::size::type messages)
+         {
+            auto connection = this->connection( descriptor);
+            auto information = this->information( descriptor);
+
+            if( ! connection || ! information || connection->protocol() < message::domain::protocol::Version::version_1_4)
+               return;
+
+            information->credit += messages;
+
+            message::domain::flow::Credit message;
+            message.messages = messages;
+            connection->send( directive, message);
+         }
+
+         //! @returns the next message from the `connection`, if any. Stripe messages are consumed, 
+         //!   and an original message is returned when all its fragments are received.
+         complete_type next( Connection& connection)
+         {
+            auto complete = connection.next();
+
+            switch( complete.type())
+            {
+               case message::domain::stripe::Join::type():
+               {
+                  message::domain::stripe::Join message;
+                  common::serialize::native::complete( complete, message);
+
+                  if( auto information = common::algorithm::find( m_information, connection.descriptor()))
+                     information->stripe = message.stripe;
+
+                  common::log::line( verbose::log, "joined stripe: ", message.stripe, " descriptor: ", connection.descriptor());
+                  return {};
+               }
+               case message::domain::stripe::Fragment::type():
+               {
+                  if( auto information = common::algorithm::find( m_information, connection.descriptor()))
+                     return charge( connection, m_reassembly.add( information->stripe, connection.descriptor(), std::move( complete)));
+                  return {};
+               }
+               default:
+                  return charge( connection, std::move( complete));
+            }
+         }
+
+         //! tries to send the unsent messages, see `tcp::unsent`
+         //! @returns the descriptors of the connections that are lost
+         auto unsent( common::communication::select::Directive& directive, common::strong::file::descriptor::id descriptor)
+         {
+            return tcp::unsent( directive, m_connections, descriptor);
+         }
+
          std::optional< Configuration> remove( 
             common::communication::select::Directive& directive, 
             common::strong::file::descriptor::id descriptor)
          {
             directive.read.remove( descriptor);
+            directive.write.remove( descriptor);
             common::algorithm::container::trim( m_connections, common::algorithm::remove( m_connections, descriptor));
             if( auto found = common::algorithm::find( m_information, descriptor))
-               return common::algorithm::container::extract( m_information, std::begin( found)).configuration;
+            {
+               auto information = common::algorithm::container::extract( m_information, std::begin( found));
+
+               // the fragments that was 'on the way' over the lost stripe will never arrive.
+               if( information.stripe)
+                  m_reassembly.discard( information.stripe);
+               else
+                  m_reassembly.discard( descriptor);
+
+               // the throttled requests are lost with the connection
+               common::algorithm::container::trim( m_throttled, common::algorithm::remove( m_throttled, descriptor));
+
+               return std::move( information.configuration);
+            }
             
             return {};
          }
@@ -273,8 +673,11 @@ namespace casual
          void clear( common::communication::select::Directive& directive)
          {
             directive.read.remove( descriptors());
+            directive.write.remove( descriptors());
             m_connections.clear();
             m_information.clear();
+            m_reassembly = {};
+            m_throttled.clear();
          }
 
          auto& information() const noexcept { return m_information;}
@@ -293,13 +696,111 @@ namespace casual
             CASUAL_SERIALIZE_NAME( m_connections, "connections");
             CASUAL_SERIALIZE_NAME( m_information, "information");
             CASUAL_SERIALIZE_NAME( m_pending, "pending");
+            CASUAL_SERIALIZE_NAME( m_reassembly, "reassembly");
+            CASUAL_SERIALIZE_NAME( m_throttled, "throttled");
             CASUAL_SERIALIZE_NAME( m_last, "last");
          )
       private:
 
+         //! a request that waits for credit
+         struct Throttled
+         {
+            common::strong::file::descriptor::id descriptor;
+            complete_type complete;
+
+            inline friend bool operator == ( const Throttled& lhs, common::strong::file::descriptor::id rhs) { return lhs.descriptor == rhs;}
+
+            CASUAL_LOG_SERIALIZE( 
+               CASUAL_SERIALIZE( descriptor);
+               CASUAL_SERIALIZE( complete);
+            )
+         };
+
+         common::strong::correlation::id transmit( common::communication::select::Directive& directive, Connection& connection, complete_type&& complete)
+         {
+            if( common::range::size( complete.payload) <= platform::tcp::stripe::fragment || ! stripe::fragment::eligible( complete))
+               return connection.send( directive, std::move( complete));
+
+            auto stripes = this->stripes( connection.descriptor());
+
+            if( stripes.size() < 2)
+               return connection.send( directive, std::move( complete));
+
+            auto least_queued = []( auto lhs, auto rhs){ return lhs->queued() < rhs->queued();};
+
+            for( auto& fragment : stripe::fragment::split( complete, platform::tcp::stripe::fragment))
+            {
+               // we rotate so equally loaded stripes take turns
+               common::algorithm::rotate( stripes, std::next( std::begin( stripes)));
+               auto stripe = *common::algorithm::min( stripes, least_queued);
+               stripe->send( directive, std::move( fragment));
+            }
+
+            return complete.correlation();
+         }
+
+         //! a received request uses one of the credits the outbound was granted. The outbound takes the
+         //! credit from the connection in the stripe set that has the most left (see `send`), regardless
+         //! of which stripe the request is sent on, hence we charge the set the same way. A request 
+         //! without credit is counted as an overrun, the credit never goes below 0.
+         complete_type charge( const Connection& connection, complete_type&& complete)
+         {
+            if( complete && connection.protocol() >= message::domain::protocol::Version::version_1_4 && flow::controlled( complete.type()))
+               if( auto information = this->information( connection.descriptor()))
+               {
+                  if( auto credited = this->credited( connection.descriptor()))
+                     --credited->credit;
+                  else if( ++information->overrun == 1)
+                     common::log::line( common::log::category::warning, "outbound sends requests without credit - descriptor: ", connection.descriptor(), " domain: ", information->domain);
+                  else
+                     common::log::line( verbose::log, "overrun: ", information->overrun, " descriptor: ", connection.descriptor());
+               }
+
+            return std::move( complete);
+         }
+
+         //! @returns the connection in the same set as `descriptor` that has the most credit left, if any has credit
+         Information* credited( common::strong::file::descriptor::id descriptor)
+         {
+            auto set = this->set( descriptor);
+            auto most = common::algorithm::max( set, []( auto lhs, auto rhs){ return lhs->credit < rhs->credit;});
+
+            if( most && ( *most)->credit > 0)
+               return *most;
+            return nullptr;
+         }
+
+         //! @returns a predicate that is true if the throttled request is for any of the connections in `set`
+         static auto in( std::vector< Information*> set)
+         {
+            return [ set = std::move( set)]( const Throttled& throttled)
+            {
+               return common::algorithm::any_of( set, [&throttled]( auto information){ return information->descriptor == throttled.descriptor;});
+            };
+         }
+
+         //! @returns all connections in the same stripe set as `descriptor`, including `descriptor`
+         std::vector< Connection*> stripes( common::strong::file::descriptor::id descriptor)
+         {
+            std::vector< Connection*> result;
+
+            auto information = common::algorithm::find( m_information, descriptor);
+            if( ! information || ! information->stripe)
+               return result;
+
+            for( auto& other : m_information)
+               if( other.stripe == information->stripe)
+                  if( auto connection = this->connection( other.descriptor))
+                     result.push_back( connection);
+
+            return result;
+         }
+
          std::vector< Connection> m_connections;
          std::vector< Information> m_information;
          connector::Pending< Configuration> m_pending;
+         stripe::Reassembly m_reassembly;
+         std::vector< Throttled> m_throttled;
 
          //! holds the last external connection that was used
          common::strong::file::descriptor::id m_last;
@@ -372,7 +873,7 @@ namespace casual
          {
             if( auto connection = state.external.connection( descriptor))
             {
-               return connection->send( state.directive, std::forward< M>( message));
+               return state.external.send( state.directive, *connection, std::forward< M>( message));
             }
             else
             {
@@ -393,25 +894,97 @@ namespace casual
 
       namespace pending::send
       {
-         template< typename State>
-         auto dispatch( State& state)
+         namespace detail
          {
-            return [&state]( common::strong::file::descriptor::id descriptor, common::communication::select::tag::write)
+            template< typename State, typename L>
+            struct select_handler
             {
-               Trace trace{ "gateway::group::tcp::pending::send::dispatch"};
-               common::log::line( verbose::log, "descriptor: ", descriptor);
+               select_handler( State& state, L lost) : m_state{ state}, m_lost{ std::move( lost)} {}
 
-               if( auto connection = state.external.connection( descriptor))
+               bool operator() ( common::strong::file::descriptor::id descriptor, common::communication::select::tag::write)
                {
-                  connection->unsent( state.directive);
+                  Trace trace{ "gateway::group::tcp::pending::send::dispatch"};
+                  common::log::line( verbose::log, "descriptor: ", descriptor);
+
+                  if( ! m_state.external.connection( descriptor))
+                     return false;
+
+                  for( auto lost : m_state.external.unsent( m_state.directive, descriptor))
+                     m_lost( m_state, lost);
+
                   return true;
                }
 
-               return false;
-
+            private:
+               State& m_state;
+               L m_lost;
             };
+         } // detail
+
+         //! @param lost invoked with `( state, descriptor)` for the connections that are lost when we send.
+         template< typename State, typename L>
+         auto dispatch( State& state, L lost)
+         {
+            return detail::select_handler< State, L>{ state, std::move( lost)};
          }
       } // pending::send
+
+      namespace cached
+      {
+         namespace detail
+         {
+            template< typename State, typename H>
+            struct select_handler
+            {
+               select_handler( State& state, H handler) : m_state{ state}, m_handler{ std::move( handler)} {}
+
+               bool operator () ( common::communication::select::tag::consume)
+               {
+                  // messages that are read ahead will not trigger select, we dispatch 
+                  // to the connection as if it's readable. Connections that are not in the read set 
+                  // (throttled) are left alone.
+                  auto readable = [&]( auto& connection)
+                  { 
+                     return connection.cached() && common::algorithm::find( m_state.directive.read.descriptors(), connection.descriptor());
+                  };
+
+                  // we take turns (round robin), so one connection with a lot of read ahead can't starve the others
+                  auto connections = m_state.external.connections();
+                  auto count = common::range::size( connections);
+
+                  for( platform::size::type index = 0; index < count; ++index)
+                  {
+                     auto& connection = *( std::begin( connections) + ( m_next + index) % count);
+                     if( readable( connection))
+                     {
+                        m_next = ( m_next + index + 1) % count;
+                        return m_handler( connection.descriptor(), common::communication::select::tag::read{});
+                     }
+                  }
+
+                  return false;
+               }
+
+               bool operator() ( common::strong::file::descriptor::id descriptor, common::communication::select::tag::read tag)
+               {
+                  return m_handler( descriptor, tag);
+               }
+
+            private:
+               State& m_state;
+               H m_handler;
+               platform::size::type m_next{};
+            };
+         } // detail
+
+         //! wraps the external read `handler` so messages that are cached in the connections
+         //! are consumed before we block in select.
+         template< typename State, typename H>
+         auto dispatch( State& state, H handler)
+         {
+            return detail::select_handler< State, H>{ state, std::move( handler)};
+         }
+      } // cached
       
    } // gateway::tcp
 } // casual
\ No newline at end of file
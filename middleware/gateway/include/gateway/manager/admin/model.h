@@ -77,6 +77,52 @@ namespace casual
                   CASUAL_SERIALIZE( peer);
                )
             };
+
+            //! payload compression of the connection, protocol 1.2 and above
+            struct Compression
+            {
+               struct Metric
+               {
+                  //! number of compressed/decompressed messages
+                  platform::size::type count{};
+                  //! payload bytes before compression
+                  platform::size::type raw{};
+                  //! payload bytes after compression
+                  platform::size::type compressed{};
+                  //! cpu time spent
+                  platform::time::unit time{};
+
+                  CASUAL_CONST_CORRECT_SERIALIZE(
+                     CASUAL_SERIALIZE( count);
+                     CASUAL_SERIALIZE( raw);
+                     CASUAL_SERIALIZE( compressed);
+                     CASUAL_SERIALIZE( time);
+                  )
+               };
+
+               Metric compress;
+               Metric decompress;
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( compress);
+                  CASUAL_SERIALIZE( decompress);
+               )
+            };
+
+            //! credit based flow control of the connection, protocol 1.4 and above
+            struct Flow
+            {
+               //! requests the outbound is granted to send
+               platform::size::type credit{};
+               //! total time the connection has been throttled. outbound: waited for credit, 
+               //! inbound: not read from due to memory budget.
+               platform::time::unit throttled{};
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( credit);
+                  CASUAL_SERIALIZE( throttled);
+               )
+            };
             
          } // connection
 
@@ -89,6 +135,8 @@ namespace casual
             common::domain::Identity remote;
             connection::Address address;
             platform::time::point::type created{};
+            connection::Compression compression;
+            connection::Flow flow;
 
             inline connection::Runlevel runlevel() const noexcept
             {
@@ -108,6 +156,8 @@ namespace casual
                CASUAL_SERIALIZE( remote);
                CASUAL_SERIALIZE( address);
                CASUAL_SERIALIZE( created);
+               CASUAL_SERIALIZE( compression);
+               CASUAL_SERIALIZE( flow);
 
                //! @deprecated remove in 2.0
                auto runlevel = Connection::runlevel();
@@ -38,13 +38,19 @@ namespace casual
                invalid = 0,
                version_1 = 1000,
                version_1_1 = 1001,
+               //! payloads can be compressed
+               version_1_2 = 1002,
+               //! connections can be striped, and large messages fragmented over the stripes
+               version_1_3 = 1003,
+               //! credit based flow control from inbound to outbound
+               version_1_4 = 1004,
 
                // make sure this 'points' to the latest version
-               latest = version_1_1
+               latest = version_1_4
             };
 
             //! an array with all versions ordered by highest to lowest
-            constexpr auto versions = std::array< Version, 2>{ Version::version_1_1, Version::version_1};
+            constexpr auto versions = std::array< Version, 5>{ Version::version_1_4, Version::version_1_3, Version::version_1_2, Version::version_1_1, Version::version_1};
          } // protocol
 
          namespace connect
@@ -104,6 +110,107 @@ namespace casual
             )
          };
 
+         //! a message with its payload compressed, protocol 1.2 and above. 
+         //! Has the same correlation as the original message.
+         using base_compressed = common::message::basic_message< common::message::Type::gateway_domain_compressed>;
+         struct Compressed : base_compressed
+         {
+            using base_compressed::base_compressed;
+
+            struct
+            {
+               //! the type of the original message
+               common::message::Type type{};
+               //! the size of the original payload
+               platform::size::type size{};
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( type);
+                  CASUAL_SERIALIZE( size);
+               )
+            } original;
+
+            //! the original payload, compressed with zstd
+            platform::binary::type payload;
+
+            CASUAL_CONST_CORRECT_SERIALIZE(
+               base_compressed::serialize( archive);
+               CASUAL_SERIALIZE( original);
+               CASUAL_SERIALIZE( payload);
+            )
+         };
+
+         namespace stripe
+         {
+            //! sent first on every connection that is a stripe of a connection set, protocol 1.3 and above. 
+            //! All connections with the same `stripe` ends up in the same process on both sides.
+            using base_join = common::message::basic_message< common::message::Type::gateway_domain_stripe_join>;
+            struct Join : base_join
+            {
+               using base_join::base_join;
+
+               common::Uuid stripe;
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  base_join::serialize( archive);
+                  CASUAL_SERIALIZE( stripe);
+               )
+            };
+
+            //! a part of a large message, interleaved over the stripes, protocol 1.3 and above. 
+            //! Has the same correlation as the original message.
+            using base_fragment = common::message::basic_message< common::message::Type::gateway_domain_stripe_fragment>;
+            struct Fragment : base_fragment
+            {
+               using base_fragment::base_fragment;
+
+               struct
+               {
+                  //! the type of the original message
+                  common::message::Type type{};
+                  //! the size of the original payload
+                  platform::size::type size{};
+
+                  CASUAL_CONST_CORRECT_SERIALIZE(
+                     CASUAL_SERIALIZE( type);
+                     CASUAL_SERIALIZE( size);
+                  )
+               } original;
+
+               //! where in the original payload this fragment belongs
+               platform::size::type offset{};
+
+               //! the part of the original payload
+               platform::binary::type payload;
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  base_fragment::serialize( archive);
+                  CASUAL_SERIALIZE( original);
+                  CASUAL_SERIALIZE( offset);
+                  CASUAL_SERIALIZE( payload);
+               )
+            };
+            
+         } // stripe
+
+         namespace flow
+         {
+            //! sent from inbound to outbound, grants the outbound to send `messages` more requests 
+            //! over the connection (or any connection in the same stripe set), protocol 1.4 and above.
+            using base_credit = common::message::basic_message< common::message::Type::gateway_domain_flow_credit>;
+            struct Credit : base_credit
+            {
+               using base_credit::base_credit;
+
+               platform::size::type messages{};
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  base_credit::serialize( archive);
+                  CASUAL_SERIALIZE( messages);
+               )
+            };
+         } // flow
+
          namespace discovery
          {
             namespace reply
@@ -155,6 +262,8 @@ namespace casual
             common::domain::Identity domain;
             Configuration configuration;
             platform::time::point::type created{};
+            manager::admin::model::connection::Compression compression;
+            manager::admin::model::connection::Flow flow;
 
             struct
             {
@@ -186,6 +295,8 @@ namespace casual
                CASUAL_SERIALIZE( configuration);
                CASUAL_SERIALIZE( metric);
                CASUAL_SERIALIZE( created);
+               CASUAL_SERIALIZE( compression);
+               CASUAL_SERIALIZE( flow);
             )
          };
          
@@ -547,6 +658,35 @@ template< typename A> struct Value< type, A, std::enable_if_t< common::serialize
             CASUAL_CUSTOMIZATION_POINT_SERIALIZE( execution);
          })
 
+         CASUAL_CUSTOMIZATION_POINT_NETWORK( casual::gateway::message::domain::Compressed,
+         {
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( execution);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( original.type);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( original.size);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( payload);
+         })
+
+         CASUAL_CUSTOMIZATION_POINT_NETWORK( casual::gateway::message::domain::stripe::Join,
+         {
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( execution);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( stripe);
+         })
+
+         CASUAL_CUSTOMIZATION_POINT_NETWORK( casual::gateway::message::domain::stripe::Fragment,
+         {
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( execution);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( original.type);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( original.size);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( offset);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( payload);
+         })
+
+         CASUAL_CUSTOMIZATION_POINT_NETWORK( casual::gateway::message::domain::flow::Credit,
+         {
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( execution);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( messages);
+         })
+
          CASUAL_CUSTOMIZATION_POINT_NETWORK( casual::gateway::message::domain::discovery::Request,
          {
             CASUAL_CUSTOMIZATION_POINT_SERIALIZE( execution);
@@ -680,6 +820,29 @@ template< typename A> struct Value< type, A, std::enable_if_t< common::serialize
             detail::transaction_reply( value, archive);
          })
 
+         // the message priority is domain local, and not part of the interdomain protocol
+         CASUAL_CUSTOMIZATION_POINT_NETWORK( queue::ipc::message::group::enqueue::Message,
+         {
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( id);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( properties);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( reply);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( available);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( type);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( payload);
+         })
+
+         CASUAL_CUSTOMIZATION_POINT_NETWORK( queue::ipc::message::group::dequeue::Message,
+         {
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( id);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( properties);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( reply);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( available);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( type);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( payload);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( redelivered);
+            CASUAL_CUSTOMIZATION_POINT_SERIALIZE( timestamp);
+         })
+
          CASUAL_CUSTOMIZATION_POINT_NETWORK( queue::ipc::message::group::enqueue::Request,
          {
             CASUAL_CUSTOMIZATION_POINT_SERIALIZE( execution);
@@ -115,6 +115,39 @@ namespace casual
             local::set_general( message);
          }
 
+         void fill( gateway::message::domain::Compressed& message)
+         {
+            local::set_general( message);
+
+            message.original.type = common::message::Type::service_call;
+            message.original.size = 128;
+            message.payload = local::binary::value( 32);
+         }
+
+         void fill( gateway::message::domain::stripe::Join& message)
+         {
+            local::set_general( message);
+
+            message.stripe = 0x6ee4ab8a8e474fb0a15c2b2a2a6fb8a2_uuid;
+         }
+
+         void fill( gateway::message::domain::stripe::Fragment& message)
+         {
+            local::set_general( message);
+
+            message.original.type = common::message::Type::service_call;
+            message.original.size = 128;
+            message.offset = 64;
+            message.payload = local::binary::value( 32);
+         }
+
+         void fill( gateway::message::domain::flow::Credit& message)
+         {
+            local::set_general( message);
+
+            message.messages = 512;
+         }
+
          void fill( gateway::message::domain::discovery::Request& message)
          {
             local::set_general( message);
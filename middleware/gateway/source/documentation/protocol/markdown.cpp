@@ -744,6 +744,121 @@ Connection reply
             }               
          }
 
+         void domain_compressed( std::ostream& out)
+         {
+            out << R"(
+## compressed messages
+
+Used when both domains has agreed on protocol version 1002 (or later). Any message with a payload 
+larger than a configured threshold could be sent compressed (zstd) within this message. The header 
+has the same correlation as the original message.
+
+)";     
+
+            {
+               using message_type = gateway::message::domain::Compressed;
+               
+               out << "### " << local::message_type( message_type{}) << R"(
+
+A compressed message
+
+)";
+
+                  message_type message;
+                  message.original.type = common::message::Type::service_call;
+                  message.payload = local::binary::value( 128);
+
+                  local::format::type( out, message, {
+                     { "execution", "uuid of the current execution context (breadcrumb)"},
+                     { "original.type", "the message type of the original message"},
+                     { "original.size", "the size of the original (uncompressed) payload"},
+                     { "payload.size", "size of the compressed payload"},
+                     { "payload.data", "the original payload, compressed with zstd"},
+                  });
+
+            }               
+         }
+
+
+         void domain_stripe( std::ostream& out)
+         {
+            out << R"(
+## stripe messages
+
+Used when both domains has agreed on protocol version 1003 (or later). A connection can be one of 
+several connections (stripes) to the same remote domain. Request and reply messages with a payload 
+larger than the fragment size could be split into fragments, and interleaved over the stripes. 
+The fragments has the same correlation as the original message.
+
+)";     
+
+            {
+               using message_type = gateway::message::domain::stripe::Join;
+               
+               out << "### " << local::message_type( message_type{}) << R"(
+
+Sent first on a connection that is a stripe of a connection set
+
+)";
+
+                  local::format::type( out, message_type{}, {
+                     { "execution", "uuid of the current execution context (breadcrumb)"},
+                     { "stripe", "uuid of the stripe set, the same for all stripes"},
+                  });
+            }
+
+            {
+               using message_type = gateway::message::domain::stripe::Fragment;
+               
+               out << "### " << local::message_type( message_type{}) << R"(
+
+A part of a large message
+
+)";
+
+                  message_type message;
+                  message.original.type = common::message::Type::service_call;
+                  message.payload = local::binary::value( 128);
+
+                  local::format::type( out, message, {
+                     { "execution", "uuid of the current execution context (breadcrumb)"},
+                     { "original.type", "the message type of the original message"},
+                     { "original.size", "the size of the original payload"},
+                     { "offset", "where in the original payload the fragment belongs"},
+                     { "payload.size", "size of the fragment"},
+                     { "payload.data", "the part of the original payload"},
+                  });
+
+            }               
+         }
+
+         void domain_flow( std::ostream& out)
+         {
+            out << R"(
+## flow control messages
+
+Used when both domains has agreed on protocol version 1004 (or later). The inbound grants the outbound 
+credit to send requests (service call, conversation connect, enqueue and dequeue), one credit per request. 
+The outbound keeps requests until it's granted credit. A credit granted over one connection 
+can be used over any connection in the same stripe set. The outbound has no credit until the first grant.
+
+)";     
+
+            {
+               using message_type = gateway::message::domain::flow::Credit;
+               
+               out << "### " << local::message_type( message_type{}) << R"(
+
+Sent from the inbound to grant the outbound more credit
+
+)";
+
+                  local::format::type( out, message_type{}, {
+                     { "execution", "uuid of the current execution context (breadcrumb)"},
+                     { "messages", "the number of requests the outbound is granted to send, in addition to earlier grants"},
+                  });
+            }
+         }
 
          void domain_discovery( std::ostream& out)
          {
@@ -1077,6 +1192,9 @@ Sent to abruptly disconnect the conversation
             
             message_header( std::cout);
             domain_connect( std::cout);
+            domain_compressed( std::cout);
+            domain_stripe( std::cout);
+            domain_flow( std::cout);
             domain_discovery( std::cout);
             service_call( std::cout);
             transaction( std::cout);
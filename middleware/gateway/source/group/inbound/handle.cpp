@@ -38,7 +38,7 @@ namespace casual
                   {
                      if( auto connection = state.consume( message.correlation))
                      {
-                        connection->send( state.directive, std::forward< M>( message));
+                        state.external.send( state.directive, *connection, std::forward< M>( message));
                         return connection->descriptor();
                      }
                      
@@ -115,6 +115,12 @@ namespace casual
                                  send_error( state, lookup, common::code::xatmi::no_entry);
                                  break;
                               }
+                              case Enum::rejected:
+                              {
+                                 log::line( common::log::category::information, " service: ", lookup.service, " projected wait exceeds deadline - action: reply with: ", common::code::xatmi::no_message);
+                                 send_error( state, lookup, common::code::xatmi::no_message);
+                                 break;
+                              }
                               default:
                               {
                                  log::line( common::log::category::error, common::code::xatmi::system, " unexpected state on lookup reply: ", lookup, " - action: reply with: ", common::code::xatmi::service_error);
@@ -133,7 +139,9 @@ namespace casual
                            Trace trace{ "gateway::group::inbound::handle::local::internal::call::lookup::reply"};
                            common::log::line( verbose::log, "message: ", lookup);
 
+                           auto descriptor = state.pending.requests.descriptor( lookup.correlation);
                            auto request = state.pending.requests.consume( lookup.correlation, lookup);
+                           handle::flow::consumed( state, descriptor);
 
                            switch( common::message::type( request))
                            {
@@ -237,7 +245,9 @@ namespace casual
                            Trace trace{ "gateway::group::inbound::handle::local::internal::queue::lookup::reply"};
                            common::log::line( verbose::log, "message: ", message);
 
+                           auto descriptor = state.pending.requests.descriptor( message.correlation);
                            auto request = state.pending.requests.consume( message.correlation);
+                           handle::flow::consumed( state, descriptor);
 
                            if( message.process)
                            {
@@ -293,7 +303,10 @@ namespace casual
                         Trace trace{ "gateway::group::inbound::handle::local::internal::domain::connected"};
                         common::log::line( verbose::log, "message: ", message);
 
-                        state.external.connected( state.directive, message);
+                        auto descriptor = state.external.connected( state.directive, message);
+
+                        // grants the initial credit, if the connection 'speaks' 1.4 or later
+                        handle::flow::update( state, descriptor);
 
                         common::log::line( verbose::log, "state.external: ", state.external);
        
@@ -434,8 +447,8 @@ namespace casual
                            request.context = decltype( request.context)::no_busy_intermediate;
                         }
 
-                        // Add message to pending
-                        state.pending.requests.add( std::move( message));
+                        // Add message to pending, 'owned' by the connection it came from
+                        state.pending.requests.add( state.external.last(), std::move( message));
 
                         // Send lookup
                         ipc::flush::send( ipc::manager::service(), request); 
@@ -527,8 +540,8 @@ namespace casual
                            // Change 'sender' so we get the reply
                            message.process = common::process::handle();
 
-                           // Add message to buffer
-                           state.pending.requests.add( std::forward< M>( message));
+                           // Add message to buffer, 'owned' by the connection it came from
+                           state.pending.requests.add( state.external.last(), std::forward< M>( message));
 
                            return true;
                         }
@@ -746,9 +759,13 @@ namespace casual
             });
 
             algorithm::container::trim( state.pending.disconnects, algorithm::remove( state.pending.disconnects, descriptor));
+            algorithm::container::trim( state.pending.throttled, algorithm::remove( state.pending.throttled, descriptor));
 
             // There is no other pending we need to discard at the moment.
 
+            // the other connections might not be congested any more
+            handle::flow::update( state);
+
             return result;
          }
 
@@ -761,7 +778,7 @@ namespace casual
             {
                log::line( verbose::log, "connection: ", *connection);
 
-               if( connection->protocol() == decltype( connection->protocol())::version_1_1)
+               if( connection->protocol() >= decltype( connection->protocol())::version_1_1)
                {
                   try 
                   {
@@ -785,6 +802,90 @@ namespace casual
          
       } // connection
 
+      namespace flow
+      {
+         void update( State& state, common::strong::file::descriptor::id descriptor)
+         {
+            auto connection = state.external.connection( descriptor);
+            auto information = state.external.information( descriptor);
+
+            if( ! connection || ! information)
+               return;
+
+            auto connections = range::size( state.external.connections());
+
+            // memory budget
+            if( state.pending.requests.congested( descriptor, connections))
+            {
+               if( ! information->throttle.active())
+               {
+                  log::line( verbose::log, "throttle descriptor: ", descriptor);
+                  state.directive.read.remove( descriptor);
+                  information->throttle.start();
+                  state.pending.throttled.push_back( descriptor);
+               }
+            }
+            else if( information->throttle.active())
+            {
+               log::line( verbose::log, "resume descriptor: ", descriptor);
+               state.directive.read.add( descriptor);
+               information->throttle.stop();
+               algorithm::container::trim( state.pending.throttled, algorithm::remove( state.pending.throttled, descriptor));
+            }
+
+            // credit
+            if( connection->protocol() < decltype( connection->protocol())::version_1_4)
+               return;
+
+            // the outbound uses the credit of a stripe set as a pool, hence the window is per set
+            auto set = state.external.set( descriptor);
+
+            auto window = state.pending.requests.share( connections).messages;
+            if( window <= 0)
+               window = platform::tcp::flow::window;
+            window *= range::size( set);
+
+            // what the outbound can send, and what it has sent that we still keep pending
+            auto used = algorithm::accumulate( set, platform::size::type{}, [&state]( auto count, auto information)
+            {
+               return count + information->credit + state.pending.requests.messages( information->descriptor);
+            });
+
+            if( used <= window / 2)
+            {
+               try
+               {
+                  state.external.grant( state.directive, descriptor, window - used);
+               }
+               catch( ...)
+               {
+                  if( exception::capture().code() != code::casual::communication_unavailable)
+                     throw;
+
+                  handle::connection::lost( state, descriptor);
+               }
+            }
+         }
+
+         void consumed( State& state, common::strong::file::descriptor::id descriptor)
+         {
+            if( descriptor)
+               flow::update( state, descriptor);
+
+            // copy - update mutates throttled
+            for( auto throttled : std::vector< common::strong::file::descriptor::id>{ state.pending.throttled})
+               flow::update( state, throttled);
+         }
+
+         void update( State& state)
+         {
+            // copy - update could mutate external
+            for( auto descriptor : state.external.descriptors())
+               flow::update( state, descriptor);
+         }
+         
+      } // flow
+
 
       void idle( State& state)
       {
@@ -205,11 +205,15 @@ namespace casual
                         {
                            try
                            {
-                              if( auto correlation = handler( connection->next()))
+                              state.external.last( descriptor);
+
+                              if( auto correlation = handler( state.external.next( *connection)))
                               {
                                  if( ! algorithm::find( state.correlations, correlation))
                                     state.correlations.emplace_back( std::move( correlation), descriptor);
                               }
+
+                              inbound::handle::flow::update( state, descriptor);
                            }
                            catch( ...)
                            {
@@ -256,9 +260,12 @@ namespace casual
                   communication::select::dispatch::pump( 
                      local::condition( state),
                      state.directive,
-                     group::tcp::pending::send::dispatch( state),
+                     group::tcp::pending::send::dispatch( state, []( State& state, strong::file::descriptor::id descriptor)
+                     {
+                        handle::connection::lost( state, descriptor);
+                     }),
                      ipc::dispatch::create( state, &internal::handler),
-                     external::dispatch::create( state),
+                     tcp::cached::dispatch( state, external::dispatch::create( state)),
                      tcp::listener::dispatch::create( state, tcp::connector::Bound::in)
                   );
                }
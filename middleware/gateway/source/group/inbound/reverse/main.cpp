@@ -102,6 +102,13 @@ namespace casual
                   }
                }
 
+               void lost( State& state, common::strong::file::descriptor::id descriptor)
+               {
+                  // Do we try to reconnect?
+                  if( auto configuration = handle::connection::lost( state, descriptor))
+                     external::reconnect( state, std::move( configuration.value()));
+               }
+
                namespace dispatch
                {
                   auto create( State& state) 
@@ -113,17 +120,19 @@ namespace casual
                         {
                            try
                            {
-                              if( auto correlation = handler( connection->next()))
+                              state.external.last( descriptor);
+
+                              if( auto correlation = handler( state.external.next( *connection)))
                                  state.correlations.emplace_back( std::move( correlation), descriptor);
+
+                              handle::flow::update( state, descriptor);
                            }
                            catch( ...)
                            {
                               if( exception::capture().code() != code::casual::communication_unavailable)
                                  throw;
                               
-                              // Do we try to reconnect?
-                              if( auto configuration = handle::connection::lost( state, descriptor))
-                                 external::reconnect( state, std::move( configuration.value()));
+                              external::lost( state, descriptor);
                            }
                            return true;
                         }
@@ -278,9 +287,9 @@ namespace casual
                communication::select::dispatch::pump( 
                   local::condition( state),
                   state.directive,
-                  group::tcp::pending::send::dispatch( state),
+                  group::tcp::pending::send::dispatch( state, &external::lost),
                   ipc::dispatch::create( state, &internal::handler),
-                  external::dispatch::create( state)
+                  group::tcp::cached::dispatch( state, external::dispatch::create( state))
                );
 
                abort_guard.release();
@@ -28,12 +28,64 @@ namespace casual
 
          namespace pending
          {
+            pending::Limit Requests::share( platform::size::type connections) const noexcept
+            {
+               connections = std::max( connections, platform::size::type{ 1});
+
+               // a limit is never 'shared' to unlimited (0)
+               auto share = []( auto limit, auto connections) -> platform::size::type
+               {
+                  if( limit <= 0)
+                     return 0;
+                  return std::max( limit / connections, platform::size::type{ 1});
+               };
+
+               pending::Limit result;
+               result.size = share( m_limits.size, connections);
+               result.messages = share( m_limits.messages, connections);
+               return result;
+            }
+
+            bool Requests::congested( strong::file::descriptor::id descriptor, platform::size::type connections) const noexcept
+            {
+               if( ! congested())
+                  return false;
+
+               auto share = Requests::share( connections);
+
+               if( share.size > 0 && Requests::size( descriptor) > share.size)
+                  return true;
+
+               return share.messages > 0 && Requests::messages( descriptor) > share.messages;
+            }
+
+            platform::size::type Requests::messages( strong::file::descriptor::id descriptor) const noexcept
+            {
+               if( auto found = algorithm::find( m_usage, descriptor))
+                  return found->second.messages;
+               return 0;
+            }
+
+            platform::size::type Requests::size( strong::file::descriptor::id descriptor) const noexcept
+            {
+               if( auto found = algorithm::find( m_usage, descriptor))
+                  return found->second.size;
+               return 0;
+            }
+
+            strong::file::descriptor::id Requests::descriptor( const strong::correlation::id& correlation) const noexcept
+            {
+               if( auto found = algorithm::find( m_entries, correlation))
+                  return found->descriptor;
+               return {};
+            }
+
             Requests::complete_type Requests::consume( const strong::correlation::id& correlation, const common::message::service::lookup::Reply& lookup)
             {
                if( auto found = common::algorithm::find( m_services, correlation))
                {
                   auto message = algorithm::container::extract( m_services, std::begin( found));
-                  m_size -= Requests::size( message);
+                  Requests::release( correlation);
                   message.pending = lookup.pending;
 
                   if( message.service.name != lookup.service.name)
@@ -50,7 +102,7 @@ namespace casual
                if( auto found = algorithm::find( m_complete, correlation))
                {
                   auto result = algorithm::container::extract( m_complete, std::begin( found));
-                  m_size -= result.payload.size();
+                  Requests::release( correlation);
 
                   return result;
                }
@@ -65,11 +117,48 @@ namespace casual
                   return ! algorithm::find( correlations, value).empty();
                };
 
-               return {
+               Result result{
                   algorithm::container::extract( m_services, algorithm::filter( m_services, has_correlation)),
                   algorithm::container::extract( m_complete, algorithm::filter( m_complete, has_correlation)),
                };
-            }     
+
+               auto released = algorithm::container::extract( m_entries, algorithm::filter( m_entries, [&has_correlation]( auto& entry){ return has_correlation( entry.correlation);}));
+
+               for( auto& entry : released)
+                  Requests::release( entry);
+
+               return result;
+            }
+
+            void Requests::charge( Entry entry)
+            {
+               m_size += entry.size;
+               auto& usage = m_usage[ entry.descriptor];
+               ++usage.messages;
+               usage.size += entry.size;
+               m_entries.push_back( std::move( entry));
+            }
+
+            void Requests::release( const strong::correlation::id& correlation)
+            {
+               if( auto found = algorithm::find( m_entries, correlation))
+               {
+                  Requests::release( *found);
+                  m_entries.erase( std::begin( found));
+               }
+            }
+
+            void Requests::release( const Entry& entry)
+            {
+               m_size -= entry.size;
+
+               if( auto found = algorithm::find( m_usage, entry.descriptor))
+               {
+                  found->second.size -= entry.size;
+                  if( --found->second.messages <= 0)
+                     m_usage.erase( std::begin( found));
+               }
+            }
          } // pending
 
 
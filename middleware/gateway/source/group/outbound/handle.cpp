@@ -506,6 +506,16 @@ namespace casual
 
                         if( auto information = algorithm::find( state.external.information(), descriptor))
                         {
+                           // join the stripe set first, so the other side knows before anything else.
+                           if( information->configuration.stripes > 1)
+                           {
+                              auto& stripe = state.stripes[ information->configuration.address];
+                              if( ! stripe)
+                                 stripe = uuid::make();
+
+                              state.external.join( state.directive, descriptor, stripe);
+                           }
+
                            // should we do discovery
                            if( information->configuration)
                            {
@@ -847,6 +857,33 @@ namespace casual
                         };
                      }
                   } // discover
+
+                  namespace flow
+                  {
+                     auto credit( State& state)
+                     {
+                        return [&state]( const gateway::message::domain::flow::Credit& message)
+                        {
+                           Trace trace{ "gateway::group::outbound::handle::local::external::domain::flow::credit"};
+                           log::line( verbose::log, "message: ", message);
+
+                           auto descriptor = state.external.last();
+
+                           try
+                           {
+                              // sends the throttled requests, if any
+                              state.external.credit( state.directive, descriptor, message.messages);
+                           }
+                           catch( ...)
+                           {
+                              if( exception::capture().code() != code::casual::communication_unavailable)
+                                 throw;
+
+                              handle::connection::lost( state, descriptor);
+                           }
+                        };
+                     }
+                  } // flow
                } // domain
   
             } // external
@@ -912,7 +949,10 @@ namespace casual
             local::external::transaction::resource::rollback::reply( state),
 
             // discover
-            local::external::domain::discovery::reply( state)
+            local::external::domain::discovery::reply( state),
+
+            // flow control
+            local::external::domain::flow::credit( state)
          };
       }
 
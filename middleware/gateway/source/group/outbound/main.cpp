@@ -105,6 +105,13 @@ namespace casual
                }
 
 
+               void lost( State& state, strong::file::descriptor::id descriptor)
+               {
+                  // Do we try to reconnect?
+                  if( auto configuration = handle::connection::lost( state, descriptor))
+                     external::reconnect( state, std::move( configuration.value()));
+               }
+
                namespace dispatch
                {
                   auto create( State& state)
@@ -117,16 +124,14 @@ namespace casual
                            try
                            {
                               state.external.last( descriptor);
-                              handler( connection->next());  
+                              handler( state.external.next( *connection));  
                            }
                            catch( ...)
                            {
                               if( exception::capture().code() != code::casual::communication_unavailable)
                                  throw;
 
-                              // Do we try to reconnect?
-                              if( auto configuration = handle::connection::lost( state, descriptor))
-                                 external::reconnect( state, std::move( configuration.value()));
+                              external::lost( state, descriptor);
                            }
                            return true;
                         }
@@ -156,10 +161,14 @@ namespace casual
                            state.alias = message.model.alias;
                            state.order = message.order;
 
-                           state.unconnected = algorithm::transform( message.model.connections, []( auto& configuration)
-                           {
-                              return local::State::Connection{ std::move( configuration)};
-                           });
+                           state.unconnected.clear();
+
+                           // one connection per stripe
+                           for( auto& configuration : message.model.connections)
+                              algorithm::for_n( std::max( configuration.stripes, platform::size::type{ 1}), [&]()
+                              {
+                                 state.unconnected.emplace_back( configuration);
+                              });
 
 
                            // we might got some addresses to try...
@@ -295,8 +304,8 @@ namespace casual
                communication::select::dispatch::pump( 
                   local::condition( state),
                   state.directive,
-                  external::dispatch::create( state),
-                  gateway::group::tcp::pending::send::dispatch( state),
+                  group::tcp::cached::dispatch( state, external::dispatch::create( state)),
+                  gateway::group::tcp::pending::send::dispatch( state, &external::lost),
                   ipc::dispatch::create( state, &internal::handler)
                );
 
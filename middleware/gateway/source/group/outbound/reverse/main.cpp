@@ -198,7 +198,7 @@ namespace casual
                            try
                            {
                               state.external.last( descriptor);
-                              handler( connection->next());  
+                              handler( state.external.next( *connection));  
                            }
                            catch( ...)
                            {
@@ -243,8 +243,11 @@ namespace casual
                communication::select::dispatch::pump( 
                   local::condition( state),
                   state.directive, 
-                  gateway::group::tcp::pending::send::dispatch( state),
-                  external::dispatch::create( state),
+                  gateway::group::tcp::pending::send::dispatch( state, []( State& state, strong::file::descriptor::id descriptor)
+                  {
+                     outbound::handle::connection::lost( state, descriptor);
+                  }),
+                  group::tcp::cached::dispatch( state, external::dispatch::create( state)),
                   ipc::dispatch::create( state, &internal::handler),
                   tcp::listener::dispatch::create( state, tcp::connector::Bound::out)
                );
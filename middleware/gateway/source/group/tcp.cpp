@@ -9,6 +9,13 @@
 #include "casual/assert.h"
 
 #include "common/communication/ipc.h"
+#include "common/communication/tcp/uring.h"
+#include "common/serialize/native/complete.h"
+#include "common/code/raise.h"
+#include "common/code/casual.h"
+
+#include <zstd.h>
+
 namespace casual
 {
    namespace gateway::group::tcp
@@ -41,25 +48,429 @@ namespace casual
 
       } // connector
 
+      namespace limit
+      {
+         namespace
+         {
+            //! @returns the max size of a message from another domain, that we allocate from the size 
+            //!   the other domain claims
+            platform::size::type size()
+            {
+               static const auto result = environment::variable::get( environment::variable::name::gateway::message::size, platform::tcp::message::max::payload);
+               return result;
+            }
+         } // <unnamed>
+      } // limit
+
+      namespace compression
+      {
+         namespace local
+         {
+            namespace
+            {
+               struct Settings
+               {
+                  platform::size::type threshold = platform::tcp::compression::threshold;
+                  int level = platform::tcp::compression::level;
+               };
+
+               const Settings& settings()
+               {
+                  static const Settings result = []()
+                  {
+                     Settings result;
+                     result.threshold = environment::variable::get( environment::variable::name::gateway::compression::threshold, result.threshold);
+                     result.level = environment::variable::get( environment::variable::name::gateway::compression::level, result.level);
+                     return result;
+                  }();
+                  return result;
+               }
+
+               struct Delete
+               {
+                  void operator() ( ZSTD_CCtx* context) const noexcept { ZSTD_freeCCtx( context);}
+                  void operator() ( ZSTD_DCtx* context) const noexcept { ZSTD_freeDCtx( context);}
+               };
+
+            } // <unnamed>
+         } // local
+
+         struct Context::Implementation
+         {
+            void compress( complete_type& complete)
+            {
+               auto& settings = local::settings();
+
+               if( settings.threshold == 0 || range::size( complete.payload) <= settings.threshold)
+                  return;
+
+               // the contexts are created when needed, and reused for the connection
+               if( ! compressor)
+                  compressor.reset( ZSTD_createCCtx());
+
+               auto start = platform::time::clock::type::now();
+
+               message::domain::Compressed message;
+               message.correlation = complete.correlation();
+               message.original.type = complete.type();
+               message.original.size = complete.payload.size();
+               message.payload.resize( ZSTD_compressBound( complete.payload.size()));
+
+               auto size = ZSTD_compressCCtx( compressor.get(), 
+                  message.payload.data(), message.payload.size(), 
+                  complete.payload.data(), complete.payload.size(), 
+                  settings.level);
+
+               metric.compress.time += platform::time::clock::type::now() - start;
+
+               if( ZSTD_isError( size))
+               {
+                  log::line( log::category::error, "failed to compress message: ", complete.type(), " - ", ZSTD_getErrorName( size), " - action: send as is");
+                  return;
+               }
+
+               // not worth it, we send it as is.
+               if( static_cast< platform::size::type>( size) * 100 > range::size( complete.payload) * platform::tcp::compression::ratio)
+                  return;
+
+               message.payload.resize( size);
+
+               ++metric.compress.count;
+               metric.compress.raw += message.original.size;
+               metric.compress.compressed += size;
+
+               complete = serialize::native::complete< complete_type>( message);
+            }
+
+            void decompress( complete_type& complete)
+            {
+               if( complete.type() != message::domain::Compressed::type())
+                  return;
+
+               auto start = platform::time::clock::type::now();
+
+               message::domain::Compressed message;
+               serialize::native::complete( complete, message);
+
+               if( message.original.size < 0 || message.original.size > limit::size())
+                  code::raise::error( code::casual::communication_protocol, "compressed message: ", message.original.type, " - size: ", message.original.size, " - exceeds limit: ", limit::size());
+
+               // the frame has to agree on the size we allocate
+               const auto content = ZSTD_getFrameContentSize( message.payload.data(), message.payload.size());
+               if( content == ZSTD_CONTENTSIZE_UNKNOWN || content == ZSTD_CONTENTSIZE_ERROR || content != static_cast< decltype( content)>( message.original.size))
+                  code::raise::error( code::casual::communication_protocol, "compressed message: ", message.original.type, " - size: ", message.original.size, " - does not match the frame content size");
+
+               if( ! decompressor)
+                  decompressor.reset( ZSTD_createDCtx());
+
+               complete_type::payload_type payload( message.original.size);
+
+               auto size = ZSTD_decompressDCtx( decompressor.get(), 
+                  payload.data(), payload.size(), 
+                  message.payload.data(), message.payload.size());
+
+               if( ZSTD_isError( size) || static_cast< platform::size::type>( size) != message.original.size)
+                  code::raise::error( code::casual::communication_protocol, "failed to decompress message: ", message.original.type, " - ", ZSTD_getErrorName( size));
+
+               ++metric.decompress.count;
+               metric.decompress.raw += message.original.size;
+               metric.decompress.compressed += range::size( message.payload);
+               metric.decompress.time += platform::time::clock::type::now() - start;
+
+               complete = complete_type{ message.original.type, complete.correlation(), std::move( payload)};
+               // the original message is received in full
+               complete.offset = communication::tcp::message::header::size + range::size( complete.payload);
+            }
+
+            std::unique_ptr< ZSTD_CCtx, local::Delete> compressor;
+            std::unique_ptr< ZSTD_DCtx, local::Delete> decompressor;
+            manager::admin::model::connection::Compression metric;
+         };
+
+         Context::Context() = default;
+         Context::~Context() = default;
+         Context::Context( Context&&) noexcept = default;
+         Context& Context::operator = ( Context&&) noexcept = default;
+
+         void Context::compress( complete_type& complete)
+         {
+            m_implementation->compress( complete);
+         }
+
+         void Context::decompress( complete_type& complete)
+         {
+            m_implementation->decompress( complete);
+         }
+
+         const manager::admin::model::connection::Compression& Context::metric() const noexcept
+         {
+            return m_implementation->metric;
+         }
+
+      } // compression
+
+      namespace stripe
+      {
+         namespace fragment
+         {
+            bool eligible( const complete_type& complete) noexcept
+            {
+               switch( complete.type())
+               {
+                  using Type = common::message::Type;
+                  case Type::service_call:
+                  case Type::service_reply:
+                  case Type::queue_group_enqueue_request:
+                  case Type::queue_group_dequeue_reply:
+                     return true;
+                  default:
+                     return false;
+               }
+            }
+
+            std::vector< complete_type> split( const complete_type& complete, platform::size::type size)
+            {
+               Trace trace{ "gateway::group::tcp::stripe::fragment::split"};
+
+               std::vector< complete_type> result;
+
+               message::domain::stripe::Fragment fragment;
+               fragment.correlation = complete.correlation();
+               fragment.original.type = complete.type();
+               fragment.original.size = complete.payload.size();
+
+               for( fragment.offset = 0; fragment.offset < fragment.original.size; fragment.offset += size)
+               {
+                  auto first = std::begin( complete.payload) + fragment.offset;
+                  fragment.payload.assign( first, first + std::min( size, fragment.original.size - fragment.offset));
+                  result.push_back( serialize::native::complete< complete_type>( fragment));
+               }
+
+               log::line( verbose::log, "fragments: ", result.size(), ", size: ", size);
+
+               return result;
+            }
+            
+         } // fragment
+
+         Reassembly::Reassembly() : Reassembly{ limit::size()} {}
+
+         complete_type Reassembly::add( const common::Uuid& stripe, common::strong::file::descriptor::id descriptor, complete_type&& complete)
+         {
+            Trace trace{ "gateway::group::tcp::stripe::Reassembly::add"};
+
+            message::domain::stripe::Fragment fragment;
+            serialize::native::complete( complete, fragment);
+
+            const auto first = fragment.offset;
+            const auto last = fragment.offset + range::size( fragment.payload);
+
+            if( fragment.original.size > limit::size())
+               code::raise::error( code::casual::communication_protocol, "fragmented message: ", fragment.original.type, " - size: ", fragment.original.size, " - exceeds limit: ", limit::size());
+
+            if( first < 0 || first == last || last > fragment.original.size)
+               code::raise::error( code::casual::communication_protocol, "fragment out of bounds - offset: ", fragment.offset, ", size: ", fragment.payload.size(), ", original: ", fragment.original.size);
+
+            auto found = algorithm::find( m_partials, complete.correlation());
+
+            if( found && ( found->complete.type() != fragment.original.type || found->size != fragment.original.size))
+               code::raise::error( code::casual::communication_protocol, "fragment does not match its message - type: ", fragment.original.type, ", original: ", fragment.original.size, ", partial: ", found->complete);
+
+            // the payload grows with the fragments, we never allocate from the size the other domain claims up front
+            // (grows geometrically, bounded by the original size)
+            auto allocated = found ? static_cast< platform::size::type>( found->complete.payload.capacity()) : platform::size::type{};
+            auto capacity = allocated;
+
+            if( last > allocated)
+               capacity = std::min( std::max( allocated * 2, last), fragment.original.size);
+
+            auto& usage = this->usage( stripe, descriptor);
+
+            if( usage.size + ( capacity - allocated) > m_capacity)
+               code::raise::error( code::casual::communication_protocol, "fragmented messages exceeds capacity - partials: ", usage.size, ", fragment: ", fragment.offset, 
+                  ", original: ", fragment.original.size, ", capacity: ", m_capacity);
+
+            if( ! found)
+            {
+               m_partials.push_back( Partial{ 
+                  stripe,
+                  descriptor,
+                  complete_type{ fragment.original.type, complete.correlation(), {}},
+                  fragment.original.size});
+               found = range::make( std::prev( std::end( m_partials)), std::end( m_partials));
+            }
+
+            // the fragment must not overlap any received fragment
+            auto& ranges = found->ranges;
+            auto next = ranges.lower_bound( first);
+            if( ( next != std::end( ranges) && next->first < last) || ( next != std::begin( ranges) && std::prev( next)->second > first))
+               code::raise::error( code::casual::communication_protocol, "fragment overlaps received fragments - offset: ", fragment.offset, ", size: ", fragment.payload.size());
+
+            ranges.emplace_hint( next, first, last);
+
+            {
+               auto& payload = found->complete.payload;
+
+               if( capacity > allocated)
+               {
+                  payload.reserve( capacity);
+                  usage.size += static_cast< platform::size::type>( payload.capacity()) - allocated;
+               }
+
+               if( last > range::size( payload))
+                  payload.resize( last);
+            }
+
+            algorithm::copy( fragment.payload, std::begin( found->complete.payload) + fragment.offset);
+            found->received += fragment.payload.size();
+
+            if( found->received < found->size)
+               return {};
+
+            release( *found);
+            auto result = algorithm::container::extract( m_partials, std::begin( found)).complete;
+            // the original message is received in full
+            result.offset = communication::tcp::message::header::size + range::size( result.payload);
+
+            log::line( verbose::log, "reassembled: ", result);
+
+            return result;
+         }
+
+         void Reassembly::discard( const common::Uuid& stripe)
+         {
+            algorithm::container::erase_if( m_partials, [&stripe]( auto& partial){ return partial.stripe == stripe;});
+            algorithm::container::erase_if( m_usage, [&stripe]( auto& usage){ return usage.stripe == stripe;});
+         }
+
+         void Reassembly::discard( common::strong::file::descriptor::id descriptor)
+         {
+            algorithm::container::erase_if( m_partials, [descriptor]( auto& partial){ return ! partial.stripe && partial.descriptor == descriptor;});
+            algorithm::container::erase_if( m_usage, [descriptor]( auto& usage){ return ! usage.stripe && usage.descriptor == descriptor;});
+         }
+
+         platform::size::type Reassembly::size( const common::Uuid& stripe, common::strong::file::descriptor::id descriptor) const noexcept
+         {
+            if( auto found = algorithm::find_if( m_usage, [&]( auto& usage){ return usage.match( stripe, descriptor);}))
+               return found->size;
+            return 0;
+         }
+
+         Reassembly::Usage& Reassembly::usage( const common::Uuid& stripe, common::strong::file::descriptor::id descriptor)
+         {
+            if( auto found = algorithm::find_if( m_usage, [&]( auto& usage){ return usage.match( stripe, descriptor);}))
+               return *found;
+
+            return m_usage.emplace_back( Usage{ stripe, descriptor});
+         }
+
+         void Reassembly::release( const Partial& partial)
+         {
+            auto& usage = this->usage( partial.stripe, partial.descriptor);
+            usage.size -= partial.complete.payload.capacity();
+
+            if( usage.size <= 0)
+               algorithm::container::erase_if( m_usage, [&]( auto& value){ return &value == &usage;});
+         }
+         
+      } // stripe
+
+      namespace flow
+      {
+         bool controlled( common::message::Type type) noexcept
+         {
+            switch( type)
+            {
+               using Type = common::message::Type;
+               case Type::service_call:
+               case Type::conversation_connect_request:
+               case Type::queue_group_enqueue_request:
+               case Type::queue_group_dequeue_request:
+                  return true;
+               default:
+                  return false;
+            }
+         }
+      } // flow
+
       void Connection::unsent( common::communication::select::Directive& directive)
       {
          Trace trace{ "gateway::group::tcp::Connection::unsent"};
 
+         // we send as many of the unsent messages as possible, in one go.
          while( ! m_unsent.empty())
          {
-            if( common::communication::device::non::blocking::send( m_device, m_unsent.front()))
-               m_unsent.erase( std::begin( m_unsent));
-            else
+            auto sent = common::communication::tcp::batch::send( m_device.connector().socket(), range::make( m_unsent));
+            
+            if( sent == 0)
                return;
+            
+            m_unsent.erase( std::begin( m_unsent), std::begin( m_unsent) + sent);
          }
 
          directive.write.remove( descriptor());
       }
       
+      std::vector< strong::file::descriptor::id> unsent( 
+         communication::select::Directive& directive, 
+         std::vector< Connection>& connections,
+         strong::file::descriptor::id descriptor)
+      {
+         Trace trace{ "gateway::group::tcp::unsent"};
+
+         std::vector< Connection*> pending;
+
+         for( auto& connection : connections)
+            if( ! connection.m_unsent.empty() && ( communication::tcp::uring::enabled() || connection.descriptor() == descriptor))
+               pending.push_back( &connection);
+
+         std::vector< strong::file::descriptor::id> lost;
+
+         // we send as many of the unsent messages as possible, as long as the connections accept
+         while( ! pending.empty())
+         {
+            auto destinations = algorithm::transform( pending, []( auto connection)
+            {
+               return communication::tcp::batch::Destination{ &connection->m_device.connector().socket(), range::make( connection->m_unsent)};
+            });
+
+            communication::tcp::batch::send( range::make( destinations));
+
+            std::vector< Connection*> accepting;
+
+            for( platform::size::type index = 0; index < range::size( pending); ++index)
+            {
+               auto connection = pending[ index];
+               auto& destination = destinations[ index];
+
+               if( destination.error)
+               {
+                  log::line( verbose::log, destination.error, " descriptor: ", connection->descriptor());
+                  lost.push_back( connection->descriptor());
+                  continue;
+               }
+
+               connection->m_unsent.erase( std::begin( connection->m_unsent), std::begin( connection->m_unsent) + destination.count);
+
+               if( connection->m_unsent.empty())
+                  directive.write.remove( connection->descriptor());
+               else if( destination.count > 0)
+                  accepting.push_back( connection);
+            }
+
+            pending = std::move( accepting);
+         }
+
+         return lost;
+      }
+      
       common::strong::correlation::id Connection::send( common::communication::select::Directive& directive, complete_type&& complete)
       {
          Trace trace{ "gateway::group::tcp::Connection::send"};
 
+         if( m_protocol >= message::domain::protocol::Version::version_1_2)
+            m_compression.compress( complete);
+
          if( m_unsent.empty())
          {
             if( common::communication::device::non::blocking::send( m_device, complete))
@@ -73,5 +484,20 @@ namespace casual
          return m_unsent.back().correlation();
       }
 
+      platform::size::type Connection::queued() const noexcept
+      {
+         return algorithm::accumulate( m_unsent, platform::size::type{}, []( auto result, auto& complete)
+         {
+            return result + range::size( complete.payload) + communication::tcp::message::header::size - complete.offset;
+         });
+      }
+
+      Connection::complete_type Connection::next()
+      {
+         auto complete = communication::device::non::blocking::next( m_device);
+         m_compression.decompress( complete);
+         return complete;
+      }
+
    } // gateway::group::tcp
 } // casual
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include "xatmi.h"
 
 #include <iostream>
+#include <iomanip>
 
 namespace casual
 {
@@ -134,6 +135,28 @@ namespace casual
                      return dash_if_empty( value.address.peer);
                   };
 
+                  //! the ratio (raw / compressed) of compressed payloads, in both directions
+                  auto format_compression = []( auto& value) -> std::string
+                  {
+                     auto& compression = value.compression;
+                     auto compressed = compression.compress.compressed + compression.decompress.compressed;
+
+                     if( compressed == 0)
+                        return "-";
+
+                     auto raw = compression.compress.raw + compression.decompress.raw;
+                     return string::compose( std::fixed, std::setprecision( 1), static_cast< double>( raw) / compressed);
+                  };
+
+                  //! the total time (seconds) the connection has been throttled by flow control
+                  auto format_throttled = []( auto& value) -> std::string
+                  {
+                     if( value.flow.throttled == platform::time::unit::zero())
+                        return "-";
+
+                     return string::compose( std::fixed, std::setprecision( 3), std::chrono::duration< double>( value.flow.throttled).count());
+                  };
+
                   using Formatter = terminal::format::formatter<  manager::admin::model::Connection>;
 
                   if( ! terminal::output::directive().porcelain())
@@ -145,6 +168,8 @@ namespace casual
                         terminal::format::column( "bound", format_bound, terminal::color::magenta),
                         terminal::format::column( "local", format_local_address, terminal::color::white),
                         terminal::format::column( "peer", format_peer_address, terminal::color::white),
+                        terminal::format::column( "compression", format_compression, terminal::color::cyan),
+                        terminal::format::column( "throttled", format_throttled, terminal::color::red),
                         terminal::format::column( "created", format::created, terminal::color::blue)
                      );
                   }
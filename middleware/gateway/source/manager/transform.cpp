@@ -73,6 +73,8 @@ namespace casual
                      result.address.peer = connection.address.peer;
                      result.remote = connection.domain;
                      result.created = connection.created;
+                     result.compression = connection.compression;
+                     result.flow = connection.flow;
 
                      // deprecated remove in 2.0
                      result.process = reply.process; 
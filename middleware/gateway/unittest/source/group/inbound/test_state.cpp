@@ -0,0 +1,155 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#include "common/unittest.h"
+
+
+#include "gateway/group/inbound/state.h"
+
+namespace casual
+{
+   using namespace common;
+
+   namespace gateway::group::inbound
+   {
+      namespace local
+      {
+         namespace
+         {
+            auto fd( int value) { return strong::file::descriptor::id{ value};};
+
+            auto call()
+            {
+               common::message::service::call::callee::Request message;
+               message.correlation = strong::correlation::id::emplace( uuid::make());
+               message.service.name = "a";
+               return message;
+            }
+
+            auto limit( platform::size::type size, platform::size::type messages)
+            {
+               state::pending::Limit result;
+               result.size = size;
+               result.messages = messages;
+               return result;
+            }
+
+         } // <unnamed>
+      } // local
+
+      TEST( gateway_group_inbound_state, pending_share)
+      {
+         common::unittest::Trace trace;
+
+         state::pending::Requests requests;
+         requests.limit( local::limit( 1000, 10));
+
+         EXPECT_TRUE( requests.share( 0) == local::limit( 1000, 10));
+         EXPECT_TRUE( requests.share( 1) == local::limit( 1000, 10));
+         EXPECT_TRUE( requests.share( 4) == local::limit( 250, 2));
+         // never shared to unlimited
+         EXPECT_TRUE( requests.share( 20) == local::limit( 50, 1));
+
+         requests.limit( local::limit( 0, 10));
+         EXPECT_TRUE( requests.share( 4) == local::limit( 0, 2));
+      }
+
+      TEST( gateway_group_inbound_state, pending_congested__connection_over_share__expect_only_that_connection_congested)
+      {
+         common::unittest::Trace trace;
+
+         state::pending::Requests requests;
+         requests.limit( local::limit( 0, 4));
+
+         std::vector< strong::correlation::id> correlations;
+
+         auto add = [&]( auto descriptor)
+         {
+            auto message = local::call();
+            correlations.push_back( message.correlation);
+            requests.add( descriptor, std::move( message));
+         };
+
+         add( local::fd( 10));
+         add( local::fd( 10));
+         add( local::fd( 10));
+         EXPECT_TRUE( requests.messages( local::fd( 10)) == 3);
+
+         // not congested in total
+         EXPECT_TRUE( ! requests.congested( local::fd( 10), 2));
+
+         add( local::fd( 20));
+         add( local::fd( 20));
+         EXPECT_TRUE( requests.congested());
+
+         // share is 2 each
+         EXPECT_TRUE( requests.congested( local::fd( 10), 2));
+         EXPECT_TRUE( ! requests.congested( local::fd( 20), 2));
+
+         // consume one from 10
+         {
+            common::message::service::lookup::Reply lookup;
+            lookup.correlation = correlations.at( 0);
+            lookup.service.name = "a";
+            requests.consume( lookup.correlation, lookup);
+         }
+         EXPECT_TRUE( requests.messages( local::fd( 10)) == 2);
+         EXPECT_TRUE( ! requests.congested());
+         EXPECT_TRUE( ! requests.congested( local::fd( 10), 2));
+      }
+
+      TEST( gateway_group_inbound_state, pending_consume_correlations__expect_connection_released)
+      {
+         common::unittest::Trace trace;
+
+         state::pending::Requests requests;
+         requests.limit( local::limit( 0, 1));
+
+         auto message = local::call();
+         auto correlation = message.correlation;
+         requests.add( local::fd( 10), std::move( message));
+         requests.add( local::fd( 10), local::call());
+
+         EXPECT_TRUE( requests.congested( local::fd( 10), 1));
+         EXPECT_TRUE( requests.size( local::fd( 10)) > 0);
+
+         auto result = requests.consume( std::vector< strong::correlation::id>{ correlation});
+         EXPECT_TRUE( result.services.size() == 1);
+         EXPECT_TRUE( requests.messages( local::fd( 10)) == 1);
+         EXPECT_TRUE( ! requests.congested( local::fd( 10), 1));
+      }
+
+      TEST( gateway_group_inbound_state, pending_usage__add_consume__expect_per_connection_counters)
+      {
+         common::unittest::Trace trace;
+
+         state::pending::Requests requests;
+
+         auto a = local::call();
+         auto correlation = a.correlation;
+         requests.add( local::fd( 10), std::move( a));
+         requests.add( local::fd( 20), local::call());
+
+         EXPECT_TRUE( requests.descriptor( correlation) == local::fd( 10));
+         EXPECT_TRUE( requests.messages( local::fd( 10)) == 1);
+         EXPECT_TRUE( requests.messages( local::fd( 20)) == 1);
+         auto size = requests.size( local::fd( 10));
+         EXPECT_TRUE( size > 0);
+
+         common::message::service::lookup::Reply lookup;
+         lookup.correlation = correlation;
+         lookup.service.name = "a";
+         requests.consume( lookup.correlation, lookup);
+
+         EXPECT_TRUE( ! requests.descriptor( correlation));
+         EXPECT_TRUE( requests.messages( local::fd( 10)) == 0);
+         EXPECT_TRUE( requests.size( local::fd( 10)) == 0);
+         EXPECT_TRUE( requests.messages( local::fd( 20)) == 1);
+         EXPECT_TRUE( requests.size( local::fd( 20)) == size);
+      }
+
+   } // gateway::group::inbound
+} // casual
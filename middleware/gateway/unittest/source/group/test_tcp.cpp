@@ -0,0 +1,699 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#include "common/unittest.h"
+
+#include "gateway/group/tcp.h"
+
+#include "configuration/model.h"
+
+#include "common/message/service.h"
+#include "common/serialize/native/complete.h"
+#include "common/code/casual.h"
+
+#include <thread>
+
+namespace casual
+{
+   using namespace common;
+
+   namespace gateway::group::tcp
+   {
+      namespace local
+      {
+         namespace
+         {
+            using Version = gateway::message::domain::protocol::Version;
+
+            communication::tcp::Address address()
+            {
+               static long port = 23766;
+               return { string::compose(  "127.0.0.1:", ++port)};
+            }
+
+            struct Loopback
+            {
+               Loopback( Version version)
+               {
+                  auto address = local::address();
+                  communication::tcp::Listener listener{ address};
+                  sender.emplace( communication::tcp::Duplex{ communication::tcp::connect( address)}, version);
+                  receiver.emplace( communication::tcp::Duplex{ listener()}, version);
+               }
+
+               template< typename M>
+               auto roundtrip( M&& message)
+               {
+                  sender->send( directive, message);
+
+                  while( true)
+                  {
+                     sender->unsent( directive);
+
+                     if( auto complete = receiver->next())
+                     {
+                        std::decay_t< M> result;
+                        serialize::native::complete( complete, result);
+                        return result;
+                     }
+                  }
+               }
+
+               communication::select::Directive directive;
+               std::optional< Connection> sender;
+               std::optional< Connection> receiver;
+            };
+
+            //! something that looks like a typical text-ish payload, that compress reasonably
+            auto payload( platform::size::type size)
+            {
+               platform::binary::type result;
+               result.reserve( size);
+
+               platform::size::type index = 0;
+
+               while( range::size( result) < size)
+               {
+                  auto row = string::compose( R"({"id":)", index, R"(,"name":"customer-)", index % 97, R"(","amount":)", ( index * 7919) % 10000, R"(,"currency":"SEK"},)");
+                  algorithm::append( row, result);
+                  ++index;
+               }
+
+               result.resize( size);
+               return result;
+            }
+
+            auto call( platform::size::type size)
+            {
+               common::message::service::call::callee::Request message;
+               message.correlation = strong::correlation::id::emplace( uuid::make());
+               message.service.name = "service";
+               message.buffer.type = ".json/";
+               message.buffer.memory = local::payload( size);
+               return message;
+            }
+
+            //! limits the socket buffers, which emulates the tcp window
+            template< int option>
+            struct window : communication::socket::option::base< option>
+            {
+               constexpr static int value() { return 64 * 1024;}
+            };
+
+            //! N tcp connections between an 'outbound' and an 'inbound' side, that forms a stripe set
+            //! (if N > 1). To emulate a latency bound link (without netem), the socket buffers are 
+            //! limited to a 'window', and the receiver only drains each tcp flow once per `delay`. 
+            //! Hence, each flow has a throughput of window / delay, as a real wan link with round trip `delay`.
+            struct Striped
+            {
+               Striped( platform::size::type count, platform::time::unit delay = {}, Version version = Version::version_1_3) 
+                  : delay{ delay}, version{ version}
+               {
+                  auto stripe = uuid::make();
+
+                  algorithm::for_n( count, [&]()
+                  {
+                     auto address = local::address();
+                     communication::tcp::Listener listener{ address};
+                     auto socket = communication::tcp::connect( address);
+                     auto accepted = listener();
+
+                     if( delay > platform::time::unit::zero())
+                     {
+                        socket.set( window< SO_SNDBUF>{});
+                        accepted.set( window< SO_RCVBUF>{});
+                     }
+
+                     auto descriptor = connect( outbound, std::move( socket));
+                     connect( inbound, std::move( accepted));
+
+                     if( count > 1)
+                        outbound.join( directive, descriptor, stripe);
+                  });
+               }
+
+               template< typename M>
+               void send( M&& message)
+               {
+                  outbound.send( directive, range::front( outbound.connections()), std::forward< M>( message));
+               }
+
+               //! @returns the next `count` messages received on the inbound side
+               std::vector< Connection::complete_type> receive( platform::size::type count)
+               {
+                  std::vector< Connection::complete_type> result;
+
+                  while( range::size( result) < count)
+                  {
+                     for( auto& connection : outbound.connections())
+                        connection.unsent( directive);
+
+                     for( auto& connection : inbound.connections())
+                        if( auto complete = inbound.next( connection))
+                           result.push_back( std::move( complete));
+
+                     if( delay > platform::time::unit::zero())
+                        std::this_thread::sleep_for( delay);
+                  }
+
+                  return result;
+               }
+
+               communication::select::Directive directive;
+               External< configuration::model::gateway::outbound::Connection> outbound;
+               External< configuration::model::gateway::inbound::Connection> inbound;
+               platform::time::unit delay;
+               Version version;
+
+            private:
+               template< typename E>
+               strong::file::descriptor::id connect( E& external, communication::Socket&& socket)
+               {
+                  external.pending().add( common::Process{}, std::move( socket), {});
+
+                  gateway::message::domain::Connected message;
+                  message.version = version;
+                  return external.connected( directive, message);
+               }
+            };
+
+         } // <unnamed>
+      } // local
+
+      TEST( gateway_group_tcp, compression__version_1_1__small_and_large__expect_not_compressed)
+      {
+         common::unittest::Trace trace;
+
+         local::Loopback loopback{ local::Version::version_1_1};
+
+         for( auto size : { 10, 64 * 1024})
+         {
+            auto message = local::call( size);
+            auto result = loopback.roundtrip( message);
+            EXPECT_TRUE( result.buffer.memory == message.buffer.memory);
+         }
+
+         EXPECT_TRUE( loopback.sender->compression().compress.count == 0);
+         EXPECT_TRUE( loopback.receiver->compression().decompress.count == 0);
+      }
+
+      TEST( gateway_group_tcp, compression__version_1_2__small_and_large__expect_large_compressed)
+      {
+         common::unittest::Trace trace;
+
+         local::Loopback loopback{ local::Version::version_1_2};
+
+         for( auto size : { 10, 64 * 1024})
+         {
+            auto message = local::call( size);
+            auto result = loopback.roundtrip( message);
+            EXPECT_TRUE( result.correlation == message.correlation);
+            EXPECT_TRUE( result.buffer.memory == message.buffer.memory);
+         }
+
+         auto& compress = loopback.sender->compression().compress;
+         EXPECT_TRUE( compress.count == 1) << CASUAL_NAMED_VALUE( compress);
+         EXPECT_TRUE( compress.compressed < compress.raw) << CASUAL_NAMED_VALUE( compress);
+         EXPECT_TRUE( loopback.receiver->compression().decompress.count == 1);
+         EXPECT_TRUE( loopback.receiver->compression().decompress.raw == compress.raw);
+      }
+
+      TEST( gateway_group_tcp, compression__loopback_benchmark)
+      {
+         common::unittest::Trace trace;
+
+         constexpr auto count = 200;
+         constexpr platform::size::type size = 64 * 1024;
+
+         auto message = local::call( size);
+
+         auto measure = [&]( local::Version version)
+         {
+            local::Loopback loopback{ version};
+
+            auto start = platform::time::clock::type::now();
+
+            for( auto index = count; index > 0; --index)
+               EXPECT_TRUE( range::size( loopback.roundtrip( message).buffer.memory) == size);
+
+            auto end = platform::time::clock::type::now();
+
+            auto& compress = loopback.sender->compression().compress;
+            auto& decompress = loopback.receiver->compression().decompress;
+
+            auto microseconds = []( auto duration){ return std::chrono::duration_cast< std::chrono::microseconds>( duration).count();};
+
+            log::line( unittest::log, "version: ", version,
+               ", messages: ", count,
+               ", payload: ", size,
+               ", time: ", microseconds( end - start), "us",
+               ", compressed: ", compress.count,
+               ", raw: ", compress.raw,
+               ", wire: ", compress.compressed,
+               ", compress cpu: ", microseconds( compress.time), "us",
+               ", decompress cpu: ", microseconds( decompress.time), "us");
+         };
+
+         measure( local::Version::version_1_1);
+         measure( local::Version::version_1_2);
+      }
+
+      TEST( gateway_group_tcp, compression__original_size_does_not_match_frame__expect_protocol_error)
+      {
+         common::unittest::Trace trace;
+
+         compression::Context context;
+
+         auto complete = serialize::native::complete< Connection::complete_type>( local::call( 64 * 1024));
+         context.compress( complete);
+         ASSERT_TRUE( complete.type() == message::domain::Compressed::type());
+
+         message::domain::Compressed message;
+         serialize::native::complete( complete, message);
+         message.original.size += 1;
+         complete = serialize::native::complete< Connection::complete_type>( message);
+
+         EXPECT_CODE({
+            context.decompress( complete);
+         }, code::casual::communication_protocol);
+      }
+
+      TEST( gateway_group_tcp, stripe_fragment__split_and_reassemble_in_reverse_order__expect_original)
+      {
+         common::unittest::Trace trace;
+
+         auto message = local::call( 200 * 1024);
+         auto complete = serialize::native::complete< Connection::complete_type>( message);
+
+         auto fragments = stripe::fragment::split( complete, 64 * 1024);
+         ASSERT_TRUE( fragments.size() == 4);
+
+         auto stripe = uuid::make();
+         stripe::Reassembly reassembly;
+
+         for( auto& fragment : range::reverse( fragments))
+         {
+            EXPECT_TRUE( reassembly.empty() == ( &fragment == &fragments.back()));
+
+            if( auto result = reassembly.add( stripe, strong::file::descriptor::id{ 42}, std::move( fragment)))
+            {
+               EXPECT_TRUE( result.type() == complete.type());
+               EXPECT_TRUE( result.correlation() == complete.correlation());
+               EXPECT_TRUE( result.payload == complete.payload);
+            }
+         }
+
+         EXPECT_TRUE( reassembly.empty());
+      }
+
+      TEST( gateway_group_tcp, stripe_fragment__discard_stripe__expect_partial_removed)
+      {
+         common::unittest::Trace trace;
+
+         auto complete = serialize::native::complete< Connection::complete_type>( local::call( 200 * 1024));
+         auto fragments = stripe::fragment::split( complete, 64 * 1024);
+
+         auto stripe = uuid::make();
+         stripe::Reassembly reassembly;
+         EXPECT_TRUE( ! reassembly.add( stripe, strong::file::descriptor::id{ 42}, std::move( fragments.front())));
+         EXPECT_TRUE( ! reassembly.empty());
+
+         reassembly.discard( stripe);
+         EXPECT_TRUE( reassembly.empty());
+      }
+
+      TEST( gateway_group_tcp, stripe_fragment__no_stripe__discard_connection__expect_partial_removed)
+      {
+         common::unittest::Trace trace;
+
+         auto complete = serialize::native::complete< Connection::complete_type>( local::call( 200 * 1024));
+         auto fragments = stripe::fragment::split( complete, 64 * 1024);
+
+         stripe::Reassembly reassembly;
+         EXPECT_TRUE( ! reassembly.add( {}, strong::file::descriptor::id{ 42}, std::move( fragments.front())));
+
+         reassembly.discard( strong::file::descriptor::id{ 43});
+         EXPECT_TRUE( ! reassembly.empty());
+
+         reassembly.discard( strong::file::descriptor::id{ 42});
+         EXPECT_TRUE( reassembly.empty());
+      }
+
+      TEST( gateway_group_tcp, stripe_fragment__many_partials__expect_allocated_as_received__bounded_by_capacity)
+      {
+         common::unittest::Trace trace;
+
+         constexpr platform::size::type fragment = 64 * 1024;
+
+         auto stripe = uuid::make();
+         stripe::Reassembly reassembly{ 16 * fragment};
+
+         auto first = [&]()
+         {
+            auto complete = serialize::native::complete< Connection::complete_type>( local::call( 200 * 1024));
+            return std::move( stripe::fragment::split( complete, fragment).front());
+         };
+
+         // only the received fragment is allocated, not the size the message claims
+         for( auto count = 1; count <= 16; ++count)
+         {
+            EXPECT_TRUE( ! reassembly.add( stripe, strong::file::descriptor::id{ 42}, first()));
+            EXPECT_TRUE( reassembly.size( stripe, {}) == count * fragment) << CASUAL_NAMED_VALUE( reassembly.size( stripe, {}));
+         }
+
+         EXPECT_CODE({
+            reassembly.add( stripe, strong::file::descriptor::id{ 43}, first());
+         }, code::casual::communication_protocol);
+
+         // another stripe set has its own bound
+         auto other = uuid::make();
+         EXPECT_TRUE( ! reassembly.add( other, strong::file::descriptor::id{ 44}, first()));
+         EXPECT_TRUE( reassembly.size( other, {}) == fragment);
+
+         reassembly.discard( stripe);
+         EXPECT_TRUE( reassembly.size( stripe, {}) == 0);
+
+         // a reassembled message releases its bytes
+         {
+            auto complete = serialize::native::complete< Connection::complete_type>( local::call( 200 * 1024));
+            auto fragments = stripe::fragment::split( complete, fragment);
+            
+            Connection::complete_type result;
+            for( auto& value : fragments)
+               result = reassembly.add( stripe, strong::file::descriptor::id{ 42}, std::move( value));
+
+            EXPECT_TRUE( result.payload == complete.payload);
+            EXPECT_TRUE( reassembly.size( stripe, {}) == 0);
+         }
+
+         reassembly.discard( other);
+         EXPECT_TRUE( reassembly.empty());
+      }
+
+      TEST( gateway_group_tcp, stripe_fragment__duplicate__expect_protocol_error)
+      {
+         common::unittest::Trace trace;
+
+         auto complete = serialize::native::complete< Connection::complete_type>( local::call( 200 * 1024));
+         auto fragments = stripe::fragment::split( complete, 64 * 1024);
+         auto duplicate = fragments.front();
+
+         auto stripe = uuid::make();
+         stripe::Reassembly reassembly;
+         EXPECT_TRUE( ! reassembly.add( stripe, strong::file::descriptor::id{ 42}, std::move( fragments.front())));
+
+         EXPECT_CODE({
+            reassembly.add( stripe, strong::file::descriptor::id{ 42}, std::move( duplicate));
+         }, code::casual::communication_protocol);
+      }
+
+      TEST( gateway_group_tcp, stripe_fragment__larger_original_than_partial__expect_protocol_error)
+      {
+         common::unittest::Trace trace;
+
+         auto complete = serialize::native::complete< Connection::complete_type>( local::call( 200 * 1024));
+         auto fragments = stripe::fragment::split( complete, 64 * 1024);
+
+         auto stripe = uuid::make();
+         stripe::Reassembly reassembly;
+         EXPECT_TRUE( ! reassembly.add( stripe, strong::file::descriptor::id{ 42}, std::move( fragments.front())));
+
+         // a later fragment claims a larger message, and an offset beyond the partial
+         message::domain::stripe::Fragment fragment;
+         serialize::native::complete( fragments.back(), fragment);
+         fragment.original.size *= 2;
+         fragment.offset = fragment.original.size - range::size( fragment.payload);
+
+         EXPECT_CODE({
+            reassembly.add( stripe, strong::file::descriptor::id{ 42}, serialize::native::complete< Connection::complete_type>( fragment));
+         }, code::casual::communication_protocol);
+      }
+
+      TEST( gateway_group_tcp, stripe_fragment__original_size_over_limit__expect_protocol_error)
+      {
+         common::unittest::Trace trace;
+
+         auto complete = serialize::native::complete< Connection::complete_type>( local::call( 200 * 1024));
+         auto fragments = stripe::fragment::split( complete, 64 * 1024);
+
+         message::domain::stripe::Fragment fragment;
+         serialize::native::complete( fragments.front(), fragment);
+         fragment.original.size = platform::tcp::message::max::payload + 1;
+
+         stripe::Reassembly reassembly;
+
+         EXPECT_CODE({
+            reassembly.add( uuid::make(), strong::file::descriptor::id{ 42}, serialize::native::complete< Connection::complete_type>( fragment));
+         }, code::casual::communication_protocol);
+
+         EXPECT_TRUE( reassembly.empty());
+      }
+
+      TEST( gateway_group_tcp, stripe_fragment__not_eligible__expect_not_fragmented)
+      {
+         common::unittest::Trace trace;
+
+         // 'ordered' messages are never fragmented
+         common::message::service::Advertise message;
+         EXPECT_TRUE( ! stripe::fragment::eligible( serialize::native::complete< Connection::complete_type>( message)));
+
+         EXPECT_TRUE( stripe::fragment::eligible( serialize::native::complete< Connection::complete_type>( local::call( 10))));
+      }
+
+      TEST( gateway_group_tcp, stripes_4__large_and_small_calls__expect_all_received)
+      {
+         common::unittest::Trace trace;
+
+         local::Striped striped{ 4};
+
+         auto large = local::call( 1024 * 1024);
+         auto small = local::call( 10);
+
+         striped.send( large);
+         striped.send( small);
+
+         auto received = striped.receive( 2);
+         ASSERT_TRUE( received.size() == 2);
+
+         // the small one is not stuck behind the large
+         EXPECT_TRUE( received.at( 0).correlation() == small.correlation);
+
+         decltype( large) result;
+         serialize::native::complete( received.at( 1), result);
+         EXPECT_TRUE( result.correlation == large.correlation);
+         EXPECT_TRUE( result.buffer.memory == large.buffer.memory);
+      }
+
+      TEST( gateway_group_tcp, unsent__peer_closed__expect_connection_lost)
+      {
+         common::unittest::Trace trace;
+
+         // limited socket buffers, so the large call is left (partly) unsent
+         local::Striped striped{ 1, std::chrono::milliseconds{ 1}};
+         auto descriptor = range::front( striped.outbound.connections()).descriptor();
+
+         // random payload, that does not compress
+         auto call = local::call( 10);
+         call.buffer.memory = unittest::random::binary( 1024 * 1024);
+
+         striped.send( call);
+         ASSERT_TRUE( range::front( striped.outbound.connections()).queued() > 0);
+
+         // the peer closes with unread data, which resets the connection
+         striped.inbound.clear( striped.directive);
+
+         std::vector< strong::file::descriptor::id> lost;
+
+         for( auto count = 0; lost.empty() && count < 100; ++count)
+         {
+            lost = striped.outbound.unsent( striped.directive, descriptor);
+            std::this_thread::sleep_for( std::chrono::milliseconds{ 1});
+         }
+
+         ASSERT_TRUE( lost.size() == 1);
+         EXPECT_TRUE( lost.at( 0) == descriptor);
+      }
+
+      TEST( gateway_group_tcp, stripes__loopback_benchmark)
+      {
+         common::unittest::Trace trace;
+
+         constexpr auto count = 10;
+         constexpr platform::size::type size = 1024 * 1024;
+         constexpr auto delay = std::chrono::milliseconds{ 1};
+
+         // does not compress, so we measure the 'wire'
+         auto large = local::call( 0);
+         large.buffer.memory = unittest::random::binary( size);
+         auto small = local::call( 10);
+
+         auto measure = [&]( platform::size::type stripes)
+         {
+            local::Striped striped{ stripes, delay};
+
+            auto microseconds = []( auto duration){ return std::chrono::duration_cast< std::chrono::microseconds>( duration).count();};
+
+            // throughput
+            auto start = platform::time::clock::type::now();
+
+            algorithm::for_n( count, [&]()
+            { 
+               // every call has its own correlation
+               large.correlation = strong::correlation::id::emplace( uuid::make());
+               striped.send( large);
+            });
+            EXPECT_TRUE( range::size( striped.receive( count)) == count);
+
+            auto throughput = platform::time::clock::type::now() - start;
+
+            // latency for a small call sent directly after a large one
+            large.correlation = strong::correlation::id::emplace( uuid::make());
+            striped.send( large);
+
+            start = platform::time::clock::type::now();
+            striped.send( small);
+
+            auto latency = platform::time::unit{};
+            auto received = 0;
+
+            while( received < 2)
+               for( auto& complete : striped.receive( 1))
+               {
+                  ++received;
+                  if( complete.correlation() == small.correlation)
+                     latency = platform::time::clock::type::now() - start;
+               }
+
+            log::line( unittest::log, "stripes: ", stripes,
+               ", messages: ", count,
+               ", payload: ", size,
+               ", delay: ", microseconds( delay), "us",
+               ", time: ", microseconds( throughput), "us",
+               ", MB/s: ", ( count * size) / std::max( microseconds( throughput), decltype( microseconds( throughput)){ 1}),
+               ", small call latency: ", microseconds( latency), "us");
+         };
+
+         measure( 1);
+         measure( 4);
+      }
+
+      TEST( gateway_group_tcp, flow__version_1_4__no_credit__expect_throttled_until_granted)
+      {
+         common::unittest::Trace trace;
+
+         local::Striped striped{ 1, {}, local::Version::version_1_4};
+         auto& outbound = range::front( striped.outbound.connections());
+         auto& inbound = range::front( striped.inbound.connections());
+
+         auto calls = algorithm::generate_n< 3>( [](){ return local::call( 10);});
+
+         for( auto& call : calls)
+            striped.send( call);
+
+         // nothing is sent, since the outbound has no credit
+         EXPECT_TRUE( striped.outbound.information( outbound.descriptor())->throttle.active());
+         EXPECT_TRUE( ! striped.inbound.next( inbound));
+
+         auto grant = [&]( platform::size::type messages)
+         {
+            striped.inbound.grant( striped.directive, inbound.descriptor(), messages);
+
+            auto credit = striped.outbound.next( outbound);
+            while( ! credit)
+               credit = striped.outbound.next( outbound);
+
+            EXPECT_TRUE( credit.type() == gateway::message::domain::flow::Credit::type());
+            gateway::message::domain::flow::Credit message;
+            serialize::native::complete( credit, message);
+
+            striped.outbound.credit( striped.directive, outbound.descriptor(), message.messages);
+         };
+
+         grant( 2);
+
+         // the two first, in order
+         {
+            auto received = striped.receive( 2);
+            ASSERT_TRUE( received.size() == 2);
+            EXPECT_TRUE( received.at( 0).correlation() == calls.at( 0).correlation);
+            EXPECT_TRUE( received.at( 1).correlation() == calls.at( 1).correlation);
+         }
+
+         // the outbound has used the credit, and waits for more
+         EXPECT_TRUE( striped.outbound.information( outbound.descriptor())->credit == 0);
+         EXPECT_TRUE( striped.outbound.information( outbound.descriptor())->throttle.active());
+         EXPECT_TRUE( striped.inbound.information( inbound.descriptor())->credit == 0);
+
+         grant( 1);
+
+         {
+            auto received = striped.receive( 1);
+            ASSERT_TRUE( received.size() == 1);
+            EXPECT_TRUE( received.at( 0).correlation() == calls.at( 2).correlation);
+         }
+
+         EXPECT_TRUE( ! striped.outbound.information( outbound.descriptor())->throttle.active());
+         EXPECT_TRUE( striped.outbound.information( outbound.descriptor())->throttle.total() > platform::time::unit::zero());
+      }
+
+      TEST( gateway_group_tcp, flow__version_1_4__2_stripes__credit_granted_on_one__sent_on_other__expect_pooled_no_overrun)
+      {
+         common::unittest::Trace trace;
+
+         local::Striped striped{ 2, {}, local::Version::version_1_4};
+
+         auto outbound = striped.outbound.descriptors();
+         auto inbound = striped.inbound.descriptors();
+         ASSERT_TRUE( outbound.size() == 2 && inbound.size() == 2);
+
+         // the inbound learns the stripe set
+         while( ! algorithm::all_of( striped.inbound.information(), []( auto& information){ return information.stripe;}))
+            for( auto& connection : striped.inbound.connections())
+               EXPECT_TRUE( ! striped.inbound.next( connection));
+
+         // the inbound grants credit on the second stripe only
+         {
+            striped.inbound.grant( striped.directive, inbound.at( 1), 2);
+
+            auto connection = striped.outbound.connection( outbound.at( 1));
+            auto credit = striped.outbound.next( *connection);
+            while( ! credit)
+               credit = striped.outbound.next( *connection);
+
+            gateway::message::domain::flow::Credit message;
+            serialize::native::complete( credit, message);
+            striped.outbound.credit( striped.directive, outbound.at( 1), message.messages);
+         }
+
+         // ... and the requests are sent on the first
+         auto calls = algorithm::generate_n< 2>( [](){ return local::call( 10);});
+         for( auto& call : calls)
+            striped.send( call);
+
+         EXPECT_TRUE( range::size( striped.receive( 2)) == 2);
+
+         auto credit = []( auto& external)
+         {
+            return algorithm::accumulate( external.information(), platform::size::type{}, []( auto count, auto& information){ return count + information.credit;});
+         };
+
+         auto overrun = []( auto& external)
+         {
+            return algorithm::accumulate( external.information(), platform::size::type{}, []( auto count, auto& information){ return count + information.overrun;});
+         };
+
+         // both sides agree on the credit left for the set, and the inbound has not seen any request without credit
+         EXPECT_TRUE( credit( striped.outbound) == 0);
+         EXPECT_TRUE( credit( striped.inbound) == 0) << CASUAL_NAMED_VALUE( striped.inbound.information());
+         EXPECT_TRUE( overrun( striped.inbound) == 0) << CASUAL_NAMED_VALUE( striped.inbound.information());
+
+         // a third request waits for credit
+         striped.send( local::call( 10));
+         EXPECT_TRUE( striped.outbound.information( outbound.at( 0))->throttle.active());
+      }
+
+   } // gateway::group::tcp
+} // casual
@@ -82,6 +82,30 @@ namespace casual
          local::compare( local::fill< gateway::message::domain::disconnect::Reply>(), expected);
       }
 
+      TEST( gateway_protocol_v1_2, compressed)
+      {
+         constexpr auto expected = R"(cHPL9BRESkGHswCG8UP8YAAAAAAAAAwcAAAAAAAAAIAAAAAAAAAAIICBgoOEhYaHiImKi4yNjo+QkZKTlJWWl5iZmpucnZ6f)";
+         local::compare( local::fill< gateway::message::domain::Compressed>(), expected);
+      }
+
+      TEST( gateway_protocol_v1_3, stripe_join)
+      {
+         constexpr auto expected = R"(cHPL9BRESkGHswCG8UP8YG7kq4qOR0+woVwrKipvuKI=)";
+         local::compare( local::fill< gateway::message::domain::stripe::Join>(), expected);
+      }
+
+      TEST( gateway_protocol_v1_3, stripe_fragment)
+      {
+         constexpr auto expected = R"(cHPL9BRESkGHswCG8UP8YAAAAAAAAAwcAAAAAAAAAIAAAAAAAAAAQAAAAAAAAAAggIGCg4SFhoeIiYqLjI2Oj5CRkpOUlZaXmJmam5ydnp8=)";
+         local::compare( local::fill< gateway::message::domain::stripe::Fragment>(), expected);
+      }
+
+      TEST( gateway_protocol_v1_4, flow_credit)
+      {
+         constexpr auto expected = R"(cHPL9BRESkGHswCG8UP8YAAAAAAAAAIA)";
+         local::compare( local::fill< gateway::message::domain::flow::Credit>(), expected);
+      }
+
       TEST( gateway_protocol_v1, discover_request)
       {
          constexpr auto expected = R"(cHPL9BRESkGHswCG8UP8YDFdrMYYLkwSv5h376kky4YAAAAAAAAACGRvbWFpbiBBAAAAAAAAAAMAAAAAAAAACHNlcnZpY2UxAAAAAAAAAAhzZXJ2aWNlMgAAAAAAAAAIc2VydmljZTMAAAAAAAAAAwAAAAAAAAAGcXVldWUxAAAAAAAAAAZxdWV1ZTIAAAAAAAAABnF1ZXVlMw==)";
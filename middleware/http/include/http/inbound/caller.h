@@ -31,6 +31,8 @@ extern "C"
       long size;
    } http_buffer_type;
 
+   //! The buffers are views, owned by the caller when passed to casual_xatmi_call, and owned
+   //! by the call when returned from casual_xatmi_receive (valid until casual_xatmi_cancel).
    typedef struct casual_http_buffer_s
    {
       //! header information
@@ -49,20 +51,33 @@ extern "C"
       char protocol[80];
 
       long descriptor;
-      long lookup_key;
       long code;
    } casual_http_buffer_type;
 
-   //! Communicate with service manager
-   long casual_xatmi_lookup( casual_http_buffer_type* data);
-
-   //! Make the call
-   long casual_xatmi_send( casual_http_buffer_type* data);
-
-   //! Get the response
+   //! Start the call, without blocking. The request is sent as soon as the service-manager
+   //! has reserved an instance, which is progressed by casual_xatmi_poll. 
+   //! Sets `data->descriptor` to the call, that is used for casual_xatmi_receive and casual_xatmi_cancel.
+   //! The request body is copied (once) into the xatmi buffer, hence the caller owns `data` only
+   //! during the invocation. The parameters are only used, to create the body, if there is no body.
+   //!
+   //! Only absent services are cached: if the service-manager replies that the service is absent,
+   //! calls to the service fail directly, for at most a second or until new resources are discovered.
+   //! Every other call does its own (non blocking) lookup.
+   long casual_xatmi_call( casual_http_buffer_type* data);
+
+   //! Progress all outstanding calls, without blocking. 
+   //! Stores (at most) `size` descriptors of calls that has completed since last poll in `completed`
+   //! @returns the number of stored descriptors
+   long casual_xatmi_poll( long* completed, long size);
+
+   //! @returns the file descriptor that is readable when there are messages for the outstanding calls, 
+   //!   to be polled with the event loop of the caller. 
+   long casual_xatmi_handle( void);
+
+   //! Get the response, AGAIN if the call has not completed yet
    long casual_xatmi_receive( casual_http_buffer_type* data);
 
-   //! Abort the call
+   //! Abort the call, if outstanding, and release the call
    long casual_xatmi_cancel( casual_http_buffer_type* data);
 
    enum
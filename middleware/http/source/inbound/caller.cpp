@@ -7,11 +7,14 @@
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <optional>
 
 #include "http/common.h"
 #include "http/inbound/caller.h"
 #include "casual/buffer/field.h"
 #include "common/service/call/context.h"
+#include "common/service/lookup.h"
+#include "common/event/listen.h"
 #include "common/transcode.h"
 #include "common/string.h"
 
@@ -31,51 +34,6 @@ namespace casual
          {
             namespace
             { 
-               namespace lookup
-               {
-                  using LookupStore = std::unordered_map< long, common::service::non::blocking::Lookup>;
-
-                  // global store for Lookup-objects
-                  LookupStore store;
-
-                  namespace key
-                  {
-                     // Must be able to tell if key is set or not
-                     // No practical risc to overflow
-                     long next{ 1};
-                  }
-
-                  long add( const std::string& service)
-                  {
-                     store.emplace( key::next, common::service::non::blocking::Lookup{ service});
-                     return key::next++;
-                  }
-
-                  LookupStore::iterator find( long key)
-                  {
-                     auto found = store.find( key);
-                     
-                     if( found != store.end())
-                        return found;
-
-                     common::code::raise::error( common::code::casual::invalid_argument, "could not find lookup object for key: ", key);
-                  }
-
-                  common::service::non::blocking::Lookup consume( long key)
-                  {
-                     auto found = find( key);
-                     auto result = std::move( found->second);
-                     store.erase( found);
-                     return result;
-                  }
-
-                  common::service::non::blocking::Lookup& get( long key) 
-                  {
-                     return find( key)->second;
-                  }
-
-                  void remove( long key) { store.erase( key); }
-               }
                namespace header
                {
                   common::service::header::Fields copy( const http_header_type& headers)
@@ -84,30 +42,32 @@ namespace casual
 
                      common::service::header::Fields result;
 
+                     if( ! headers.data)
+                        return result;
+
                      for( auto& header : common::range::make( headers.data, headers.size))
                         result.emplace_back( header.key, header.value);
 
                      return result;
                   }
-                  http_header_type copy( const common::service::header::Fields& headers)
+                  std::vector< header_data_type> transform( const common::service::header::Fields& headers)
                   {
-                     const http::Trace trace("casual::http::inbound::local::header::copy");
+                     const http::Trace trace("casual::http::inbound::local::header::transform");
 
-                     http_header_type result;
-
-                     result.size = headers.size();
-                     result.data = reinterpret_cast< header_data_type*>( malloc( result.size * sizeof( header_data_type)));
+                     std::vector< header_data_type> result( headers.size());
 
                      auto index = 0;
                      for( const auto& header : headers)
                      {
                         // key
-                        std::copy( header.key.begin(), header.key.end(), result.data[ index].key);
-                        result.data[ index].key[ std::min( header.key.size(), sizeof( result.data[index].key) - 1)] = '\0';
+                        auto key = std::min( header.key.size(), sizeof( result[ index].key) - 1);
+                        std::copy( header.key.begin(), header.key.begin() + key, result[ index].key);
+                        result[ index].key[ key] = '\0';
 
                         // value
-                        std::copy( header.value.begin(), header.value.end(), result.data[ index].value);
-                        result.data[ index].value[ std::min( header.value.size(), sizeof( result.data[index].value) - 1)] = '\0';
+                        auto value = std::min( header.value.size(), sizeof( result[ index].value) - 1);
+                        std::copy( header.value.begin(), header.value.begin() + value, result[ index].value);
+                        result[ index].value[ value] = '\0';
 
                         index++;
                      }
@@ -140,7 +100,11 @@ namespace casual
                   container copy( const http_buffer_type& buffer)
                   {
                      container result;
-                     const auto parameters = common::string::split( buffer.data, '&');
+
+                     if( ! buffer.data || buffer.size < 1)
+                        return result;
+
+                     const auto parameters = common::string::split( std::string( buffer.data, buffer.size), '&');
                      for (const auto& parameter : parameters)
                      {
                         const auto parts = common::string::split( parameter, '=');
@@ -205,134 +169,350 @@ namespace casual
 
                namespace buffer
                {
-                  template< typename Type>
-                  http_buffer_type copy( const Type& input)
+                  //! copies the body (as is) to the memory of the xatmi buffer, or creates the body from the
+                  //! parameters if there is no body. The body is copied once, since the call outlives
+                  //! this invocation (until the service-manager has reserved an instance) and the memory 
+                  //! might be decoded in place.
+                  platform::binary::type assemble( casual_http_buffer_type* transport, const std::string& protocol)
                   {
-                     http_buffer_type output;
-                     output.data = reinterpret_cast<char*>( malloc( input.size()));
-                     output.size = input.size();
-                     common::algorithm::copy( input, output.data);
-                     return output;
-                  }
+                     if( transport->payload.data && transport->payload.size > 0)
+                        return platform::binary::type( transport->payload.data, transport->payload.data + transport->payload.size);
+
+                     // the parameters are only used if there is no body
+                     if( protocol == http::protocol::json || protocol == http::protocol::xml)
+                     {
+                        const auto parameters = parameter::copy( transport->parameter);
+                        common::log::line( common::verbose::log, "parameters: ", parameters);
+
+                        if( protocol == http::protocol::json)
+                           return parameter::make_json( parameters);
 
-                  platform::binary::type assemble( casual_http_buffer_type* transport, const parameter::container& parameters, const std::string& protocol)
-                  {
-                     if ( protocol == http::protocol::json && transport->payload.size < 1)
-                        return parameter::make_json( parameters);
-                     else if ( protocol == http::protocol::xml && transport->payload.size < 1)
                         return parameter::make_xml( parameters);
-                        
-                     return platform::binary::type( transport->payload.data, transport->payload.data + transport->payload.size);
+                     }
+
+                     return {};
                   }
                } // buffer
 
-               namespace exception
+               namespace call
                {
-                  long handle( casual_http_buffer_type* transport)
+                  using descriptor_type = common::service::call::descriptor_type;
+
+                  enum class Stage : short
                   {
-                     auto usercode{ 0};
-                     try
+                     lookup,
+                     pending,
+                     done,
+                  };
+
+                  struct Call
+                  {
+                     Stage stage = Stage::lookup;
+                     std::string service;
+                     common::service::non::blocking::Lookup lookup;
+                     common::service::header::Fields header;
+
+                     //! the request until it's sent, then the reply
+                     common::buffer::Payload payload;
+                     descriptor_type descriptor{};
+
+                     struct
                      {
-                        throw;
-                     }
-                     catch( common::service::call::Fail& exception)
+                        long result = AGAIN;
+                        long context = cTPACALL;
+                        long code{};
+                        bool null = false;
+                        std::vector< header_data_type> header;
+                     } outcome;
+                  };
+
+                  struct State
+                  {
+                     std::unordered_map< long, Call> calls;
+
+                     //! calls that waits for the service-manager to reserve an instance
+                     std::vector< long> lookups;
+
+                     //! xatmi descriptor -> call, for the pending calls
+                     std::unordered_map< descriptor_type, long> pending;
+
+                     //! the descriptors of the pending calls, that is gathered
+                     std::vector< descriptor_type> descriptors;
+
+                     //! calls that has completed since last poll
+                     std::vector< long> completed;
+
+                     // Must be able to tell if key is set or not
+                     // No practical risc to overflow
+                     long next{ 1};
+                  };
+
+                  // global state for the calls of this process (nginx worker)
+                  State state;
+               } // call
+
+               namespace absent
+               {
+                  //! how long we trust that a service is absent, if we don't get an event about new
+                  //! discoverable resources before. Services advertised within the domain is not evented.
+                  constexpr auto expiry = std::chrono::seconds{ 1};
+
+                  //! services that the service-manager has replied absent, with expiry, so we don't 
+                  //! do lookups (and discovery) for each http request to an unknown service.
+                  std::unordered_map< std::string, platform::time::point::type> cache;
+
+                  //! the subscription to discoverable events, that invalidates the cache
+                  std::optional< common::event::handler_type> events;
+
+                  bool cached( const std::string& service)
+                  {
+                     auto found = cache.find( service);
+
+                     if( found == std::end( cache))
+                        return false;
+
+                     if( found->second > platform::time::clock::type::now())
+                        return true;
+
+                     cache.erase( found);
+                     return false;
+                  }
+
+                  void add( const std::string& service)
+                  {
+                     const http::Trace trace("casual::http::inbound::local::absent::add");
+                     common::log::line( common::verbose::log, "service: ", service);
+
+                     if( ! events)
                      {
-                        transport->code = common::cast::underlying( common::code::xatmi::service_fail);
-                        http::buffer::transcode::to::wire( exception.result.buffer);
-                        transport->payload = buffer::copy( exception.result.buffer.memory);
-                        usercode = exception.result.user;
+                        events = common::event::listener( []( const common::message::event::discoverable::Avaliable& event)
+                        {
+                           common::log::line( common::verbose::log, "event: ", event, " - invalidate absent services: ", cache.size());
+                           cache.clear();
+                        });
                      }
-                     catch( ...)
+
+                     cache[ service] = platform::time::clock::type::now() + expiry;
+                  }
+
+                  //! consumes the discoverable events, if any
+                  void consume()
+                  {
+                     if( ! events)
+                        return;
+
+                     auto& device = common::communication::ipc::inbound::device();
+                     auto types = events->types();
+
+                     while( ( *events)( device.next( types, common::communication::device::policy::non::blocking( device))))
+                        ;
+                  }
+               } // absent
+
+               namespace call
+               {
+                  namespace pending
+                  {
+                     void add( descriptor_type descriptor, long key)
                      {
-                        auto error = common::exception::capture();
+                        state.pending.emplace( descriptor, key);
+                        state.descriptors.push_back( descriptor);
+                     }
 
-                        if( error.code() == common::code::xatmi::no_message)
-                           return AGAIN; // No reply yet, try again later
+                     //! @returns the key of the pending call
+                     long remove( descriptor_type descriptor)
+                     {
+                        auto key = state.pending.at( descriptor);
+                        state.pending.erase( descriptor);
 
-                        if( common::code::is::category< common::code::xatmi>( error.code()))
-                           transport->code = error.code().value();
-                        else 
-                           transport->code = common::cast::underlying( common::code::xatmi::os);
+                        // order is not relevant, we swap with the last
+                        if( auto found = common::algorithm::find( state.descriptors, descriptor))
+                        {
+                           std::iter_swap( std::begin( found), std::prev( std::end( state.descriptors)));
+                           state.descriptors.pop_back();
+                        }
 
-                        transport->payload = buffer::copy( common::string::compose( error));
+                        return key;
                      }
+                  } // pending
 
-                     // Handle reply headers
-                     auto header = header::codes::add( transport->code, usercode);
-                     transport->header_out = header::copy( header);
+                  void complete( long key, Call& call, long result, long context, long code, long user)
+                  {
+                     call.stage = Stage::done;
+                     call.outcome.result = result;
+                     call.outcome.context = context;
+                     call.outcome.code = code;
+                     call.outcome.header = header::transform( header::codes::add( code, user));
 
-                     return ERROR;
+                     state.completed.push_back( key);
                   }
-               }
-
-               namespace service
-               {
 
-                  // Contacts service-manager and gets a lookup object.
-                  // When lookup object returns true, the service-manager is
-                  // ready to handle the actual call
-                  long lookup( casual_http_buffer_type* transport)
+                  //! completes the call with the ongoing exception
+                  void failed( long key, Call& call, long context)
                   {
-                     const http::Trace trace("casual::http::inbound::local::service::lookup");
-                     const auto& service = transport->service;
+                     auto error = common::exception::capture();
+                     common::log::line( common::verbose::log, "key: ", key, " - error: ", error);
 
-                     common::log::line( common::verbose::log, "service: ", service);
+                     auto code = common::code::is::category< common::code::xatmi>( error.code()) ? 
+                        error.code().value() : common::cast::underlying( common::code::xatmi::os);
 
+                     if( error.code() == common::code::xatmi::no_entry)
+                     {
+                        try
+                        {
+                           absent::add( call.service);
+                        }
+                        catch( ...)
+                        {
+                           common::log::line( common::log::category::error, common::exception::capture(), " - failed to cache absent service: ", call.service);
+                        }
+                     }
+
+                     call.payload.memory.clear();
+                     common::algorithm::append( common::string::compose( error), call.payload.memory);
+
+                     complete( key, call, ERROR, context, code, 0);
+                  }
+
+                  //! sends the request, if the service-manager has reserved an instance
+                  void advance( long key, Call& call)
+                  {
                      try
-                     { 
-                        if( transport->lookup_key == 0) 
-                           transport->lookup_key = lookup::add( service);
+                     {
+                        if( ! call.lookup)
+                           return;
 
-                        const auto key = transport->lookup_key;
-                        common::log::line( common::verbose::log, "key: ", key);
+                        call.descriptor = common::service::call::context().async( 
+                           std::move( call.lookup), 
+                           common::buffer::payload::Send( call.payload),
+                           std::move( call.header),
+                           common::service::call::async::Flag::no_block);
 
-                        return lookup::get( key) ? OK : AGAIN;
+                        common::log::line( common::verbose::log, "key: ", key, " - descriptor: ", call.descriptor);
+
+                        call.stage = Stage::pending;
+                        pending::add( call.descriptor, key);
+
+                        // the request is sent, we keep the memory to the reply
+                        call.payload.memory.clear();
                      }
                      catch( ...)
                      {
-                        lookup::remove( transport->lookup_key);
-                        return exception::handle( transport);
+                        failed( key, call, cTPACALL);
+                     }
+                  }
+
+                  void reply( Call& call, common::service::call::gather::Result&& result)
+                  {
+                     auto key = pending::remove( result.descriptor);
+
+                     call.payload = std::move( result.buffer);
+
+                     if( result.code)
+                     {
+                        if( result.code == common::code::xatmi::service_fail)
+                           http::buffer::transcode::to::wire( call.payload);
+                        else
+                        {
+                           call.payload.memory.clear();
+                           common::algorithm::append( result.code.message(), call.payload.memory);
+                        }
+
+                        complete( key, call, ERROR, cTPGETRPLY, result.code.value(), result.user);
+                        return;
+                     }
+
+                     if( call.payload.null())
+                     {
+                        call.outcome.null = true;
+                        call.payload.memory.clear();
+                        common::algorithm::append( std::string_view{ "NULL"}, call.payload.memory);
+                     }
+                     else 
+                     {
+                        // possible transcode buffer to wire-encoding
+                        http::buffer::transcode::to::wire( call.payload);
                      }
+
+                     complete( key, call, OK, cTPGETRPLY, common::cast::underlying( common::code::xatmi::ok), result.user);
                   }
 
-                  long send( casual_http_buffer_type* transport)
+                  //! collects the replies that has arrived, without blocking.
+                  void gather()
                   {
-                     const http::Trace trace("casual::http::inbound::local::service::send");
+                     while( ! state.descriptors.empty())
+                     {
+                        try
+                        {
+                           auto result = common::service::call::context().gather( state.descriptors, common::service::call::reply::Flag::no_block);
+                           auto& call = state.calls.at( state.pending.at( result.descriptor));
+                           reply( call, std::move( result));
+                        }
+                        catch( ...)
+                        {
+                           auto error = common::exception::capture();
+                           if( error.code() != common::code::xatmi::no_message)
+                              common::log::line( common::log::category::error, error, " - failed to gather replies");
+                           return;
+                        }
+                     }
+                  }
+
+               } // call
+
+               namespace service
+               {
+                  long call( casual_http_buffer_type* transport)
+                  {
+                     const http::Trace trace("casual::http::inbound::local::service::call");
                      const auto& protocol = transport->protocol;
-                     const auto& service = transport->service;
 
                      common::log::line( common::verbose::log, "protocol: ", protocol);
-                     common::log::line( common::verbose::log, "service: ", service);
+                     common::log::line( common::verbose::log, "service: ", transport->service);
 
                      transport->context = cTPACALL;
 
                      try
                      {
-                        // Lookup done, ready to call
-                        common::log::line( common::verbose::log, "key: ", transport->lookup_key);
+                        const auto key = call::state.next++;
+                        auto& call = call::state.calls[ key];
+                        transport->descriptor = key;
 
-                        // Handle header
-                        const auto& header = header::copy( transport->header_in);
+                        common::log::line( common::verbose::log, "key: ", key);
 
-                        // Handle parameter
-                        const auto& parameters = parameter::copy( transport->parameter);
-                        common::log::line( common::verbose::log, "parameters: ", parameters);
+                        try
+                        {
+                           call.service = transport->service;
+
+                           if( absent::cached( call.service))
+                              common::code::raise::error( common::code::xatmi::no_entry, "service: ", call.service, " is absent");
+
+                           // Handle header
+                           call.header = header::copy( transport->header_in);
+
+                           // possible transcode buffer from wire-encoding
+                           call.payload = common::buffer::Payload( protocol::convert::to::buffer( protocol), buffer::assemble( transport, protocol));
+                           http::buffer::transcode::from::wire( call.payload);
+
+                           // Contacts service-manager, the call is sent when the service-manager
+                           // has reserved an instance
+                           call.lookup = common::service::non::blocking::Lookup{ call.service};
+
+                           call::advance( key, call);
 
-                        // possible transcode buffer from wire-encoding
-                        common::buffer::Payload payload( protocol::convert::to::buffer( protocol), buffer::assemble( transport, parameters, protocol));
-                        http::buffer::transcode::from::wire( payload);
-
-                        // Call service
-                        namespace call = common::service::call;
-                        transport->descriptor = call::context().async( 
-                           lookup::consume( transport->lookup_key), 
-                           common::buffer::payload::Send( payload),
-                           header,
-                           call::async::Flag::no_block);
+                           if( call.stage == call::Stage::lookup)
+                              call::state.lookups.push_back( key);
+                        }
+                        catch( ...)
+                        {
+                           call::failed( key, call, cTPACALL);
+                        }
                      }
                      catch( ...)
                      {
-                        return exception::handle( transport);
+                        common::log::line( common::log::category::error, common::exception::capture());
+                        transport->code = common::cast::underlying( common::code::xatmi::system);
+                        return ERROR;
                      }
 
                      transport->code = common::cast::underlying( common::code::xatmi::ok);
@@ -340,78 +520,139 @@ namespace casual
                      return OK;
                   }
 
+                  long poll( long* completed, long size)
+                  {
+                     const http::Trace trace("casual::http::inbound::local::service::poll");
+
+                     try
+                     {
+                        // we drain the ipc-device, since the event-loop of the caller 
+                        // might only notify when new messages arrive
+                        common::communication::ipc::inbound::device().flush();
+
+                        absent::consume();
+
+                        // only the calls that waits for the service-manager, cancelled calls are dropped
+                        auto& lookups = call::state.lookups;
+                        common::algorithm::container::trim( lookups, common::algorithm::remove_if( lookups, []( auto key)
+                        {
+                           auto found = call::state.calls.find( key);
+
+                           if( found == std::end( call::state.calls))
+                              return true;
+
+                           call::advance( key, found->second);
+                           return found->second.stage != call::Stage::lookup;
+                        }));
+
+                        call::gather();
+                     }
+                     catch( ...)
+                     {
+                        common::log::line( common::log::category::error, common::exception::capture(), " - failed to poll calls");
+                     }
+
+                     // we ignore calls that has been cancelled
+                     auto& keys = call::state.completed;
+                     common::algorithm::container::trim( keys, common::algorithm::remove_if( keys, []( auto key)
+                     {
+                        return call::state.calls.count( key) == 0;
+                     }));
+
+                     auto count = std::min( static_cast< long>( keys.size()), size);
+                     std::copy( std::begin( keys), std::begin( keys) + count, completed);
+                     keys.erase( std::begin( keys), std::begin( keys) + count);
+
+                     common::log::line( common::verbose::log, "completed: ", count, ", outstanding: ", call::state.calls.size());
+
+                     return count;
+                  }
+
+                  long handle()
+                  {
+                     try
+                     {
+                        return common::communication::ipc::inbound::device().connector().descriptor().value();
+                     }
+                     catch( ...)
+                     {
+                        common::log::line( common::log::category::error, common::exception::capture());
+                        return -1;
+                     }
+                  }
+
                   long receive( casual_http_buffer_type* const transport)
                   {
                      const http::Trace trace("casual::http::inbound::service::local::receive");
-                     const auto& protocol = transport->protocol;
                      const auto& descriptor = transport->descriptor;
-                     const auto& service = transport->service;
 
-                     common::log::line( common::verbose::log, "protocol: ", protocol);
-                     common::log::line( common::verbose::log, "service: ", service);
+                     common::log::line( common::verbose::log, "service: ", transport->service);
                      common::log::line( common::verbose::log, "descriptor: ", descriptor);
 
                      transport->context = cTPGETRPLY;
 
-                     try
-                     {
-                        const http::Trace trace("casual::http::inbound::local::service::receive reply");
+                     auto found = call::state.calls.find( descriptor);
 
-                        // Handle reply
-                        namespace call = common::service::call;
-                        auto reply = call::context().reply( descriptor, call::reply::Flag::no_block);
-
-                        if( reply.buffer.null())
-                        {
-                           ::strncpy( transport->protocol, http::protocol::null, sizeof( transport->protocol));
-                           common::algorithm::copy( "NULL", reply.buffer.memory);
-                           common::log::line( common::verbose::log, "protocol: ", transport->protocol);
-                        }
-                        else 
-                        {
-                            // possible transcode buffer to wire-encoding
-                           http::buffer::transcode::to::wire( reply.buffer);
-                        }
-                           
-                        transport->payload = buffer::copy( reply.buffer.memory);
+                     if( found == std::end( call::state.calls))
+                     {
+                        transport->code = common::cast::underlying( common::code::xatmi::descriptor);
+                        transport->payload = http_buffer_type{};
+                        transport->header_out = http_header_type{};
+                        return ERROR;
+                     }
 
-                        // Handle reply headers
-                        auto header = header::codes::add( common::cast::underlying( common::code::xatmi::ok), reply.user);
-                        transport->header_out = header::copy( header);
+                     auto& call = found->second;
 
+                     if( call.stage != call::Stage::done)
+                        return AGAIN; // No reply yet, try again later
 
-                        return OK;
-                     }
-                     catch( ...)
+                     if( call.outcome.null)
                      {
-                        return exception::handle( transport);
+                        ::strncpy( transport->protocol, http::protocol::null, sizeof( transport->protocol));
+                        common::log::line( common::verbose::log, "protocol: ", transport->protocol);
                      }
+
+                     // the memory is owned by the call, until it's cancelled
+                     transport->context = call.outcome.context;
+                     transport->code = call.outcome.code;
+                     transport->payload = http_buffer_type{ call.payload.memory.data(), static_cast< long>( call.payload.memory.size())};
+                     transport->header_out = http_header_type{ call.outcome.header.data(), static_cast< long>( call.outcome.header.size())};
+
+                     return call.outcome.result;
                   }
 
                   long cancel( casual_http_buffer_type* transport)
                   {
                      const http::Trace trace("casual::http::inbound::local::service::cancel");
-                     const auto& protocol = transport->protocol;
                      const auto& descriptor = transport->descriptor;
-                     const auto& service = transport->service;
 
-                     common::log::line( common::verbose::log, "protocol: ", protocol);
-                     common::log::line( common::verbose::log, "service: ", service);
+                     common::log::line( common::verbose::log, "service: ", transport->service);
                      common::log::line( common::verbose::log, "descriptor: ", descriptor);
 
-                     transport->context = cTPGETRPLY;
+                     auto found = call::state.calls.find( descriptor);
+
+                     if( found == std::end( call::state.calls))
+                        return OK;
 
                      try
                      {
-                        // Handle reply
-                        namespace call = common::service::call;
-                        call::context().cancel( descriptor);
+                        auto& call = found->second;
+
+                        if( call.stage == call::Stage::pending)
+                        {
+                           call::pending::remove( call.descriptor);
+                           common::service::call::context().cancel( call.descriptor);
+                        }
 
+                        // a pending lookup is discarded when the call is erased
+                        call::state.calls.erase( found);
                         return OK;
                      }
                      catch( ...)
                      {
-                        return exception::handle( transport);
+                        common::log::line( common::log::category::error, common::exception::capture());
+                        call::state.calls.erase( found);
+                        return ERROR;
                      }
                   }
                } // service
@@ -421,14 +662,19 @@ namespace casual
    } // http
 } // casual
 
-long casual_xatmi_lookup( casual_http_buffer_type* data)
+long casual_xatmi_call( casual_http_buffer_type* data)
+{
+   return casual::http::inbound::local::service::call( data);
+}
+
+long casual_xatmi_poll( long* completed, long size)
 {
-   return casual::http::inbound::local::service::lookup( data);
+   return casual::http::inbound::local::service::poll( completed, size);
 }
 
-long casual_xatmi_send( casual_http_buffer_type* data)
+long casual_xatmi_handle( void)
 {
-   return casual::http::inbound::local::service::send( data);
+   return casual::http::inbound::local::service::handle();
 }
 
 long casual_xatmi_receive( casual_http_buffer_type* data)
@@ -440,4 +686,3 @@ long casual_xatmi_cancel( casual_http_buffer_type* data)
 {
    return casual::http::inbound::local::service::cancel( data);
 }
-
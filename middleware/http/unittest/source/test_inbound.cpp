@@ -0,0 +1,146 @@
+//!
+//! Copyright (c) 2015, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#include "common/unittest.h"
+
+#include "http/inbound/caller.h"
+#include "http/common.h"
+
+#include "common/code/xatmi.h"
+#include "common/algorithm.h"
+#include "common/algorithm/container.h"
+
+#include "domain/manager/unittest/process.h"
+
+#include <cstring>
+
+namespace casual
+{
+   namespace http::inbound
+   {
+      namespace local
+      {
+         namespace
+         {
+            constexpr auto configuration = R"(
+domain:
+   name: http-inbound-domain
+
+   groups:
+      -  name: base
+      -  name: user
+         dependencies: [ base]
+
+   servers:
+      -  path: ${CASUAL_MAKE_SOURCE_ROOT}/middleware/service/bin/casual-service-manager
+         memberships: [ base]
+      -  path: ${CASUAL_MAKE_SOURCE_ROOT}/middleware/transaction/bin/casual-transaction-manager
+         memberships: [ base]
+      -  path: ${CASUAL_MAKE_SOURCE_ROOT}/middleware/example/server/bin/casual-example-server
+         memberships: [ user]
+)";
+
+            casual_http_buffer_type transport( std::string_view service, std::string& body)
+            {
+               casual_http_buffer_type result{};
+               ::strncpy( result.service, service.data(), std::min( service.size(), sizeof( result.service) - 1));
+               ::strncpy( result.protocol, http::protocol::json, sizeof( result.protocol) - 1);
+               result.payload = http_buffer_type{ body.data(), static_cast< long>( body.size())};
+               return result;
+            }
+
+            //! polls until the `descriptors` has completed
+            void wait( std::vector< long> descriptors)
+            {
+               std::vector< long> completed( 16);
+
+               while( ! descriptors.empty())
+               {
+                  auto count = casual_xatmi_poll( completed.data(), completed.size());
+
+                  for( auto descriptor : common::range::make( completed.data(), count))
+                     common::algorithm::container::trim( descriptors, common::algorithm::remove( descriptors, descriptor));
+
+                  if( count == 0)
+                     common::process::sleep( std::chrono::milliseconds{ 1});
+               }
+            }
+
+         } // <unnamed>
+      } // local
+
+      TEST( http_inbound, absent_service__expect_no_entry__second_call_completes_without_lookup)
+      {
+         common::unittest::Trace trace;
+         domain::manager::unittest::Process domain{ { local::configuration}};
+
+         std::string body = R"({ "casual": 42})";
+
+         {
+            auto transport = local::transport( "absent/service", body);
+            ASSERT_TRUE( casual_xatmi_call( &transport) == OK);
+            local::wait( { transport.descriptor});
+
+            EXPECT_TRUE( casual_xatmi_receive( &transport) == ERROR);
+            EXPECT_TRUE( transport.code == common::cast::underlying( common::code::xatmi::no_entry));
+            EXPECT_TRUE( transport.context == cTPACALL);
+            casual_xatmi_cancel( &transport);
+         }
+
+         // the service is known to be absent, the call completes directly
+         {
+            auto transport = local::transport( "absent/service", body);
+            ASSERT_TRUE( casual_xatmi_call( &transport) == OK);
+            EXPECT_TRUE( casual_xatmi_receive( &transport) == ERROR);
+            EXPECT_TRUE( transport.code == common::cast::underlying( common::code::xatmi::no_entry));
+            casual_xatmi_cancel( &transport);
+         }
+      }
+
+      TEST( http_inbound, outstanding_calls__poll__expect_all_replies)
+      {
+         common::unittest::Trace trace;
+         domain::manager::unittest::Process domain{ { local::configuration}};
+
+         std::string body = R"({ "casual": 42})";
+
+         std::vector< casual_http_buffer_type> transports;
+
+         for( auto count = 20; count > 0; --count)
+         {
+            transports.push_back( local::transport( "casual/example/echo", body));
+            ASSERT_TRUE( casual_xatmi_call( &transports.back()) == OK);
+         }
+
+         local::wait( common::algorithm::transform( transports, []( auto& transport){ return transport.descriptor;}));
+
+         for( auto& transport : transports)
+         {
+            ASSERT_TRUE( casual_xatmi_receive( &transport) == OK);
+            EXPECT_TRUE( transport.code == common::cast::underlying( common::code::xatmi::ok));
+            EXPECT_TRUE( std::string( transport.payload.data, transport.payload.size) == body);
+            EXPECT_TRUE( transport.header_out.size > 0);
+            casual_xatmi_cancel( &transport);
+         }
+      }
+
+      TEST( http_inbound, cancel_outstanding_call__expect_unknown_descriptor)
+      {
+         common::unittest::Trace trace;
+         domain::manager::unittest::Process domain{ { local::configuration}};
+
+         std::string body = R"({ "casual": 42})";
+
+         auto transport = local::transport( "casual/example/echo", body);
+         ASSERT_TRUE( casual_xatmi_call( &transport) == OK);
+         EXPECT_TRUE( casual_xatmi_cancel( &transport) == OK);
+
+         EXPECT_TRUE( casual_xatmi_receive( &transport) == ERROR);
+         EXPECT_TRUE( transport.code == common::cast::underlying( common::code::xatmi::descriptor));
+      }
+
+   } // http::inbound
+} // casual
@@ -15,15 +15,18 @@
 typedef struct {
    u_char* service;
    u_char* protocol;
-   ngx_int_t lookup_key;
    ngx_int_t descriptor;
    ngx_int_t code;
-   ngx_int_t number_of_calls;
-   ngx_msec_t timeout;
    ngx_str_t call;
    ngx_str_t reply;
    ngx_int_t state;
+   ngx_http_request_t* request;
+   //
+   // Node in the calls of the worker that waits for the reply, keyed by descriptor
+   //
+   ngx_rbtree_node_t node;
    unsigned waiting_more_body:1;
+   unsigned waiting_reply:1;
 } ngx_http_xatmi_ctx_t;
 
 
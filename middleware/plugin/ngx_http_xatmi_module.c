@@ -29,6 +29,31 @@ typedef struct
 //
 const long cServiceLocationStart = sizeof("/casual/") - 1;
 
+//
+// Interval to poll outstanding calls, if we're not notified by the ipc-handle of casual
+//
+const ngx_msec_t cPollInterval = 100;
+
+//
+// Max number of completed calls to handle per poll
+//
+#define XATMI_POLL_BATCH 64
+
+//
+// The outstanding calls of this worker, that waits for the reply, keyed by descriptor
+//
+typedef struct
+{
+   ngx_connection_t* connection;
+   ngx_event_t notify;
+   ngx_event_t timer;
+   ngx_rbtree_t waiting;
+   ngx_rbtree_node_t sentinel;
+   ngx_flag_t initialized;
+} ngx_http_xatmi_worker_t;
+
+static ngx_http_xatmi_worker_t xatmi_worker;
+
 //
 // Nginx "drivers"
 //
@@ -36,7 +61,6 @@ static char* ngx_http_xatmi_setup(ngx_conf_t* cf, ngx_command_t* cmd, void* conf
 static void* ngx_http_xatmi_create_loc_conf(ngx_conf_t* cf);
 static char* ngx_http_xatmi_merge_loc_conf(ngx_conf_t* cf, void* parent, void* child);
 static void ngx_http_xatmi_body_read(ngx_http_request_t* r);
-static void ngx_http_xatmi_request_handler(ngx_event_t* ev);
 static ngx_int_t ngx_xatmi_backend_init(ngx_http_xatmi_loc_conf_t* cf);
 
 //
@@ -44,7 +68,9 @@ static ngx_int_t ngx_xatmi_backend_init(ngx_http_xatmi_loc_conf_t* cf);
 //
 
 static ngx_int_t bufferhandler( ngx_http_request_t* r, ngx_str_t* body);
-static void restart_cycle( ngx_http_request_t* r);
+static void wait_reply( ngx_http_request_t* r, ngx_http_xatmi_ctx_t* client_context);
+static void dispatch_replies( ngx_event_t* ev);
+static void ngx_http_xatmi_cleanup( void* data);
 
 //
 // xatmi specific
@@ -210,7 +236,6 @@ static ngx_int_t receive( ngx_http_request_t* r)
    ngx_http_xatmi_ctx_t* client_context = ngx_http_get_module_ctx(r, ngx_http_xatmi_module);
 
    ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: Waiting for answer: descriptor=%d", client_context->descriptor);
-   ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: Waiting for answer: number_of_calls=%d", client_context->number_of_calls);
    ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: Waiting for answer: Initial size of client_context->reply: [%d]", client_context->reply.len);
 
    return xatmi_receive( client_context, r);
@@ -288,10 +313,21 @@ static ngx_int_t ngx_xatmi_backend_handler( ngx_http_request_t* r)
       {
          return NGX_ERROR;
       }
-      client_context->timeout = 1;
       client_context->state = NGX_OK;
+      client_context->request = r;
       ngx_str_null( &client_context->call);
 
+      //
+      // Release the call (and the reply) when the request is released
+      //
+      ngx_pool_cleanup_t* cleanup = ngx_pool_cleanup_add( r->pool, 0);
+      if (cleanup == NULL)
+      {
+         return NGX_ERROR;
+      }
+      cleanup->handler = ngx_http_xatmi_cleanup;
+      cleanup->data = client_context;
+
       //
       // Set unique context for this request
       //
@@ -374,23 +410,17 @@ static ngx_int_t ngx_xatmi_backend_handler( ngx_http_request_t* r)
       error_handler(r, client_context);
       goto produce_output;
    }
-   else
-   {
-      restart_cycle( r);
-      return NGX_DONE;
-   }
 
    receive:
 
    rc = receive( r);
    if ( rc == NGX_AGAIN)
    {
-      restart_cycle( r);
+      wait_reply( r, client_context);
       return NGX_DONE;
    }
    else if ( rc == NGX_ERROR)
    {
-      xatmi_cancel(client_context, r);
       //Errorhantering p.g.a. fel vid försök till tpgetreply eller bufferhantering m.a.a. detta
       error_handler(r, client_context);
    }
@@ -514,62 +544,179 @@ ngx_http_xatmi_merge_loc_conf(ngx_conf_t* cf, void* parent, void* child)
    return NGX_CONF_OK ;
 }
 
-static void restart_cycle( ngx_http_request_t* r)
+static void ngx_http_xatmi_cleanup( void* data)
 {
-   ngx_http_xatmi_ctx_t* client_context = ngx_http_get_module_ctx(r, ngx_http_xatmi_module);
-   //
-   // Adjust timeout
-   //
-   if (client_context->number_of_calls > 500)
+   ngx_http_xatmi_ctx_t* client_context = data;
+
+   if (client_context->waiting_reply)
+   {
+      ngx_rbtree_delete( &xatmi_worker.waiting, &client_context->node);
+      client_context->waiting_reply = 0;
+   }
+
+   if (client_context->descriptor > 0)
+   {
+      xatmi_cancel( client_context);
+   }
+}
+
+//
+// Register the ipc-handle of casual in the event loop, so we're notified when replies arrives
+//
+static void worker_initialize( ngx_log_t* log)
+{
+   xatmi_worker.initialized = 1;
+
+   ngx_rbtree_init( &xatmi_worker.waiting, &xatmi_worker.sentinel, ngx_rbtree_insert_value);
+
+   xatmi_worker.notify.handler = dispatch_replies;
+   xatmi_worker.notify.log = ngx_cycle->log;
+   xatmi_worker.notify.data = &xatmi_worker;
+
+   xatmi_worker.timer.handler = dispatch_replies;
+   xatmi_worker.timer.log = ngx_cycle->log;
+   xatmi_worker.timer.data = &xatmi_worker;
+   xatmi_worker.timer.cancelable = 1;
+
+   ngx_socket_t handle = xatmi_handle();
+
+   if (handle < 0)
    {
-      client_context->timeout = 500;
+      ngx_log_error(NGX_LOG_WARN, log, 0, "xatmi: no ipc-handle, calls are polled every %M ms", cPollInterval);
+      return;
    }
-   else if (client_context->number_of_calls > 100)
+
+   ngx_connection_t* c = ngx_get_connection( handle, ngx_cycle->log);
+
+   if (c == NULL)
    {
-      client_context->timeout = 100;
+      ngx_log_error(NGX_LOG_WARN, log, 0, "xatmi: failed to register ipc-handle, calls are polled every %M ms", cPollInterval);
+      return;
    }
-   else if (client_context->number_of_calls > 50)
+
+   c->data = &xatmi_worker;
+   c->read->handler = dispatch_replies;
+   c->read->log = ngx_cycle->log;
+
+   if (ngx_handle_read_event( c->read, 0) != NGX_OK)
    {
-      client_context->timeout = 50;
+      ngx_log_error(NGX_LOG_WARN, log, 0, "xatmi: failed to register ipc-handle, calls are polled every %M ms", cPollInterval);
+      c->fd = (ngx_socket_t) -1;
+      ngx_free_connection( c);
+      return;
    }
 
+   xatmi_worker.connection = c;
+}
+
+//
+// Park the request until the reply arrives
+//
+static void wait_reply( ngx_http_request_t* r, ngx_http_xatmi_ctx_t* client_context)
+{
+   if (! xatmi_worker.initialized)
+   {
+      worker_initialize( r->connection->log);
+   }
+
+   ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: wait for reply, descriptor [%d]", client_context->descriptor);
+
    r->main->count++;
+   client_context->waiting_reply = 1;
+   client_context->node.key = (ngx_rbtree_key_t) client_context->descriptor;
+   ngx_rbtree_insert( &xatmi_worker.waiting, &client_context->node);
+
    //
-   // Start timer again
+   // The lookup reply might already be read by casual, we poll once when the event loop
+   // has handled the current events, for all calls made in this cycle
    //
-   r->connection->read->handler = ngx_http_xatmi_request_handler;
-   r->read_event_handler = ngx_http_core_run_phases;
-   r->connection->read->log = r->connection->log;
-   ngx_add_timer( r->connection->read, client_context->timeout );
-   client_context->number_of_calls++;
+   ngx_post_event( &xatmi_worker.notify, &ngx_posted_events);
 
+   if (! xatmi_worker.timer.timer_set)
+   {
+      ngx_add_timer( &xatmi_worker.timer, cPollInterval);
+   }
 }
-static void
-ngx_http_xatmi_request_handler(ngx_event_t* ev)
+
+//
+// Descriptors are unique within the worker, so there is at most one waiting request per descriptor
+//
+static ngx_http_xatmi_ctx_t* find_request( long descriptor)
 {
-   //
-   // A copy of standard ngx_http_request_handler
-   //
-   ngx_connection_t    *c;
-   ngx_http_request_t  *r;
-   ngx_http_log_ctx_t  *ctx;
+   ngx_rbtree_key_t key = (ngx_rbtree_key_t) descriptor;
+   ngx_rbtree_node_t* node = xatmi_worker.waiting.root;
+   ngx_rbtree_node_t* sentinel = xatmi_worker.waiting.sentinel;
+
+   while (node != sentinel)
+   {
+      if (key == node->key)
+      {
+         return (ngx_http_xatmi_ctx_t*) ((u_char*) node - offsetof( ngx_http_xatmi_ctx_t, node));
+      }
+
+      node = (key < node->key) ? node->left : node->right;
+   }
 
-   c = ev->data;
-   r = c->data;
+   return NULL;
+}
+
+static void wake_request( long descriptor)
+{
+   ngx_http_xatmi_ctx_t* client_context = find_request( descriptor);
 
-   ctx = c->log->data;
+   if (client_context == NULL)
+   {
+      return;
+   }
+
+   ngx_rbtree_delete( &xatmi_worker.waiting, &client_context->node);
+   client_context->waiting_reply = 0;
+
+   ngx_http_request_t* r = client_context->request;
+   ngx_connection_t* c = r->connection;
+   ngx_http_log_ctx_t* ctx = c->log->data;
    ctx->current_request = r;
 
    ngx_log_debug2(NGX_LOG_DEBUG_HTTP, c->log, 0,
       "xatmi: http run request: \"%V?%V\"", &r->uri, &r->args);
 
-   if (ev->write) {
-      r->write_event_handler(r);
+   ngx_http_core_run_phases( r);
+   ngx_http_run_posted_requests( c);
+}
+
+//
+// Progress the outstanding calls, and run the requests which reply has arrived
+//
+static void dispatch_replies( ngx_event_t* ev)
+{
+   long completed[ XATMI_POLL_BATCH];
+   ngx_int_t count;
 
-   } else {
-      r->read_event_handler(r);
+   do
+   {
+      count = xatmi_poll( completed, XATMI_POLL_BATCH);
+
+      for (ngx_int_t index = 0; index < count; ++index)
+      {
+         wake_request( completed[ index]);
+      }
    }
+   while (count == XATMI_POLL_BATCH);
 
-   ngx_http_run_posted_requests(c);
-}
+   if (xatmi_worker.connection && ev == xatmi_worker.connection->read)
+   {
+      ngx_handle_read_event( ev, 0);
+   }
 
+   if (xatmi_worker.waiting.root == xatmi_worker.waiting.sentinel)
+   {
+      if (xatmi_worker.timer.timer_set)
+      {
+         ngx_del_timer( &xatmi_worker.timer);
+      }
+   }
+   else if (! xatmi_worker.timer.timer_set)
+   {
+      ngx_add_timer( &xatmi_worker.timer, cPollInterval);
+   }
+}
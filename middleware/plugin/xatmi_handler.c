@@ -12,26 +12,6 @@ long xatmi_tperrno;
 //Global representation av senaste context där fel uppstod.
 enum xatmi_context xatmi_error_context;
 
-http_buffer_type copy( ngx_str_t source)
-{
-   http_buffer_type buffer;
-   buffer.data = (char*)malloc( source.len + 1);
-   memcpy( buffer.data, (char*)source.data, source.len);
-   buffer.data[source.len] = '\0';
-   buffer.size = source.len;
-   return buffer;
-}
-
-ngx_str_t copy_buffer( http_buffer_type source, ngx_http_request_t* r)
-{
-   ngx_str_t destination;
-   destination.data = ngx_pcalloc( r->pool, source.size + 1);
-   ngx_memcpy( destination.data, source.data, source.size);
-   destination.len = source.size;
-   destination.data[source.size] = '\0';
-   return destination;
-}
-
 ngx_str_t copy_data( const char* const source, ngx_http_request_t* r)
 {
    ngx_str_t destination;
@@ -79,41 +59,23 @@ ngx_int_t set_custom_header_in_headers_out(ngx_http_request_t* r, http_header_ty
     return NGX_OK;
 }
 
+http_buffer_type view( ngx_str_t source)
+{
+   http_buffer_type buffer;
+   buffer.data = (char*)source.data;
+   buffer.size = source.len;
+   return buffer;
+}
+
 ngx_int_t xatmi_call( ngx_http_xatmi_ctx_t* client_context, ngx_http_request_t* r)
 {
    ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: calling service [%s]", client_context->service);
    ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: call [%V]", &client_context->call);
 
-    casual_http_buffer_type transport;
+   casual_http_buffer_type transport;
    strcpy( transport.service, (char*)client_context->service);
    strcpy( transport.protocol, (char*)client_context->protocol);
 
-   transport.lookup_key = client_context->lookup_key;
-
-   ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: lookup_key [%d]", client_context->lookup_key);
-
-   long response = casual_xatmi_lookup( &transport);
-
-   if (response == AGAIN)
-   {
-      client_context->lookup_key = transport.lookup_key;
-      ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: lookup_key [%d]", client_context->lookup_key);
-      return NGX_AGAIN;
-   }
-   else if ( response == ERROR)
-   {
-      xatmi_error_context = transport.context;
-      xatmi_tperrno = transport.code;
-      client_context->reply = copy_buffer( transport.payload,  r);
-      client_context->code = transport.code;
-      set_custom_header_in_headers_out( r, transport.header_out);
-      free( transport.payload.data);
-      return NGX_ERROR;
-   }
-
-   //
-   // Service manager ready, time to make the call
-   //
    ngx_int_t headersize = get_header_length(r);
    ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: headerlength [%d]", headersize);
    header_data_type* header = NULL;
@@ -128,34 +90,34 @@ ngx_int_t xatmi_call( ngx_http_xatmi_ctx_t* client_context, ngx_http_request_t*
    transport.header_in.size = headersize;
    transport.header_out.data = 0;
    transport.header_out.size = 0;
-   transport.payload = copy( client_context->call);
-   transport.parameter = copy( r->args);
 
    //
-   // Make the call
+   // The body and the parameters is mapped as is, casual copies them to the xatmi buffer
+   //
+   transport.payload = view( client_context->call);
+   transport.parameter = view( r->args);
+
    //
-   response = casual_xatmi_send( &transport);
+   // Make the call, the lookup and the call is progressed by xatmi_poll
+   //
+   long response = casual_xatmi_call( &transport);
+
+   free( transport.header_in.data);
 
    if (response == ERROR)
    {
      xatmi_error_context = transport.context;
      xatmi_tperrno = transport.code;
-     client_context->reply = copy_buffer( transport.payload,  r);
      client_context->code = transport.code;
-     free( transport.header_in.data);
-     free( transport.payload.data);
-     free( transport.parameter.data);
+     ngx_str_null( &client_context->reply);
      return NGX_ERROR;
    }
 
    client_context->descriptor = transport.descriptor;
 
-   free( transport.header_in.data);
-   free( transport.payload.data);
-   free( transport.parameter.data);
-   ngx_log_debug0(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: calling service - end");
+   ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0, "xatmi: calling service - end, descriptor [%d]", client_context->descriptor);
 
-   return transport.descriptor;
+   return NGX_OK;
 }
 
 ngx_int_t xatmi_receive( ngx_http_xatmi_ctx_t* client_context, ngx_http_request_t* r)
@@ -179,21 +141,31 @@ ngx_int_t xatmi_receive( ngx_http_xatmi_ctx_t* client_context, ngx_http_request_
    // copy the protocol back, to get possible changes from receive.
    strcpy( (char*)client_context->protocol, transport.protocol);
 
-   client_context->reply = copy_buffer( transport.payload, r);
+   //
+   // The reply is owned by the call until it's cancelled, when the request is released
+   //
+   client_context->reply.data = (u_char*)transport.payload.data;
+   client_context->reply.len = transport.payload.size;
+   xatmi_error_context = transport.context;
    xatmi_tperrno = transport.code;
    client_context->code = transport.code;
    set_custom_header_in_headers_out( r, transport.header_out);
 
-   free( transport.header_out.data);
-   free( transport.payload.data);
-
    return result == OK ? NGX_OK : NGX_ERROR;
 }
 
-void xatmi_cancel( ngx_http_xatmi_ctx_t* client_context, ngx_http_request_t* r)
+ngx_int_t xatmi_poll( long* completed, ngx_int_t size)
 {
-   ngx_log_debug1(NGX_LOG_DEBUG_ALL, r->connection->log, 0,  "xatmi: canceling... descriptor [%d]", client_context->descriptor);
+   return casual_xatmi_poll( completed, size);
+}
 
+ngx_int_t xatmi_handle()
+{
+   return casual_xatmi_handle();
+}
+
+void xatmi_cancel( ngx_http_xatmi_ctx_t* client_context)
+{
    casual_http_buffer_type transport;
    transport.header_in.size = 0; // No header needed
    transport.descriptor = client_context->descriptor;
@@ -201,6 +173,7 @@ void xatmi_cancel( ngx_http_xatmi_ctx_t* client_context, ngx_http_request_t* r)
    strcpy( transport.service, (char*)client_context->service);
 
    casual_xatmi_cancel( &transport);
+   client_context->descriptor = 0;
 }
 
 ngx_int_t xatmi_max_service_length()
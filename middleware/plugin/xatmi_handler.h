@@ -14,7 +14,9 @@
 
 ngx_int_t xatmi_call( ngx_http_xatmi_ctx_t* client_context, ngx_http_request_t* r);
 ngx_int_t xatmi_receive( ngx_http_xatmi_ctx_t* client_context, ngx_http_request_t* r);
-void xatmi_cancel( ngx_http_xatmi_ctx_t* client_context, ngx_http_request_t* r);
+ngx_int_t xatmi_poll( long* completed, ngx_int_t size);
+ngx_int_t xatmi_handle();
+void xatmi_cancel( ngx_http_xatmi_ctx_t* client_context);
 void xatmi_terminate( );
 ngx_int_t xatmi_max_service_length();
 
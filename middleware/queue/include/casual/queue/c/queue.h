@@ -69,6 +69,20 @@ extern int casual_queue_message_attribute_set_reply( casual_message_descriptor_t
 */
 extern int casual_queue_message_attribute_set_available( casual_message_descriptor_t message, long ms_since_epoc);
 
+/* when the message expires, ms since epoc, hence absolute time. An expired message is never dequeued.
+   0 -> never expires (default)
+   @returns 0 on success -1 on error and casual_qerrno is set 
+*/
+extern int casual_queue_message_attribute_set_expiry( casual_message_descriptor_t message, long ms_since_epoc);
+
+/* sets the priority of the message. Messages with higher priority are dequeued before messages 
+   with lower priority, messages with the same priority in the order they were enqueued. Default is 0.
+   @returns 0 on success -1 on error and casual_qerrno is set 
+*/
+extern int casual_queue_message_attribute_set_priority( casual_message_descriptor_t message, long priority);
+/* @returns 0 on success -1 on error and casual_qerrno is set */
+extern int casual_queue_message_attribute_get_priority( casual_message_descriptor_t message, long* priority);
+
 /* (re)sets the associated buffer to the message 
   @returns 0 on success -1 on error and casual_qerrno is set
 */
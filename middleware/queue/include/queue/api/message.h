@@ -43,11 +43,21 @@ namespace casual
          //! When the message is available, in absolute time.
          platform::time::point::type available = platform::time::point::limit::zero();
 
+         //! Messages with higher priority are dequeued before messages with lower priority,
+         //! messages with the same priority in the order they were enqueued.
+         size_type priority = 0;
+
+         //! When the message expires, in absolute time. An expired message is never dequeued,
+         //! and is eventually moved to the error queue. zero -> never expires.
+         platform::time::point::type expiry = platform::time::point::limit::zero();
+
          CASUAL_CONST_CORRECT_SERIALIZE(
          {
             CASUAL_SERIALIZE( properties);
             CASUAL_SERIALIZE( reply);
             CASUAL_SERIALIZE( available);
+            CASUAL_SERIALIZE( priority);
+            CASUAL_SERIALIZE( expiry);
          })
 
       };
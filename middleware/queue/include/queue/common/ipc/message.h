@@ -309,6 +309,11 @@ namespace casual
                Selector selector;
                bool block = false;
 
+               //! transactions for additional messages to dequeue (if available), one message
+               //! per transaction. Only honoured if `trid` is set.
+               //! The reply messages are in the order `trid`, `prefetch`...
+               std::vector< common::transaction::ID> prefetch;
+
                CASUAL_CONST_CORRECT_SERIALIZE(
                   base_request::serialize( archive);
                   CASUAL_SERIALIZE( trid);
@@ -316,6 +321,7 @@ namespace casual
                   CASUAL_SERIALIZE( name);
                   CASUAL_SERIALIZE( selector);
                   CASUAL_SERIALIZE( block);
+                  CASUAL_SERIALIZE( prefetch);
                )
             };
 
@@ -329,6 +335,10 @@ namespace casual
                platform::binary::type payload;
                platform::size::type redelivered{};
                platform::time::point::type timestamp;
+               //! higher priority is dequeued first
+               platform::size::type priority{};
+               //! the message is not dequeued after expiry, zero -> never expires
+               platform::time::point::type expiry{};
 
                CASUAL_CONST_CORRECT_SERIALIZE(
                   CASUAL_SERIALIZE( id);
@@ -339,6 +349,8 @@ namespace casual
                   CASUAL_SERIALIZE( payload);
                   CASUAL_SERIALIZE( redelivered);
                   CASUAL_SERIALIZE( timestamp);
+                  CASUAL_SERIALIZE( priority);
+                  CASUAL_SERIALIZE( expiry);
                )
             };
 
@@ -393,7 +405,7 @@ namespace casual
                Message() = default;
                Message( dequeue::Message other)
                   : id{ other.id}, properties{ std::move( other.properties)}, reply{ std::move( other.reply)}, available{ other.available},
-                     type{ std::move( other.type)}, payload{ std::move( other.payload)}
+                     type{ std::move( other.type)}, payload{ std::move( other.payload)}, priority{ other.priority}, expiry{ other.expiry}
                {}
 
                common::Uuid id;
@@ -402,6 +414,10 @@ namespace casual
                platform::time::point::type available;
                std::string type;
                platform::binary::type payload;
+               //! higher priority is dequeued first
+               platform::size::type priority{};
+               //! the message is not dequeued after expiry, zero -> never expires
+               platform::time::point::type expiry{};
 
                CASUAL_CONST_CORRECT_SERIALIZE(
                   CASUAL_SERIALIZE( id);
@@ -410,6 +426,8 @@ namespace casual
                   CASUAL_SERIALIZE( available);
                   CASUAL_SERIALIZE( type);
                   CASUAL_SERIALIZE( payload);
+                  CASUAL_SERIALIZE( priority);
+                  CASUAL_SERIALIZE( expiry);
                )
             };
 
@@ -512,6 +530,8 @@ namespace casual
                   platform::time::point::type last;
                   platform::size::type dequeued{};
                   platform::size::type enqueued{};
+                  //! messages that has expired (removed or moved to the error queue)
+                  platform::size::type expired{};
 
                   CASUAL_CONST_CORRECT_SERIALIZE(
                      CASUAL_SERIALIZE( count);
@@ -519,6 +539,7 @@ namespace casual
                      CASUAL_SERIALIZE( uncommitted);
                      CASUAL_SERIALIZE( dequeued);
                      CASUAL_SERIALIZE( enqueued);
+                     CASUAL_SERIALIZE( expired);
                      CASUAL_SERIALIZE( last);
                   )
                };
@@ -596,6 +617,8 @@ namespace casual
                std::string type;
                platform::size::type size;
                platform::time::point::type timestamp;
+               platform::size::type priority{};
+               platform::time::point::type expiry{};
 
                CASUAL_CONST_CORRECT_SERIALIZE(
                   CASUAL_SERIALIZE( id);
@@ -610,6 +633,8 @@ namespace casual
                   CASUAL_SERIALIZE( type);
                   CASUAL_SERIALIZE( size);
                   CASUAL_SERIALIZE( timestamp);
+                  CASUAL_SERIALIZE( priority);
+                  CASUAL_SERIALIZE( expiry);
                )
             };
 
@@ -249,6 +249,16 @@ namespace casual
 
             struct Dequeue : transaction_base
             {
+               //! the transactions for the prefetched messages, one per reserved instance.
+               std::vector< common::transaction::ID> prefetch;
+
+               //! @returns how many instances the dequeue has reserved
+               inline platform::size::type instances() const noexcept { return 1 + common::range::size( prefetch);}
+
+               CASUAL_LOG_SERIALIZE(
+                  transaction_base::serialize( archive);
+                  CASUAL_SERIALIZE( prefetch);
+               )
             };
 
             namespace service
@@ -259,24 +269,29 @@ namespace casual
                   Lookup( transaction_base&& other) : transaction_base{ std::move( other)} {}
 
                   common::buffer::Payload buffer;
+                  //! the priority of the dequeued message, used for the reply
+                  platform::size::type priority{};
 
                   CASUAL_LOG_SERIALIZE(
                      transaction_base::serialize( archive);
                      CASUAL_SERIALIZE( buffer);
+                     CASUAL_SERIALIZE( priority);
                   )
                };
 
                struct Call : transaction_base
                {
                   Call() = default;
-                  Call( transaction_base&& other, common::strong::process::id pid)
-                     : transaction_base{ std::move( other)}, pid{ pid} {}
+                  Call( Lookup&& other, common::strong::process::id pid)
+                     : transaction_base{ std::move( other)}, pid{ pid}, priority{ other.priority} {}
 
                   common::strong::process::id pid{};
+                  platform::size::type priority{};
 
                   CASUAL_LOG_SERIALIZE(
                      transaction_base::serialize( archive);
                      CASUAL_SERIALIZE( pid);
+                     CASUAL_SERIALIZE( priority);
                   )
                };
                
@@ -389,6 +404,9 @@ namespace casual
          state::Pending pending;
 
          std::string alias;
+
+         //! max number of messages a forward dequeues in one request, 1 -> no prefetch
+         platform::size::type prefetch = platform::batch::queue::forward::prefetch;
          
          //! we're done when we're in shutdown mode
          //! and all forwards has no concurrent stuff in flight.
@@ -410,6 +428,7 @@ namespace casual
          CASUAL_LOG_SERIALIZE(
             CASUAL_SERIALIZE( runlevel);
             CASUAL_SERIALIZE( alias);
+            CASUAL_SERIALIZE( prefetch);
             CASUAL_SERIALIZE( forward);
             CASUAL_SERIALIZE( pending);
          )
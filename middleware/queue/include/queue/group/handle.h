@@ -31,6 +31,11 @@ namespace casual
          //! * check if pending request has some messages to consume
          void persist( State& state);
 
+         //! purges (at most platform::batch::queue::expired) expired messages, and rearms the expire timer.
+         //! Directly if the batch was full, since there might be more expired messages, otherwise
+         //! after platform::queue::expire::interval
+         void expire( State& state);
+
       } // handle
 
       handle::dispatch_type handlers( State& state);
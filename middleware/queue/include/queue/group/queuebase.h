@@ -11,6 +11,7 @@
 #include "sql/database.h"
 
 #include "queue/group/queuebase/statement.h"
+#include "queue/group/queuebase/blob.h"
 #include "queue/common/ipc/message.h"
 
 #include "common/string.h"
@@ -108,7 +109,9 @@ namespace casual
          Queuebase() = default;
 
          //! open/creates the queuebase, and starts a transaction
-         Queuebase( std::filesystem::path database);
+         //! @param blob settings for payloads stored outside the queuebase. If `blob.directory` is
+         //!   empty, the directory is derived from `database` (`<database-stem>.blob`)
+         Queuebase( std::filesystem::path database, queuebase::blob::Settings blob = {});
          //! commits current transaction, if any.
          ~Queuebase();
 
@@ -170,12 +173,18 @@ namespace casual
          std::vector< queue::ipc::message::group::message::Meta> meta( common::strong::queue::id id);
 
          void metric_reset( const std::vector< common::strong::queue::id>& ids);
+
+         //! purges (at most `limit`) messages that has expired at `now`. The messages are moved to
+         //! their error queue, or removed if they expired on an error queue.
+         //! @returns the number of purged messages
+         platform::size::type expire( const platform::time::point::type& now, platform::size::type limit);
          
 
          //! @return the number of rows affected by the last statement.
          platform::size::type affected() const;
 
-         //! commits current sqlite transaction, and starts a new one
+         //! commits current sqlite transaction, and starts a new one.
+         //! Blob segments that no message refers to are removed, and sparse segments are compacted.
          void persist();
          //! rollback current sqlite transaction and starts a new one
          void rollback();
@@ -205,8 +214,18 @@ namespace casual
 
       private:
 
+         //! stores the payload in a blob segment
+         //! @returns the id of the blob
+         std::int64_t blob( const platform::binary::type& payload);
+         //! @returns the payload of the blob
+         platform::binary::type blob( std::int64_t id);
+
+         //! @returns segments that can be removed when the current transaction is committed
+         std::vector< platform::size::type> compact();
+
          sql::database::Connection m_connection;
          queuebase::Statement m_statement;
+         queuebase::blob::Store m_blob;
       };
 
    } // queue::group
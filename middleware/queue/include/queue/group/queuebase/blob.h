@@ -0,0 +1,113 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#pragma once
+
+#include "casual/platform.h"
+
+#include "common/pimpl.h"
+#include "common/serialize/macro.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace casual
+{
+   namespace queue::group::queuebase::blob
+   {
+      struct Settings
+      {
+         //! payloads larger than `threshold` bytes are stored in segment files, 0 -> never
+         platform::size::type threshold = 0;
+
+         //! a new segment is started when the active segment would grow beyond `segment` bytes
+         platform::size::type segment = 64 * 1024 * 1024;
+
+         //! where the segment files are stored. If empty, payloads are always stored in the queuebase
+         std::filesystem::path directory;
+
+         CASUAL_LOG_SERIALIZE(
+            CASUAL_SERIALIZE( threshold);
+            CASUAL_SERIALIZE( segment);
+            CASUAL_SERIALIZE( directory);
+         )
+      };
+
+      struct Location
+      {
+         platform::size::type segment{};
+         platform::size::type offset{};
+         platform::size::type size{};
+
+         CASUAL_LOG_SERIALIZE(
+            CASUAL_SERIALIZE( segment);
+            CASUAL_SERIALIZE( offset);
+            CASUAL_SERIALIZE( size);
+         )
+      };
+
+      struct Segment
+      {
+         platform::size::type id{};
+         platform::size::type size{};
+
+         CASUAL_LOG_SERIALIZE(
+            CASUAL_SERIALIZE( id);
+            CASUAL_SERIALIZE( size);
+         )
+      };
+
+      //! @returns the content address of `content`. Not collision free, equal hashes needs to be
+      //! verified with `Store::equal`
+      std::int64_t hash( const platform::binary::type& content) noexcept;
+
+      //! Append only segment files that holds the payloads that are to large to be stored inline
+      //! in the queuebase. The store has no knowledge of which blobs are alive, that's
+      //! the responsibility of the queuebase.
+      class Store
+      {
+      public:
+         Store();
+         explicit Store( Settings settings);
+         ~Store();
+
+         Store( Store&&) noexcept;
+         Store& operator = ( Store&&) noexcept;
+
+         //! @returns true if a payload of `size` should be stored in a segment
+         bool external( platform::size::type size) const noexcept;
+
+         //! appends `content` to the active segment, starts a new segment if needed
+         Location append( const platform::binary::type& content);
+
+         //! @returns the blob at `location`, read from a (read only) mapping of the segment
+         platform::binary::type read( const Location& location);
+
+         //! @returns true if the blob at `location` has the same content as `content`
+         bool equal( const Location& location, const platform::binary::type& content);
+
+         //! flushes appended content to stable storage, needs to be done before the
+         //! queuebase is committed.
+         void persist();
+
+         //! @returns all segments except the active one
+         std::vector< Segment> segments() const;
+
+         //! removes the segment files. Should only be done when the queuebase is committed
+         //! with no references to the segments.
+         void remove( const std::vector< platform::size::type>& segments);
+
+         //! @returns true if a segment has been sealed (a new segment started) since the last call.
+         bool sealed() noexcept;
+
+      private:
+         class Implementation;
+         common::move::basic_pimpl< Implementation> m_implementation;
+      };
+
+   } // queue::group::queuebase::blob
+} // casual
@@ -10,8 +10,37 @@ namespace casual
    {
       namespace table
       {
-         inline namespace v3_0
+         namespace v3_0
          {
+            //! the message table prior to priority, used by the upgrade from earlier versions
+            constexpr auto message = R"( CREATE TABLE IF NOT EXISTS message 
+(  id            BLOB PRIMARY KEY,
+   queue         INTEGER  NOT NULL,
+   origin        NUMBER   NOT NULL, -- the first queue a message is enqueued to
+   gtrid         BLOB,
+   properties    TEXT,
+   state         INTEGER  NOT NULL, -- (1: enqueued, 2: committed, 3: dequeued)
+   reply         TEXT,
+   redelivered   INTEGER  NOT NULL,
+   type          TEXT,
+   available     INTEGER  NOT NULL,
+   timestamp     INTEGER  NOT NULL,
+   payload       BLOB,
+   FOREIGN KEY (queue) REFERENCES queue( id)
+); )";
+
+            namespace drop::index
+            {
+               constexpr auto message = R"( 
+DROP INDEX IF EXISTS i_dequeue_message;
+DROP INDEX IF EXISTS i_dequeue_message_properties;
+)";
+            } // drop::index
+         } // v3_0
+
+         namespace v5_0
+         {
+            //! the queue table prior to expiry, used by the upgrade from earlier versions
             constexpr auto queue = R"( CREATE TABLE IF NOT EXISTS queue 
 (
    id                INTEGER  PRIMARY KEY,
@@ -27,6 +56,26 @@ namespace casual
    last              INTEGER NOT NULL, -- last update to the queue
    created           INTEGER NOT NULL -- when the queue was created
 ); )";
+         } // v5_0
+
+         inline namespace v6_0
+         {
+            constexpr auto queue = R"( CREATE TABLE IF NOT EXISTS queue 
+(
+   id                INTEGER  PRIMARY KEY,
+   name              TEXT     UNIQUE,
+   retry_count       INTEGER  NOT NULL,
+   retry_delay       INTEGER  NOT NULL,
+   error             INTEGER  NOT NULL,
+   count             INTEGER  NOT NULL, -- number of (committed) messages
+   size              INTEGER  NOT NULL, -- total size of all (committed) messages
+   uncommitted_count INTEGER  NOT NULL, -- uncommitted messages
+   metric_dequeued   INTEGER  NOT NULL,
+   metric_enqueued   INTEGER  NOT NULL,
+   last              INTEGER NOT NULL, -- last update to the queue
+   created           INTEGER NOT NULL, -- when the queue was created
+   metric_expired    INTEGER  NOT NULL DEFAULT 0 -- messages that has expired
+); )";
 
 
          constexpr auto message = R"( CREATE TABLE IF NOT EXISTS message 
@@ -41,9 +90,24 @@ namespace casual
    type          TEXT,
    available     INTEGER  NOT NULL,
    timestamp     INTEGER  NOT NULL,
-   payload       BLOB,
+   payload       BLOB, -- NULL if the payload is stored in a blob segment
+   priority      INTEGER  NOT NULL DEFAULT 0, -- higher priority is dequeued first
+   size          INTEGER  NOT NULL DEFAULT 0, -- size of the payload
+   blob          INTEGER, -- blob.id, if the payload is stored in a blob segment
+   expiry        INTEGER  NOT NULL DEFAULT 0, -- the message is not dequeued after expiry, 0 -> never expires
    FOREIGN KEY (queue) REFERENCES queue( id)
 ); )";
+
+            //! payloads that are stored in segment files (outside the queuebase). Several messages
+            //! can refer to the same blob, if the content is the same.
+            constexpr auto blob = R"( CREATE TABLE IF NOT EXISTS blob 
+(  id            INTEGER  PRIMARY KEY,
+   hash          INTEGER  NOT NULL, -- content address, not collision free
+   segment       INTEGER  NOT NULL,
+   offset        INTEGER  NOT NULL,
+   size          INTEGER  NOT NULL,
+   reference     INTEGER  NOT NULL -- number of messages that refers to the blob
+); )";
             namespace index
             {
                constexpr auto queue = R"( 
@@ -54,17 +118,24 @@ CREATE INDEX IF NOT EXISTS i_queue_count ON queue ( count);
                constexpr auto message = R"( 
 CREATE INDEX IF NOT EXISTS i_message_id  ON message ( id);
 CREATE INDEX IF NOT EXISTS i_message_queue  ON message ( queue);
-CREATE INDEX IF NOT EXISTS i_dequeue_message  ON message ( queue, state, timestamp ASC, available ASC);
-CREATE INDEX IF NOT EXISTS i_dequeue_message_properties ON message ( queue, state, properties, timestamp ASC);
+CREATE INDEX IF NOT EXISTS i_dequeue_message_priority  ON message ( queue, state, priority DESC, timestamp ASC, available ASC);
+CREATE INDEX IF NOT EXISTS i_dequeue_message_properties_priority ON message ( queue, state, properties, priority DESC, timestamp ASC);
 CREATE INDEX IF NOT EXISTS i_message_timestamp ON message ( timestamp ASC);
 CREATE INDEX IF NOT EXISTS i_message_available ON message ( available ASC);
 CREATE INDEX IF NOT EXISTS i_gtrid_message  ON message ( gtrid, state);
+CREATE INDEX IF NOT EXISTS i_message_expiry ON message ( expiry) WHERE expiry > 0;
+)";
+
+               constexpr auto blob = R"( 
+CREATE INDEX IF NOT EXISTS i_blob_hash ON blob ( hash, size);
+CREATE INDEX IF NOT EXISTS i_blob_segment ON blob ( segment);
+CREATE INDEX IF NOT EXISTS i_blob_unreferenced ON blob ( id) WHERE reference = 0;
 )";
             } // index
-         } // inline v2_0
+         } // inline v6_0
       } // table
 
-      inline namespace v3_0
+      inline namespace v6_0
       {
          constexpr auto triggers = R"(
 CREATE TRIGGER IF NOT EXISTS insert_message INSERT ON message 
@@ -77,7 +148,7 @@ BEGIN
    UPDATE queue SET
       last = new.timestamp,
       count = count + 1,
-      size = size + coalesce( length( new.payload), 0),
+      size = size + new.size,
       metric_enqueued = metric_enqueued + 1
    WHERE id = new.queue AND new.state = 2;
 
@@ -88,7 +159,7 @@ BEGIN
    UPDATE queue SET
       count = count + 1,
       metric_enqueued = metric_enqueued + 1,
-      size = size + coalesce( length( new.payload), 0),
+      size = size + new.size,
       uncommitted_count = uncommitted_count - 1,
       last = new.timestamp
    WHERE id = new.queue AND old.state = 1 AND new.state = 2;
@@ -100,14 +171,14 @@ BEGIN
    UPDATE queue SET  -- 'queue move' update the new queue
       count = count + 1,
       metric_enqueued = metric_enqueued + 1,
-      size = size + coalesce( length( new.payload), 0),
+      size = size + new.size,
       last = MAX( last, new.timestamp)
    WHERE id = new.queue AND new.queue != old.queue;
 
    UPDATE queue SET  -- 'queue move' update the old queue
       count = count - 1,
       metric_dequeued = metric_dequeued + 1,
-      size = size - coalesce( length( old.payload), 0),
+      size = size - old.size,
       last = MAX( last, new.timestamp)
    WHERE id = old.queue AND old.queue != new.queue;
 
@@ -118,7 +189,7 @@ BEGIN
    UPDATE queue SET 
       count = count - 1,
       metric_dequeued = metric_dequeued + 1,
-      size = size - coalesce( length( old.payload), 0),
+      size = size - old.size,
       last = old.timestamp
    WHERE id = old.queue AND old.state IN ( 2, 3);
 
@@ -127,6 +198,16 @@ BEGIN
    WHERE id = old.queue AND old.state = 1;
    
 END;
+
+CREATE TRIGGER IF NOT EXISTS insert_message_blob INSERT ON message WHEN new.blob IS NOT NULL
+BEGIN
+   UPDATE blob SET reference = reference + 1 WHERE id = new.blob;
+END;
+
+CREATE TRIGGER IF NOT EXISTS delete_message_blob DELETE ON message WHEN old.blob IS NOT NULL
+BEGIN
+   UPDATE blob SET reference = reference - 1 WHERE id = old.blob;
+END;
                
 )";
          namespace drop
@@ -136,10 +217,12 @@ DROP TRIGGER IF EXISTS insert_message;
 DROP TRIGGER IF EXISTS update_message_state;
 DROP TRIGGER IF EXISTS update_message_queue;
 DROP TRIGGER IF EXISTS delete_message;
+DROP TRIGGER IF EXISTS insert_message_blob;
+DROP TRIGGER IF EXISTS delete_message_blob;
 )";
          } // drop
          
-      } // inline v2_0
+      } // inline v6_0
 
    } // queue::group::queuebase::schema
 } // casual
\ No newline at end of file
@@ -77,6 +77,37 @@ namespace casual
             //! arguments: (queue)id;
             sql::database::Statement reset;
          } metric;
+
+         struct
+         {
+            //! arguments: now, limit
+            sql::database::Statement candidates;
+            //! moves the message to the error queue, arguments: (error queue)id, rowid
+            sql::database::Statement error;
+            //! arguments: rowid
+            sql::database::Statement remove;
+            //! arguments: (queue)id
+            sql::database::Statement metric;
+         } expired;
+
+         struct
+         {
+            //! arguments: hash, size
+            sql::database::Statement candidates;
+            //! arguments: hash, segment, offset, size
+            sql::database::Statement insert;
+            //! arguments: (blob)id
+            sql::database::Statement location;
+
+            //! removes blobs that no message refers to
+            sql::database::Statement unreferenced;
+            //! the live size of each segment
+            sql::database::Statement segments;
+            //! arguments: segment
+            sql::database::Statement segment;
+            //! arguments: segment, offset, (blob)id
+            sql::database::Statement relocate;
+         } blob;
       };
 
       Statement statement( sql::database::Connection& connection);
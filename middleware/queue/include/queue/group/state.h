@@ -13,6 +13,7 @@
 #include "casual/platform.h"
 
 #include "common/state/machine.h"
+#include "common/timer/descriptor.h"
 
 #include <string>
 
@@ -84,6 +85,9 @@ namespace casual
 
          std::vector< common::strong::queue::id> zombies;
 
+         //! drives the purge of expired messages
+         common::timer::Descriptor expire;
+
          std::string alias;
          std::string note;
 
@@ -94,6 +98,7 @@ namespace casual
             CASUAL_SERIALIZE( pending);
             CASUAL_SERIALIZE( involved);
             CASUAL_SERIALIZE( zombies);
+            CASUAL_SERIALIZE( expire);
             CASUAL_SERIALIZE( alias);
             CASUAL_SERIALIZE( note);
          )
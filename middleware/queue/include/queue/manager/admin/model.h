@@ -105,10 +105,13 @@ namespace casual
          {
             platform::size::type dequeued{};
             platform::size::type enqueued{};
+            //! messages that has expired (removed or moved to the error queue)
+            platform::size::type expired{};
 
             CASUAL_CONST_CORRECT_SERIALIZE(
                CASUAL_SERIALIZE( dequeued);
                CASUAL_SERIALIZE( enqueued);
+               CASUAL_SERIALIZE( expired);
             )
 
          } metric;
@@ -301,6 +304,8 @@ namespace casual
          platform::time::point::type timestamp;
 
          platform::size::type size;
+         platform::size::type priority{};
+         platform::time::point::type expiry{};
 
          CASUAL_CONST_CORRECT_SERIALIZE(
             CASUAL_SERIALIZE( id);
@@ -314,6 +319,8 @@ namespace casual
             CASUAL_SERIALIZE( available);
             CASUAL_SERIALIZE( timestamp);
             CASUAL_SERIALIZE( size);
+            CASUAL_SERIALIZE( priority);
+            CASUAL_SERIALIZE( expiry);
          )
       };
 
@@ -65,6 +65,8 @@ namespace casual
                   request.message.properties = message.attributes.properties;
                   request.message.reply = message.attributes.reply;
                   request.message.available = message.attributes.available;
+                  request.message.priority = message.attributes.priority;
+                  request.message.expiry = message.attributes.expiry;
 
                   request.name = lookup.name();
 
@@ -109,6 +111,8 @@ namespace casual
                            queue::Message result;
                            result.id = value.id;
                            result.attributes.available = value.available;
+                           result.attributes.priority = value.priority;
+                           result.attributes.expiry = value.expiry;
                            result.attributes.properties = std::move( value.properties);
                            result.attributes.reply = std::move( value.reply);
                            result.payload.type = std::move( value.type);
@@ -506,6 +510,8 @@ namespace casual
                   result.trid = std::move( message.trid);
                   result.state = state( message.state);
                   result.attributes.available = message.available;
+                  result.attributes.priority = message.priority;
+                  result.attributes.expiry = message.expiry;
                   result.attributes.reply = std::move( message.reply);
                   result.attributes.properties = std::move( message.properties);
                   result.payload.type = std::move( message.type);
@@ -544,6 +550,8 @@ namespace casual
                   Message message;
                   message.id = m.id;
                   message.attributes.available = m.available;
+                  message.attributes.priority = m.priority;
+                  message.attributes.expiry = m.expiry;
                   message.attributes.reply = std::move( m.reply);
                   message.attributes.properties = std::move( m.properties);
                   message.payload.type = std::move( m.type);
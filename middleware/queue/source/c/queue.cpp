@@ -176,6 +176,30 @@ namespace casual
                         return 0;
                      }
                   } // available
+
+                  namespace expiry
+                  {
+                     auto set( descriptor::id descriptor, std::chrono::milliseconds time)
+                     {
+                        global::cache.get( descriptor).value.attributes.expiry = platform::time::point::type{ time};
+                        return 0;
+                     }
+                  } // expiry
+
+                  namespace priority
+                  {
+                     auto set( descriptor::id descriptor, long priority)
+                     {
+                        global::cache.get( descriptor).value.attributes.priority = priority;
+                        return 0;
+                     }
+
+                     auto get( descriptor::id descriptor, long* priority)
+                     {
+                        *priority = global::cache.get( descriptor).value.attributes.priority;
+                        return 0;
+                     }
+                  } // priority
                } // attribute
 
                namespace buffer
@@ -357,6 +381,21 @@ extern "C"
       return local::wrap( local::message::attribute::available::set, -1, local::message::descriptor::id{ message}, std::chrono::milliseconds{ ms_since_epoc});
    }
 
+   int casual_queue_message_attribute_set_expiry( casual_message_descriptor_t message, long ms_since_epoc)
+   {
+      return local::wrap( local::message::attribute::expiry::set, -1, local::message::descriptor::id{ message}, std::chrono::milliseconds{ ms_since_epoc});
+   }
+
+   int casual_queue_message_attribute_set_priority( casual_message_descriptor_t message, long priority)
+   {
+      return local::wrap( local::message::attribute::priority::set, -1, local::message::descriptor::id{ message}, priority);
+   }
+
+   int casual_queue_message_attribute_get_priority( casual_message_descriptor_t message, long* priority)
+   {
+      return local::wrap( local::message::attribute::priority::get, -1, local::message::descriptor::id{ message}, priority);
+   }
+
    int casual_queue_message_set_buffer( casual_message_descriptor_t message, casual_buffer_t buffer)
    {
       return local::wrap( local::message::buffer::set, -1, local::message::descriptor::id{ message}, buffer);
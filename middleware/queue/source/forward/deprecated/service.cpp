@@ -65,6 +65,7 @@ namespace casual
                      queue::Message reply;
                      reply.payload.data = std::move( result.buffer.memory);
                      reply.payload.type = std::move( result.buffer.type);
+                     reply.attributes.priority = message.attributes.priority;
                      queue::enqueue( replyqueue, reply);
                   }
                }
@@ -192,7 +192,7 @@ namespace casual
                      Trace trace{ "queue::forward::send::dequeue::request"};
                      common::log::line( verbose::log, "forward: ", forward);
 
-                     auto send_request =[&]()
+                     auto send_request =[&]( platform::size::type count)
                      {
                         ipc::message::group::dequeue::Request request{ common::process::handle()};
                         request.trid = common::transaction::id::create( common::process::handle());
@@ -202,8 +202,15 @@ namespace casual
                         request.selector = forward.selector;
                         request.block = true;
 
+                        // every prefetched message gets its own transaction, to keep the rollback
+                        // (and error queue) semantics per message.
+                        common::algorithm::for_n( count - 1, [&request]()
+                        {
+                           request.prefetch.push_back( common::transaction::id::create( common::process::handle()));
+                        });
+
                         if( ! ipc::flush::optional::send( forward.source.process.ipc, request))
-                           return;
+                           return false;
 
                         using Pending = common::traits::remove_cvref_t< decltype( state.pending.dequeues.back())>;
 
@@ -211,12 +218,18 @@ namespace casual
                         pending.id = forward.id;
                         pending.correlation = request.correlation;
                         pending.trid = request.trid;
+                        pending.prefetch = std::move( request.prefetch);
+
+                        // the dequeue reserves an instance for every message it could get.
+                        common::algorithm::for_n( pending.instances(), [&forward](){ ++forward;});
 
                         state.pending.dequeues.push_back( std::move( pending));
-                        ++forward;
+                        return true;
                      };
 
-                     common::algorithm::for_n( forward.instances.missing(), send_request);
+                     while( auto missing = forward.instances.missing())
+                        if( ! send_request( std::min( missing, state.prefetch)))
+                           return;
                   }
                } // dequeue
 
@@ -440,21 +453,12 @@ namespace casual
 
                namespace dequeue
                {
-                  auto reply( State& state)
+                  namespace detail
                   {
-                     return [&state]( ipc::message::group::dequeue::Reply& message)
+                     //! starts the 'flow' for one dequeued message
+                     void dispatch( State& state, forward::state::pending::Dequeue&& pending, ipc::message::group::dequeue::Message& message)
                      {
-                        Trace trace{ "queue::forward::service::local::handle::dequeue::reply"};
-                        log::line( verbose::log, "message: ", message);
-
-                        auto pending = pending::consume( state.pending.dequeues, message.correlation);
-                        
-                        if( message.message.empty())
-                        {
-                           log::line( log::category::error, "empty dequeued message - action: rollback");
-                           send::transaction::rollback::request( state, std::move( pending));
-                        }
-                        else if( state.runlevel > decltype( state.runlevel())::running)
+                        if( state.runlevel > decltype( state.runlevel())::running)
                         {
                            // if we're in _shutdown mode_ we don't want to start any "flows"
                            log::line( log::category::information, "message dequeued in shutdown mode - the message might end up on error queue - action: rollback");
@@ -473,8 +477,9 @@ namespace casual
                            ipc::flush::send( ipc::service::manager(), request);
 
                            forward::state::pending::service::Lookup lookup{ std::move( pending)};
-                           lookup.buffer.type = std::move( message.message[ 0].type);
-                           lookup.buffer.memory = std::move( message.message[ 0].payload);
+                           lookup.buffer.type = std::move( message.type);
+                           lookup.buffer.memory = std::move( message.payload);
+                           lookup.priority = message.priority;
 
                            state.pending.service.lookups.push_back( std::move( lookup));
 
@@ -487,7 +492,7 @@ namespace casual
                            request.trid = pending.trid;
                            request.queue = forward->target.id;
                            request.name = forward->target.queue;
-                           request.message = std::move( message.message.front());
+                           request.message = std::move( message);
 
                            // make sure we've got a new message-id
                            request.message.id = uuid::make();
@@ -502,6 +507,63 @@ namespace casual
                            state.pending.enqueues.emplace_back( std::move( pending));
 
                         }
+                     }
+
+                     //! releases `count` reserved instances of the forward
+                     void release( State& state, forward::state::forward::id id, platform::size::type count)
+                     {
+                        if( count <= 0)
+                           return;
+
+                        state.forward_apply( id, [count]( auto& forward)
+                        {
+                           common::algorithm::for_n( count, [&forward](){ --forward;});
+                           common::log::line( verbose::log, "forward: ", forward);
+                        });
+                     }
+
+                  } // detail
+
+                  auto reply( State& state)
+                  {
+                     return [&state]( ipc::message::group::dequeue::Reply& message)
+                     {
+                        Trace trace{ "queue::forward::service::local::handle::dequeue::reply"};
+                        log::line( verbose::log, "message: ", message);
+
+                        auto pending = pending::consume( state.pending.dequeues, message.correlation);
+                        auto prefetch = std::exchange( pending.prefetch, {});
+                        auto id = pending.id;
+
+                        if( message.message.empty())
+                        {
+                           log::line( log::category::error, "empty dequeued message - action: rollback");
+                           detail::release( state, id, range::size( prefetch));
+                           send::transaction::rollback::request( state, std::move( pending));
+                           return;
+                        }
+
+                        // the prefetch transactions that did not get a message was never involved,
+                        // we just release the instances they reserved
+                        auto unused = range::size( prefetch) - ( range::size( message.message) - 1);
+                        detail::release( state, id, unused);
+
+                        detail::dispatch( state, std::move( pending), message.message.front());
+
+                        // every prefetched message is a flow of its own, with its own correlation
+                        for( auto index = 1; index < range::size( message.message); ++index)
+                        {
+                           forward::state::pending::Dequeue flow;
+                           flow.id = id;
+                           flow.correlation = strong::correlation::id::emplace( uuid::make());
+                           flow.trid = std::move( prefetch[ index - 1]);
+
+                           detail::dispatch( state, std::move( flow), message.message[ index]);
+                        }
+
+                        // fewer messages than we asked for, start (blocking) dequeues for the released instances
+                        if( unused > 0 && state.runlevel == decltype( state.runlevel())::running)
+                           state.forward_apply( id, [&state]( auto& forward){ send::dequeue::request( state, forward);});
                      };
                   }
 
@@ -515,11 +577,8 @@ namespace casual
                            {
                               auto pending = algorithm::container::extract( state.pending.dequeues, std::begin( found));
 
-                              state.forward_apply( pending.id, []( auto& forward)
-                              {
-                                 --forward;                                 
-                                 common::log::line( verbose::log, "forward: ", forward);
-                              });
+                              // the dequeue has reserved an instance per (possible) message
+                              dequeue::detail::release( state, pending.id, pending.instances());
 
                               common::log::line( verbose::log, "pending: ", pending);
                            }
@@ -650,6 +709,7 @@ namespace casual
                               request.name = reply.queue;
                               request.message.type = std::move( message.buffer.type);
                               request.message.payload = std::move( message.buffer.memory);
+                              request.message.priority = call.priority;
 
                               if( reply.delay > platform::time::unit::zero())
                                  request.message.available = platform::time::clock::type::now() + reply.delay;
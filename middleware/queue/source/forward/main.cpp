@@ -12,6 +12,7 @@
 
 #include "common/message/dispatch.h"
 #include "common/exception/guard.h"
+#include "common/environment.h"
 
 namespace casual
 {
@@ -31,7 +32,9 @@ namespace casual
                   ipc::queue::manager(),
                   ipc::message::forward::group::Connect{ process::handle()});
 
-               return State{};
+               State state;
+               state.prefetch = std::max( environment::variable::get( environment::variable::name::queue::forward::prefetch, state.prefetch), platform::size::type{ 1});
+               return state;
             }
 
             auto condition( State& state)
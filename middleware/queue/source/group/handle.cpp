@@ -240,7 +240,23 @@ namespace casual
                      {
                         // we notify TM if the dequeue is in a transaction
                         if( message.trid)
+                        {
                            local::detail::transaction::involved( state, message);
+
+                           // prefetch, each message in its own transaction, as long as there are
+                           // available messages.
+                           for( auto& trid : message.prefetch)
+                           {
+                              message.trid = std::move( trid);
+
+                              auto prefetched = state.queuebase.dequeue( message, now);
+                              if( prefetched.message.empty())
+                                 break;
+
+                              local::detail::transaction::involved( state, message);
+                              algorithm::move( prefetched.message, std::back_inserter( reply.message));
+                           }
+                        }
                      }
                      else if( message.block)
                      {
@@ -552,10 +568,17 @@ namespace casual
                         );
                      }
 
+                     auto blob()
+                     {
+                        queuebase::blob::Settings result;
+                        result.threshold = environment::variable::get( environment::variable::name::queue::blob, result.threshold);
+                        return result;
+                     }
+
                      auto queuebase( const queue::ipc::message::group::configuration::update::Request& message)
                      {
                         if( ! message.model.queuebase.empty())
-                           return group::Queuebase{ message.model.queuebase};
+                           return group::Queuebase{ message.model.queuebase, blob()};
                         
                         auto name = message.model.alias + ".qb";
                         auto file = common::environment::directory::queue() / name;
@@ -564,7 +587,7 @@ namespace casual
                         {
                            // if the wanted path exists, we can't overwrite with the old
                            if( std::filesystem::exists( file))
-                              return group::Queuebase{ std::move( file)};
+                              return group::Queuebase{ std::move( file), blob()};
 
                            auto old = common::environment::directory::domain() / "queue" / "groups" / name;
 
@@ -576,7 +599,7 @@ namespace casual
                            }
                         }
 
-                        return group::Queuebase{ std::move( file)};
+                        return group::Queuebase{ std::move( file), blob()};
                      }
 
                   } // detail
@@ -834,6 +857,27 @@ namespace casual
             local::detail::pending::dequeues( state);
          }
 
+         void expire( State& state)
+         {
+            Trace trace{ "queue::handle::expire"};
+
+            if( ! state.expire.consume())
+               return;
+
+            auto now = platform::time::clock::type::now();
+
+            // bounded per purge so we don't stall the group, inbound is served between purges.
+            auto expired = state.queuebase.expire( now, platform::batch::queue::expired);
+
+            if( expired == platform::batch::queue::expired)
+               state.expire.set( now);
+            else
+               state.expire.set( now + platform::queue::expire::interval);
+
+            if( expired > 0)
+               state.queuebase.persist();
+         }
+
       } // handle
 
       handle::dispatch_type handlers( State& state)
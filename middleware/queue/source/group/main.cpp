@@ -16,6 +16,7 @@
 #include "common/exception/handle.h"
 #include "common/communication/instance.h"
 #include "common/message/signal.h"
+#include "common/communication/select.h"
 
 namespace casual
 {
@@ -52,11 +53,56 @@ namespace casual
                   return {};
                }
 
+               namespace dispatch
+               {
+                  template< typename H>
+                  struct ipc
+                  {
+                     ipc( H handler) : m_handler{ std::move( handler)} {}
+
+                     bool operator () ( communication::select::tag::consume)
+                     {
+                        // we consume the cache.
+                        return predicate::boolean( m_handler( queue::ipc::device().cached()));
+                     }
+
+                     bool operator() ( strong::file::descriptor::id descriptor, communication::select::tag::read)
+                     {
+                        if( queue::ipc::device().connector().descriptor() != descriptor)
+                           return false;
+
+                        m_handler( communication::device::non::blocking::next( queue::ipc::device()));
+                        return true;
+                     }
+
+                  private:
+                     H m_handler;
+                  };
+
+                  //! purges expired messages when the expire timer expires
+                  struct expire
+                  {
+                     expire( State& state) : m_state{ &state} {}
+
+                     bool operator() ( strong::file::descriptor::id descriptor, communication::select::tag::read)
+                     {
+                        if( m_state->expire.descriptor() != descriptor)
+                           return false;
+
+                        handle::expire( *m_state);
+                        return true;
+                     }
+
+                  private:
+                     State* m_state;
+                  };
+               } // dispatch
+
                auto condition( State& state)
                {
-                  return common::message::dispatch::condition::compose(
-                     common::message::dispatch::condition::done( [&state](){ return state.done();}),
-                     common::message::dispatch::condition::idle( [&state]()
+                  return communication::select::dispatch::condition::compose(
+                     communication::select::dispatch::condition::done( [&state](){ return state.done();}),
+                     communication::select::dispatch::condition::idle( [&state]()
                      {
                         // make sure we persist when inbound is idle,
                         handle::persist( state);
@@ -73,10 +119,18 @@ namespace casual
                      handle::abort( state);
                   });
 
-                  common::message::dispatch::pump( 
+                  // expired messages are purged periodically, driven by the expire timer
+                  state.expire.set( platform::time::clock::type::now() + platform::queue::expire::interval);
+
+                  communication::select::Directive directive;
+                  directive.read.add( ipc::device().connector().descriptor());
+                  directive.read.add( state.expire.descriptor());
+
+                  communication::select::dispatch::pump( 
                      condition( state), 
-                     group::handlers( state), 
-                     ipc::device());
+                     directive,
+                     dispatch::ipc{ group::handlers( state)},
+                     dispatch::expire{ state});
 
                   abort_guard.release();
                }
@@ -50,7 +50,9 @@ namespace casual
                      message.type,
                      message.available,
                      message.timestamp,
-                     message.size
+                     message.size,
+                     message.priority,
+                     message.expiry
                   );  
                }
 
@@ -60,11 +62,12 @@ namespace casual
                   {
                      std::int64_t rowid{};
                      ipc::message::group::dequeue::Message message;
+                     std::optional< std::int64_t> blob;
 
                      explicit operator bool () const { return rowid != 0;}
                   };
 
-                  // SELECT ROWID, id, properties, reply, redelivered, type, available, timestamp, payload
+                  // SELECT ROWID, id, properties, reply, redelivered, type, available, timestamp, payload, priority, blob, expiry
                   void result( sql::database::Row& row, Result& result)
                   {
                      sql::database::row::get( row,
@@ -76,7 +79,10 @@ namespace casual
                         result.message.type,
                         result.message.available,
                         result.message.timestamp,
-                        result.message.payload
+                        result.message.payload,
+                        result.message.priority,
+                        result.blob,
+                        result.message.expiry
                      );
                   }
 
@@ -125,12 +131,34 @@ namespace casual
             */
 
 
+            namespace blob
+            {
+               auto settings( const std::filesystem::path& database, queuebase::blob::Settings settings)
+               {
+                  if( settings.directory.empty() && database != sql::database::memory::file)
+                     settings.directory = std::filesystem::path{ database}.replace_extension( ".blob");
+
+                  return settings;
+               }
+
+               auto location( sql::database::Row& row)
+               {
+                  queuebase::blob::Location result;
+                  sql::database::row::get( row, result.segment, result.offset, result.size);
+                  return result;
+               }
+
+               //! a segment with less live content than this fraction is compacted
+               constexpr platform::size::type sparse = 4;
+
+            } // blob
+
             template< typename C>
             void check_version( C& connection)
             {
                Trace trace{ "queue::group::database::local::check_version"};
 
-               auto required = sql::database::Version{ 3, 0};
+               auto required = sql::database::Version{ 6, 0};
 
                auto version = sql::database::version::get( connection);
 
@@ -181,8 +209,8 @@ namespace casual
       } // queuebase
 
 
-      Queuebase::Queuebase( std::filesystem::path database) 
-         : m_connection{ std::move( database)}
+      Queuebase::Queuebase( std::filesystem::path database, queuebase::blob::Settings blob) 
+         : m_connection{ database}, m_blob{ local::blob::settings( database, std::move( blob))}
       {
          Trace trace{ "queue::group::Queuebase::Queuebase"};
 
@@ -208,6 +236,13 @@ namespace casual
             m_connection.statement( queuebase::schema::table::index::message);
          }
 
+         {
+            Trace trace{ "queue::group::Queuebase::Queuebase create table blob"};
+
+            m_connection.statement( queuebase::schema::table::blob);
+            m_connection.statement( queuebase::schema::table::index::blob);
+         }
+
          // Triggers
          {
             Trace trace{ "queue::group::Queuebase::Queuebase create triggers"};
@@ -263,12 +298,13 @@ namespace casual
             metric_dequeued   INTEGER  NOT NULL,
             metric_enqueued   INTEGER  NOT NULL,
             last              INTEGER NOT NULL, -- last update to the queue
-            created           INTEGER NOT NULL -- when the queue was created
+            created           INTEGER NOT NULL, -- when the queue was created
+            metric_expired    INTEGER NOT NULL
             */
 
          auto now = platform::time::clock::type::now();
 
-         constexpr auto statement = "INSERT INTO queue VALUES ( NULL,?,?,?,?, 0, 0, 0, 0, 0, 0, ?);";
+         constexpr auto statement = "INSERT INTO queue VALUES ( NULL,?,?,?,?, 0, 0, 0, 0, 0, 0, ?, 0);";
 
          // Create corresponding error queue
          // Note that 'error-queues' has '0' as error, hence a rollbacked message will never be moved to another queue.
@@ -360,7 +396,9 @@ namespace casual
 
          auto state = message.trid ? queuebase::message::State::added : queuebase::message::State::enqueued;
 
-         m_statement.enqueue.execute(
+         auto insert = [&]( auto&& payload, auto&& blob)
+         {
+            m_statement.enqueue.execute(
                reply.id.get(),
                message.queue.value(),
                message.queue.value(),
@@ -372,7 +410,18 @@ namespace casual
                message.message.type,
                message.message.available,
                platform::time::clock::type::now(),
-               message.message.payload);
+               payload,
+               message.message.priority,
+               message.message.payload.size(),
+               blob,
+               message.message.expiry);
+         };
+
+         // large payloads are stored outside the queuebase, and the message refers to the blob.
+         if( m_blob.external( message.message.payload.size()))
+            insert( nullptr, blob( message.message.payload));
+         else
+            insert( message.message.payload, nullptr);
 
          common::log::line( verbose::log, "reply: ", reply);
          return reply;
@@ -409,6 +458,10 @@ namespace casual
 
          if( auto result = fetch( message, now))
          {
+            // we need to read the blob before the message (and possible the blob) is removed
+            if( result.blob)
+               result.message.payload = blob( result.blob.value());
+
             // Update state
             if( message.trid)
                m_statement.state.xid.execute( common::transaction::id::range::global( message.trid), result.rowid);
@@ -469,6 +522,9 @@ namespace casual
             if( query.fetch( row))
             {
                auto result = local::transform::dequeue::result( row);
+               if( result.blob)
+                  result.message.payload = blob( result.blob.value());
+
                reply.messages.push_back( std::move( result.message));
             }
             else
@@ -607,7 +663,8 @@ namespace casual
                metric_dequeued   INTEGER  NOT NULL,
                metric_enqueued   INTEGER  NOT NULL,
                last              INTEGER NOT NULL, -- last update to the queue
-               created           INTEGER NOT NULL -- when the queue was created
+               created           INTEGER NOT NULL, -- when the queue was created
+               metric_expired    INTEGER NOT NULL
                */
             sql::database::row::get( row, 
                queue.id.underlaying(),
@@ -621,7 +678,8 @@ namespace casual
                queue.metric.dequeued,
                queue.metric.enqueued,
                queue.metric.last,
-               queue.created 
+               queue.created,
+               queue.metric.expired
             );
             return queue;
          });
@@ -652,6 +710,42 @@ namespace casual
       }
 
 
+      platform::size::type Queuebase::expire( const platform::time::point::type& now, platform::size::type limit)
+      {
+         Trace trace{ "queue::Queuebase::expire"};
+
+         struct Expired
+         {
+            std::int64_t rowid{};
+            common::strong::queue::id queue;
+            common::strong::queue::id error;
+         };
+
+         // SELECT m.ROWID, m.queue, q.error
+         auto expired = sql::database::query::fetch( m_statement.expired.candidates.query( now, limit), []( auto& row)
+         {
+            Expired result;
+            sql::database::row::get( row, result.rowid, result.queue.underlaying(), result.error.underlaying());
+            return result;
+         });
+
+         for( auto& message : expired)
+         {
+            // error queues has no error queue, the message is removed
+            if( message.error)
+               m_statement.expired.error.execute( message.error.value(), message.rowid);
+            else
+               m_statement.expired.remove.execute( message.rowid);
+
+            m_statement.expired.metric.execute( message.queue.value());
+         }
+
+         if( ! expired.empty())
+            log::line( log, "expired messages: ", expired.size());
+
+         return range::size( expired);
+      }
+
       platform::size::type Queuebase::affected() const
       {
          return m_connection.affected();
@@ -660,7 +754,14 @@ namespace casual
 
       void Queuebase::persist() 
       { 
+         auto removable = compact();
+
+         // the blobs needs to be on stable storage before the references are committed
+         m_blob.persist();
          m_connection.commit();
+
+         m_blob.remove( removable);
+
          m_connection.exclusive_begin();
       }
       void Queuebase::rollback() 
@@ -670,6 +771,106 @@ namespace casual
       }
 
 
+      std::int64_t Queuebase::blob( const platform::binary::type& payload)
+      {
+         Trace trace{ "queue::Queuebase::blob store"};
+
+         auto hash = queuebase::blob::hash( payload);
+
+         // same content is only stored once
+         sql::database::Row row;
+         auto query = m_statement.blob.candidates.query( hash, payload.size());
+
+         while( query.fetch( row))
+         {
+            std::int64_t id{};
+            queuebase::blob::Location location;
+            sql::database::row::get( row, id, location.segment, location.offset, location.size);
+
+            if( m_blob.equal( location, payload))
+            {
+               log::line( verbose::log, "blob: ", id, " - reused: ", location);
+               return id;
+            }
+         }
+
+         auto location = m_blob.append( payload);
+         m_statement.blob.insert.execute( hash, location.segment, location.offset, location.size);
+
+         return m_connection.rowid();
+      }
+
+      platform::binary::type Queuebase::blob( std::int64_t id)
+      {
+         Trace trace{ "queue::Queuebase::blob read"};
+
+         auto location = sql::database::query::first( m_statement.blob.location.query( id), &local::blob::location);
+
+         if( ! location)
+            code::raise::error( code::casual::invalid_argument, "failed to find blob: ", id);
+
+         return m_blob.read( location.value());
+      }
+
+      std::vector< platform::size::type> Queuebase::compact()
+      {
+         m_statement.blob.unreferenced.execute();
+
+         // we only need to check the segments if some blobs has been removed, or if a segment
+         // has been sealed (could have blobs from rolled back enqueues)
+         if( m_connection.affected() == 0 && ! m_blob.sealed())
+            return {};
+
+         Trace trace{ "queue::Queuebase::compact"};
+
+         auto live = sql::database::query::fetch( m_statement.blob.segments.query(), []( auto& row)
+         {
+            queuebase::blob::Segment segment;
+            sql::database::row::get( row, segment.id, segment.size);
+            return segment;
+         });
+
+         std::vector< platform::size::type> result;
+
+         for( auto& segment : m_blob.segments())
+         {
+            auto found = algorithm::find_if( live, [&segment]( auto& value){ return value.id == segment.id;});
+
+            if( ! found)
+            {
+               result.push_back( segment.id);
+               continue;
+            }
+
+            // to few live blobs - we move them to the active segment 
+            if( found->size * local::blob::sparse < segment.size)
+            {
+               log::line( log, "compact blob segment: ", segment, " - live size: ", found->size);
+
+               auto blobs = sql::database::query::fetch( m_statement.blob.segment.query( segment.id), []( auto& row)
+               {
+                  std::int64_t id{};
+                  queuebase::blob::Location location;
+                  sql::database::row::get( row, id, location.segment, location.offset, location.size);
+                  return std::make_tuple( id, location);
+               });
+
+               for( auto& [ id, location] : blobs)
+               {
+                  auto relocated = m_blob.append( m_blob.read( location));
+                  m_statement.blob.relocate.execute( relocated.segment, relocated.offset, id);
+               }
+
+               result.push_back( segment.id);
+            }
+         }
+
+         log::line( verbose::log, "removable blob segments: ", result);
+
+         return result;
+      }
+
+
       sql::database::Version Queuebase::version()
       {
          return sql::database::version::get( m_connection);
@@ -733,6 +934,11 @@ log_statement( value, #value)
          CASUAL_QUEUE_EXPLAIN_STATEMENT( m_statement.message.remove);
 
          CASUAL_QUEUE_EXPLAIN_STATEMENT( m_statement.metric.reset);
+
+         CASUAL_QUEUE_EXPLAIN_STATEMENT( m_statement.blob.candidates);
+         CASUAL_QUEUE_EXPLAIN_STATEMENT( m_statement.blob.location);
+         CASUAL_QUEUE_EXPLAIN_STATEMENT( m_statement.blob.unreferenced);
+         CASUAL_QUEUE_EXPLAIN_STATEMENT( m_statement.blob.segments);
       }
    } // queue::group
 } // casual
@@ -0,0 +1,376 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#include "queue/group/queuebase/blob.h"
+
+#include "queue/common/log.h"
+
+#include "common/algorithm.h"
+#include "common/result.h"
+#include "common/code/raise.h"
+#include "common/code/casual.h"
+#include "common/log.h"
+
+#include <map>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace casual
+{
+   using namespace common;
+
+   namespace queue::group::queuebase::blob
+   {
+      namespace local
+      {
+         namespace
+         {
+            constexpr std::string_view extension = ".segment";
+
+            auto path( const std::filesystem::path& directory, platform::size::type segment)
+            {
+               return directory / ( std::to_string( segment) + std::string{ extension});
+            }
+
+            //! @returns the segment id if `path` is a segment file
+            std::optional< platform::size::type> segment( const std::filesystem::path& path)
+            {
+               if( path.extension() != extension)
+                  return {};
+
+               auto stem = path.stem().string();
+               if( stem.empty() || ! algorithm::all_of( stem, []( auto c){ return c >= '0' && c <= '9';}))
+                  return {};
+
+               return std::stoll( stem);
+            }
+
+            struct Descriptor
+            {
+               Descriptor() = default;
+               explicit Descriptor( int descriptor) : descriptor{ descriptor} {}
+               ~Descriptor()
+               {
+                  if( descriptor != -1)
+                     ::close( descriptor);
+               }
+
+               Descriptor( Descriptor&& other) noexcept : descriptor{ std::exchange( other.descriptor, -1)} {}
+               Descriptor& operator = ( Descriptor&& other) noexcept
+               {
+                  std::swap( descriptor, other.descriptor);
+                  return *this;
+               }
+
+               explicit operator bool() const noexcept { return descriptor != -1;}
+
+               int descriptor = -1;
+            };
+
+            struct Mapping
+            {
+               Mapping() = default;
+               Mapping( const std::filesystem::path& path, platform::size::type size)
+               {
+                  Descriptor file{ posix::result( ::open( path.c_str(), O_RDONLY | O_CLOEXEC), "open segment: ", path)};
+
+                  struct ::stat status{};
+                  posix::result( ::fstat( file.descriptor, &status), "stat segment: ", path);
+
+                  // the active segment grows, we map at least the wanted size (which
+                  // is never beyond what's been written)
+                  m_size = std::max( static_cast< platform::size::type>( status.st_size), size);
+
+                  auto address = ::mmap( nullptr, m_size, PROT_READ, MAP_SHARED, file.descriptor, 0);
+                  if( address == MAP_FAILED)
+                     code::raise::error( code::casual::invalid_path, "failed to map segment: ", path, " - errno: ", errno);
+
+                  m_address = address;
+
+                  // mostly read once, front to back
+                  ::madvise( m_address, m_size, MADV_SEQUENTIAL);
+               }
+
+               ~Mapping()
+               {
+                  if( m_address)
+                     ::munmap( m_address, m_size);
+               }
+
+               Mapping( Mapping&& other) noexcept
+                  : m_address{ std::exchange( other.m_address, nullptr)}, m_size{ other.m_size} {}
+
+               Mapping& operator = ( Mapping&& other) noexcept
+               {
+                  std::swap( m_address, other.m_address);
+                  std::swap( m_size, other.m_size);
+                  return *this;
+               }
+
+               bool contains( const Location& location) const noexcept
+               {
+                  return location.offset + location.size <= m_size;
+               }
+
+               const char* data( const Location& location) const noexcept
+               {
+                  return static_cast< const char*>( m_address) + location.offset;
+               }
+
+            private:
+               void* m_address = nullptr;
+               platform::size::type m_size = 0;
+            };
+
+         } // <unnamed>
+      } // local
+
+      std::int64_t hash( const platform::binary::type& content) noexcept
+      {
+         // 64-bit, word at the time, multiply/rotate mix. Fast enough to not be noticed
+         // compared to the write of the content.
+         constexpr std::uint64_t prime = 0x9E3779B97F4A7C15;
+
+         std::uint64_t result = content.size() * prime;
+
+         auto current = content.data();
+         auto last = current + content.size();
+
+         for( ; last - current >= 8; current += 8)
+         {
+            std::uint64_t word;
+            std::memcpy( &word, current, 8);
+            result ^= word * prime;
+            result = ( result << 31 | result >> 33) * prime;
+         }
+
+         for( ; current != last; ++current)
+            result = ( result ^ static_cast< unsigned char>( *current)) * prime;
+
+         result ^= result >> 29;
+         return static_cast< std::int64_t>( result);
+      }
+
+      class Store::Implementation
+      {
+      public:
+         Implementation() = default;
+         Implementation( Settings settings) : m_settings{ std::move( settings)}
+         {
+            if( m_settings.directory.empty())
+               return;
+
+            // continue with the highest segment
+            for( auto& segment : segments( true))
+               m_active = std::max( m_active, segment.id);
+         }
+
+         bool external( platform::size::type size) const noexcept
+         {
+            return m_settings.threshold > 0 && size > m_settings.threshold && ! m_settings.directory.empty();
+         }
+
+         Location append( const platform::binary::type& content)
+         {
+            if( ! m_file)
+               open();
+            else if( m_size > 0 && m_size + range::size( content) > m_settings.segment)
+            {
+               // seal the active segment, and start a new one
+               persist();
+               m_file = {};
+               ++m_active;
+               m_sealed = true;
+               open();
+            }
+
+            Location result{ m_active, m_size, range::size( content)};
+
+            auto current = content.data();
+            auto last = current + content.size();
+
+            while( current != last)
+            {
+               auto written = ::write( m_file.descriptor, current, last - current);
+
+               if( written == -1 && errno == EINTR)
+                  continue;
+
+               posix::result( written, "write segment: ", local::path( m_settings.directory, m_active));
+               current += written;
+            }
+
+            m_size += result.size;
+            m_dirty = true;
+
+            log::line( verbose::log, "blob appended: ", result);
+
+            return result;
+         }
+
+         const char* data( const Location& location)
+         {
+            auto found = m_mappings.find( location.segment);
+
+            if( found == std::end( m_mappings) || ! found->second.contains( location))
+            {
+               auto size = location.segment == m_active ? std::max( m_settings.segment, m_size) : location.offset + location.size;
+               found = m_mappings.insert_or_assign( location.segment, local::Mapping{ local::path( m_settings.directory, location.segment), size}).first;
+
+               if( ! found->second.contains( location))
+                  code::raise::error( code::casual::invalid_argument, "blob location outside segment: ", location);
+            }
+
+            return found->second.data( location);
+         }
+
+         void persist()
+         {
+            if( ! std::exchange( m_dirty, false))
+               return;
+
+            posix::result( ::fdatasync( m_file.descriptor), "sync segment: ", local::path( m_settings.directory, m_active));
+
+            if( std::exchange( m_created, false))
+            {
+               // make sure the directory entry of the new segment is persistent
+               local::Descriptor directory{ posix::result( ::open( m_settings.directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC), "open: ", m_settings.directory)};
+               posix::result( ::fsync( directory.descriptor), "sync: ", m_settings.directory);
+            }
+         }
+
+         std::vector< Segment> segments( bool active = false) const
+         {
+            std::vector< Segment> result;
+
+            if( ! std::filesystem::exists( m_settings.directory))
+               return result;
+
+            for( auto& entry : std::filesystem::directory_iterator{ m_settings.directory})
+            {
+               if( auto id = local::segment( entry.path()); id && ( active || id.value() != m_active))
+                  result.push_back( Segment{ id.value(), static_cast< platform::size::type>( entry.file_size())});
+            }
+
+            return algorithm::sort( result, []( auto& l, auto& r){ return l.id < r.id;});
+         }
+
+         void remove( const std::vector< platform::size::type>& segments)
+         {
+            for( auto segment : segments)
+            {
+               if( segment == m_active)
+                  continue;
+
+               m_mappings.erase( segment);
+
+               auto path = local::path( m_settings.directory, segment);
+               std::error_code code;
+               if( std::filesystem::remove( path, code))
+                  log::line( log, "blob segment removed: ", path);
+               else if( code)
+                  log::line( log::category::error, code::casual::invalid_path, " failed to remove blob segment: ", path, " - ", code.message());
+            }
+         }
+
+         bool sealed() noexcept { return std::exchange( m_sealed, false);}
+
+      private:
+
+         void open()
+         {
+            if( ! std::filesystem::exists( m_settings.directory))
+               std::filesystem::create_directories( m_settings.directory);
+
+            auto path = local::path( m_settings.directory, m_active);
+
+            m_created = ! std::filesystem::exists( path);
+
+            m_file = local::Descriptor{ posix::result(
+               ::open( path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP),
+               "open segment: ", path)};
+
+            struct ::stat status{};
+            posix::result( ::fstat( m_file.descriptor, &status), "stat segment: ", path);
+            m_size = status.st_size;
+
+            // the mapping of the active segment could be to small
+            m_mappings.erase( m_active);
+
+            log::line( verbose::log, "active blob segment: ", path, " - size: ", m_size);
+         }
+
+         Settings m_settings;
+         platform::size::type m_active = 1;
+         local::Descriptor m_file;
+         //! the size of the active segment
+         platform::size::type m_size = 0;
+         std::map< platform::size::type, local::Mapping> m_mappings;
+         bool m_dirty = false;
+         bool m_created = false;
+         bool m_sealed = false;
+      };
+
+      Store::Store() = default;
+      Store::Store( Settings settings) : m_implementation{ std::move( settings)} {}
+      Store::~Store() = default;
+
+      Store::Store( Store&&) noexcept = default;
+      Store& Store::operator = ( Store&&) noexcept = default;
+
+      bool Store::external( platform::size::type size) const noexcept
+      {
+         return m_implementation->external( size);
+      }
+
+      Location Store::append( const platform::binary::type& content)
+      {
+         return m_implementation->append( content);
+      }
+
+      platform::binary::type Store::read( const Location& location)
+      {
+         Trace trace{ "queue::group::queuebase::blob::Store::read"};
+         log::line( verbose::log, "location: ", location);
+
+         auto data = m_implementation->data( location);
+         return platform::binary::type( data, data + location.size);
+      }
+
+      bool Store::equal( const Location& location, const platform::binary::type& content)
+      {
+         if( location.size != range::size( content))
+            return false;
+
+         return std::memcmp( m_implementation->data( location), content.data(), content.size()) == 0;
+      }
+
+      void Store::persist()
+      {
+         m_implementation->persist();
+      }
+
+      std::vector< Segment> Store::segments() const
+      {
+         return m_implementation->segments();
+      }
+
+      void Store::remove( const std::vector< platform::size::type>& segments)
+      {
+         m_implementation->remove( segments);
+      }
+
+      bool Store::sealed() noexcept
+      {
+         return m_implementation->sealed();
+      }
+
+   } // queue::group::queuebase::blob
+} // casual
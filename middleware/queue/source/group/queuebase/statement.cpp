@@ -36,34 +36,41 @@ namespace casual
                available     INTEGER,
                timestamp     INTEGER,
                payload       BLOB,
+               priority      INTEGER,
+               size          INTEGER,
+               blob          INTEGER,
+               expiry        INTEGER,
             */
-            result.enqueue = connection.precompile( "INSERT INTO message VALUES (?,?,?,?,?,?,?,?,?,?,?,?);");
+            result.enqueue = connection.precompile( "INSERT INTO message VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);");
 
          }
 
          {
             Trace trace{ "queue::group::Database::Database precompile statements dequeue"};
 
+            // highest priority first, and within the same priority the oldest. Both uses the
+            // corresponding (priority) index, so it's a seek and a (short) scan. Expired messages
+            // are never dequeued (they're purged on persist).
             result.dequeue.first = connection.precompile( 
                   "SELECT"
-                     " ROWID, id, properties, reply, redelivered, type, available, timestamp, payload"
+                     " ROWID, id, properties, reply, redelivered, type, available, timestamp, payload, priority, blob, expiry"
                   " FROM"
                      " message"
-                  " WHERE queue = :queue AND state = 2 AND available < :available ORDER BY timestamp ASC, available ASC LIMIT 1;");
+                  " WHERE queue = :queue AND state = 2 AND available < :available AND ( expiry = 0 OR expiry > :available) ORDER BY priority DESC, timestamp ASC, available ASC LIMIT 1;");
 
             result.dequeue.first_id = connection.precompile(  
                   "SELECT"
-                     " ROWID, id, properties, reply, redelivered, type, available, timestamp, payload"
+                     " ROWID, id, properties, reply, redelivered, type, available, timestamp, payload, priority, blob, expiry"
                   " FROM "
                      " message"
-                  " WHERE id = :id AND queue = :queue AND state = 2 AND available < :available;");
+                  " WHERE id = :id AND queue = :queue AND state = 2 AND available < :available AND ( expiry = 0 OR expiry > :available);");
 
             result.dequeue.first_match = connection.precompile(
                   "SELECT"
-                     " ROWID, id, properties, reply, redelivered, type, available, MIN( timestamp), payload"
+                     " ROWID, id, properties, reply, redelivered, type, available, timestamp, payload, priority, blob, expiry"
                   " FROM"
                      " message"
-                  " WHERE queue = :queue AND state = 2 AND properties = :properties AND available < :available;");
+                  " WHERE queue = :queue AND state = 2 AND properties = :properties AND available < :available AND ( expiry = 0 OR expiry > :available) ORDER BY priority DESC, timestamp ASC LIMIT 1;");
          }
 
 
@@ -148,7 +155,8 @@ namespace casual
                metric_dequeued   INTEGER  NOT NULL,
                metric_enqueued   INTEGER  NOT NULL,
                last              INTEGER NOT NULL, -- last update to the queue
-               created           INTEGER NOT NULL -- when the queue was created
+               created           INTEGER NOT NULL, -- when the queue was created
+               metric_expired    INTEGER NOT NULL
             */
             result.information.queue = connection.precompile( R"(
 SELECT
@@ -163,7 +171,8 @@ SELECT
    q.metric_dequeued,
    q.metric_enqueued,
    q.last,
-   q.created
+   q.created,
+   q.metric_expired
 FROM
    queue q  
 ;)");
@@ -181,6 +190,10 @@ FROM
                available      INTEGER,
                timestamp     INTEGER,
                payload       BLOB,
+               priority      INTEGER,
+               size          INTEGER,
+               blob          INTEGER,
+               expiry        INTEGER,
             */
             result.information.message = connection.precompile( R"(
 SELECT
@@ -195,7 +208,9 @@ SELECT
    m.type, 
    m.available, 
    m.timestamp, 
-   length( m.payload)
+   m.size,
+   m.priority,
+   m.expiry
 FROM
    message m
 WHERE
@@ -220,7 +235,9 @@ SELECT
    m.type,
    m.available,
    m.timestamp,
-   length( m.payload)
+   m.size,
+   m.priority,
+   m.expiry
 FROM 
    message  m
 WHERE m.queue = :queue AND m.properties = :properties;)");
@@ -236,13 +253,42 @@ SELECT
    type, 
    available, 
    timestamp, 
-   payload
+   payload,
+   priority,
+   blob,
+   expiry
 FROM 
    message 
 WHERE id = :id; )");
 
          }
 
+         {
+            Trace trace{ "queue::group::Database::Database precompile statements blob"};
+
+            result.blob.candidates = connection.precompile( "SELECT id, segment, offset, size FROM blob WHERE hash = :hash AND size = :size;");
+            result.blob.insert = connection.precompile( "INSERT INTO blob VALUES ( NULL, :hash, :segment, :offset, :size, 0);");
+            result.blob.location = connection.precompile( "SELECT segment, offset, size FROM blob WHERE id = :id;");
+
+            result.blob.unreferenced = connection.precompile( "DELETE FROM blob WHERE reference = 0;");
+            result.blob.segments = connection.precompile( "SELECT segment, SUM( size) FROM blob GROUP BY segment;");
+            result.blob.segment = connection.precompile( "SELECT id, segment, offset, size FROM blob WHERE segment = :segment;");
+            result.blob.relocate = connection.precompile( "UPDATE blob SET segment = :segment, offset = :offset WHERE id = :id;");
+         }
+
+         {
+            Trace trace{ "queue::group::Database::Database precompile statements expired"};
+
+            // uses the (partial) expiry index
+            result.expired.candidates = connection.precompile( 
+               "SELECT m.ROWID, m.queue, q.error FROM message m JOIN queue q ON q.id = m.queue"
+               " WHERE m.expiry > 0 AND m.expiry <= :now AND m.state = 2 LIMIT :limit;");
+
+            result.expired.error = connection.precompile( "UPDATE message SET redelivered = 0, expiry = 0, queue = :error WHERE ROWID = :id;");
+            result.expired.remove = connection.precompile( "DELETE FROM message WHERE ROWID = :id;");
+            result.expired.metric = connection.precompile( "UPDATE queue SET metric_expired = metric_expired + 1 WHERE id = :id;");
+         }
+
          result.restore = connection.precompile(R"( 
             UPDATE message 
             SET queue = :queue 
@@ -258,7 +304,7 @@ WHERE id = :id; )");
 
          result.metric.reset = connection.precompile(R"( 
             UPDATE queue
-            SET metric_dequeued = 0, metric_enqueued = 0
+            SET metric_dequeued = 0, metric_enqueued = 0, metric_expired = 0
             WHERE id = :id; )");
 
          return result;
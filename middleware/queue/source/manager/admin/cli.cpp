@@ -115,6 +115,7 @@ namespace casual
                      terminal::format::column( "id", []( auto& message) { return message.id;}, terminal::color::yellow),
                      terminal::format::column( "S", format_state, terminal::color::no_color),
                      terminal::format::column( "size", []( auto& message) { return message.size;}, terminal::color::cyan, terminal::format::Align::right),
+                     terminal::format::column( "prio", []( auto& message) { return message.priority;}, terminal::color::no_color, terminal::format::Align::right),
                      terminal::format::column( "trid", format_trid, terminal::color::blue, terminal::format::Align::right),
                      terminal::format::column( "rd", []( auto& message) { return message.redelivered;}, terminal::color::no_color, terminal::format::Align::right),
                      terminal::format::column( "type", format_type, terminal::color::no_color),
@@ -177,6 +178,7 @@ namespace casual
                      terminal::format::column( "avg", avg_size, common::terminal::color::white, terminal::format::Align::right),
                      terminal::format::column( "EQ", []( auto& q){ return q.metric.enqueued;}, common::terminal::color::cyan, terminal::format::Align::right),
                      terminal::format::column( "DQ", []( auto& q){ return q.metric.dequeued;}, common::terminal::color::cyan, terminal::format::Align::right),
+                     terminal::format::column( "EX", []( auto& q){ return q.metric.expired;}, common::terminal::color::cyan, terminal::format::Align::right),
                      terminal::format::column( "UC", []( const auto& q){ return q.uncommitted;}, common::terminal::color::magenta, terminal::format::Align::right),
                      terminal::format::column( "last", []( auto& q){ return normalize::timestamp( q.last);}, common::terminal::color::blue)
                   );
@@ -475,6 +477,9 @@ namespace casual
    DQ: 
       dequeued - total number of successfully dequeued messages on the queue (committet), over time. 
       note: this also includes when a message is moved to an error queue if a retry-count is reached.   
+   EX:
+      expired - total number of messages that has expired on the queue, over time.
+      note: expired messages are moved to the error queue, and removed if they expire on the error queue.
    UC:
       number of currently uncommitted messages.
    last:
@@ -491,6 +496,8 @@ namespace casual
          D: dequeued - not visable, removed on commit, back to state 'committed' if rolled back
    size:
       the size of the message
+   prio:
+      the priority of the message, higher priority is dequeued first
    trid:
       transaction trid
    rd:
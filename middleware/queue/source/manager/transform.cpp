@@ -42,6 +42,7 @@ namespace casual
                   result.uncommitted = queue.metric.uncommitted;
                   result.metric.dequeued = queue.metric.dequeued;
                   result.metric.enqueued = queue.metric.enqueued;
+                  result.metric.expired = queue.metric.expired;
                   result.last = queue.metric.last;
                   result.created = queue.created;
                   return result;
@@ -147,6 +148,8 @@ namespace casual
                      result.available = message.available;
                      result.timestamp = message.timestamp;
                      result.size = message.size;
+                     result.priority = message.priority;
+                     result.expiry = message.expiry;
                      return result;
                   });
                   return result;
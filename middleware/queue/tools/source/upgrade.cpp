@@ -90,7 +90,7 @@ INSERT INTO queue
                            connection.statement( "ALTER TABLE message RENAME TO message_v1;");
 
                            // create the new table
-                           connection.statement( group::queuebase::schema::table::message);
+                           connection.statement( group::queuebase::schema::table::v3_0::message);
 
                            // migrate data
                            connection.statement( R"(
@@ -144,8 +144,8 @@ INSERT INTO message
                            // first we rename the current to queue_v2
                            connection.statement( "ALTER TABLE queue RENAME TO queue_v2;");
 
-                           // create the new table
-                           connection.statement( group::queuebase::schema::table::queue);
+                           // create the new table (as it was in 3.0, later columns are added by later versions)
+                           connection.statement( group::queuebase::schema::table::v5_0::queue);
 
                            // migrate data
                            // julianday('now') - 2440587.5) *86400.0 <- some magic that sqlite recommend for fraction of seconds
@@ -174,6 +174,82 @@ INSERT INTO queue
                         }
                         sql::database::version::set( connection, sql::database::Version{ 3, 0});
 
+                        // everythin went ok, we commit.
+                        rollback.release();
+                        connection.commit();
+                     }
+                  },
+                  // from 3.0 to 4.0
+                  {
+                     sql::database::Version{ 4, 0},
+                     []( sql::database::Connection& connection)
+                     {
+                        Trace trace{ "queue::upgrade::local::global::tasks to version 4.0" };
+
+                        connection.exclusive_begin();
+
+                        auto rollback = common::execute::scope( [&connection](){ connection.rollback();});
+
+                        // add message.priority, all existing messages gets the default priority (0). The column
+                        // is added last, and the table is not rewritten.
+                        connection.statement( "ALTER TABLE message ADD COLUMN priority INTEGER NOT NULL DEFAULT 0;");
+
+                        // the dequeue indexes is replaced by the priority aware (created on startup)
+                        connection.statement( group::queuebase::schema::table::v3_0::drop::index::message);
+
+                        sql::database::version::set( connection, sql::database::Version{ 4, 0});
+
+                        // everythin went ok, we commit.
+                        rollback.release();
+                        connection.commit();
+                     }
+                  },
+                  // from 4.0 to 5.0
+                  {
+                     sql::database::Version{ 5, 0},
+                     []( sql::database::Connection& connection)
+                     {
+                        Trace trace{ "queue::upgrade::local::global::tasks to version 5.0" };
+
+                        connection.exclusive_begin();
+
+                        auto rollback = common::execute::scope( [&connection](){ connection.rollback();});
+
+                        // the triggers use message.size instead of the length of the payload (will be created on startup)
+                        connection.statement( group::queuebase::schema::drop::triggers);
+
+                        // add message.size and message.blob, all existing payloads are stored inline.
+                        connection.statement( "ALTER TABLE message ADD COLUMN size INTEGER NOT NULL DEFAULT 0;");
+                        connection.statement( "ALTER TABLE message ADD COLUMN blob INTEGER;");
+                        connection.statement( "UPDATE message SET size = coalesce( length( payload), 0);");
+
+                        // the blob table is created on startup
+                        
+                        sql::database::version::set( connection, sql::database::Version{ 5, 0});
+
+                        // everythin went ok, we commit.
+                        rollback.release();
+                        connection.commit();
+                     }
+                  },
+                  // from 5.0 to 6.0
+                  {
+                     sql::database::Version{ 6, 0},
+                     []( sql::database::Connection& connection)
+                     {
+                        Trace trace{ "queue::upgrade::local::global::tasks to version 6.0" };
+
+                        connection.exclusive_begin();
+
+                        auto rollback = common::execute::scope( [&connection](){ connection.rollback();});
+
+                        // add message.expiry, existing messages never expires, and the expired metric.
+                        // The expiry index is created on startup
+                        connection.statement( "ALTER TABLE message ADD COLUMN expiry INTEGER NOT NULL DEFAULT 0;");
+                        connection.statement( "ALTER TABLE queue ADD COLUMN metric_expired INTEGER NOT NULL DEFAULT 0;");
+
+                        sql::database::version::set( connection, sql::database::Version{ 6, 0});
+
                         // everythin went ok, we commit.
                         rollback.release();
                         connection.commit();
@@ -5,6 +5,7 @@
 //!
 
 #include "common/unittest.h"
+#include "common/unittest/file.h"
 
 #include "queue/group/queuebase.h"
 
@@ -75,6 +76,34 @@ namespace casual
 
             } // peek
 
+            namespace blob
+            {
+               auto settings( const common::unittest::directory::temporary::Scoped& directory)
+               {
+                  queuebase::blob::Settings result;
+                  result.threshold = 100;
+                  result.segment = 1024;
+                  result.directory = directory.path();
+                  return result;
+               }
+
+               auto message( const queuebase::Queue& queue, platform::size::type size, const common::transaction::ID& trid = nullId)
+               {
+                  auto result = local::message( queue, trid);
+                  result.message.payload = common::unittest::random::binary( size);
+                  return result;
+               }
+
+               //! @returns the segment files in the directory
+               auto segments( const common::unittest::directory::temporary::Scoped& directory)
+               {
+                  std::vector< std::filesystem::path> result;
+                  for( auto& entry : std::filesystem::directory_iterator{ directory.path()})
+                     result.push_back( entry.path());
+                  return result;
+               }
+            } // blob
+
             std::optional< ipc::message::group::state::Queue> get_queue( group::Queuebase& queuebase, common::strong::queue::id id)
             {
                auto result = queuebase.queues();
@@ -851,7 +880,343 @@ namespace casual
       }
       
 
-      TEST( casual_queue_group, expect_version_3_0)
+      TEST( casual_queue_group_database, enqueue_different_priorities__expect_highest_priority_first__fifo_within_priority)
+      {
+         common::unittest::Trace trace;
+
+         auto path = local::file();
+         group::Queuebase database( path);
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         std::vector< ipc::message::group::enqueue::Request> messages;
+
+         for( auto priority : { 0, 2, 1, 2, 0, 1})
+         {
+            auto message = local::message( queue);
+            message.message.priority = priority;
+            database.enqueue( message);
+            messages.push_back( std::move( message));
+         }
+
+         auto expected = common::algorithm::stable_sort( messages, []( auto& lhs, auto& rhs){ return lhs.message.priority > rhs.message.priority;});
+
+         for( auto& origin : expected)
+         {
+            auto fetched = database.dequeue( local::request( queue), platform::time::clock::type::now());
+            ASSERT_TRUE( fetched.message.size() == 1);
+            EXPECT_TRUE( origin.message.id == fetched.message.at( 0).id) << CASUAL_NAMED_VALUE( origin);
+            EXPECT_TRUE( origin.message.priority == fetched.message.at( 0).priority);
+         }
+
+         EXPECT_TRUE( database.dequeue( local::request( queue), platform::time::clock::type::now()).message.empty());
+      }
+
+      TEST( casual_queue_group_database, dequeue_message__from_properties__expect_highest_priority_first)
+      {
+         common::unittest::Trace trace;
+
+         auto path = local::file();
+         group::Queuebase database( path);
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         auto enqueue = [&]( std::string properties, platform::size::type priority)
+         {
+            auto message = local::message( queue);
+            message.message.properties = std::move( properties);
+            message.message.priority = priority;
+            database.enqueue( message);
+            return message;
+         };
+
+         enqueue( "a", 0);
+         enqueue( "b", 5);
+         auto high = enqueue( "a", 3);
+         enqueue( "a", 1);
+
+         auto reqest = local::request( queue);
+         reqest.selector.properties = "a";
+         auto fetched = database.dequeue( reqest, platform::time::clock::type::now());
+
+         ASSERT_TRUE( fetched.message.size() == 1);
+         EXPECT_TRUE( high.message.id == fetched.message.at( 0).id);
+         EXPECT_TRUE( fetched.message.at( 0).priority == 3);
+      }
+
+      TEST( casual_queue_group_database, blob__enqueue_large_payload__expect_stored_in_segment__dequeue_same_payload)
+      {
+         common::unittest::Trace trace;
+
+         common::unittest::directory::temporary::Scoped directory;
+         group::Queuebase database( local::file(), local::blob::settings( directory));
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         auto small = local::blob::message( queue, 50);
+         database.enqueue( small);
+         auto large = local::blob::message( queue, 500);
+         database.enqueue( large);
+         database.persist();
+
+         EXPECT_TRUE( local::blob::segments( directory).size() == 1);
+
+         auto info = local::get_queue( database, queue.id).value();
+         EXPECT_TRUE( info.metric.size == 550) << CASUAL_NAMED_VALUE( info);
+
+         auto meta = database.meta( queue.id);
+         ASSERT_TRUE( meta.size() == 2);
+         EXPECT_TRUE( meta.at( 1).size == 500);
+
+         {
+            ipc::message::group::message::peek::Request request{ common::process::handle()};
+            request.ids = { large.message.id};
+            auto peeked = database.peek( request);
+            ASSERT_TRUE( peeked.messages.size() == 1);
+            EXPECT_TRUE( peeked.messages.at( 0).payload == large.message.payload);
+         }
+
+         for( auto& origin : { small, large})
+         {
+            auto fetched = database.dequeue( local::request( queue), platform::time::clock::type::now());
+            ASSERT_TRUE( fetched.message.size() == 1);
+            EXPECT_TRUE( fetched.message.at( 0).id == origin.message.id);
+            EXPECT_TRUE( fetched.message.at( 0).payload == origin.message.payload);
+         }
+
+         info = local::get_queue( database, queue.id).value();
+         EXPECT_TRUE( info.metric.size == 0) << CASUAL_NAMED_VALUE( info);
+      }
+
+      TEST( casual_queue_group_database, blob__same_payload_twice__expect_one_blob)
+      {
+         common::unittest::Trace trace;
+
+         common::unittest::directory::temporary::Scoped directory;
+         group::Queuebase database( local::file(), local::blob::settings( directory));
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         auto first = local::blob::message( queue, 500);
+         database.enqueue( first);
+         auto second = local::message( queue);
+         second.message.payload = first.message.payload;
+         database.enqueue( second);
+         database.persist();
+
+         auto segments = local::blob::segments( directory);
+         ASSERT_TRUE( segments.size() == 1);
+         EXPECT_TRUE( std::filesystem::file_size( segments.at( 0)) == 500);
+
+         for( auto& origin : { first, second})
+         {
+            auto fetched = database.dequeue( local::request( queue), platform::time::clock::type::now());
+            database.persist();
+            ASSERT_TRUE( fetched.message.size() == 1);
+            EXPECT_TRUE( fetched.message.at( 0).id == origin.message.id);
+            EXPECT_TRUE( fetched.message.at( 0).payload == first.message.payload);
+         }
+      }
+
+      TEST( casual_queue_group_database, blob__dequeue_all__persist__expect_sealed_segments_removed)
+      {
+         common::unittest::Trace trace;
+
+         common::unittest::directory::temporary::Scoped directory;
+         group::Queuebase database( local::file(), local::blob::settings( directory));
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         // 600 bytes each, segment is 1024 -> one blob per segment
+         for( auto count = 0; count < 4; ++count)
+            database.enqueue( local::blob::message( queue, 600));
+
+         database.persist();
+         EXPECT_TRUE( local::blob::segments( directory).size() == 4);
+
+         while( ! database.dequeue( local::request( queue), platform::time::clock::type::now()).message.empty())
+            ;
+
+         database.persist();
+
+         // only the active segment is kept
+         EXPECT_TRUE( local::blob::segments( directory).size() == 1) << CASUAL_NAMED_VALUE( local::blob::segments( directory));
+      }
+
+      TEST( casual_queue_group_database, blob__sparse_segment__persist__expect_compacted)
+      {
+         common::unittest::Trace trace;
+
+         common::unittest::directory::temporary::Scoped directory;
+         group::Queuebase database( local::file(), local::blob::settings( directory));
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         // segment 1: 800 + 150 bytes
+         auto large = local::blob::message( queue, 800);
+         database.enqueue( large);
+         auto keep = local::blob::message( queue, 150);
+         database.enqueue( keep);
+
+         // seals segment 1
+         database.enqueue( local::blob::message( queue, 600));
+         database.persist();
+         EXPECT_TRUE( local::blob::segments( directory).size() == 2);
+
+         // remove the large -> segment 1 gets sparse, the 150 bytes is moved to the active segment
+         auto request = local::request( queue);
+         request.selector.id = large.message.id;
+         ASSERT_TRUE( database.dequeue( request, platform::time::clock::type::now()).message.size() == 1);
+         database.persist();
+
+         auto segments = local::blob::segments( directory);
+         ASSERT_TRUE( segments.size() == 1) << CASUAL_NAMED_VALUE( segments);
+         EXPECT_TRUE( std::filesystem::file_size( segments.at( 0)) == 750);
+
+         request.selector.id = keep.message.id;
+         auto fetched = database.dequeue( request, platform::time::clock::type::now());
+         ASSERT_TRUE( fetched.message.size() == 1);
+         EXPECT_TRUE( fetched.message.at( 0).payload == keep.message.payload);
+      }
+
+      TEST( casual_queue_group_database, blob__enqueue_in_transaction_rollback__expect_blob_unreferenced)
+      {
+         common::unittest::Trace trace;
+
+         common::unittest::directory::temporary::Scoped directory;
+         group::Queuebase database( local::file(), local::blob::settings( directory));
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         auto xid = common::transaction::id::create();
+         database.enqueue( local::blob::message( queue, 600, xid));
+         database.rollback( xid);
+         database.persist();
+
+         // seals the first segment, with no live blobs
+         database.enqueue( local::blob::message( queue, 600));
+         database.persist();
+
+         EXPECT_TRUE( local::blob::segments( directory).size() == 1) << CASUAL_NAMED_VALUE( local::blob::segments( directory));
+      }
+
+      TEST( casual_queue_group_database, blob__dequeue_rollback__moved_to_error_queue__expect_same_payload)
+      {
+         common::unittest::Trace trace;
+
+         common::unittest::directory::temporary::Scoped directory;
+         group::Queuebase database( local::file(), local::blob::settings( directory));
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         auto origin = local::blob::message( queue, 600);
+         database.enqueue( origin);
+
+         {
+            auto xid = common::transaction::id::create();
+            ASSERT_TRUE( database.dequeue( local::request( queue, xid), platform::time::clock::type::now()).message.size() == 1);
+            database.rollback( xid);
+            database.persist();
+         }
+
+         auto error = local::get_queue( database, queue.error).value();
+         EXPECT_TRUE( error.metric.count == 1);
+         EXPECT_TRUE( error.metric.size == 600);
+
+         auto fetched = database.dequeue( local::request( error), platform::time::clock::type::now());
+         ASSERT_TRUE( fetched.message.size() == 1);
+         EXPECT_TRUE( fetched.message.at( 0).payload == origin.message.payload);
+      }
+
+      TEST( casual_queue_group_database, expired_message__expect_not_dequeued)
+      {
+         common::unittest::Trace trace;
+
+         auto path = local::file();
+         group::Queuebase database( path);
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         // the queuebase has microsecond resolution
+         auto now = std::chrono::time_point_cast< std::chrono::microseconds>( platform::time::clock::type::now());
+
+         auto expired = local::message( queue);
+         expired.message.expiry = now - std::chrono::seconds{ 1};
+         database.enqueue( expired);
+
+         auto alive = local::message( queue);
+         alive.message.expiry = now + std::chrono::hours{ 1};
+         database.enqueue( alive);
+
+         auto fetched = database.dequeue( local::request( queue), platform::time::clock::type::now());
+         ASSERT_TRUE( fetched.message.size() == 1);
+         EXPECT_TRUE( fetched.message.at( 0).id == alive.message.id);
+         EXPECT_TRUE( fetched.message.at( 0).expiry == alive.message.expiry);
+
+         EXPECT_TRUE( database.dequeue( local::request( queue), platform::time::clock::type::now()).message.empty());
+
+         // dequeue by id does not find it either
+         auto request = local::request( queue);
+         request.selector.id = expired.message.id;
+         EXPECT_TRUE( database.dequeue( request, platform::time::clock::type::now()).message.empty());
+      }
+
+      TEST( casual_queue_group_database, expired_messages__expire__expect_moved_to_error_queue__and_metric)
+      {
+         common::unittest::Trace trace;
+
+         auto path = local::file();
+         group::Queuebase database( path);
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         auto now = platform::time::clock::type::now();
+
+         common::algorithm::for_n< 3>( [&]()
+         {
+            auto message = local::message( queue);
+            message.message.expiry = now - std::chrono::seconds{ 1};
+            database.enqueue( message);
+         });
+
+         // not expired
+         database.enqueue( local::message( queue));
+
+         // bounded
+         EXPECT_TRUE( database.expire( now, 2) == 2);
+         EXPECT_TRUE( database.expire( now, 2) == 1);
+         EXPECT_TRUE( database.expire( now, 2) == 0);
+         database.persist();
+
+         auto info = local::get_queue( database, queue.id).value();
+         EXPECT_TRUE( info.metric.count == 1) << CASUAL_NAMED_VALUE( info);
+         EXPECT_TRUE( info.metric.expired == 3) << CASUAL_NAMED_VALUE( info);
+
+         auto error = local::get_queue( database, queue.error).value();
+         EXPECT_TRUE( error.metric.count == 3) << CASUAL_NAMED_VALUE( error);
+
+         // moved messages does not expire again on the error queue
+         auto fetched = database.dequeue( local::request( error), platform::time::clock::type::now());
+         ASSERT_TRUE( fetched.message.size() == 1);
+         EXPECT_TRUE( fetched.message.at( 0).expiry == platform::time::point::type{});
+
+         database.metric_reset( { queue.id});
+         EXPECT_TRUE( local::get_queue( database, queue.id).value().metric.expired == 0);
+      }
+
+      TEST( casual_queue_group_database, expired_message_on_error_queue__expire__expect_removed)
+      {
+         common::unittest::Trace trace;
+
+         auto path = local::file();
+         group::Queuebase database( path);
+         auto queue = database.create( queuebase::Queue{ "unittest_queue"});
+
+         auto now = platform::time::clock::type::now();
+
+         auto message = local::message( queue);
+         message.queue = queue.error;
+         message.message.expiry = now - std::chrono::seconds{ 1};
+         database.enqueue( message);
+
+         EXPECT_TRUE( database.expire( now, 10) == 1);
+
+         auto error = local::get_queue( database, queue.error).value();
+         EXPECT_TRUE( error.metric.count == 0) << CASUAL_NAMED_VALUE( error);
+         EXPECT_TRUE( error.metric.expired == 1) << CASUAL_NAMED_VALUE( error);
+      }
+
+      TEST( casual_queue_group, expect_version_6_0)
       {
          common::unittest::Trace trace;
 
@@ -860,7 +1225,7 @@ namespace casual
 
          auto version = database.version();
 
-         EXPECT_TRUE( version.major == 3);
+         EXPECT_TRUE( version.major == 6);
          EXPECT_TRUE( version.minor == 0);
       }
 
@@ -17,6 +17,7 @@
 #include "common/message/domain.h"
 #include "common/message/service.h"
 #include "common/signal/timer.h"
+#include "common/environment.h"
 
 #include "common/transaction/context.h"
 #include "common/transaction/resource.h"
@@ -631,5 +632,79 @@ domain:
          }
       }
 
+      TEST( casual_queue_forward, benchmark__queue_forward_1000_messages__prefetch_1_vs_default)
+      {
+         common::unittest::Trace trace;
+
+         static constexpr auto configuration = R"(
+domain: 
+   name: forward-domain
+
+   queue:
+      groups:
+         - name: a
+           queuebase: ":memory:"
+           queues:
+            - name: a1
+            - name: a2
+
+      forward:
+         default:
+            queue:
+               instances: 0
+         groups:
+            -  alias: forward-group-1
+               queues:
+                  -  source: a1
+                     target:
+                        queue: a2
+)";
+
+         constexpr platform::size::type count = 1000;
+
+         // @returns forwarded messages per second
+         auto forward = []( std::string prefetch)
+         {
+            common::environment::variable::set( environment::variable::name::queue::forward::prefetch, prefetch);
+            auto unset = common::execute::scope( [](){ common::environment::variable::unset( environment::variable::name::queue::forward::prefetch);});
+
+            auto domain = local::domain( configuration);
+
+            {
+               queue::Message message;
+               message.payload.type = common::buffer::type::binary();
+               message.payload.data = common::unittest::random::binary( 128);
+
+               common::algorithm::for_n< count>( [&message]()
+               {
+                  queue::enqueue( "a1", message);
+               });
+            }
+
+            auto start = platform::time::clock::type::now();
+
+            local::scale_all_forward_aliases( 4);
+
+            auto state = local::call::state();
+
+            while( state.forward.queues.at( 0).metric.commit.count < count)
+            {
+               common::process::sleep( std::chrono::milliseconds{ 1});
+               state = local::call::state();
+            }
+
+            auto duration = std::chrono::duration_cast< std::chrono::duration< double>>( platform::time::clock::type::now() - start);
+
+            EXPECT_TRUE( state.forward.queues.at( 0).metric.rollback.count == 0);
+
+            return count / duration.count();
+         };
+
+         auto single = forward( "1");
+         auto prefetch = forward( std::to_string( platform::batch::queue::forward::prefetch));
+
+         log::line( log::category::information, "forwarded messages/s - prefetch 1: ", single, " - prefetch ", platform::batch::queue::forward::prefetch, ": ", prefetch);
+      }
+
    } // queue
 } // casual
\ No newline at end of file
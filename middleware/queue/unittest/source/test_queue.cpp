@@ -710,6 +710,29 @@ domain:
          EXPECT_TRUE( local::call::messages( "a1").empty());
       }
 
+      TEST( casual_queue, enqueue_1_message_expiry_10ms__idle_group__expect_purged_to_error_queue)
+      {
+         common::unittest::Trace trace;
+
+         auto domain = local::domain();
+
+         const std::string payload{ "some message"};
+         queue::Message message;
+         message.payload.type = common::buffer::type::binary();
+         message.payload.data.assign( std::begin( payload), std::end( payload));
+         message.attributes.expiry = platform::time::clock::type::now() + std::chrono::milliseconds{ 10};
+
+         queue::enqueue( "a1", message);
+
+         // the group is idle, the purge is driven by the expire timer
+         auto count = 50;
+         while( ! local::call::messages( "a1").empty() && count-- > 0)
+            common::process::sleep( std::chrono::milliseconds{ 100});
+
+         EXPECT_TRUE( local::call::messages( "a1").empty());
+         EXPECT_TRUE( local::call::messages( "a1.error").size() == 1);
+      }
+
       TEST( casual_queue, enqueue_5___clear_queue___expect_0_message_in_queue)
       {
          common::unittest::Trace trace;
@@ -21,6 +21,13 @@ namespace casual
             {
                //! internal casual api 
                model::State state();
+
+               namespace delta
+               {
+                  //! applies the `delta`, from a state event, to `state`
+                  //! @returns the version of the state
+                  platform::size::type apply( model::State& state, model::delta::State&& delta);
+               } // delta
                   
             } // api
          } // admin
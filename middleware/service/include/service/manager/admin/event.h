@@ -0,0 +1,36 @@
+//! 
+//! Copyright (c) 2015, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+
+#pragma once
+
+#include "service/manager/admin/model.h"
+
+#include "common/message/type.h"
+
+namespace casual
+{
+   namespace service::manager::admin::event
+   {
+      using base_state = common::message::basic_request< common::message::Type::event_service_state>;
+
+      //! Pushed by the service-manager to the subscribers of `common::message::Type::event_service_state`.
+      //! The first event after the subscription is a snapshot, then each event has the changes
+      //! since the previous event.
+      struct State : base_state
+      {
+         using base_state::base_state;
+
+         model::delta::State delta;
+
+         CASUAL_CONST_CORRECT_SERIALIZE(
+            base_state::serialize( archive);
+            CASUAL_SERIALIZE( delta);
+         )
+      };
+
+   } // service::manager::admin::event
+} // casual
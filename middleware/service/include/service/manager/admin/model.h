@@ -203,6 +203,44 @@ namespace casual
          )
       };
 
+      namespace outbound
+      {
+         //! a caller that has had replies queued, since it was not able to receive
+         struct Destination
+         {
+            common::strong::ipc::id ipc;
+
+            struct
+            {
+               //! current number of queued replies
+               platform::size::type count{};
+               //! current queued bytes
+               platform::size::type size{};
+               //! the most bytes that has been queued
+               platform::size::type high{};
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( count);
+                  CASUAL_SERIALIZE( size);
+                  CASUAL_SERIALIZE( high);
+               )
+            } queue;
+
+            //! number of replies discarded due to overflow
+            platform::size::type shed{};
+
+            //! the durations the caller has had queued replies
+            Metric stall;
+
+            CASUAL_CONST_CORRECT_SERIALIZE(
+               CASUAL_SERIALIZE( ipc);
+               CASUAL_SERIALIZE( queue);
+               CASUAL_SERIALIZE( shed);
+               CASUAL_SERIALIZE( stall);
+            )
+         };
+      } // outbound
+
       struct State
       {
          struct
@@ -221,14 +259,68 @@ namespace casual
          std::vector< Service> services;
          std::vector< Pending> pending;
          std::vector< Route> routes;
+         std::vector< outbound::Destination> outbound;
 
          CASUAL_CONST_CORRECT_SERIALIZE(
             CASUAL_SERIALIZE( instances);
             CASUAL_SERIALIZE( services);
             CASUAL_SERIALIZE( pending);
             CASUAL_SERIALIZE( routes);
+            CASUAL_SERIALIZE( outbound);
          )
       };
+
+      namespace delta
+      {
+         //! entities that are added or changed since the requested version, and the keys of the removed
+         template< typename T, typename K>
+         struct Entities
+         {
+            std::vector< T> changed;
+            std::vector< K> removed;
+
+            CASUAL_CONST_CORRECT_SERIALIZE(
+               CASUAL_SERIALIZE( changed);
+               CASUAL_SERIALIZE( removed);
+            )
+         };
+
+         //! the changes of the state since the previous version
+         struct State
+         {
+            //! the version of the state, when the delta is applied. Each delta has the version 
+            //! of the previous + 1, a gap means that the caller has missed changes.
+            platform::size::type version{};
+
+            //! if true, the caller should discard what it got and replace it with this, 
+            //! all entities are in `changed`
+            bool snapshot = false;
+
+            struct
+            {
+               Entities< instance::Sequential, common::strong::process::id> sequential;
+               Entities< instance::Concurrent, common::strong::process::id> concurrent;
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( sequential);
+                  CASUAL_SERIALIZE( concurrent);
+               )
+            } instances;
+
+            Entities< Service, std::string> services;
+
+            //! routes only changes with the configuration, hence only in snapshots
+            std::vector< Route> routes;
+
+            CASUAL_CONST_CORRECT_SERIALIZE(
+               CASUAL_SERIALIZE( version);
+               CASUAL_SERIALIZE( snapshot);
+               CASUAL_SERIALIZE( instances);
+               CASUAL_SERIALIZE( services);
+               CASUAL_SERIALIZE( routes);
+            )
+         };
+      } // delta
    
       } // inline namespace v1
 
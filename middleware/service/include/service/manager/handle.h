@@ -50,6 +50,19 @@ namespace casual
             
          } // metric
 
+         namespace changes
+         {
+            //! pushes the recorded changes to the subscribers of the state event, if any
+            void send( State& state);
+
+            namespace batch
+            {
+               //! pushes the changes if we've reach batch-limit
+               void send( State& state);
+            } // batch
+
+         } // changes
+
          namespace process
          {
             void exit( const common::process::lifetime::Exit& exit);   
@@ -12,18 +12,26 @@
 #include "common/metric.h"
 #include "common/server/service.h"
 #include "common/communication/ipc.h"
+#include "common/communication/ipc/send.h"
 #include "common/event/dispatch.h"
 #include "common/state/machine.h"
 #include "common/message/coordinate.h"
+#include "common/timer/wheel.h"
+#include "common/timer/descriptor.h"
+
+#include "service/manager/admin/event.h"
 
 #include "configuration/model.h"
 
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 #include <list>
 #include <deque>
+#include <array>
+#include <optional>
 
 namespace casual
 {
@@ -167,6 +175,103 @@ namespace casual
                   )
                };
 
+               namespace lookup
+               {
+                  using Priority = common::message::service::lookup::Request::Priority;
+
+                  //! the relative share of the dispatches each priority class gets, when
+                  //! lookups of all classes are pending for a service.
+                  constexpr std::array< platform::size::type, 3> weights{ 8, 4, 1};
+                  
+               } // lookup
+
+               //! Holds pending lookups, indexed per requested service and correlation.
+               //!
+               //! For each service, the priority classes are served weighted-fair (stride scheduling,
+               //! by `lookup::weights`), and within a class earliest-deadline-first. Lookups without
+               //! deadline are served in arrival order, after the ones with deadline.
+               struct Lookups
+               {
+                  void push( Lookup lookup);
+
+                  //! @returns the pending lookup with `correlation`, if any.
+                  std::optional< Lookup> extract( const common::strong::correlation::id& correlation);
+
+                  //! @returns the next lookup to dispatch, for any of the services that fulfill `predicate`, if any.
+                  //!   Between services, the lookup with the highest priority class, and then the 
+                  //!   earliest deadline, is choosen.
+                  std::optional< Lookup> next( common::function< bool( const std::string&) const> predicate);
+
+                  //! @returns all pending lookups for `services`
+                  std::vector< Lookup> extract( const std::vector< std::string>& services);
+
+                  //! @returns all pending lookups for services that fulfill `predicate`
+                  std::vector< Lookup> extract_if( common::function< bool( const std::string&) const> predicate);
+
+                  //! @returns the number of lookups for `service` that will be dispatched before a new 
+                  //!   lookup with `priority` and `deadline`. 
+                  platform::size::type ahead( const std::string& service, lookup::Priority priority, const std::optional< platform::time::point::type>& deadline) const;
+
+                  //! @returns the services that has pending lookups
+                  std::vector< std::string> services() const;
+
+                  //! @returns all pending lookups, in no particular order
+                  std::vector< std::reference_wrapper< const Lookup>> all() const;
+
+                  inline platform::size::type size() const noexcept { return m_correlations.size();}
+                  inline bool empty() const noexcept { return m_correlations.empty();}
+
+                  CASUAL_LOG_SERIALIZE( 
+                     CASUAL_SERIALIZE_NAME( size(), "size");
+                     CASUAL_SERIALIZE_NAME( services(), "services");
+                  )
+
+               private:
+
+                  struct Key
+                  {
+                     platform::time::point::type deadline;
+                     platform::time::point::type when;
+                     platform::size::type sequence;
+
+                     inline friend bool operator < ( const Key& lhs, const Key& rhs) 
+                     { 
+                        return std::tie( lhs.deadline, lhs.when, lhs.sequence) < std::tie( rhs.deadline, rhs.when, rhs.sequence);
+                     }
+                  };
+
+                  struct Class
+                  {
+                     std::map< Key, Lookup> lookups;
+                     //! the 'virtual time' of the class, advanced with the stride of the class for each dispatch
+                     platform::size::type pass = 0;
+                  };
+
+                  struct Queue
+                  {
+                     std::array< Class, lookup::weights.size()> classes;
+                     //! the pass of the last dispatch, a class that becomes active starts from here.
+                     platform::size::type pass = 0;
+                     platform::size::type size = 0;
+
+                     //! @returns the class that is next to dispatch, nullptr if empty
+                     const Class* next() const;
+                  };
+
+                  struct Location
+                  {
+                     std::string service;
+                     lookup::Priority priority;
+                     Key key;
+                  };
+
+                  Lookup extract( std::unordered_map< std::string, Queue>::iterator queue, Class& type, std::map< Key, Lookup>::iterator position);
+
+                  std::unordered_map< std::string, Queue> m_queues;
+                  std::unordered_map< common::strong::correlation::id, Location> m_correlations;
+                  platform::size::type m_sequence = 0;
+               };
+
                namespace deadline
                {
                   struct Entry
@@ -189,31 +294,33 @@ namespace casual
                   
                } // deadline
 
+               //! Holds the deadlines for pending calls. The deadlines are held in a timing wheel,
+               //! and the next expiration is signaled via `descriptor()`, which is multiplexed
+               //! in the dispatch loop.
                struct Deadline
                {      
-                  std::optional< platform::time::point::type> add( deadline::Entry entry);
-                  std::optional< platform::time::point::type> remove( const common::strong::correlation::id& correlation);
-                  std::optional< platform::time::point::type> remove( const std::vector< common::strong::correlation::id>& correlations);
+                  void add( deadline::Entry entry);
+                  void remove( const common::strong::correlation::id& correlation);
+                  void remove( const std::vector< common::strong::correlation::id>& correlations);
 
-                  struct Expired
-                  {
-                     std::vector< deadline::Entry> entries;
-                     std::optional< platform::time::point::type> deadline;
-
-                     CASUAL_LOG_SERIALIZE(
-                        CASUAL_SERIALIZE( entries);
-                        CASUAL_SERIALIZE( deadline);
-                     )
-                  };
+                  //! consumes the timer expiration and extracts the expired entries.
+                  std::vector< deadline::Entry> expired( platform::time::point::type now = platform::time::point::type::clock::now());
 
-                  Expired expired( platform::time::point::type now = platform::time::point::type::clock::now());
+                  inline auto descriptor() const noexcept { return m_timer.descriptor();}
+                  inline platform::size::type size() const noexcept { return m_wheel.size();}
 
                   CASUAL_LOG_SERIALIZE( 
-                     CASUAL_SERIALIZE_NAME( m_entries, "entries");
+                     CASUAL_SERIALIZE_NAME( m_wheel, "wheel");
+                     CASUAL_SERIALIZE_NAME( m_timer, "timer");
                   )
                   
                private:
-                  std::vector< deadline::Entry> m_entries;
+                  //! makes sure the timer is armed at the latest when the wheel needs to advance
+                  void arm();
+
+                  common::timer::Wheel< deadline::Entry> m_wheel;
+                  std::unordered_map< common::strong::correlation::id, common::timer::wheel::id> m_correlations;
+                  common::timer::Descriptor m_timer;
                };
             } // pending
 
@@ -358,6 +465,39 @@ namespace casual
             )
          };
 
+         //! The entities that has changed since the previous state event was pushed to 
+         //! the subscribers. Only recorded while there are subscribers.
+         struct Changes
+         {
+            //! the keys in `State::services`
+            std::unordered_set< std::string> services;
+            std::unordered_set< common::strong::process::id> instances;
+
+            //! the state has changed in ways that are not tracked per entity (configuration),
+            //! the subscribers gets a snapshot
+            bool snapshot = false;
+
+            //! the version of the previous state event
+            platform::size::type version{};
+
+            inline platform::size::type size() const noexcept { return services.size() + instances.size();}
+            inline explicit operator bool() const noexcept { return snapshot || size() > 0;}
+
+            inline void clear() 
+            { 
+               services.clear();
+               instances.clear();
+               snapshot = false;
+            }
+
+            CASUAL_LOG_SERIALIZE(
+               CASUAL_SERIALIZE( services);
+               CASUAL_SERIALIZE( instances);
+               CASUAL_SERIALIZE( snapshot);
+               CASUAL_SERIALIZE( version);
+            )
+         };
+
          enum struct Runlevel : short
          {
             running,
@@ -395,7 +535,7 @@ namespace casual
          struct
          {
             state::service::pending::Deadline deadline;
-            std::deque< state::service::pending::Lookup> lookups;
+            state::service::pending::Lookups lookups;
             common::message::coordinate::fan::Out< common::message::service::call::ACK, common::strong::process::id> shutdown;
             
             CASUAL_LOG_SERIALIZE(
@@ -405,7 +545,10 @@ namespace casual
             )
          } pending;
 
-         common::event::dispatch::Collection< common::message::event::service::Calls> events;  
+         //! replies to callers, queued while the caller is not able to receive
+         common::communication::ipc::send::Coordinator multiplex;
+
+         common::event::dispatch::Collection< common::message::event::service::Calls, admin::event::State> events;  
 
          struct Metric 
          {
@@ -428,6 +571,8 @@ namespace casual
             common::message::event::service::Calls m_message;
          } metric; 
 
+         state::Changes changes;
+
          common::Process forward;
 
          casual::configuration::model::service::Timeout timeout;
@@ -484,12 +629,22 @@ namespace casual
 
          void connect_manager( std::vector< common::server::Service> services);
 
+         //! records that the entity has changed, if there are subscribers to the state events
+         //! @{
+         void changed( const std::string& service);
+         void changed( common::strong::process::id instance);
+         //! @}
+
+         //! records that the services `instance` is associated with has changed
+         void changed_services( common::strong::process::id instance);
+
          CASUAL_LOG_SERIALIZE(
             CASUAL_SERIALIZE( runlevel);
             CASUAL_SERIALIZE( services);
             CASUAL_SERIALIZE( pending);
             CASUAL_SERIALIZE( events);
             CASUAL_SERIALIZE( metric);
+            CASUAL_SERIALIZE( changes);
             CASUAL_SERIALIZE( forward);
             CASUAL_SERIALIZE( timeout);
             CASUAL_SERIALIZE( routes);
@@ -21,6 +21,12 @@ namespace casual
 
       manager::admin::model::State state( const manager::State& state);
 
+      //! @returns the entities in `changes` as they are now, and the ones that are gone as removed
+      manager::admin::model::delta::State delta( const manager::State& state, const manager::state::Changes& changes);
+
+      //! @returns the complete state, as a delta snapshot
+      manager::admin::model::delta::State snapshot( const manager::State& state);
+
       casual::configuration::model::service::Model configuration( const manager::State& state);
 
    } // service::manager::transform
@@ -90,6 +90,13 @@ namespace casual
                            return;
                         }
 
+                        if( message.state == decltype( message.state)::rejected)
+                        {
+                           log::line( log, "service '", message.service.name, "' projected wait exceeds deadline - action: send error reply");
+                           send::error::reply( state, request, common::code::xatmi::no_message);
+                           return;
+                        }
+
                         log::line( log, "send request - to: ", message.process, " - request: ", request);
 
                         if( ! communication::ipc::flush::optional::send( message.process.ipc, request))
@@ -48,6 +48,11 @@ namespace casual
 
                auto handler = handle::create( state);
 
+               // lookup replies releases pending calls, consume them before new requests
+               communication::ipc::inbound::device().priorities( { 
+                  common::message::Type::shutdown_request,
+                  common::message::Type::service_name_lookup_reply});
+
                message::dispatch::pump( 
                   local::condition( state),
                   handler, 
@@ -11,6 +11,11 @@
 
 #include "serviceframework/service/protocol/call.h"
 
+#include "common/algorithm.h"
+#include "common/algorithm/container.h"
+
+#include <set>
+
 namespace casual
 {
    namespace service
@@ -35,6 +40,48 @@ namespace casual
                   return result;
                }
 
+               namespace delta
+               {
+                  namespace local
+                  {
+                     namespace
+                     {
+                        template< typename T, typename K, typename P>
+                        void apply( std::vector< T>& entities, model::delta::Entities< T, K>&& delta, P key)
+                        {
+                           // the changed replaces what we got
+                           std::set< K> keys{ std::begin( delta.removed), std::end( delta.removed)};
+                           for( auto& changed : delta.changed)
+                              keys.insert( key( changed));
+
+                           common::algorithm::container::erase_if( entities, [&]( auto& entity){ return keys.count( key( entity)) > 0;});
+
+                           common::algorithm::move( delta.changed, std::back_inserter( entities));
+                        }
+
+                        constexpr auto pid = []( auto& instance){ return instance.process.pid;};
+                        constexpr auto name = []( auto& service) -> const std::string& { return service.name;};
+
+                     } // <unnamed>
+                  } // local
+
+                  platform::size::type apply( model::State& state, model::delta::State&& delta)
+                  {
+                     if( delta.snapshot)
+                     {
+                        state = model::State{};
+                        state.routes = std::move( delta.routes);
+                     }
+
+                     local::apply( state.instances.sequential, std::move( delta.instances.sequential), local::pid);
+                     local::apply( state.instances.concurrent, std::move( delta.instances.concurrent), local::pid);
+                     local::apply( state.services, std::move( delta.services), local::name);
+
+                     return delta.version;
+                  }
+
+               } // delta
+
             } // api
          } // admin
       } // manager  
@@ -9,6 +9,7 @@
 #include "service/manager/admin/model.h"
 #include "service/manager/admin/server.h"
 #include "service/manager/admin/api.h"
+#include "service/manager/admin/event.h"
 
 #include "domain/manager/admin/model.h"
 #include "domain/manager/admin/server.h"
@@ -17,6 +18,7 @@
 #include "common/chronology.h"
 #include "common/terminal.h"
 #include "common/server/service.h"
+#include "common/event/listen.h"
 #include "common/exception/handle.h"
 #include "common/algorithm/compare.h"
 #include "common/serialize/macro.h"
@@ -614,6 +616,63 @@ namespace casual
                   } // list
 
 
+                  namespace watch
+                  {
+                     void invoke()
+                     {
+                        admin::model::State state;
+                        platform::size::type version{};
+                        bool synchronized = false;
+
+                        auto handler = [&]( admin::event::State& event)
+                        {
+                           if( ! event.delta.snapshot && ( ! synchronized || event.delta.version != version + 1))
+                           {
+                              // we've lost changes, we subscribe again to get a new snapshot, and ignore 
+                              // the changes until we get it.
+                              if( synchronized)
+                                 common::event::subscribe( process::handle(), { admin::event::State::type()});
+
+                              synchronized = false;
+                              return;
+                           }
+
+                           auto snapshot = event.delta.snapshot;
+
+                           admin::model::State changed;
+                           changed.services = event.delta.services.changed;
+                           auto removed = event.delta.services.removed;
+
+                           version = admin::api::delta::apply( state, std::move( event.delta));
+                           synchronized = true;
+
+                           if( snapshot)
+                              print::services( std::cout, state, print::Service::user);
+                           else 
+                           {
+                              if( ! changed.services.empty())
+                                 print::services( std::cout, changed, print::Service::user);
+
+                              for( auto& name : removed)
+                                 std::cout << name << " - removed\n";
+                           }
+                        };
+
+                        common::event::listen( 
+                           common::event::condition::compose( common::event::condition::idle( []()
+                           {
+                              std::cout << std::flush;
+                           })),
+                           std::move( handler));
+                     }
+
+                     constexpr auto description = R"(lists services, and then the services that changes, as they change
+
+The service-manager pushes what has changed to the subscribers of the state, hence it's cheap 
+to watch domains with a lot of services. Use Ctrl-C to stop watching.)";
+
+                  } // watch
+
                   void list_admin_services()
                   {
                      auto state = admin::api::state();
@@ -665,6 +724,7 @@ namespace casual
                      const std::map< std::string, const char*> legends{
                         { "list-service", action::list::services::legend},
                         { "list-admin-services", action::list::services::legend},
+                        { "watch", action::list::services::legend},
                      };
                
                      void invoke( const std::string& option)
@@ -761,6 +821,10 @@ note: not all options has legend, use 'auto complete' to find out which legends
                            { "service.manager.service.metric.pending.count", string::compose( pending_count( services))},
                            { "service.manager.service.metric.pending.total", string::compose( pending_total( services))},
                            { "service.manager.service.metric.pending.everage", string::compose( average( pending_total( services), pending_count( services)))},
+                           { "service.manager.outbound.queue.count", string::compose( accumulate( []( auto& destination){ return destination.queue.count;})( state.outbound))},
+                           { "service.manager.outbound.shed", string::compose( accumulate( []( auto& destination){ return destination.shed;})( state.outbound))},
+                           { "service.manager.outbound.stall.count", string::compose( accumulate( []( auto& destination){ return destination.stall.count;})( state.outbound))},
+                           { "service.manager.outbound.stall.total", string::compose( second_t{ accumulate( []( auto& destination){ return destination.stall.total;})( state.outbound)})},
                         };
                      }
 
@@ -787,6 +851,7 @@ note: not all options has legend, use 'auto complete' to find out which legends
                   };
                   return common::argument::Group{ [](){}, { "service"}, "service related administration",
                      common::argument::Option{ &local::action::list::services::invoke , { "-ls", "--list-services"}, local::action::list::services::description},
+                     common::argument::Option{ &local::action::watch::invoke, { "--watch"}, local::action::watch::description},
                      common::argument::Option{ &local::action::list_instances,  { "-li", "--list-instances"}, "list instances"},
                      common::argument::Option{ &local::action::routes::list, { "--list-routes"}, local::action::routes::description},
                      common::argument::Option{ &local::action::metric::reset, local::action::services_completer,  { "-mr", "--metric-reset"}, "reset metrics for provided services, if no services provided, all metrics will be reset"},
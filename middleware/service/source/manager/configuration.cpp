@@ -213,6 +213,8 @@ namespace casual
          local::restrictions( state, std::move( current.restrictions), std::move( wanted.restrictions));
          local::services( state, std::move( current.services), std::move( wanted.services));
 
+         // services and routes can be changed in all kinds of ways, subscribers gets a snapshot
+         state.changes.snapshot = true;
       }
    } // service::manager::configuration 
 } // casual
\ No newline at end of file
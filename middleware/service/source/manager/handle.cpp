@@ -57,45 +57,18 @@ namespace casual
             {
                namespace optional
                {
-                  template< typename D, typename M>
-                  auto send( D&& device, M&& message)
+                  //! sends or queues the message, we never block on a caller that is not able to receive
+                  template< typename M>
+                  auto send( State& state, const strong::ipc::id& destination, M&& message)
                   {
                      log::line( verbose::log, "send message: ", message);
-                     return communication::device::blocking::optional::send( device, message);
+                     return communication::ipc::send::optional::send( state.multiplex, destination, message);
                   }
                } // optional
 
-               namespace eventually
-               {
-                  template<  typename M>
-                  bool send( const common::process::Handle& destination, M&& message)
-                  {
-                     Trace trace{ "service::manager::handle::local::eventually::send"};
-                     log::line( verbose::log, "message: ", message);
-
-                     try
-                     {
-                        if( ! communication::device::non::blocking::send( destination.ipc, message))
-                           casual::domain::pending::message::send( destination, std::forward< M>( message));
-
-                        return true;
-                     }
-                     catch( ...)
-                     {
-                        auto error = exception::capture();
-                        if( error.code() != code::casual::communication_unavailable)
-                           throw;
-                           
-                        log::line( log, error, " destination unavailable - ", destination);
-                        return false;
-                     }
-
-                  }
-               } // eventually
-
                namespace error
                {
-                  auto reply( const state::instance::Caller& caller, common::code::xatmi code)
+                  auto reply( State& state, const state::instance::Caller& caller, common::code::xatmi code)
                   {
                      Trace trace{ "service::manager::handle::local::error::reply"};
                      log::line( verbose::log, "caller: ", caller, ", code: ", code);
@@ -104,7 +77,7 @@ namespace casual
                      message.correlation = caller.correlation;
                      message.code.result = code; 
 
-                     handle::local::eventually::send( caller.process, std::move( message));
+                     optional::send( state, caller.process.ipc, message);
                   }
                } // error
 
@@ -182,16 +155,14 @@ namespace casual
          {
             Trace trace{ "service::manager::handle::timeout"};
 
-            const auto now = platform::time::clock::type::now();
-
-            auto expired = state.pending.deadline.expired( now);
+            auto expired = state.pending.deadline.expired();
             log::line( verbose::log, "expired: ", expired);
 
-            auto send_error_reply = []( auto& entry)
+            auto send_error_reply = [ &state]( auto& entry)
             {
                if( auto caller = entry.service->consume( entry.correlation))
                {
-                  local::error::reply( caller, common::code::xatmi::timeout);
+                  local::error::reply( state, caller, common::code::xatmi::timeout);
 
                   // send event, at least domain-manager want's to know...
                   common::message::event::process::Assassination event{ common::process::handle()};
@@ -201,10 +172,7 @@ namespace casual
                }
             };
 
-            algorithm::for_each( expired.entries, send_error_reply);
-
-            if( expired.deadline)
-               signal::timer::set( expired.deadline.value() - now);
+            algorithm::for_each( expired, send_error_reply);
          }
 
          namespace metric
@@ -225,6 +193,44 @@ namespace casual
             } // batch
          } // metric
 
+         namespace changes
+         {
+            void send( State& state)
+            {
+               if( ! state.changes)
+                  return;
+
+               // the subscribers might be gone
+               if( ! state.events.active< admin::event::State>())
+               {
+                  state.changes.clear();
+                  return;
+               }
+
+               Trace trace{ "service::manager::handle::changes::send"};
+               log::line( verbose::log, "changes: ", state.changes);
+
+               admin::event::State event{ common::process::handle()};
+               event.delta = state.changes.snapshot ? transform::snapshot( state) : transform::delta( state, state.changes);
+               event.delta.version = ++state.changes.version;
+               state.changes.clear();
+
+               auto pending = state.events( event);
+
+               if( ! common::message::pending::non::blocking::send( pending))
+                  casual::domain::pending::message::send( pending);
+            }
+
+            namespace batch
+            {
+               void send( State& state)
+               {
+                  if( state.changes.size() >= platform::batch::service::changes)
+                     changes::send( state);
+               }
+            } // batch
+         } // changes
+
          namespace process
          {
             void exit( const common::process::lifetime::Exit& exit)
@@ -265,7 +271,7 @@ namespace casual
 
                                  log::line( common::log::category::verbose::error, "instance: ", instance);
 
-                                 local::error::reply( instance.caller(), common::code::xatmi::service_error);
+                                 local::error::reply( state, instance.caller(), common::code::xatmi::service_error);
                               }
                            }
 
@@ -285,6 +291,16 @@ namespace casual
                            log::line( verbose::log, "message: ", message);
 
                            state.events.subscription( message);
+
+                           // a subscriber to the state gets a snapshot, and then the changes as they are pushed
+                           if( message.types.empty() || algorithm::find( message.types, admin::event::State::type()))
+                           {
+                              admin::event::State event{ common::process::handle()};
+                              event.delta = transform::snapshot( state);
+                              event.delta.version = state.changes.version;
+
+                              local::optional::send( state, message.process.ipc, event);
+                           }
                         };
                      }
 
@@ -309,9 +325,7 @@ namespace casual
                            Trace trace{ "service::manager::handle::local::event::discoverable::available"};
                            common::log::line( verbose::log, "event: ", event);
 
-                           auto services = algorithm::transform( state.pending.lookups, []( auto& pending){ return pending.request.requested;});
-
-                           algorithm::container::trim( services, algorithm::unique( algorithm::sort( services)));
+                           auto services = state.pending.lookups.services();
 
                            if( ! services.empty())
                               local::discovery::send( std::move( services));
@@ -369,10 +383,17 @@ namespace casual
                            log::line( verbose::log, "message: ", message);
 
                            for( auto& metric : message.metrics)
+                           {
                               if( auto service = state.service( metric.service))
+                              {
                                  service->metric.update( metric);
+                                 state.changed( metric.service);
+                              }
+                           }
+
+                           handle::changes::batch::send( state);
 
-                           if( state.events)
+                           if( state.events.active< common::message::event::service::Calls>())
                            {
                               state.metric.add( std::move( message.metrics));
                               handle::metric::batch::send( state);
@@ -397,7 +418,7 @@ namespace casual
                            reply.service.name = message.requested;
                            reply.state = decltype( reply.state)::absent;
 
-                           local::optional::send( message.process.ipc, reply);
+                           local::optional::send( state, message.process.ipc, reply);
                         });
 
                         {
@@ -408,12 +429,46 @@ namespace casual
                               // we sent the request OR the caller is willing to wait for future 
                               // advertised services
 
-                              state.pending.lookups.emplace_back( std::move( message), platform::time::clock::type::now());
+                              state.pending.lookups.push( { std::move( message), platform::time::clock::type::now()});
                               send_reply.release();
                            }
                         }
                      }
 
+                     namespace admission
+                     {
+                        //! @returns true if the lookup could be served before its deadline, projected from the
+                        //!   service average invocation time, the number of instances and the lookups that will be
+                        //!   served ahead of this one.
+                        bool projected( const State& state, const manager::state::Service& service, const common::message::service::lookup::Request& message)
+                        {
+                           if( ! message.deadline || service.metric.invoked.count == 0 || service.instances.sequential.empty())
+                              return true;
+
+                           auto average = service.metric.invoked.total / service.metric.invoked.count;
+                           auto ahead = state.pending.lookups.ahead( message.requested, message.priority, message.deadline);
+                           auto instances = static_cast< platform::size::type>( service.instances.sequential.size());
+
+                           auto projected = average * ( ahead + 1) / instances;
+
+                           log::line( verbose::log, "admission - average: ", average, ", ahead: ", ahead, ", instances: ", instances, ", projected: ", projected);
+
+                           return platform::time::clock::type::now() + projected <= message.deadline.value();
+                        }
+
+                        //! rejects the lookup, the caller will get TPEBLOCK
+                        void reject( State& state, const manager::state::Service& service, const common::message::service::lookup::Request& message)
+                        {
+                           log::line( log, "lookup rejected - projected wait exceeds deadline: ", message);
+
+                           auto reply = common::message::reverse::type( message);
+                           reply.service = service.information;
+                           reply.state = decltype( reply.state)::rejected;
+                           local::optional::send( state, message.process.ipc, reply);
+                        }
+                        
+                     } // admission
+
                      void lookup( State& state, common::message::service::lookup::Request& message, platform::time::unit pending)
                      {
                         Trace trace{ "service::manager::handle::local::service::detail::lookup"};
@@ -423,6 +478,10 @@ namespace casual
                         {
                            if( auto handle = service->reserve( message.process, message.correlation))
                            {
+                              state.changed( message.requested);
+                              state.changed( handle.pid);
+                              manager::handle::changes::batch::send( state);
+
                               auto reply = common::message::reverse::type( message);
                               reply.service = service->information;
                               reply.state = decltype( reply.state)::idle;
@@ -439,14 +498,11 @@ namespace casual
 
                                  reply.service.timeout.duration = service->timeout.duration.value();
 
-                                 auto next = state.pending.deadline.add( {
+                                 state.pending.deadline.add( {
                                     now + reply.service.timeout.duration,
                                     message.correlation,
                                     handle.pid,
                                     service});
-
-                                 if( next)
-                                    signal::timer::set( next.value() - now);
                               }
                               else if( message.deadline)
                               {
@@ -454,7 +510,7 @@ namespace casual
                               }                             
 
                               // TODO maintainence: if the message is not sent, we need to unreserve
-                              local::optional::send( message.process.ipc, reply);
+                              local::optional::send( state, message.process.ipc, reply);
                            }
                            else if( service->instances.empty())
                            {
@@ -479,12 +535,18 @@ namespace casual
                                     // with our forward.
                                     reply.state = decltype( reply.state)::idle;
 
-                                    local::optional::send( message.process.ipc, reply);
+                                    local::optional::send( state, message.process.ipc, reply);
 
                                     break;
                                  }
                                  case Context::no_busy_intermediate:
                                  {
+                                    if( ! admission::projected( state, *service, message))
+                                    {
+                                       admission::reject( state, *service, message);
+                                       break;
+                                    }
+
                                     // the caller does not want to get a busy intermediate, only want's to wait until
                                     // the service is idle. That is, we don't need to send timeout and
                                     // stuff to the caller.
@@ -493,19 +555,25 @@ namespace casual
                                     // and this might be a problem?
                                     // TODO semantics: something we need to address? probably not,
                                     // since we can't make it 100% any way...)
-                                    state.pending.lookups.emplace_back( std::move( message), platform::time::clock::type::now());
+                                    state.pending.lookups.push( { std::move( message), platform::time::clock::type::now()});
 
                                     break;
                                  }
                                  case Context::regular:
                                  {
+                                    if( ! admission::projected( state, *service, message))
+                                    {
+                                       admission::reject( state, *service, message);
+                                       break;
+                                    }
+
                                     // send busy-message to caller, to set timeouts and stuff
                                     reply.state = decltype( reply.state)::busy;
 
-                                    if( local::optional::send( message.process.ipc, reply))
+                                    if( local::optional::send( state, message.process.ipc, reply))
                                     {
                                        // All instances are busy, we stack the request
-                                       state.pending.lookups.emplace_back( std::move( message), platform::time::clock::type::now());
+                                       state.pending.lookups.push( { std::move( message), platform::time::clock::type::now()});
                                     }
 
                                     break;
@@ -513,7 +581,7 @@ namespace casual
                                  case Context::wait:
                                  {
                                     // we know the service exists, and it got instances, we do a regular pending.
-                                    state.pending.lookups.emplace_back( std::move( message), platform::time::clock::type::now());
+                                    state.pending.lookups.push( { std::move( message), platform::time::clock::type::now()});
                                  }
                               }
                            }
@@ -546,12 +614,11 @@ namespace casual
 
                            auto reply = message::reverse::type( message);
 
-                           if( auto found = algorithm::find( state.pending.lookups, message.correlation))
+                           if( auto found = state.pending.lookups.extract( message.correlation))
                            {
                               log::line( log, "found pending to discard");
                               log::line( verbose::log, "pending: ", *found);
 
-                              state.pending.lookups.erase( std::begin( found));
                               reply.state = decltype( reply.state)::discarded;
                            }
                            else 
@@ -580,7 +647,7 @@ namespace casual
 
                            // We only send reply if caller want's it
                            if( message.reply)
-                              local::optional::send( message.process.ipc, reply);
+                              local::optional::send( state, message.process.ipc, reply);
                         };
                      }
                   } // discard
@@ -641,9 +708,7 @@ namespace casual
 
                            // extract the corresponding pending lookups and 'emulate' new lookups, if any.
                            {
-                              auto lookups = algorithm::container::extract( 
-                                 state.pending.lookups, 
-                                 std::get< 0>( algorithm::intersection( state.pending.lookups, services)));
+                              auto lookups = state.pending.lookups.extract( services);
 
                               const auto now = platform::time::clock::type::now();
 
@@ -690,7 +755,7 @@ namespace casual
                               {
                                  return instance.process;
                               });
-                              handle::local::eventually::send( message.process, reply);
+                              local::optional::send( state, message.process.ipc, reply);
                            }
 
                            if( busy)
@@ -705,6 +770,7 @@ namespace casual
                               });
 
                               auto callback = [ 
+                                 &state,
                                  message = common::message::reverse::type( message, common::process::handle()), 
                                  instances = range::to_vector( busy),
                                  destination = message.process]
@@ -719,7 +785,7 @@ namespace casual
                                  // take care of failed, if any
                                  for( auto& failed : failed)
                                     if( auto found = algorithm::find( instances, failed.id))
-                                       local::error::reply( found->caller(), code::xatmi::service_error);
+                                       local::error::reply( state, found->caller(), code::xatmi::service_error);
 
                                  // take care of replies
                                  algorithm::for_each( replies, [&]( auto& reply)
@@ -732,7 +798,7 @@ namespace casual
                                     }
                                  }); 
                                  
-                                 handle::local::eventually::send( destination, message);
+                                 local::optional::send( state, destination.ipc, message);
 
                               };
 
@@ -776,7 +842,7 @@ namespace casual
                               return result;
                            });
 
-                           communication::device::blocking::send( message.process.ipc, reply);
+                           local::optional::send( state, message.process.ipc, reply);
                         };
                      }
 
@@ -788,9 +854,9 @@ namespace casual
                            Trace trace{ "service::manager::handle::gateway::discover::Reply"};
                            common::log::line( verbose::log, "message: ", message);
 
-                           if( auto found = algorithm::find( state.pending.lookups, message.correlation))
+                           if( auto found = state.pending.lookups.extract( message.correlation))
                            {
-                              auto pending = algorithm::container::extract( state.pending.lookups, std::begin( found));
+                              auto pending = std::move( *found);
 
                               auto service = state.service( pending.request.requested);
 
@@ -802,8 +868,8 @@ namespace casual
                               }
                               else if( pending.request.context == decltype( pending.request.context)::wait)
                               {
-                                 // we put the pending back. In front to be as fair as possible
-                                 state.pending.lookups.push_front( std::move( pending));
+                                 // we put the pending back, it keeps its original position.
+                                 state.pending.lookups.push( std::move( pending));
                               }
                               else 
                               {
@@ -811,7 +877,7 @@ namespace casual
                                  reply.service.name = pending.request.requested;
                                  reply.state = decltype( reply.state)::absent;
 
-                                 communication::device::blocking::send( pending.request.process.ipc, reply);
+                                 local::optional::send( state, pending.request.process.ipc, reply);
                               }
                            }
                            // else we've sent a discover request triggered by an discoverable event.
@@ -833,8 +899,7 @@ namespace casual
                      log::line( verbose::log, "message: ", message);
 
                      // we remove possible deadline first.
-                     if( auto deadline = state.pending.deadline.remove( message.correlation))
-                        signal::timer::set( deadline.value());
+                     state.pending.deadline.remove( message.correlation);
 
                      // add metric event regardless
                      if( state.events.active< common::message::event::service::Calls>())
@@ -849,28 +914,37 @@ namespace casual
                         log::line( verbose::log, "instance: ", *instance);
 
                         instance->unreserve( message.metric);
-                        
+
+                        state.changed( instance->process.pid);
+
+                        // the metric is for the origin service, that might be known by its routes
+                        if( auto found = algorithm::find( state.routes, message.metric.service))
+                           algorithm::for_each( found->second, [&state]( auto& route){ state.changed( route);});
+                        else
+                           state.changed( message.metric.service);
+
+                        handle::changes::batch::send( state);
 
                         // Check if there are pending request for services that this
                         // instance has.
 
-                        auto has_pending = [&state, instance]( const auto& pending)
+                        auto has_pending = [&state, instance]( const auto& requested)
                         {
-                           if( instance->service( pending.request.requested))
+                           if( instance->service( requested))
                               return true;
                            
                            // we need to check routes...
-                           if( auto found = algorithm::find( state.reverse_routes, pending.request.requested))
+                           if( auto found = algorithm::find( state.reverse_routes, requested))
                               return instance->service( found->second);
 
                            return false;
                         };
 
-                        if( auto found = common::algorithm::find_if( state.pending.lookups, has_pending))
+                        if( auto found = state.pending.lookups.next( has_pending))
                         {
                            log::line( verbose::log, "found pendig: ", *found);
 
-                           auto pending = algorithm::container::extract( state.pending.lookups, std::begin( found));
+                           auto pending = std::move( *found);
 
                            // We now know that there are one idle server that has advertised the
                            // requested service (we've just marked it as idle...).
@@ -903,12 +977,12 @@ namespace casual
                            manager::configuration::conform( state, transform::configuration( state), std::move( message.model.service));
 
                            auto reply = message::reverse::type( message);
-                           eventually::send( message.process, reply);
+                           optional::send( state, message.process.ipc, reply);
                         };
                      }
                   } // update
 
-                  auto request( const State& state)
+                  auto request( State& state)
                   {
                      return [&state]( casual::configuration::message::Request& message)
                      {
@@ -918,7 +992,7 @@ namespace casual
                         auto reply = message::reverse::type( message);
 
                         reply.model.service = transform::configuration( state);
-                        eventually::send( message.process, reply);
+                        optional::send( state, message.process.ipc, reply);
                      };
                   }
 
@@ -959,7 +1033,7 @@ namespace casual
 
                   void reply( common::strong::ipc::id id, common::message::service::call::Reply& message)
                   {
-                     communication::device::blocking::send( id, message);
+                     local::optional::send( *m_state, id, message);
                   }
 
                   void ack( const common::message::service::call::ACK& ack)
@@ -17,6 +17,7 @@
 #include "common/argument.h"
 #include "common/environment.h"
 #include "common/communication/instance.h"
+#include "common/communication/select.h"
 #include "common/message/dispatch.h"
 
 #include <iostream>
@@ -49,6 +50,10 @@ namespace casual
 
                State state;
 
+               // publish service events via shared memory rings, to subscribers that can read them.
+               // instances and outbounds still send their metrics to us, we aggregate and write the ring once.
+               state.events.multicast();
+
                // We ask the domain manager for configuration, and 'comply' to it...
                handle::comply::configuration( state, casual::domain::configuration::fetch());
 
@@ -71,11 +76,6 @@ namespace casual
                   });
                }); 
 
-               signal::callback::registration< code::signal::alarm>( [&state]()
-               {
-                  handle::timeout( state);
-               });
-
                // Start forward
                {
                   Trace trace{ "service::manager:local::setup spawn forward"};
@@ -88,16 +88,80 @@ namespace casual
             }
 
 
+            namespace dispatch
+            {
+               template< typename H>
+               struct ipc
+               {
+                  ipc( H handler) : m_handler{ std::move( handler)} {}
+
+                  bool operator () ( communication::select::tag::consume)
+                  {
+                     // we consume the cache.
+                     return predicate::boolean( m_handler( manager::ipc::device().cached()));
+                  }
+
+                  bool operator() ( strong::file::descriptor::id descriptor, communication::select::tag::read)
+                  {
+                     if( manager::ipc::device().connector().descriptor() != descriptor)
+                        return false;
+
+                     m_handler( communication::device::non::blocking::next( manager::ipc::device()));
+                     return true;
+                  }
+
+               private:
+                  H m_handler;
+               };
+
+               struct timeout
+               {
+                  timeout( State& state) : m_state{ &state} {}
+
+                  bool operator() ( strong::file::descriptor::id descriptor, communication::select::tag::read)
+                  {
+                     if( m_state->pending.deadline.descriptor() != descriptor)
+                        return false;
+
+                     handle::timeout( *m_state);
+                     return true;
+                  }
+
+               private:
+                  State* m_state;
+               };
+
+               //! sends the queued replies, when the destinations are writable
+               struct multiplex
+               {
+                  multiplex( State& state) : m_state{ &state} {}
+
+                  bool operator() ( strong::file::descriptor::id descriptor, communication::select::tag::read)
+                  {
+                     if( m_state->multiplex.descriptor() != descriptor)
+                        return false;
+
+                     m_state->multiplex.send();
+                     return true;
+                  }
+
+               private:
+                  State* m_state;
+               };
+            } // dispatch
+
             auto condition( State& state)
             {
-               return message::dispatch::condition::compose(
-                  message::dispatch::condition::done( [&state]() { return state.done();}),
-                  message::dispatch::condition::idle( [&state]()
+               return communication::select::dispatch::condition::compose(
+                  communication::select::dispatch::condition::done( [&state]() { return state.done();}),
+                  communication::select::dispatch::condition::idle( [&state]()
                   {
                      // the input socket is empty, we can't know if there ever gonna be any more 
-                     // messages to read, we need to send metric, if any...
+                     // messages to read, we need to send metric and state changes, if any...
                      if( state.metric && state.events.active< common::message::event::service::Calls>())
                         manager::handle::metric::send( state);
+
+                     manager::handle::changes::send( state);
                   })
                );
             }
@@ -110,6 +174,12 @@ namespace casual
 
                auto handler = manager::handler( state);
 
+               // we want to know about shutdown before we route more calls. process exit is consumed in
+               // arrival order, otherwise we could handle the exit before an earlier advertise from the same pid.
+               // metrics are only forwarded to subscribers, and can wait for other traffic.
+               ipc::device().priorities( { common::message::Type::shutdown_request});
+               ipc::device().deferred( { common::message::Type::event_service_calls});
+
                // register that we can answer discovery questions.
                casual::domain::discovery::internal::registration();
 
@@ -119,10 +189,19 @@ namespace casual
                log::line( common::log::category::information, "casual-service-manager is on-line");
                log::line( verbose::log, "state: ", state);
 
-               common::message::dispatch::pump(
+               // deadlines are signaled via a timer descriptor, and writable destinations of queued replies via 
+               // the multiplex descriptor, multiplexed with our inbound
+               communication::select::Directive directive;
+               directive.read.add( ipc::device().connector().descriptor());
+               directive.read.add( state.pending.deadline.descriptor());
+               directive.read.add( state.multiplex.descriptor());
+
+               communication::select::dispatch::pump(
                   local::condition( state),
-                  handler, 
-                  ipc::device());
+                  directive,
+                  local::dispatch::ipc{ std::move( handler)},
+                  local::dispatch::timeout{ state},
+                  local::dispatch::multiplex{ state});
             }
 
             void main( int argc, char** argv)
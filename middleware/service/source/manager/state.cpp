@@ -176,61 +176,252 @@ namespace casual
             namespace pending
             {
              
-               std::optional< platform::time::point::type> Deadline::add( deadline::Entry entry)
+               namespace local
                {
-                  auto inserted = m_entries.insert(
-                     std::upper_bound( std::begin( m_entries), std::end( m_entries), entry),
-                     std::move( entry));
+                  namespace
+                  {
+                     namespace lookup
+                     {
+                        auto index( pending::lookup::Priority priority)
+                        {
+                           return static_cast< platform::size::type>( priority);
+                        }
+
+                        //! the 'lcm' of the weights, so the strides are integral
+                        constexpr platform::size::type stride_base = 8;
+
+                        auto stride( platform::size::type index)
+                        {
+                           return stride_base / pending::lookup::weights[ index];
+                        }
+                     } // lookup
+                  } // <unnamed>
+               } // local
+
+               const Lookups::Class* Lookups::Queue::next() const
+               {
+                  const Class* result = nullptr;
+
+                  // lowest pass first, and the higher priority (lower index) on ties
+                  for( auto& type : classes)
+                     if( ! type.lookups.empty() && ( ! result || type.pass < result->pass))
+                        result = &type;
+
+                  return result;
+               }
+
+               void Lookups::push( Lookup lookup)
+               {
+                  Key key{ lookup.request.deadline.value_or( platform::time::point::type::max()), lookup.when, m_sequence++};
+
+                  auto priority = lookup.request.priority;
+                  auto& queue = m_queues[ lookup.request.requested];
+                  auto& type = queue.classes.at( local::lookup::index( priority));
+
+                  // a class that becomes active can't 'save' passes while idle
+                  if( type.lookups.empty())
+                     type.pass = std::max( type.pass, queue.pass);
+
+                  m_correlations.emplace( lookup.request.correlation, Location{ lookup.request.requested, priority, key});
+                  type.lookups.emplace( key, std::move( lookup));
+                  ++queue.size;
+               }
+
+               Lookup Lookups::extract( std::unordered_map< std::string, Queue>::iterator queue, Class& type, std::map< Key, Lookup>::iterator position)
+               {
+                  auto result = std::move( position->second);
+                  type.lookups.erase( position);
+                  m_correlations.erase( result.request.correlation);
+
+                  if( --queue->second.size == 0)
+                     m_queues.erase( queue);
+
+                  return result;
+               }
 
-                  if( inserted != std::begin( m_entries))
+               std::optional< Lookup> Lookups::extract( const strong::correlation::id& correlation)
+               {
+                  auto found = m_correlations.find( correlation);
+                  if( found == std::end( m_correlations))
                      return {};
 
-                  return { inserted->when};
+                  auto queue = m_queues.find( found->second.service);
+                  auto& type = queue->second.classes.at( local::lookup::index( found->second.priority));
+
+                  return extract( queue, type, type.lookups.find( found->second.key));
                }
 
-               std::optional< platform::time::point::type> Deadline::remove( const strong::correlation::id& correlation)
+               std::optional< Lookup> Lookups::next( common::function< bool( const std::string&) const> predicate)
                {
-                  if( auto found = algorithm::find( m_entries, correlation))
+                  auto candidate = std::end( m_queues);
+                  const Class* candidate_type = nullptr;
+
+                  for( auto current = std::begin( m_queues); current != std::end( m_queues); ++current)
                   {
-                     if( auto next = m_entries.erase( std::begin( found)); next == std::begin( m_entries))
-                        return { next->when};
+                     if( ! predicate( current->first))
+                        continue;
+
+                     auto type = current->second.next();
+
+                     // highest priority class, then earliest key
+                     if( ! candidate_type 
+                        || std::make_tuple( type - current->second.classes.data(), std::begin( type->lookups)->first) 
+                           < std::make_tuple( candidate_type - candidate->second.classes.data(), std::begin( candidate_type->lookups)->first))
+                     {
+                        candidate = current;
+                        candidate_type = type;
+                     }
                   }
-                  return {};
+
+                  if( ! candidate_type)
+                     return {};
+
+                  auto& queue = candidate->second;
+                  auto& type = queue.classes.at( candidate_type - queue.classes.data());
+
+                  // advance the 'virtual time' for the class, and the queue
+                  queue.pass = type.pass;
+                  type.pass += local::lookup::stride( candidate_type - queue.classes.data());
+
+                  return extract( candidate, type, std::begin( type.lookups));
                }
 
-               std::optional< platform::time::point::type> Deadline::remove( const std::vector< strong::correlation::id>& correlations)
+               std::vector< Lookup> Lookups::extract( const std::vector< std::string>& services)
                {
+                  return extract_if( [&services]( auto& service){ return predicate::boolean( algorithm::find( services, service));});
+               }
+
+               std::vector< Lookup> Lookups::extract_if( common::function< bool( const std::string&) const> predicate)
+               {
+                  std::vector< Lookup> result;
 
-                  auto [ keep, remove] = algorithm::stable::partition( m_entries, [&correlations]( auto& entry)
+                  for( auto current = std::begin( m_queues); current != std::end( m_queues);)
                   {
-                     return ! predicate::boolean( algorithm::find( correlations, entry.correlation));
-                  });
+                     if( ! predicate( current->first))
+                     {
+                        ++current;
+                        continue;
+                     }
+
+                     for( auto& type : current->second.classes)
+                     {
+                        for( auto& pair : type.lookups)
+                        {
+                           m_correlations.erase( pair.second.request.correlation);
+                           result.push_back( std::move( pair.second));
+                        }
+                     }
+
+                     current = m_queues.erase( current);
+                  }
+
+                  // keep the arrival order between the extracted
+                  algorithm::sort( result, []( auto& lhs, auto& rhs){ return lhs.when < rhs.when;});
+
+                  return result;
+               }
+
+               platform::size::type Lookups::ahead( const std::string& service, lookup::Priority priority, const std::optional< platform::time::point::type>& deadline) const
+               {
+                  auto found = m_queues.find( service);
+                  if( found == std::end( m_queues))
+                     return 0;
+
+                  auto& queue = found->second;
+                  auto index = local::lookup::index( priority);
+                  auto& own = queue.classes.at( index);
+
+                  // the ones in our own class that has an earlier deadline
+                  auto key = deadline.value_or( platform::time::point::type::max());
+                  platform::size::type earlier = std::distance( 
+                     std::begin( own.lookups),
+                     own.lookups.lower_bound( Key{ key, platform::time::point::type::max(), 0}));
 
-                  // has the next deadline been postponed?
-                  if( remove && keep && range::front( remove) < range::front( keep))
+                  auto result = earlier;
+
+                  // the other classes gets their share, relative to the weights, while we wait
+                  for( platform::size::type other = 0; other < range::size( queue.classes); ++other)
                   {
-                     algorithm::container::trim( m_entries, keep);
-                     return { m_entries.front().when};
+                     if( other == index)
+                        continue;
+
+                     auto size = static_cast< platform::size::type>( queue.classes[ other].lookups.size());
+                     auto share = ( earlier + 1) * lookup::weights[ other] / lookup::weights[ index];
+                     result += std::min( size, share);
                   }
-                  algorithm::container::trim( m_entries, keep);
-                  return {};
+
+                  return result;
+               }
+
+               std::vector< std::string> Lookups::services() const
+               {
+                  return algorithm::transform( m_queues, []( auto& pair){ return pair.first;});
+               }
+
+               std::vector< std::reference_wrapper< const Lookup>> Lookups::all() const
+               {
+                  std::vector< std::reference_wrapper< const Lookup>> result;
+                  
+                  for( auto& [ service, queue] : m_queues)
+                     for( auto& type : queue.classes)
+                        for( auto& pair : type.lookups)
+                           result.push_back( std::cref( pair.second));
+
+                  return result;
+               }
+
+               void Deadline::add( deadline::Entry entry)
+               {
+                  auto correlation = entry.correlation;
+                  auto when = entry.when;
+
+                  // a correlation has at most one deadline, the earlier entry would otherwise expire 'spuriously'
+                  if( auto found = m_correlations.find( correlation); found != std::end( m_correlations))
+                     m_wheel.cancel( found->second);
+
+                  m_correlations[ correlation] = m_wheel.add( when, std::move( entry));
+
+                  if( ! m_timer.deadline() || when < m_timer.deadline().value())
+                     arm();
                }
 
-               Deadline::Expired Deadline::expired( platform::time::point::type now)
+               void Deadline::remove( const strong::correlation::id& correlation)
                {
-                  auto pivot = std::find_if( std::begin( m_entries), std::end( m_entries), [now]( auto& entry)
+                  // we don't re-arm the timer, a 'premature' expiration is harmless.
+                  if( auto found = m_correlations.find( correlation); found != std::end( m_correlations))
                   {
-                     return entry.when >= now;
-                  });
+                     m_wheel.cancel( found->second);
+                     m_correlations.erase( found);
+                  }
+               }
+
+               void Deadline::remove( const std::vector< strong::correlation::id>& correlations)
+               {
+                  for( auto& correlation : correlations)
+                     remove( correlation);
+               }
+
+               std::vector< deadline::Entry> Deadline::expired( platform::time::point::type now)
+               {
+                  m_timer.consume();
+
+                  auto result = m_wheel.expired( now);
 
-                  Deadline::Expired result;
-                  result.entries = algorithm::container::extract( m_entries, range::make( std::begin( m_entries), pivot));
+                  for( auto& entry : result)
+                     m_correlations.erase( entry.correlation);
 
-                  if( ! m_entries.empty())
-                     result.deadline = m_entries.front().when;
+                  arm();
 
                   return result;
                }
+
+               void Deadline::arm()
+               {
+                  if( auto next = m_wheel.next())
+                     m_timer.set( next.value());
+                  else
+                     m_timer.unset();
+               }
             } // pending
          } // service
 
@@ -378,6 +569,8 @@ namespace casual
 
                auto add_service = [&]( auto& name)
                {
+                  state.changed( name);
+
                   // is the service advertised before?
                   if( auto found = algorithm::find( state.services, name))
                   {
@@ -436,7 +629,10 @@ namespace casual
                // unadvertise only comes with origin service names.
                for( auto& pair : state.services)
                   if( algorithm::find( services, pair.second.information.name))
+                  {
                      pair.second.remove( instance.process.pid);
+                     state.changed( pair.first);
+                  }
             }
 
             template< typename M>
@@ -471,6 +667,9 @@ namespace casual
          if( forward.pid == pid)
             forward.clear();
 
+         changed( pid);
+         changed_services( pid);
+
          events.remove( pid);
 
          local::remove_process( instances.sequential, services, pid);
@@ -485,12 +684,19 @@ namespace casual
          {
             if( auto found = common::algorithm::find( instances.sequential, process.pid))
             {
+               changed( process.pid);
+               changed_services( process.pid);
+
                algorithm::append_unique( found->second.detach(), std::get< 0>( result));
                std::get< 1>( result).push_back( algorithm::container::extract( instances.sequential, std::begin( found)).second);
                return true;
             }
             else if( common::algorithm::find( instances.concurrent, process.pid))
+            {
+               changed( process.pid);
+               changed_services( process.pid);
                local::remove_process( instances.concurrent, services, process.pid);
+            }
 
             return false;
          }));
@@ -522,6 +728,7 @@ namespace casual
          local::restrict_add_services( *this, message);
 
          auto& instance = local::find_or_add( instances.sequential, message.process);
+         changed( instance.process.pid);
 
          // add
          {
@@ -542,13 +749,13 @@ namespace casual
 
          // now we need to check if there are pending request that this instance has enabled
          {
-            auto requested_service = [&instance]( auto& pending)
+            auto requested_service = [&instance]( auto& requested)
             {
-               return instance.service( pending.request.requested);
+               return instance.service( requested);
             };
 
-            if( auto found = algorithm::find_if( pending.lookups, requested_service))
-               return { algorithm::container::extract( pending.lookups, std::begin( found))};
+            if( auto found = pending.lookups.next( requested_service))
+               return { std::move( *found)};
          }
 
          return {};
@@ -574,6 +781,7 @@ namespace casual
 
          auto& instance = local::find_or_add( instances.concurrent, message.process);
          instance.order = message.order;
+         changed( instance.process.pid);
 
          // add
          {
@@ -598,17 +806,13 @@ namespace casual
          local::remove_services( *this, instance, message.services.remove);
 
          // find all potentially pending.
-         auto [ keep, remove] = algorithm::stable::partition( pending.lookups, [&]( auto& pending)
+         return pending.lookups.extract_if( [&]( auto& requested)
          {
-            if( auto found = algorithm::find( services, pending.request.requested))
-               return found->second.instances.empty(); // false/remove if not empty, hence what we 'want' to return
+            if( auto found = algorithm::find( services, requested))
+               return ! found->second.instances.empty();
 
-            return true; // keep
+            return false;
          });
-
-         auto result = range::to_vector( remove);
-         algorithm::container::trim( pending.lookups, keep);
-         return result;
       }
 
       std::vector< std::string> State::metric_reset( std::vector< std::string> lookup)
@@ -622,6 +826,7 @@ namespace casual
             for( auto& service : services)
             {
                service.second.metric.reset();
+               changed( service.first);
                result.push_back( service.first);
             }
          }
@@ -633,6 +838,7 @@ namespace casual
                if( service)
                {
                   service->metric.reset();
+                  changed( name);
                   result.push_back( std::move( name));
                }
             }
@@ -670,6 +876,7 @@ namespace casual
          };
 
          auto& instance = local::find_or_add( instances.sequential, process::handle());
+         changed( instance.process.pid);
 
          for( auto service : algorithm::transform( services, transform_service))
          {
@@ -679,6 +886,28 @@ namespace casual
          }
       }
 
+      void State::changed( const std::string& service)
+      {
+         if( events.active< admin::event::State>())
+            changes.services.insert( service);
+      }
+
+      void State::changed( common::strong::process::id instance)
+      {
+         if( events.active< admin::event::State>())
+            changes.instances.insert( instance);
+      }
+
+      void State::changed_services( common::strong::process::id instance)
+      {
+         if( ! events.active< admin::event::State>())
+            return;
+
+         for( auto& [ name, service] : services)
+            if( algorithm::find( service.instances.sequential, instance) || algorithm::find( service.instances.concurrent, instance))
+               changes.services.insert( name);
+      }
+
       void State::Metric::add( metric_type metric)
       {
          m_message.metrics.push_back( std::move( metric));
@@ -57,7 +57,7 @@ namespace casual
 
             auto pending()
             {
-               return []( auto& value)
+               return []( const state::service::pending::Lookup& value)
                {
                   manager::admin::model::Pending result;
                   result.process = value.request.process;
@@ -146,7 +146,7 @@ namespace casual
          common::algorithm::transform( state.instances.concurrent, result.instances.concurrent,
                common::predicate::make_nested( local::Instance{}, common::predicate::adapter::second()));
 
-         common::algorithm::transform( state.pending.lookups, result.pending, local::pending());
+         common::algorithm::transform( state.pending.lookups.all(), result.pending, local::pending());
 
          common::algorithm::transform( state.services, result.services, local::service());
 
@@ -162,9 +162,70 @@ namespace casual
             });
          });
 
+         common::algorithm::transform( state.multiplex.metrics(), result.outbound, []( auto& value)
+         {
+            manager::admin::model::outbound::Destination result;
+
+            result.ipc = value.ipc;
+            result.queue.count = value.queue.count;
+            result.queue.size = value.queue.size;
+            result.queue.high = value.queue.high;
+            result.shed = value.shed;
+
+            result.stall.count = value.stall.count;
+            result.stall.total = value.stall.total;
+            result.stall.limit.min = value.stall.limit.min;
+            result.stall.limit.max = value.stall.limit.max;
+
+            return result;
+         });
+
+         return result;
+      }
+
+
+      manager::admin::model::delta::State delta( const manager::State& state, const manager::state::Changes& changes)
+      {
+         manager::admin::model::delta::State result;
+
+         for( auto& name : changes.services)
+         {
+            if( auto found = common::algorithm::find( state.services, name))
+               result.services.changed.push_back( local::service()( *found));
+            else
+               result.services.removed.push_back( name);
+         }
+
+         for( auto pid : changes.instances)
+         {
+            if( auto found = common::algorithm::find( state.instances.sequential, pid))
+               result.instances.sequential.changed.push_back( local::Instance{}( found->second));
+            else if( auto found = common::algorithm::find( state.instances.concurrent, pid))
+               result.instances.concurrent.changed.push_back( local::Instance{}( found->second));
+            else
+            {
+               // we don't know which kind the instance was
+               result.instances.sequential.removed.push_back( pid);
+               result.instances.concurrent.removed.push_back( pid);
+            }
+         }
+
          return result;
       }
 
+      manager::admin::model::delta::State snapshot( const manager::State& state)
+      {
+         auto current = transform::state( state);
+
+         manager::admin::model::delta::State result;
+         result.snapshot = true;
+         result.instances.sequential.changed = std::move( current.instances.sequential);
+         result.instances.concurrent.changed = std::move( current.instances.concurrent);
+         result.services.changed = std::move( current.services);
+         result.routes = std::move( current.routes);
+
+         return result;
+      }
 
       configuration::model::service::Model configuration( const manager::State& state)
       {
@@ -10,6 +10,8 @@
 
 #include "service/manager/admin/server.h"
 #include "service/manager/admin/model.h"
+#include "service/manager/admin/api.h"
+#include "service/manager/admin/event.h"
 #include "service/forward/instance.h"
 #include "service/unittest/utility.h"
 
@@ -18,6 +20,7 @@
 #include "common/message/service.h"
 
 #include "common/service/lookup.h"
+#include "common/service/call/context.h"
 #include "common/communication/instance.h"
 #include "common/event/listen.h"
 #include "common/algorithm/container.h"
@@ -291,6 +294,48 @@ domain:
          }
       }
 
+      TEST( service_manager, state_event__advertise_2_services__subscribe__advertise_1_more___expect_snapshot_then_only_changes)
+      {
+         common::unittest::Trace trace;
+
+         auto domain = local::domain();
+
+         service::unittest::advertise( { "service1", "service2"});
+
+         common::event::subscribe( common::process::handle(), { manager::admin::event::State::type()});
+
+         auto receive = []()
+         {
+            manager::admin::event::State event;
+            common::communication::device::blocking::receive( common::communication::ipc::inbound::device(), event);
+            return event;
+         };
+
+         auto event = receive();
+         EXPECT_TRUE( event.delta.snapshot);
+         EXPECT_TRUE( local::has_services( event.delta.services.changed, { manager::admin::service::name::state(), "service1", "service2"}));
+
+         manager::admin::model::State state;
+         auto version = manager::admin::api::delta::apply( state, std::move( event.delta));
+
+         service::unittest::advertise( { "service3"});
+
+         event = receive();
+         EXPECT_TRUE( ! event.delta.snapshot);
+         EXPECT_TRUE( event.delta.version == version + 1);
+         ASSERT_TRUE( event.delta.services.changed.size() == 1) << CASUAL_NAMED_VALUE( event.delta);
+         EXPECT_TRUE( event.delta.services.changed.at( 0).name == "service3");
+         ASSERT_TRUE( event.delta.instances.sequential.changed.size() == 1) << CASUAL_NAMED_VALUE( event.delta);
+         EXPECT_TRUE( event.delta.instances.sequential.changed.at( 0).process == common::process::handle());
+
+         version = manager::admin::api::delta::apply( state, std::move( event.delta));
+
+         // the applied state has the same services as the full state
+         auto full = local::call::state();
+         EXPECT_TRUE( state.services.size() == full.services.size());
+         EXPECT_TRUE( local::has_services( state.services, { "service1", "service2", "service3"}));
+      }
+
       TEST( service_manager, advertise_A__route_B_A__expect_lookup_for_B)
       {
          common::unittest::Trace trace;
@@ -671,6 +716,34 @@ domain:
          }
       }
 
+      TEST( service_manager, advertise_service1__process_exit_same_pid__expect_no_instance)
+      {
+         common::unittest::Trace trace;
+
+         auto domain = local::domain();
+
+         // the advertise and the exit are queued back to back, the exit must not be handled first
+         service::unittest::advertise( { "service1"});
+
+         {
+            common::message::event::process::Exit message;
+            message.state.pid = common::process::id();
+            message.state.reason = common::process::lifetime::Exit::Reason::core;
+
+            common::communication::device::blocking::send( 
+               common::communication::instance::outbound::service::manager::device(),
+               message);
+         }
+
+         auto state = local::call::state();
+
+         EXPECT_TRUE( ! local::instance::find( state, common::process::id())) << CASUAL_NAMED_VALUE( state.instances);
+
+         auto service = local::service::find( state, "service1");
+         ASSERT_TRUE( service);
+         EXPECT_TRUE( service->instances.sequential.empty()) << CASUAL_NAMED_VALUE( *service);
+      }
+
       TEST( service_manager, advertise_a____prepare_shutdown___expect_reply_with_our_self)
       {
          common::unittest::Trace trace;
@@ -924,5 +997,194 @@ domain:
   
       }
 
+      TEST( service_manager, scatter_3_concurrent_services__reply_in_reverse_order___expect_gather_in_reverse_order)
+      {
+         common::unittest::Trace trace;
+
+         auto domain = local::domain();
+
+         {
+            common::message::service::concurrent::Advertise message{ common::process::handle()};
+            for( auto name : { "a", "b", "c"})
+               message.services.add.emplace_back( name, "", common::service::transaction::Type::none);
+            
+            common::communication::device::blocking::send( 
+               common::communication::instance::outbound::service::manager::device(),
+               message);
+         }
+
+         common::buffer::Payload payload{ common::buffer::type::x_octet(), 128};
+
+         auto& context = common::service::call::context();
+
+         auto scattered = context.scatter( { { "a", payload}, { "b", payload}, { "absent", payload}, { "c", payload}}, {});
+         ASSERT_TRUE( scattered.size() == 4);
+         EXPECT_TRUE( scattered[ 0] && scattered[ 1] && scattered[ 3]);
+         EXPECT_TRUE( scattered[ 2].code == common::code::xatmi::no_entry) << CASUAL_NAMED_VALUE( scattered[ 2].code);
+
+         // we're the server for all the services, reply in reverse order
+         {
+            std::vector< common::message::service::call::callee::Request> requests( 3);
+            for( auto& request : requests)
+               common::communication::device::blocking::receive( local::ipc::inbound(), request);
+
+            long user = 0;
+            for( auto& request : common::range::reverse( requests))
+            {
+               common::message::service::call::Reply reply;
+               reply.correlation = request.correlation;
+               reply.code.result = request.service.name == "b" ? common::code::xatmi::service_fail : common::code::xatmi::ok;
+               reply.code.user = ++user;
+               reply.buffer = common::buffer::Payload{ common::buffer::type::x_octet(), 42};
+               common::communication::device::blocking::send( request.process.ipc, reply);
+            }
+         }
+
+         std::vector< common::service::call::descriptor_type> descriptors{ scattered[ 0].descriptor, scattered[ 1].descriptor, scattered[ 3].descriptor};
+
+         {
+            auto result = context.gather( descriptors, {});
+            EXPECT_TRUE( result.descriptor == scattered[ 3].descriptor);
+            EXPECT_TRUE( ! result.code);
+            EXPECT_TRUE( result.user == 1);
+            EXPECT_TRUE( result.buffer.memory.size() == 42);
+         }
+
+         {
+            auto result = context.gather( { scattered[ 0].descriptor, scattered[ 1].descriptor}, {});
+            EXPECT_TRUE( result.descriptor == scattered[ 1].descriptor);
+            EXPECT_TRUE( result.code == common::code::xatmi::service_fail);
+            EXPECT_TRUE( result.user == 2);
+         }
+
+         {
+            auto result = context.gather( { scattered[ 0].descriptor}, {});
+            EXPECT_TRUE( result.descriptor == scattered[ 0].descriptor);
+            EXPECT_TRUE( ! result.code);
+         }
+
+         EXPECT_TRUE( ! context.pending());
+
+         // all gathered, descriptors are not valid anymore
+         EXPECT_CODE({
+            context.gather( descriptors, {});
+         }, common::code::xatmi::descriptor);
+      }
+
+      TEST( service_manager, scatter_2_services_deadline_10s___expect_requests_timeout_bound_by_deadline)
+      {
+         common::unittest::Trace trace;
+
+         auto domain = local::domain();
+
+         {
+            common::message::service::concurrent::Advertise message{ common::process::handle()};
+            for( auto name : { "a", "b"})
+               message.services.add.emplace_back( name, "", common::service::transaction::Type::none);
+
+            common::communication::device::blocking::send(
+               common::communication::instance::outbound::service::manager::device(),
+               message);
+         }
+
+         common::buffer::Payload payload{ common::buffer::type::x_octet(), 128};
+
+         auto& context = common::service::call::context();
+
+         auto deadline = platform::time::clock::type::now() + std::chrono::seconds{ 10};
+         auto scattered = context.scatter( { { "a", payload}, { "b", payload}}, {}, deadline);
+         ASSERT_TRUE( scattered.size() == 2);
+         EXPECT_TRUE( scattered[ 0] && scattered[ 1]);
+
+         // we're the server for the services, the timeout of the calls is the time remaining until the deadline
+         std::vector< common::message::service::call::callee::Request> requests( 2);
+         for( auto& request : requests)
+         {
+            common::communication::device::blocking::receive( local::ipc::inbound(), request);
+            EXPECT_TRUE( request.service.timeout.duration > platform::time::unit::zero()) << CASUAL_NAMED_VALUE( request.service.timeout);
+            EXPECT_TRUE( request.service.timeout.duration <= std::chrono::seconds{ 10}) << CASUAL_NAMED_VALUE( request.service.timeout);
+         }
+
+         for( auto& request : requests)
+         {
+            common::message::service::call::Reply reply;
+            reply.correlation = request.correlation;
+            reply.buffer = common::buffer::Payload{ common::buffer::type::x_octet(), 42};
+            common::communication::device::blocking::send( request.process.ipc, reply);
+         }
+
+         std::vector< common::service::call::descriptor_type> descriptors{ scattered[ 0].descriptor, scattered[ 1].descriptor};
+
+         while( ! descriptors.empty())
+         {
+            auto result = context.gather( descriptors, {});
+            EXPECT_TRUE( ! result.code);
+            common::algorithm::container::trim( descriptors, common::algorithm::remove( descriptors, result.descriptor));
+         }
+
+         EXPECT_TRUE( ! context.pending());
+      }
+
+      TEST( service_manager, async_1000_calls_to_concurrent_service__reply_any___expect_all_replies)
+      {
+         common::unittest::Trace trace;
+
+         auto domain = local::domain();
+
+         {
+            common::message::service::concurrent::Advertise message{ common::process::handle()};
+            message.services.add.emplace_back( "a", "", common::service::transaction::Type::none);
+            
+            common::communication::device::blocking::send( 
+               common::communication::instance::outbound::service::manager::device(),
+               message);
+         }
+
+         constexpr auto count = 1000;
+
+         common::buffer::Payload payload{ common::buffer::type::x_octet(), 128};
+         auto& context = common::service::call::context();
+
+         auto start = platform::time::clock::type::now();
+
+         std::vector< common::service::call::descriptor_type> descriptors;
+
+         for( auto index = 0; index < count; ++index)
+            descriptors.push_back( context.async( "a", payload, {}));
+
+         auto sent = platform::time::clock::type::now();
+
+         // we're the server, reply to all
+         for( auto index = 0; index < count; ++index)
+         {
+            common::message::service::call::callee::Request request;
+            common::communication::device::blocking::receive( local::ipc::inbound(), request);
+
+            common::message::service::call::Reply reply;
+            reply.correlation = request.correlation;
+            reply.buffer = std::move( request.buffer);
+            common::communication::device::blocking::send( request.process.ipc, reply);
+         }
+
+         auto replied = platform::time::clock::type::now();
+
+         std::vector< common::service::call::descriptor_type> received;
+
+         for( auto index = 0; index < count; ++index)
+            received.push_back( context.reply( 0, common::service::call::reply::Flag::any).descriptor);
+
+         auto end = platform::time::clock::type::now();
+
+         auto milliseconds = []( auto duration){ return std::chrono::duration_cast< std::chrono::milliseconds>( duration).count();};
+
+         common::log::line( common::unittest::log, "count: ", count, 
+            " - tpacall: ", milliseconds( sent - start), 
+            "ms, serve: ", milliseconds( replied - sent), 
+            "ms, tpgetrply(TPGETANY): ", milliseconds( end - replied), "ms");
+
+         EXPECT_TRUE( common::algorithm::sort( descriptors) == common::algorithm::sort( received));
+         EXPECT_TRUE( ! context.pending());
+      }
+
    } // service
 } // casual
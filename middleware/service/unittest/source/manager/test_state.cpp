@@ -9,6 +9,9 @@
 
 #include "service/manager/state.h"
 #include "service/manager/admin/server.h"
+#include "service/manager/admin/model.h"
+
+#include "common/serialize/create.h"
 
 
 #include <random>
@@ -26,6 +29,26 @@ namespace casual
             {
                return manager::State{};
             }
+
+            namespace lookup
+            {
+               using Priority = state::service::pending::lookup::Priority;
+
+               auto pending( std::string service, Priority priority, std::optional< platform::time::point::type> deadline = {})
+               {
+                  common::message::service::lookup::Request request{ common::process::handle()};
+                  request.correlation = common::strong::correlation::id::emplace( common::uuid::make());
+                  request.requested = std::move( service);
+                  request.priority = priority;
+                  request.deadline = deadline;
+                  return state::service::pending::Lookup{ std::move( request), platform::time::clock::type::now()};
+               }
+
+               auto any()
+               {
+                  return []( const std::string&){ return true;};
+               }
+            } // lookup
             
          } // <unnamed>
       } // local
@@ -218,5 +241,196 @@ namespace casual
          }
       }
 
+      TEST( service_manager_state, pending_lookups__same_priority__expect_earliest_deadline_first__no_deadline_last)
+      {
+         common::unittest::Trace trace;
+
+         state::service::pending::Lookups lookups;
+         auto now = platform::time::clock::type::now();
+         using Priority = local::lookup::Priority;
+
+         auto none = local::lookup::pending( "a", Priority::regular);
+         auto late = local::lookup::pending( "a", Priority::regular, now + std::chrono::seconds{ 20});
+         auto early = local::lookup::pending( "a", Priority::regular, now + std::chrono::seconds{ 10});
+
+         std::vector< common::strong::correlation::id> expected{ early.request.correlation, late.request.correlation, none.request.correlation};
+
+         lookups.push( std::move( none));
+         lookups.push( std::move( late));
+         lookups.push( std::move( early));
+
+         EXPECT_TRUE( lookups.size() == 3);
+
+         for( auto& correlation : expected)
+         {
+            auto next = lookups.next( local::lookup::any());
+            ASSERT_TRUE( next);
+            EXPECT_TRUE( next->request.correlation == correlation);
+         }
+
+         EXPECT_TRUE( lookups.empty());
+         EXPECT_TRUE( ! lookups.next( local::lookup::any()));
+      }
+
+      TEST( service_manager_state, pending_lookups__100_of_each_priority__expect_weighted_dispatch)
+      {
+         common::unittest::Trace trace;
+
+         state::service::pending::Lookups lookups;
+         using Priority = local::lookup::Priority;
+
+         for( auto count = 0; count < 100; ++count)
+            for( auto priority : { Priority::batch, Priority::regular, Priority::interactive})
+               lookups.push( local::lookup::pending( "a", priority));
+
+         std::map< Priority, platform::size::type> dispatched;
+
+         // 13 dispatches is one 'round' with weights 8, 4, 1
+         for( auto count = 0; count < 13 * 5; ++count)
+         {
+            auto next = lookups.next( local::lookup::any());
+            ASSERT_TRUE( next);
+            ++dispatched[ next->request.priority];
+         }
+
+         EXPECT_TRUE( dispatched[ Priority::interactive] == 8 * 5) << CASUAL_NAMED_VALUE( dispatched[ Priority::interactive]);
+         EXPECT_TRUE( dispatched[ Priority::regular] == 4 * 5) << CASUAL_NAMED_VALUE( dispatched[ Priority::regular]);
+         EXPECT_TRUE( dispatched[ Priority::batch] == 1 * 5) << CASUAL_NAMED_VALUE( dispatched[ Priority::batch]);
+      }
+
+      TEST( service_manager_state, pending_lookups__extract_correlation__services__expect_removed)
+      {
+         common::unittest::Trace trace;
+
+         state::service::pending::Lookups lookups;
+         using Priority = local::lookup::Priority;
+
+         auto a = local::lookup::pending( "a", Priority::interactive);
+         auto correlation = a.request.correlation;
+         lookups.push( std::move( a));
+         lookups.push( local::lookup::pending( "b", Priority::batch));
+         lookups.push( local::lookup::pending( "b", Priority::regular));
+
+         EXPECT_TRUE( lookups.services().size() == 2);
+
+         auto found = lookups.extract( correlation);
+         ASSERT_TRUE( found);
+         EXPECT_TRUE( found->request.requested == "a");
+         EXPECT_TRUE( ! lookups.extract( correlation));
+         EXPECT_TRUE( ! lookups.next( []( auto& service){ return service == "a";}));
+
+         EXPECT_TRUE( lookups.extract( { "b"}).size() == 2);
+         EXPECT_TRUE( lookups.empty());
+         EXPECT_TRUE( lookups.services().empty());
+      }
+
+      TEST( service_manager_state, pending_lookups__ahead__expect_earlier_deadlines_and_weighted_share_of_others)
+      {
+         common::unittest::Trace trace;
+
+         state::service::pending::Lookups lookups;
+         auto now = platform::time::clock::type::now();
+         using Priority = local::lookup::Priority;
+
+         EXPECT_TRUE( lookups.ahead( "a", Priority::regular, now) == 0);
+
+         for( auto count = 0; count < 4; ++count)
+            lookups.push( local::lookup::pending( "a", Priority::regular, now + std::chrono::seconds{ count + 1}));
+
+         // 2 of own class with earlier deadline
+         EXPECT_TRUE( lookups.ahead( "a", Priority::regular, now + std::chrono::milliseconds{ 2500}) == 2);
+         // no deadline, all of own class
+         EXPECT_TRUE( lookups.ahead( "a", Priority::regular, {}) == 4);
+         // interactive gets 2 dispatches per regular dispatch
+         EXPECT_TRUE( lookups.ahead( "a", Priority::interactive, now) == 0);
+         // batch gets 1 dispatch per 4 regular dispatches
+         EXPECT_TRUE( lookups.ahead( "a", Priority::batch, now) == 4);
+         // other service
+         EXPECT_TRUE( lookups.ahead( "b", Priority::batch, now) == 0);
+      }
+
+      TEST( service_manager_state, pending_deadline__add_same_correlation_twice__expect_only_latest)
+      {
+         common::unittest::Trace trace;
+
+         state::service::pending::Deadline deadline;
+
+         auto now = platform::time::clock::type::now();
+         auto correlation = common::strong::correlation::id::emplace( common::uuid::make());
+
+         deadline.add( { now + std::chrono::milliseconds{ 10}, correlation});
+         deadline.add( { now + std::chrono::hours{ 1}, correlation});
+
+         EXPECT_TRUE( deadline.size() == 1);
+
+         // the first deadline is replaced, and does not expire
+         EXPECT_TRUE( deadline.expired( now + std::chrono::seconds{ 1}).empty());
+
+         auto expired = deadline.expired( now + std::chrono::hours{ 2});
+         ASSERT_TRUE( expired.size() == 1);
+         EXPECT_TRUE( expired.at( 0).correlation == correlation);
+         EXPECT_TRUE( deadline.size() == 0);
+      }
+
+      TEST( service_manager_state, serialize_large_admin_model__yaml_json___expect_same_services)
+      {
+         common::unittest::Trace trace;
+
+         // exercises the transcoding of string fields for all string-based archives, 
+         // and logs the elapsed time to the unittest log
+         auto model = []()
+         {
+            admin::model::State result;
+
+            constexpr auto instances = 100;
+            constexpr auto services = 10000;
+
+            for( auto index = 0; index < instances; ++index)
+            {
+               admin::model::instance::Sequential instance;
+               instance.process.pid = common::strong::process::id{ index + 1};
+               result.instances.sequential.push_back( std::move( instance));
+            }
+
+            for( auto index = 0; index < services; ++index)
+            {
+               admin::model::Service service;
+               service.name = common::string::compose( "some.service.name.", index);
+               service.category = "some/category";
+               service.instances.sequential.push_back( { common::strong::process::id{ ( index % instances) + 1}});
+               result.services.push_back( std::move( service));
+            }
+
+            result.routes.push_back( { "a", "b"});
+
+            return result;
+         }();
+
+         for( auto protocol : { "yaml", "json"})
+         {
+            auto start = platform::time::clock::type::now();
+
+            auto writer = common::serialize::create::writer::from( protocol);
+            writer << CASUAL_NAMED_VALUE( model);
+            auto stream = writer.consume< std::stringstream>();
+
+            auto written = platform::time::clock::type::now();
+
+            admin::model::State result;
+            auto reader = common::serialize::create::reader::consumed::from( protocol, stream);
+            reader >> CASUAL_NAMED_VALUE_NAME( result, "model");
+
+            auto end = platform::time::clock::type::now();
+
+            common::log::line( common::unittest::log, "protocol: ", protocol, 
+               " - write: ", std::chrono::duration_cast< std::chrono::milliseconds>( written - start).count(), 
+               "ms, read: ", std::chrono::duration_cast< std::chrono::milliseconds>( end - written).count(), "ms");
+
+            ASSERT_TRUE( result.services.size() == model.services.size()) << "protocol: " << protocol;
+            EXPECT_TRUE( result.services.back().name == model.services.back().name);
+            EXPECT_TRUE( result.instances.sequential.size() == model.instances.sequential.size());
+         }
+      }
+
    } // service::manager
 } // casual
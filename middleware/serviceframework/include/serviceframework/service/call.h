@@ -52,6 +52,36 @@ namespace casual
             Result invoke( descriptor_type descriptor, Flags flags = Flags{});
          } // receive
 
+         namespace scatter
+         {
+            using Request = common::service::call::scatter::Request;
+            using Result = common::service::call::scatter::Result;
+            using Flag = send::Flag;
+            using Flags = send::Flags;
+
+            //! calls all services in @p requests as one batch, with a shared @p deadline
+            //! @return one result per request, in the same order
+            std::vector< Result> invoke( 
+               std::vector< Request> requests, 
+               Flags flags = Flags{}, 
+               std::optional< platform::time::point::type> deadline = {});
+
+         } // scatter
+
+         namespace gather
+         {
+            using Result = common::service::call::gather::Result;
+            using Flag = receive::Flag;
+            using Flags = receive::Flags;
+
+            //! @return the first reply to complete of the calls in @p descriptors
+            Result invoke( const std::vector< descriptor_type>& descriptors, Flags flags = Flags{});
+
+            //! @return the replies of all calls in @p descriptors, in the order they completed
+            std::vector< Result> all( std::vector< descriptor_type> descriptors, Flags flags = Flags{});
+
+         } // gather
+
       } // service
    } // serviceframework
 } // casual
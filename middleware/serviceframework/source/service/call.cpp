@@ -8,6 +8,9 @@
 #include "serviceframework/service/call.h"
 #include "serviceframework/log.h"
 
+#include "common/algorithm.h"
+#include "common/algorithm/container.h"
+
 
 
 namespace casual
@@ -47,6 +50,42 @@ namespace casual
             }
          } // receive
 
+         namespace scatter
+         {
+            std::vector< Result> invoke( std::vector< Request> requests, Flags flags, std::optional< platform::time::point::type> deadline)
+            {
+               Trace trace{ "sf::service::scatter::invoke"};
+
+               return common::service::call::context().scatter( std::move( requests), flags, deadline);
+            }
+         } // scatter
+
+         namespace gather
+         {
+            Result invoke( const std::vector< descriptor_type>& descriptors, Flags flags)
+            {
+               Trace trace{ "sf::service::gather::invoke"};
+
+               return common::service::call::context().gather( descriptors, flags);
+            }
+
+            std::vector< Result> all( std::vector< descriptor_type> descriptors, Flags flags)
+            {
+               Trace trace{ "sf::service::gather::all"};
+
+               std::vector< Result> result;
+               result.reserve( descriptors.size());
+
+               while( ! descriptors.empty())
+               {
+                  result.push_back( common::service::call::context().gather( descriptors, flags));
+                  common::algorithm::container::trim( descriptors, common::algorithm::remove( descriptors, result.back().descriptor));
+               }
+
+               return result;
+            }
+         } // gather
+
 
       } // service
    } // serviceframework
@@ -0,0 +1,156 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#pragma once
+
+#include "common/serialize/macro.h"
+
+#include "casual/platform.h"
+
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+namespace casual
+{
+   namespace tools::service::call
+   {
+      namespace histogram
+      {
+         //! each power of two range is divided in 2^bits linear buckets, which gives
+         //! a relative error less than 1%
+         constexpr platform::size::type bits = 7;
+         constexpr platform::size::type buckets = 1 << bits;
+
+         using resolution = std::chrono::microseconds;
+
+      } // histogram
+
+      //! A log-linear latency histogram, in the spirit of HdrHistogram.
+      //!
+      //! Durations are recorded with microsecond resolution, values below `2 * histogram::buckets`
+      //! microseconds are exact, above that the relative error is at most `1 / histogram::buckets`.
+      class Histogram
+      {
+      public:
+         using duration_type = platform::time::unit;
+
+         void record( duration_type duration)
+         {
+            auto value = std::max( std::chrono::duration_cast< histogram::resolution>( duration).count(), decltype( duration.count()){ 0});
+            auto index = Histogram::index( value);
+
+            if( index >= static_cast< platform::size::type>( m_counts.size()))
+               m_counts.resize( index + 1);
+
+            ++m_counts[ index];
+
+            if( m_count == 0 || value < m_min)
+               m_min = value;
+            m_max = std::max( m_max, value);
+            m_total += value;
+            ++m_count;
+         }
+
+         //! @returns the value that `percentile` (0-100) of the recorded values are less or equal to.
+         duration_type percentile( double percentile) const
+         {
+            if( m_count == 0)
+               return {};
+
+            auto target = static_cast< platform::size::type>( std::ceil( std::clamp( percentile, 0.0, 100.0) / 100.0 * m_count));
+            target = std::max( target, platform::size::type{ 1});
+
+            platform::size::type accumulated = 0;
+
+            for( platform::size::type index = 0; index < static_cast< platform::size::type>( m_counts.size()); ++index)
+            {
+               accumulated += m_counts[ index];
+               if( accumulated >= target)
+                  return convert( std::min( Histogram::highest( index), m_max));
+            }
+
+            return max();
+         }
+
+         inline platform::size::type count() const noexcept { return m_count;}
+         inline duration_type min() const noexcept { return convert( m_min);}
+         inline duration_type max() const noexcept { return convert( m_max);}
+         inline duration_type mean() const noexcept { return m_count == 0 ? duration_type{} : convert( m_total / m_count);}
+
+         inline void clear() { *this = Histogram{};}
+
+         friend Histogram& operator += ( Histogram& lhs, const Histogram& rhs)
+         {
+            if( rhs.m_count == 0)
+               return lhs;
+
+            if( lhs.m_counts.size() < rhs.m_counts.size())
+               lhs.m_counts.resize( rhs.m_counts.size());
+
+            std::transform( std::begin( rhs.m_counts), std::end( rhs.m_counts), std::begin( lhs.m_counts), std::begin( lhs.m_counts), std::plus<>{});
+
+            lhs.m_min = lhs.m_count == 0 ? rhs.m_min : std::min( lhs.m_min, rhs.m_min);
+            lhs.m_max = std::max( lhs.m_max, rhs.m_max);
+            lhs.m_total += rhs.m_total;
+            lhs.m_count += rhs.m_count;
+
+            return lhs;
+         }
+
+         CASUAL_LOG_SERIALIZE(
+            CASUAL_SERIALIZE_NAME( m_count, "count");
+            CASUAL_SERIALIZE_NAME( min(), "min");
+            CASUAL_SERIALIZE_NAME( max(), "max");
+         )
+
+      private:
+         using value_type = std::chrono::microseconds::rep;
+
+         static duration_type convert( value_type value)
+         {
+            return std::chrono::duration_cast< duration_type>( histogram::resolution{ value});
+         }
+
+         static platform::size::type index( value_type value) noexcept
+         {
+            constexpr value_type exact = 2 * histogram::buckets;
+
+            if( value < exact)
+               return value;
+
+            // the position of the highest bit, at least histogram::bits + 1
+            platform::size::type exponent = 63 - __builtin_clzll( value);
+            auto shift = exponent - histogram::bits;
+            auto mantissa = value >> shift;
+
+            return exact + ( shift - 1) * histogram::buckets + ( mantissa - histogram::buckets);
+         }
+
+         //! @returns the highest value that maps to `index`
+         static value_type highest( platform::size::type index) noexcept
+         {
+            constexpr platform::size::type exact = 2 * histogram::buckets;
+
+            if( index < exact)
+               return index;
+
+            auto shift = ( index - exact) / histogram::buckets + 1;
+            value_type mantissa = ( index - exact) % histogram::buckets + histogram::buckets;
+
+            return ( ( mantissa + 1) << shift) - 1;
+         }
+
+         std::vector< platform::size::type> m_counts;
+         platform::size::type m_count = 0;
+         value_type m_min = 0;
+         value_type m_max = 0;
+         value_type m_total = 0;
+      };
+
+   } // tools::service::call
+} // casual
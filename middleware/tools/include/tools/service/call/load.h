@@ -0,0 +1,64 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#pragma once
+
+#include "casual/platform.h"
+#include "common/serialize/macro.h"
+
+#include <string>
+#include <vector>
+#include <optional>
+
+namespace casual
+{
+   namespace tools::service::call::load
+   {
+      struct Settings
+      {
+         std::string service;
+
+         //! max number of calls in flight
+         platform::size::type concurrency = 1;
+
+         //! target rate in calls per second. 0 -> closed loop, a new call as soon as one completes
+         platform::size::type rate = 0;
+
+         //! calls started during warmup are not part of the report
+         platform::time::unit warmup{};
+         platform::time::unit duration{};
+
+         //! if set, interval reports are printed
+         platform::time::unit interval{};
+
+         //! files with payloads (casual-pipe format), if empty payloads are read from stdin
+         std::vector< std::string> files;
+
+         //! if set, the report is serialized with the format, otherwise human readable
+         std::optional< std::string> format;
+
+         CASUAL_LOG_SERIALIZE(
+            CASUAL_SERIALIZE( service);
+            CASUAL_SERIALIZE( concurrency);
+            CASUAL_SERIALIZE( rate);
+            CASUAL_SERIALIZE( warmup);
+            CASUAL_SERIALIZE( duration);
+            CASUAL_SERIALIZE( interval);
+            CASUAL_SERIALIZE( files);
+            CASUAL_SERIALIZE( format);
+         )
+      };
+
+      //! generates load to `settings.service`, with the payloads from stdin or `settings.files`,
+      //! and prints the throughput and latency report to stdout.
+      //!
+      //! With a target rate the calls are scheduled open loop, and the latency is measured from the
+      //! _intended_ start of the call, so the time a call waits for a free slot is included (no
+      //! coordinated omission).
+      void invoke( const Settings& settings);
+
+   } // tools::service::call::load
+} // casual
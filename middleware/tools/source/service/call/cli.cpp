@@ -7,6 +7,7 @@
 #define CASUAL_NO_XATMI_UNDEFINE
 
 #include "tools/service/call/cli.h"
+#include "tools/service/call/load.h"
 
 #include "common/argument.h"
 #include <optional>
@@ -19,6 +20,7 @@
 #include "common/communication/select.h"
 #include "common/communication/ipc.h"
 #include "common/communication/instance.h"
+#include "common/chronology.h"
 
 #include "casual/cli/pipe.h"
 
@@ -420,6 +422,9 @@ fields:
 
 from a dequeue
 `host# casual queue --dequeue qA | casual call --service a | casual queue --enqueue qB`
+
+load generation, 200 calls per second with at most 10 concurrent calls, for one minute:
+`host# echo '{ "key" : "some"}' | casual buffer --compose ".json/" | casual call --service a --concurrency 10 --rate 200 --warmup 5s --duration 1min --interval 10s`
 )";
 
                   };
@@ -427,6 +432,28 @@ from a dequeue
                   return argument::Option{ invoke, { "--examples"}, "prints several examples of how casual call can be used"};
 
                }
+
+               namespace load
+               {
+                  auto duration( platform::time::unit& target)
+                  {
+                     return [&target]( const std::string& value)
+                     {
+                        target = common::chronology::from::string( value);
+                     };
+                  }
+
+                  auto complete_duration = []( auto values, bool) -> std::vector< std::string>
+                  {
+                     return { "<duration>"};
+                  };
+
+                  auto complete_format = []( auto values, bool) -> std::vector< std::string>
+                  {
+                     return { "json", "yaml", "xml", "ini"};
+                  };
+
+               } // load
             } // option
          } // <unnamed>
       } // local
@@ -437,7 +464,12 @@ from a dequeue
          {
             auto invoked = [&]()
             {
-               if( terminal::output::directive().block())
+               if( m_load.duration > platform::time::unit::zero())
+               {
+                  m_load.service = m_state.service;
+                  call::load::invoke( m_load);
+               }
+               else if( terminal::output::directive().block())
                   local::blocking::call( m_state);
                else
                   local::call( m_state);
@@ -467,6 +499,21 @@ Errors will be printed to stderr
                argument::Option( std::tie( m_state.iterations), { "--iterations"}, "number of iterations (default: 1) - this could be helpful for testing load"),
                local::option::examples( m_state),
 
+               // load generation
+               argument::Option( local::option::load::duration( m_load.duration), local::option::load::complete_duration, { "--duration"}, R"(enables load generation for the duration (example: 30s)
+
+Calls the service with the payload(s) from stdin, or from --payload files, and prints a throughput 
+and latency report to stdout. Replies are discarded.)"),
+               argument::Option( local::option::load::duration( m_load.warmup), local::option::load::complete_duration, { "--warmup"}, "load: warmup duration, calls started during warmup are not measured (default: 0)"),
+               argument::Option( std::tie( m_load.concurrency), { "--concurrency"}, "load: max number of concurrent calls (default: 1)"),
+               argument::Option( std::tie( m_load.rate), { "--rate"}, R"(load: target rate in calls per second (default: 0 - closed loop)
+
+The calls are scheduled open loop, and the latency is measured from the intended start of the call, 
+hence the time waiting for a free --concurrency slot is included.)"),
+               argument::Option( local::option::load::duration( m_load.interval), local::option::load::complete_duration, { "--interval"}, "load: prints a report for each interval (example: 1s)"),
+               argument::Option( std::tie( m_load.files), { "--payload"}, "load: files with payload(s) in casual-pipe format, used instead of stdin"),
+               argument::Option( std::tie( m_load.format), local::option::load::complete_format, { "--format"}, "load: output format of the report (default: human readable)"),
+
                // deprecated
                argument::Option( deprecated( asynchronous_information), argument::option::keys( {}, { "--asynchronous"}), asynchronous_information),
                argument::Option( deprecated( transaction_information), argument::option::keys( {}, { "--transaction"}), transaction_information),
@@ -474,6 +521,7 @@ Errors will be printed to stderr
          }
 
          local::State m_state;
+         call::load::Settings m_load;
       };
 
       cli::cli() = default; 
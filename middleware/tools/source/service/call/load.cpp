@@ -0,0 +1,574 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#define CASUAL_NO_XATMI_UNDEFINE
+
+#include "tools/service/call/load.h"
+#include "tools/service/call/histogram.h"
+
+#include "casual/cli/pipe.h"
+
+#include "common/message/service.h"
+#include "common/message/dispatch.h"
+#include "common/communication/select.h"
+#include "common/communication/ipc.h"
+#include "common/communication/instance.h"
+#include "common/communication/stream.h"
+#include "common/timer/descriptor.h"
+#include "common/serialize/create.h"
+#include "common/code/raise.h"
+#include "common/code/xatmi.h"
+#include "common/predicate.h"
+#include "common/log.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <unordered_map>
+
+namespace casual
+{
+   using namespace common;
+
+   namespace tools::service::call::load
+   {
+      namespace local
+      {
+         namespace
+         {
+            namespace payload
+            {
+               template< typename D>
+               void read( D&& device, std::istream& stream, std::vector< casual::cli::message::Payload>& payloads)
+               {
+                  bool done = false;
+
+                  auto handler = common::message::dispatch::handler( device,
+                     casual::cli::pipe::discard::handle::defaults(),
+                     [&payloads]( casual::cli::message::Payload& message)
+                     {
+                        payloads.push_back( std::move( message));
+                     },
+                     casual::cli::pipe::handle::done( done));
+
+                  common::message::dispatch::pump(
+                     common::message::dispatch::condition::compose(
+                        common::message::dispatch::condition::done( [&]()
+                        {
+                           return done || stream.peek() == std::istream::traits_type::eof();
+                        })),
+                     handler,
+                     device);
+               }
+
+               auto read( const Settings& settings)
+               {
+                  Trace trace{ "tools::service::call::load::local::payload::read"};
+
+                  std::vector< casual::cli::message::Payload> result;
+
+                  if( settings.files.empty())
+                  {
+                     if( ! casual::cli::pipe::terminal::in())
+                        read( communication::stream::inbound::Device{ std::cin}, std::cin, result);
+                  }
+
+                  for( auto& name : settings.files)
+                  {
+                     std::ifstream file{ name};
+                     if( ! file)
+                        code::raise::error( code::casual::invalid_argument, "failed to open payload file: ", name);
+
+                     read( communication::stream::inbound::Device{ file}, file, result);
+                  }
+
+                  if( result.empty())
+                     code::raise::error( code::casual::invalid_argument, "no payloads - provide payloads via stdin or --payload");
+
+                  log::line( verbose::log, "payloads: ", result.size());
+
+                  return result;
+               }
+            } // payload
+
+            struct Report
+            {
+               struct Latency
+               {
+                  platform::time::unit min{};
+                  platform::time::unit mean{};
+                  platform::time::unit p50{};
+                  platform::time::unit p90{};
+                  platform::time::unit p99{};
+                  platform::time::unit p999{};
+                  platform::time::unit max{};
+
+                  static Latency create( const Histogram& histogram)
+                  {
+                     Latency result;
+                     result.min = histogram.min();
+                     result.mean = histogram.mean();
+                     result.p50 = histogram.percentile( 50);
+                     result.p90 = histogram.percentile( 90);
+                     result.p99 = histogram.percentile( 99);
+                     result.p999 = histogram.percentile( 99.9);
+                     result.max = histogram.max();
+                     return result;
+                  }
+
+                  CASUAL_CONST_CORRECT_SERIALIZE(
+                     CASUAL_SERIALIZE( min);
+                     CASUAL_SERIALIZE( mean);
+                     CASUAL_SERIALIZE( p50);
+                     CASUAL_SERIALIZE( p90);
+                     CASUAL_SERIALIZE( p99);
+                     CASUAL_SERIALIZE( p999);
+                     CASUAL_SERIALIZE( max);
+                  )
+               };
+
+               struct Interval
+               {
+                  platform::time::unit offset{};
+                  platform::size::type calls{};
+                  platform::size::type errors{};
+                  double throughput{};
+                  Latency latency;
+
+                  CASUAL_CONST_CORRECT_SERIALIZE(
+                     CASUAL_SERIALIZE( offset);
+                     CASUAL_SERIALIZE( calls);
+                     CASUAL_SERIALIZE( errors);
+                     CASUAL_SERIALIZE( throughput);
+                     CASUAL_SERIALIZE( latency);
+                  )
+               };
+
+               std::string service;
+               platform::size::type concurrency{};
+               platform::size::type rate{};
+               platform::time::unit duration{};
+               platform::size::type calls{};
+               platform::size::type errors{};
+               double throughput{};
+               Latency latency;
+               std::vector< Interval> intervals;
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( service);
+                  CASUAL_SERIALIZE( concurrency);
+                  CASUAL_SERIALIZE( rate);
+                  CASUAL_SERIALIZE( duration);
+                  CASUAL_SERIALIZE( calls);
+                  CASUAL_SERIALIZE( errors);
+                  CASUAL_SERIALIZE( throughput);
+                  CASUAL_SERIALIZE( latency);
+                  CASUAL_SERIALIZE( intervals);
+               )
+            };
+
+            namespace print
+            {
+               auto milliseconds( platform::time::unit duration)
+               {
+                  return std::chrono::duration< double, std::milli>{ duration}.count();
+               }
+
+               void latency( std::ostream& out, const Report::Latency& latency)
+               {
+                  out << std::fixed << std::setprecision( 3)
+                     << "min: " << milliseconds( latency.min) << "ms"
+                     << ", mean: " << milliseconds( latency.mean) << "ms"
+                     << ", p50: " << milliseconds( latency.p50) << "ms"
+                     << ", p90: " << milliseconds( latency.p90) << "ms"
+                     << ", p99: " << milliseconds( latency.p99) << "ms"
+                     << ", p99.9: " << milliseconds( latency.p999) << "ms"
+                     << ", max: " << milliseconds( latency.max) << "ms";
+               }
+
+               void interval( std::ostream& out, const Report::Interval& interval)
+               {
+                  out << std::fixed << std::setprecision( 1)
+                     << std::setw( 8) << std::chrono::duration< double>{ interval.offset}.count() << "s"
+                     << " - calls: " << interval.calls
+                     << ", errors: " << interval.errors
+                     << ", throughput: " << interval.throughput << "/s, ";
+                  print::latency( out, interval.latency);
+                  out << std::endl;
+               }
+
+               void report( std::ostream& out, const Report& report)
+               {
+                  out << std::fixed << std::setprecision( 1)
+                     << "service:     " << report.service << '\n'
+                     << "concurrency: " << report.concurrency << '\n'
+                     << "rate:        " << ( report.rate == 0 ? std::string{ "closed loop"} : std::to_string( report.rate) + "/s") << '\n'
+                     << "duration:    " << std::chrono::duration< double>{ report.duration}.count() << "s\n"
+                     << "calls:       " << report.calls << '\n'
+                     << "errors:      " << report.errors << '\n'
+                     << "throughput:  " << report.throughput << "/s\n"
+                     << "latency:\n";
+
+                  auto row = [&out]( std::string_view name, platform::time::unit value)
+                  {
+                     out << "  " << std::left << std::setw( 6) << name << std::right << std::setw( 12) << std::fixed << std::setprecision( 3) << print::milliseconds( value) << "ms\n";
+                  };
+
+                  row( "min", report.latency.min);
+                  row( "mean", report.latency.mean);
+                  row( "p50", report.latency.p50);
+                  row( "p90", report.latency.p90);
+                  row( "p99", report.latency.p99);
+                  row( "p99.9", report.latency.p999);
+                  row( "max", report.latency.max);
+               }
+            } // print
+
+            struct State
+            {
+               State( const Settings& settings, std::vector< casual::cli::message::Payload> payloads)
+                  : settings{ settings}, payloads{ std::move( payloads)}
+               {
+                  start = platform::time::clock::type::now();
+                  measure = start + settings.warmup;
+                  end = measure + settings.duration;
+                  interval.next = measure + settings.interval;
+               }
+
+               struct Call
+               {
+                  //! when the call should have started. Open loop: the scheduled time, closed loop: when it was started
+                  platform::time::point::type intended;
+                  platform::size::type payload{};
+               };
+
+               const Settings& settings;
+               std::vector< casual::cli::message::Payload> payloads;
+
+               platform::time::point::type start;
+               platform::time::point::type measure;
+               platform::time::point::type end;
+
+               //! number of started calls, used to schedule the open loop calls
+               platform::size::type sequence = 0;
+
+               struct
+               {
+                  std::unordered_map< strong::correlation::id, Call> lookups;
+                  std::unordered_map< strong::correlation::id, Call> calls;
+
+                  platform::size::type size() const noexcept { return lookups.size() + calls.size();}
+               } pending;
+
+               Histogram histogram;
+               platform::size::type errors = 0;
+
+               struct
+               {
+                  platform::time::point::type next;
+                  Histogram histogram;
+                  platform::size::type errors = 0;
+               } interval;
+
+               std::vector< Report::Interval> intervals;
+
+               common::timer::Descriptor timer;
+
+               //! @returns the intended start of the next call, if it could be started
+               std::optional< platform::time::point::type> scheduled( platform::time::point::type now) const
+               {
+                  if( pending.size() >= settings.concurrency)
+                     return {};
+
+                  if( settings.rate == 0)
+                  {
+                     if( now >= end)
+                        return {};
+                     return now;
+                  }
+
+                  auto intended = next();
+
+                  if( intended >= end || intended > now)
+                     return {};
+
+                  return intended;
+               }
+
+               //! @returns the scheduled start of the next open loop call
+               platform::time::point::type next() const
+               {
+                  return start + std::chrono::duration_cast< platform::time::unit>(
+                     std::chrono::duration< double>{ static_cast< double>( sequence) / settings.rate});
+               }
+
+               bool done() const
+               {
+                  if( pending.size() > 0 || platform::time::clock::type::now() < end)
+                     return false;
+
+                  // open loop calls that are scheduled before the end, but still wait for a free slot
+                  return settings.rate == 0 || next() >= end;
+               }
+
+               void complete( const Call& call, platform::time::point::type now, bool error)
+               {
+                  // only calls that are intended to start after the warmup are measured
+                  if( call.intended < measure)
+                     return;
+
+                  if( error)
+                  {
+                     ++errors;
+                     ++interval.errors;
+                     return;
+                  }
+
+                  histogram.record( now - call.intended);
+                  interval.histogram.record( now - call.intended);
+               }
+            };
+
+            namespace call
+            {
+               void start( State& state, platform::time::point::type intended)
+               {
+                  auto index = state.sequence++ % static_cast< platform::size::type>( state.payloads.size());
+
+                  common::message::service::lookup::Request request{ process::handle()};
+                  request.requested = state.settings.service;
+                  request.context = decltype( request.context)::no_busy_intermediate;
+
+                  auto correlation = communication::device::blocking::send( communication::instance::outbound::service::manager::device(), request);
+                  state.pending.lookups.emplace( correlation, State::Call{ intended, index});
+               }
+
+               //! starts all calls that are due, and arms the timer to the next time we need to act
+               void schedule( State& state)
+               {
+                  auto now = platform::time::clock::type::now();
+
+                  while( auto intended = state.scheduled( now))
+                     call::start( state, *intended);
+
+                  if( state.settings.interval > platform::time::unit::zero() && now >= state.interval.next)
+                  {
+                     Report::Interval interval;
+                     interval.offset = state.interval.next - state.measure;
+                     interval.calls = state.interval.histogram.count();
+                     interval.errors = state.interval.errors;
+                     interval.throughput = interval.calls / std::chrono::duration< double>{ state.settings.interval}.count();
+                     interval.latency = Report::Latency::create( state.interval.histogram);
+
+                     if( ! state.settings.format)
+                        print::interval( std::cout, interval);
+
+                     state.intervals.push_back( std::move( interval));
+
+                     state.interval.histogram.clear();
+                     state.interval.errors = 0;
+                     state.interval.next += state.settings.interval;
+                  }
+
+                  // next time we need to wake up, if nothing else happens
+                  auto next = state.end;
+
+                  if( state.settings.rate > 0 && state.pending.size() < state.settings.concurrency)
+                     next = std::min( next, state.next());
+
+                  if( state.settings.interval > platform::time::unit::zero())
+                     next = std::min( next, state.interval.next);
+
+                  // after the end we just wait for the pending replies
+                  if( now < state.end)
+                     state.timer.set( next);
+                  else
+                     state.timer.unset();
+               }
+            } // call
+
+            namespace handle
+            {
+               auto lookup( State& state)
+               {
+                  return [&state]( common::message::service::lookup::Reply& message)
+                  {
+                     Trace trace{ "tools::service::call::load::local::handle::lookup"};
+                     log::line( verbose::log, "message: ", message);
+
+                     auto found = state.pending.lookups.find( message.correlation);
+                     if( found == std::end( state.pending.lookups))
+                        return;
+
+                     auto call = found->second;
+                     state.pending.lookups.erase( found);
+
+                     switch( message.state)
+                     {
+                        using Enum = decltype( message.state);
+                        case Enum::idle:
+                        {
+                           auto& payload = state.payloads[ call.payload];
+
+                           common::message::service::call::caller::Request request{ common::buffer::payload::Send{ payload.payload}};
+                           request.process = process::handle();
+                           request.service = message.service;
+                           request.pending = message.pending;
+
+                           using Type = common::service::transaction::Type;
+                           if( algorithm::compare::any( message.service.transaction, Type::automatic, Type::join, Type::branch))
+                              request.trid = payload.transaction.trid;
+
+                           auto correlation = communication::device::blocking::send( message.process.ipc, request);
+                           state.pending.calls.emplace( correlation, call);
+                           break;
+                        }
+                        case Enum::absent:
+                        {
+                           code::raise::error( code::xatmi::no_entry, "service: ", message.service.name);
+                        }
+                        default:
+                        {
+                           // busy should not happen with no_busy_intermediate, rejected due to deadline
+                           state.complete( call, platform::time::clock::type::now(), true);
+                           break;
+                        }
+                     }
+
+                     call::schedule( state);
+                  };
+               }
+
+               auto reply( State& state)
+               {
+                  return [&state]( common::message::service::call::Reply& message)
+                  {
+                     Trace trace{ "tools::service::call::load::local::handle::reply"};
+
+                     auto now = platform::time::clock::type::now();
+
+                     auto found = state.pending.calls.find( message.correlation);
+                     if( found == std::end( state.pending.calls))
+                     {
+                        log::line( log::category::error, "failed to correlate reply: ", message.correlation);
+                        return;
+                     }
+
+                     state.complete( found->second, now, message.code.result != code::xatmi::ok);
+                     state.pending.calls.erase( found);
+
+                     call::schedule( state);
+                  };
+               }
+            } // handle
+
+            namespace dispatch
+            {
+               template< typename H>
+               struct ipc
+               {
+                  ipc( H handler) : m_handler{ std::move( handler)} {}
+
+                  bool operator () ( communication::select::tag::consume)
+                  {
+                     return predicate::boolean( m_handler( communication::ipc::inbound::device().cached()));
+                  }
+
+                  bool operator() ( strong::file::descriptor::id descriptor, communication::select::tag::read)
+                  {
+                     if( communication::ipc::inbound::device().connector().descriptor() != descriptor)
+                        return false;
+
+                     m_handler( communication::device::non::blocking::next( communication::ipc::inbound::device()));
+                     return true;
+                  }
+
+               private:
+                  H m_handler;
+               };
+
+               struct timer
+               {
+                  timer( State& state) : m_state{ &state} {}
+
+                  bool operator() ( strong::file::descriptor::id descriptor, communication::select::tag::read)
+                  {
+                     if( m_state->timer.descriptor() != descriptor)
+                        return false;
+
+                     m_state->timer.consume();
+                     call::schedule( *m_state);
+                     return true;
+                  }
+
+               private:
+                  State* m_state;
+               };
+            } // dispatch
+
+            Report report( const State& state, platform::time::point::type stop)
+            {
+               Report result;
+               result.service = state.settings.service;
+               result.concurrency = state.settings.concurrency;
+               result.rate = state.settings.rate;
+               result.duration = stop - state.measure;
+               result.calls = state.histogram.count();
+               result.errors = state.errors;
+               if( result.duration > platform::time::unit::zero())
+                  result.throughput = result.calls / std::chrono::duration< double>{ result.duration}.count();
+               result.latency = Report::Latency::create( state.histogram);
+               result.intervals = state.intervals;
+               return result;
+            }
+
+         } // <unnamed>
+      } // local
+
+      void invoke( const Settings& settings)
+      {
+         Trace trace{ "tools::service::call::load::invoke"};
+         log::line( verbose::log, "settings: ", settings);
+
+         if( settings.concurrency <= 0)
+            code::raise::error( code::casual::invalid_argument, "concurrency has to be at least 1");
+
+         if( settings.duration <= platform::time::unit::zero())
+            code::raise::error( code::casual::invalid_argument, "duration has to be set");
+
+         local::State state{ settings, local::payload::read( settings)};
+
+         auto& ipc = communication::ipc::inbound::device();
+
+         communication::select::Directive directive;
+         directive.read.add( ipc.connector().descriptor());
+         directive.read.add( state.timer.descriptor());
+
+         local::call::schedule( state);
+
+         communication::select::dispatch::pump(
+            communication::select::dispatch::condition::compose(
+               communication::select::dispatch::condition::done( [&state]() { return state.done();})),
+            directive,
+            local::dispatch::ipc{ common::message::dispatch::handler( ipc,
+               local::handle::lookup( state),
+               local::handle::reply( state))},
+            local::dispatch::timer{ state});
+
+         auto report = local::report( state, std::max( platform::time::clock::type::now(), state.end));
+
+         if( settings.format)
+         {
+            auto archive = common::serialize::create::writer::from( settings.format.value());
+            archive << CASUAL_NAMED_VALUE( report);
+            archive.consume( std::cout);
+         }
+         else
+            local::print::report( std::cout, report);
+      }
+
+   } // tools::service::call::load
+} // casual
@@ -0,0 +1,99 @@
+//!
+//! Copyright (c) 2021, The casual project
+//!
+//! This software is licensed under the MIT license, https://opensource.org/licenses/MIT
+//!
+
+#include "common/unittest.h"
+
+#include "tools/service/call/histogram.h"
+
+#include <random>
+
+namespace casual
+{
+   namespace tools::service::call
+   {
+      TEST( tools_service_call_histogram, empty)
+      {
+         common::unittest::Trace trace;
+
+         Histogram histogram;
+
+         EXPECT_TRUE( histogram.count() == 0);
+         EXPECT_TRUE( histogram.percentile( 50) == platform::time::unit::zero());
+         EXPECT_TRUE( histogram.mean() == platform::time::unit::zero());
+      }
+
+      TEST( tools_service_call_histogram, exact_range__expect_exact_percentiles)
+      {
+         common::unittest::Trace trace;
+
+         Histogram histogram;
+
+         // 1..100 us
+         for( auto value = 1; value <= 100; ++value)
+            histogram.record( std::chrono::microseconds{ value});
+
+         EXPECT_TRUE( histogram.count() == 100);
+         EXPECT_TRUE( histogram.min() == std::chrono::microseconds{ 1});
+         EXPECT_TRUE( histogram.max() == std::chrono::microseconds{ 100});
+         EXPECT_TRUE( histogram.percentile( 50) == std::chrono::microseconds{ 50});
+         EXPECT_TRUE( histogram.percentile( 99) == std::chrono::microseconds{ 99});
+         EXPECT_TRUE( histogram.percentile( 100) == std::chrono::microseconds{ 100});
+      }
+
+      TEST( tools_service_call_histogram, random_values__expect_percentiles_within_one_percent)
+      {
+         common::unittest::Trace trace;
+
+         Histogram histogram;
+         std::vector< std::chrono::microseconds> values;
+
+         std::mt19937 engine{ 42};
+         std::lognormal_distribution< double> distribution{ 8.0, 2.0};
+
+         for( auto count = 0; count < 100000; ++count)
+         {
+            auto value = std::chrono::microseconds{ static_cast< std::int64_t>( distribution( engine))};
+            values.push_back( value);
+            histogram.record( value);
+         }
+
+         std::sort( std::begin( values), std::end( values));
+
+         for( auto percentile : { 50.0, 90.0, 99.0, 99.9})
+         {
+            auto index = static_cast< platform::size::type>( std::ceil( percentile / 100.0 * values.size())) - 1;
+            auto expected = values[ index].count();
+            auto actual = std::chrono::duration_cast< std::chrono::microseconds>( histogram.percentile( percentile)).count();
+
+            EXPECT_TRUE( actual >= expected) << "percentile: " << percentile << " expected: " << expected << " actual: " << actual;
+            EXPECT_TRUE( actual - expected <= expected / 100) << "percentile: " << percentile << " expected: " << expected << " actual: " << actual;
+         }
+
+         EXPECT_TRUE( histogram.max() == values.back());
+      }
+
+      TEST( tools_service_call_histogram, merge__expect_combined)
+      {
+         common::unittest::Trace trace;
+
+         Histogram a;
+         Histogram b;
+
+         a.record( std::chrono::milliseconds{ 1});
+         b.record( std::chrono::seconds{ 1});
+         b.record( std::chrono::microseconds{ 10});
+
+         a += b;
+
+         EXPECT_TRUE( a.count() == 3);
+         EXPECT_TRUE( a.min() == std::chrono::microseconds{ 10});
+         EXPECT_TRUE( a.max() == std::chrono::seconds{ 1});
+         EXPECT_TRUE( a.percentile( 50) <= std::chrono::milliseconds{ 1} + std::chrono::microseconds{ 10});
+         EXPECT_TRUE( a.percentile( 50) >= std::chrono::milliseconds{ 1});
+      }
+
+   } // tools::service::call
+} // casual
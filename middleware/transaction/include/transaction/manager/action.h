@@ -28,7 +28,23 @@ namespace casual
 
          std::vector< admin::model::resource::Proxy> instances( State& state, std::vector< admin::model::scale::Instances> instances);
 
-         bool request( State& state, state::pending::Request& message);
+         namespace batch
+         {
+            //! sends pending requests for `instance` (resource), at most `state.batch.size` in one message
+            //! @returns true if requests was sent, and the instance is busy
+            bool send( State& state, state::resource::Proxy::Instance& instance);
+
+            //! sends pending requests for `rm` to idle instances, if any
+            void dispatch( State& state, common::strong::resource::id rm);
+
+            //! the linger timer has expired, sends pending requests for all resources with idle instances
+            void dispatch( State& state);
+
+            //! a new pending request for `rm`. Dispatches directly if we don't linger, or the batch is full,
+            //! otherwise the linger timer is armed.
+            void pending( State& state, common::strong::resource::id rm);
+
+         } // batch
 
       } // resource
    } // transaction::manager::action
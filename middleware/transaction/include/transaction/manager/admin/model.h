@@ -260,6 +260,44 @@ namespace casual
          )
       };
 
+      namespace outbound
+      {
+         //! a destination that has had outbound messages queued, since it was not able to receive
+         struct Destination
+         {
+            common::strong::ipc::id ipc;
+
+            struct
+            {
+               //! current number of queued messages
+               platform::size::type count{};
+               //! current queued bytes
+               platform::size::type size{};
+               //! the most bytes that has been queued
+               platform::size::type high{};
+
+               CASUAL_CONST_CORRECT_SERIALIZE(
+                  CASUAL_SERIALIZE( count);
+                  CASUAL_SERIALIZE( size);
+                  CASUAL_SERIALIZE( high);
+               )
+            } queue;
+
+            //! number of messages discarded due to overflow
+            platform::size::type shed{};
+
+            //! the durations the destination has had queued messages
+            Metric stall;
+
+            CASUAL_CONST_CORRECT_SERIALIZE(
+               CASUAL_SERIALIZE( ipc);
+               CASUAL_SERIALIZE( queue);
+               CASUAL_SERIALIZE( shed);
+               CASUAL_SERIALIZE( stall);
+            )
+         };
+      } // outbound
+
       struct State
       {
          std::vector< admin::model::resource::Proxy> resources;
@@ -289,11 +327,14 @@ namespace casual
 
          Log log;
 
+         std::vector< outbound::Destination> outbound;
+
          CASUAL_CONST_CORRECT_SERIALIZE(
             CASUAL_SERIALIZE( resources);
             CASUAL_SERIALIZE( transactions);
             CASUAL_SERIALIZE( pending);
             CASUAL_SERIALIZE( log);
+            CASUAL_SERIALIZE( outbound);
          )
       };
 
@@ -19,6 +19,8 @@
 #include "common/functional.h"
 #include "common/message/coordinate.h"
 #include "common/state/machine.h"
+#include "common/communication/ipc/send.h"
+#include "common/timer/descriptor.h"
 
 #include "common/serialize/native/complete.h"
 
@@ -26,7 +28,10 @@
 
 #include <map>
 #include <deque>
+#include <list>
 #include <vector>
+#include <string_view>
+#include <unordered_map>
 
 
 namespace casual
@@ -129,6 +134,12 @@ namespace casual
 
                   bool remove_instance( common::strong::process::id pid);
 
+                  //! @return an idle instance, that is set to busy. nullptr if all are busy.
+                  Instance* acquire();
+
+                  //! sets `instance` to idle, and makes it available for `acquire`
+                  void release( Instance& instance);
+
                   inline friend bool operator < ( const Proxy& lhs, const Proxy& rhs) { return lhs.id < rhs.id;}
                   friend bool operator == ( const Proxy& lhs, common::strong::resource::id rhs) { return lhs.id == rhs; }
                   friend bool operator == ( common::strong::resource::id lhs, const Proxy& rhs) { return lhs == rhs.id; }
@@ -138,7 +149,13 @@ namespace casual
                      CASUAL_SERIALIZE( configuration);
                      CASUAL_SERIALIZE( instances);
                      CASUAL_SERIALIZE( metrics);
+                     CASUAL_SERIALIZE_NAME( m_idle, "idle");
                   )
+
+               private:
+                  //! indexes to `instances` that has been released, most recent last. Indexes
+                  //! to instances that are no longer idle are discarded by `acquire`.
+                  std::vector< platform::size::type> m_idle;
                };
 
                namespace external
@@ -350,6 +367,46 @@ namespace casual
                )
             };
 
+            //! Holds the transactions, indexed on the global transaction id (gtrid).
+            //! References to a transaction are stable until the transaction is erased.
+            class Transactions
+            {
+            public:
+               using container_type = std::list< Transaction>;
+
+               //! @return the transaction with the same gtrid, nullptr if absent.
+               //! @{
+               Transaction* find( const common::transaction::ID& trid) noexcept;
+               Transaction* find( common::transaction::id::range::range_type global) noexcept;
+               //! @}
+
+               //! adds a new transaction for `trid`, which must be absent
+               Transaction& emplace( const common::transaction::ID& trid);
+
+               //! @return the transaction for `trid`, added if absent
+               Transaction& find_or_emplace( const common::transaction::ID& trid);
+
+               void erase( const Transaction& transaction);
+               void erase( common::transaction::id::range::range_type global);
+
+               inline bool empty() const noexcept { return m_transactions.empty();}
+               inline platform::size::type size() const noexcept { return m_transactions.size();}
+
+               inline auto begin() noexcept { return std::begin( m_transactions);}
+               inline auto end() noexcept { return std::end( m_transactions);}
+               inline auto begin() const noexcept { return std::begin( m_transactions);}
+               inline auto end() const noexcept { return std::end( m_transactions);}
+
+               CASUAL_LOG_SERIALIZE(
+                  CASUAL_SERIALIZE_NAME( m_transactions, "transactions");
+               )
+
+            private:
+               container_type m_transactions;
+               //! the key is a view of the gtrid owned by the transaction
+               std::unordered_map< std::string_view, container_type::iterator> m_index;
+            };
+
          } // state
 
          struct State
@@ -361,7 +418,7 @@ namespace casual
             State( State&&) = default;
             State& operator = ( State&&) = default;
 
-            std::vector< state::Transaction> transactions;
+            state::Transactions transactions;
             std::vector< state::resource::Proxy> resources;
             std::vector< state::resource::external::Proxy> externals;
 
@@ -398,9 +455,9 @@ namespace casual
 
             struct
             {
-               //! Resource request, that will be processed as soon as possible,
-               //! that is, as soon as corresponding resources is done/idle
-               std::vector< state::pending::Request> requests;
+               //! Resource request, per resource, that will be processed as soon as possible,
+               //! that is, as soon as corresponding resources is done/idle. In the order they was added.
+               std::unordered_map< common::strong::resource::id, std::deque< state::pending::Request>> requests;
 
                CASUAL_LOG_SERIALIZE(
                   CASUAL_SERIALIZE( requests);
@@ -408,6 +465,28 @@ namespace casual
 
             } pending;
 
+            //! xa operations to the same resource are batched in one message to a resource proxy instance
+            struct
+            {
+               //! max number of operations per message
+               platform::size::type size = platform::batch::transaction::resource;
+
+               //! how long we wait for more operations before we send a batch that is not full
+               platform::time::unit linger{};
+
+               //! armed when there are pending requests that waits for the _linger_ to pass
+               common::timer::Descriptor timer;
+
+               CASUAL_LOG_SERIALIZE(
+                  CASUAL_SERIALIZE( size);
+                  CASUAL_SERIALIZE( linger);
+                  CASUAL_SERIALIZE( timer);
+               )
+            } batch;
+
+            //! outbound messages to resource proxies and callers, queued while the destination is full
+            common::communication::ipc::send::Coordinator multiplex;
+
 
             struct
             {
@@ -445,8 +524,11 @@ namespace casual
 
             bool remove_instance( common::strong::process::id pid);
 
-            //! @return an idle instance, nullptr if all are busy.
-            state::resource::Proxy::Instance* idle( common::strong::resource::id rm);
+            //! @return an idle instance of `rm`, that is set to busy. nullptr if all are busy.
+            state::resource::Proxy::Instance* acquire( common::strong::resource::id rm);
+
+            //! sets `instance` to idle, and makes it available for `acquire`
+            void release( state::resource::Proxy::Instance& instance);
 
             const state::resource::external::Proxy& get_external( common::strong::resource::id rm) const;
 
@@ -460,6 +542,7 @@ namespace casual
                CASUAL_SERIALIZE( resources);
                CASUAL_SERIALIZE( externals);
                CASUAL_SERIALIZE( persistent);
+               CASUAL_SERIALIZE( batch);
                CASUAL_SERIALIZE( system);
                CASUAL_SERIALIZE( alias);
             )
@@ -140,32 +140,145 @@ namespace casual
             return result;
          }
 
-         bool request( State& state, state::pending::Request& message)
+         namespace batch
          {
-            Trace trace{ "transaction::action::resource::request"};
-            log::line( verbose::log, "message: ", message);
+            namespace local
+            {
+               namespace
+               {
+                  //! extracts at most `max` pending requests for `rm`, in the order they was added
+                  auto extract( State& state, strong::resource::id rm, platform::size::type max)
+                  {
+                     std::vector< state::pending::Request> result;
+
+                     auto found = algorithm::find( state.pending.requests, rm);
+                     if( ! found)
+                        return result;
+
+                     auto& requests = found->second;
+                     auto end = std::next( std::begin( requests), std::min( max, range::size( requests)));
+
+                     result.assign( std::make_move_iterator( std::begin( requests)), std::make_move_iterator( end));
+                     requests.erase( std::begin( requests), end);
+
+                     if( requests.empty())
+                        state.pending.requests.erase( std::begin( found));
+
+                     return result;
+                  }
+
+                  template< typename M>
+                  auto operation( const communication::ipc::message::Complete& complete)
+                  {
+                     M message;
+                     serialize::native::complete( complete, message);
+                     return message;
+                  }
+
+                  auto message( const std::vector< state::pending::Request>& requests)
+                  {
+                     message::transaction::resource::batch::Request result{ process::handle()};
+                     result.operations.reserve( requests.size());
 
-            if( state::resource::id::local( message.resource))
+                     // the operations keeps the order of the pending requests
+                     for( auto& request : requests)
+                     {
+                        switch( request.message.type())
+                        {
+                           case message::Type::transaction_resource_prepare_request: result.operations.emplace_back( local::operation< message::transaction::resource::prepare::Request>( request.message)); break;
+                           case message::Type::transaction_resource_commit_request: result.operations.emplace_back( local::operation< message::transaction::resource::commit::Request>( request.message)); break;
+                           case message::Type::transaction_resource_rollback_request: result.operations.emplace_back( local::operation< message::transaction::resource::rollback::Request>( request.message)); break;
+                           default:
+                              code::raise::error( code::casual::internal_unexpected_value, "unexpected pending request: ", request.message.type());
+                        }
+                     }
+
+                     return result;
+                  }
+
+                  auto send( State& state, const strong::ipc::id& ipc, std::vector< state::pending::Request>& requests)
+                  {
+                     // a single request is sent as is
+                     if( requests.size() == 1)
+                        return communication::ipc::send::optional::send( state.multiplex, ipc, requests.front().message);
+
+                     return communication::ipc::send::optional::send( state.multiplex, ipc, local::message( requests));
+                  }
+
+               } // <unnamed>
+            } // local
+
+            bool send( State& state, state::resource::Proxy::Instance& instance)
             {
-               if( auto found = state.idle( message.resource))
+               Trace trace{ "transaction::manager::action::resource::batch::send"};
+
+               auto requests = local::extract( state, instance.id, state.batch.size);
+
+               if( requests.empty())
+                  return false;
+
+               log::line( verbose::log, "instance: ", instance, ", requests: ", requests.size());
+
+               if( ! local::send( state, instance.process.ipc, requests))
                {
-                  communication::ipc::flush::send( found->process.ipc, message.message);
-                  found->state( state::resource::Proxy::Instance::State::busy);
-                  found->metrics.requested = platform::time::clock::type::now();
+                  log::line( log::category::error, "the instance: ", instance , " - does not seem to be running");
 
-                  return true;
+                  // keep the requests pending, in the same order
+                  auto& pending = state.pending.requests[ instance.id];
+                  pending.insert( std::begin( pending), std::make_move_iterator( std::begin( requests)), std::make_move_iterator( std::end( requests)));
+                  return false;
                }
-      
-               log::line( log, "failed to find idle resource - action: wait");
-               return false;
+
+               instance.state( state::resource::Proxy::Instance::State::busy);
+               instance.metrics.requested = platform::time::clock::type::now();
+               return true;
             }
 
-            // 'external' resource proxy
-            auto& resource = state.get_external( message.resource);
-            communication::ipc::flush::send( resource.process.ipc, message.message);
-            
-            return true;
-         }
+            void dispatch( State& state, strong::resource::id rm)
+            {
+               Trace trace{ "transaction::manager::action::resource::batch::dispatch"};
+
+               while( auto instance = state.acquire( rm))
+               {
+                  if( ! batch::send( state, *instance))
+                  {
+                     state.release( *instance);
+                     return;
+                  }
+               }
+            }
+
+            void dispatch( State& state)
+            {
+               Trace trace{ "transaction::manager::action::resource::batch::dispatch"};
+
+               if( ! state.batch.timer.consume())
+                  return;
+
+               // dispatch might remove resources from pending
+               auto resources = algorithm::transform( state.pending.requests, []( auto& pair){ return pair.first;});
+
+               algorithm::for_each( resources, [&state]( auto rm){ batch::dispatch( state, rm);});
+
+               // requests that are still pending are sent when instances are done
+            }
+
+            void pending( State& state, strong::resource::id rm)
+            {
+               auto found = algorithm::find( state.pending.requests, rm);
+
+               if( state.batch.linger == platform::time::unit::zero() 
+                  || ( found && range::size( found->second) >= state.batch.size))
+               {
+                  batch::dispatch( state, rm);
+                  return;
+               }
+
+               if( ! state.batch.timer.deadline())
+                  state.batch.timer.set( platform::time::clock::type::now() + state.batch.linger);
+            }
+
+         } // batch
 
       } // resource
          
@@ -478,6 +478,11 @@ namespace casual
                            { "transaction.manager.log.writes", string::compose( state.log.writes)},
                            { "transaction.manager.log.update.prepare", string::compose( state.log.update.prepare)},
                            { "transaction.manager.log.update.remove", string::compose( state.log.update.remove)},
+
+                           { "transaction.manager.outbound.queue.count", string::compose( accumulate( []( auto& destination){ return destination.queue.count;})( state.outbound))},
+                           { "transaction.manager.outbound.shed", string::compose( accumulate( []( auto& destination){ return destination.shed;})( state.outbound))},
+                           { "transaction.manager.outbound.stall.count", string::compose( accumulate( []( auto& destination){ return destination.stall.count;})( state.outbound))},
+                           { "transaction.manager.outbound.stall.total", string::compose( second_t{ accumulate( []( auto& destination){ return destination.stall.total;})( state.outbound)})},
                         };
                      }
 
@@ -154,6 +154,30 @@ namespace casual
                   };
                }
             } // pending
+
+            namespace outbound
+            {
+               auto destination()
+               {
+                  return []( auto& value)
+                  {
+                     admin::model::outbound::Destination result;
+
+                     result.ipc = value.ipc;
+                     result.queue.count = value.queue.count;
+                     result.queue.size = value.queue.size;
+                     result.queue.high = value.queue.high;
+                     result.shed = value.shed;
+
+                     result.stall.count = value.stall.count;
+                     result.stall.total = value.stall.total;
+                     result.stall.limit.min = value.stall.limit.min;
+                     result.stall.limit.max = value.stall.limit.max;
+
+                     return result;
+                  };
+               }
+            } // outbound
             
          } // <unnamed>
       } // local
@@ -198,11 +222,14 @@ namespace casual
          common::algorithm::transform( state.resources, result.resources, &transform::resource::proxy);
          common::algorithm::transform( state.transactions, result.transactions, local::transaction());
 
-         common::algorithm::transform( state.pending.requests, result.pending.requests, local::pending::request());
+         for( auto& [ resource, requests] : state.pending.requests)
+            common::algorithm::transform( requests, result.pending.requests, local::pending::request());
          common::algorithm::transform( state.persistent.replies, result.pending.persistent.replies, local::pending::reply());
 
          result.log = local::log( state.persistent.log.statistics());
 
+         common::algorithm::transform( state.multiplex.metrics(), result.outbound, local::outbound::destination());
+
          return result;
       }
 
@@ -19,7 +19,7 @@
 #include "common/code/raise.h"
 #include "common/code/convert.h"
 #include "common/communication/instance.h"
-#include "common/communication/ipc/flush/send.h"
+#include "common/communication/ipc/send.h"
 
 #include "configuration/message.h"
 
@@ -57,14 +57,7 @@ namespace casual
                         auto find_or_add_and_involve( State& state, M&& message, I&& involved)
                         {
                            // Find the transaction
-                           auto transaction = common::algorithm::find( state.transactions, message.trid);
-
-                           if( ! transaction)
-                           {
-                              state.transactions.emplace_back( message.trid);
-                              auto end = std::end( state.transactions);
-                              transaction = common::range::make( std::prev( end), end);
-                           }
+                           auto transaction = &state.transactions.find_or_emplace( message.trid);
 
                            if( auto branch = common::algorithm::find( transaction->branches, message.trid))
                               branch->involve( involved);
@@ -87,19 +80,13 @@ namespace casual
                         template< typename M>
                         state::transaction::Branch& find_or_add( State& state, M&& message)
                         {
-                           // Find the transaction
-                           if( auto transaction = common::algorithm::find( state.transactions, message.trid))
-                           {
-                              // try find the branch
-                              auto branch = common::algorithm::find( transaction->branches, message.trid);
+                           auto& transaction = state.transactions.find_or_emplace( message.trid);
 
-                              if( branch)
-                                 return *branch;
+                           // try find the branch
+                           if( auto branch = common::algorithm::find( transaction.branches, message.trid))
+                              return *branch;
 
-                              return transaction->branches.emplace_back( message.trid);
-                           }
-
-                           return state.transactions.emplace_back( message.trid).branches.back();
+                           return transaction.branches.emplace_back( message.trid);
                         }
 
                      } // branch
@@ -185,14 +172,7 @@ namespace casual
                         template< typename M, typename I>
                         auto involved( State& state, const M& message, I&& involved)
                         {
-                           auto transaction = common::algorithm::find( state.transactions, message.trid);
-
-                           if( ! transaction)
-                           {
-                              state.transactions.emplace_back( message.trid);
-                              auto end = std::end( state.transactions);
-                              transaction = common::range::make( std::prev( end), end);
-                           }
+                           auto transaction = &state.transactions.find_or_emplace( message.trid);
 
                            if( auto branch = common::algorithm::find( transaction->branches, message.trid))
                               branch->involve( involved);
@@ -216,13 +196,13 @@ namespace casual
                      namespace send
                      {
                         template< typename M, typename C>
-                        bool reply( const M& message, C custom)
+                        bool reply( State& state, const M& message, C custom)
                         {
                            auto reply = common::message::reverse::type( message);
                            reply.trid = message.trid;
                            custom( reply);
 
-                           return common::predicate::boolean( common::communication::ipc::flush::optional::send( message.process.ipc, reply));
+                           return common::predicate::boolean( common::communication::ipc::send::optional::send( state.multiplex, message.process.ipc, reply));
                         }
 
                         namespace resource
@@ -232,20 +212,17 @@ namespace casual
                            {
                               if( state::resource::id::local( request.resource))
                               {
-                                 if( auto found = state.idle( request.resource))
-                                 {
-                                    auto correlation = common::communication::ipc::flush::send( found->process.ipc, request);
-                                    found->state( state::resource::Proxy::Instance::State::busy);
-                                    found->metrics.requested = platform::time::clock::type::now();
-                                    return correlation;
-                                 }
-
-                                 common::log::line( log, "could not send to resource: ", request.resource, " - action: try later");
-                                 return state.pending.requests.emplace_back( request.resource, std::move( request)).message.correlation();
+                                 // all requests to local resources goes via pending, so they can be batched
+                                 // to the resource proxy instances
+                                 auto rm = request.resource;
+                                 auto correlation = state.pending.requests[ rm].emplace_back( rm, std::move( request)).message.correlation();
+                                 action::resource::batch::pending( state, rm);
+                                 return correlation;
                               }
 
+                              // the transaction can't be coordinated without the request, it's never shed
                               auto& resource = state.get_external( request.resource);
-                              return common::communication::ipc::flush::send( resource.process.ipc, request);
+                              return state.multiplex.send( resource.process.ipc, request, common::communication::ipc::send::overflow::Discard::never);
                            }
 
                         } // resource
@@ -349,8 +326,7 @@ namespace casual
                            void transaction( State& state, common::transaction::id::range::range_type global)
                            {
                               state.persistent.log.remove( global);
-                              if( auto found = common::algorithm::find( state.transactions, global))
-                                 state.transactions.erase( std::begin( found));
+                              state.transactions.erase( global);
                            }
                            
                         } // remove
@@ -370,7 +346,7 @@ namespace casual
                               if constexpr( common::traits::is::any_v< Reply, common::message::transaction::commit::Reply>)
                                  reply.stage = decltype( reply.stage)::commit;
 
-                              common::communication::ipc::flush::optional::send( destination.process.ipc, reply);
+                              common::communication::ipc::send::optional::send( state.multiplex, destination.process.ipc, reply);
 
                               remove::transaction( state, common::transaction::id::range::global( origin));
                            });
@@ -390,7 +366,7 @@ namespace casual
                               if constexpr( common::traits::is::any_v< Reply, common::message::transaction::commit::Reply>)
                                  reply.stage = decltype( reply.stage)::rollback;
 
-                              common::communication::ipc::flush::optional::send( destination.process.ipc, reply);
+                              common::communication::ipc::send::optional::send( state.multiplex, destination.process.ipc, reply);
 
                               remove::transaction( state, common::transaction::id::range::global( origin));
                            });
@@ -405,7 +381,7 @@ namespace casual
                               Trace trace{ "transaction::manager::handle::local::detail::coordinate::prepare"};
                               common::log::line( verbose::log, "replies: ", replies, ", outcome: ", outcome);
 
-                              auto transaction = common::algorithm::find( state.transactions, origin);
+                              auto transaction = state.transactions.find( origin);
                               casual::assertion( transaction, "failed to find transaction 'context' for: ", origin);
 
                               // filter away all read-only replies
@@ -418,7 +394,7 @@ namespace casual
 
                               if( code == decltype( code)::read_only)
                               {
-                                 state.transactions.erase( std::begin( transaction));
+                                 state.transactions.erase( *transaction);
 
                                  // we can send the reply directly
                                  auto reply = create::reply< Reply>( origin, destination, code);
@@ -426,7 +402,7 @@ namespace casual
                                  if constexpr( common::traits::is::any_v< Reply, common::message::transaction::commit::Reply>)
                                     reply.stage = decltype( reply.stage)::commit;
                                  
-                                 common::communication::ipc::flush::optional::send( destination.process.ipc, reply);
+                                 common::communication::ipc::send::optional::send( state.multiplex, destination.process.ipc, reply);
                               }
                               else if( code == decltype( code)::ok)
                               {
@@ -479,7 +455,7 @@ namespace casual
                            if( transaction->stage > decltype( transaction->stage())::involved)
                            {
                               // transaction is not in the correct 'stage'
-                              detail::send::reply( message, []( auto& reply)
+                              detail::send::reply( state, message, []( auto& reply)
                               { 
                                  reply.state = decltype( reply.state)::protocol;
                                  reply.stage = decltype( reply.stage)::commit;
@@ -498,9 +474,9 @@ namespace casual
                                  common::log::line( log, transaction->global, " no resources involved: ");
 
                                  // We can remove this transaction
-                                 state.transactions.erase( std::begin( transaction));
+                                 state.transactions.erase( *transaction);
 
-                                 detail::send::reply( message, []( auto& reply)
+                                 detail::send::reply( state, message, []( auto& reply)
                                  { 
                                     reply.state = decltype( reply.state)::ok;
                                     reply.stage = decltype( reply.stage)::commit;
@@ -578,19 +554,11 @@ namespace casual
                            {
                               Trace trace{ "transaction::manager::handle::local::resource::detail::instance::done"};
 
-                              instance.state( state::resource::Proxy::Instance::State::idle);
+                              // We got pending requests for this resource, let's oblige
+                              if( action::resource::batch::send( state, instance))
+                                 return;
 
-                              if( auto request = common::algorithm::find( state.pending.requests, instance.id))
-                              {
-                                 // We got a pending request for this resource, let's oblige
-                                 if( common::communication::ipc::flush::optional::send( instance.process.ipc, request->message))
-                                 {
-                                    instance.state( state::resource::Proxy::Instance::State::busy);
-                                    state.pending.requests.erase( std::begin( request));
-                                 }
-                                 else
-                                    common::log::line( common::log::category::error, "the instance: ", instance , " - does not seem to be running");
-                              }
+                              state.release( instance);
                            }
 
                            template< typename M>
@@ -601,8 +569,8 @@ namespace casual
                                  // The resource is a local resource proxy, and it's done, and ready for more work
                                  auto& instance = state.get_instance( message.resource, message.process.pid);
                                  {
-                                    instance::done( state, instance);
                                     instance.metrics.add( message);
+                                    instance::done( state, instance);
                                  }
                               } 
                            }
@@ -614,22 +582,19 @@ namespace casual
 
                      namespace involved
                      {
-                        auto request( State& state)
+                        namespace detail
                         {
-                           return [ &state]( common::message::transaction::resource::involved::Request& message)
+                           //! involves the resources in the branch
+                           //! @returns the resources involved prior to the message
+                           template< typename M>
+                           auto involve( State& state, M& message)
                            {
-                              Trace trace{ "transaction::manager::handle::local::resource::involved::request"};
-                              common::log::line( verbose::log, "message: ",  message);
-
                               auto& branch = local::detail::branch::find_or_add( state, message);
 
-                              // prepare and send the reply
-                              auto reply = common::message::reverse::type( message);
-                              reply.involved = common::algorithm::transform( branch.resources, []( auto& resource){ return resource.id;});
-                              common::communication::device::blocking::optional::send( message.process.ipc, reply);
+                              auto prior = common::algorithm::transform( branch.resources, []( auto& resource){ return resource.id;});
 
                               // partition what we don't got since before
-                              auto involved = std::get< 1>( common::algorithm::intersection( message.involved, reply.involved));
+                              auto involved = std::get< 1>( common::algorithm::intersection( message.involved, prior));
 
                               // partition the new involved based on which we've got configured resources for
                               auto [ known, unknown] = common::algorithm::partition( involved, [&]( auto& resource)
@@ -647,8 +612,35 @@ namespace casual
                                  common::log::line( common::log::category::error, "unknown resources: ", unknown, " - action: discard");
                                  common::log::line( common::log::category::verbose::error, "trid: ", message.trid);
                               }
+
+                              return prior;
+                           }
+                        } // detail
+
+                        auto request( State& state)
+                        {
+                           return [ &state]( common::message::transaction::resource::involved::Request& message)
+                           {
+                              Trace trace{ "transaction::manager::handle::local::resource::involved::request"};
+                              common::log::line( verbose::log, "message: ",  message);
+
+                              // prepare and send the reply
+                              auto reply = common::message::reverse::type( message);
+                              reply.involved = detail::involve( state, message);
+                              common::communication::device::blocking::optional::send( message.process.ipc, reply);
                            };
                         } 
+
+                        auto notify( State& state)
+                        {
+                           return [ &state]( common::message::transaction::resource::involved::Notify& message)
+                           {
+                              Trace trace{ "transaction::manager::handle::local::resource::involved::notify"};
+                              common::log::line( verbose::log, "message: ",  message);
+
+                              detail::involve( state, message);
+                           };
+                        }
                         
                      } // involved
 
@@ -700,6 +692,38 @@ namespace casual
 
                      } // rollback
 
+                     namespace batch
+                     {
+                        void coordinate( State& state, const common::message::transaction::resource::prepare::Reply& reply) { state.coordinate.prepare( reply);}
+                        void coordinate( State& state, const common::message::transaction::resource::commit::Reply& reply) { state.coordinate.commit( reply);}
+                        void coordinate( State& state, const common::message::transaction::resource::rollback::Reply& reply) { state.coordinate.rollback( reply);}
+
+                        auto reply( State& state)
+                        {
+                           return [&state]( const common::message::transaction::resource::batch::Reply& message)
+                           {
+                              Trace trace{ "transaction::manager::handle::local::resource::batch::reply"};
+                              common::log::line( verbose::log, "message: ", message);
+
+                              // the instance is done with all operations in the batch
+                              {
+                                 auto& instance = state.get_instance( message.resource, message.process.pid);
+                                 auto now = platform::time::clock::type::now();
+
+                                 for( auto& operation : message.operations)
+                                    std::visit( [ &instance, now]( auto& reply){ instance.metrics.add( reply, now);}, operation);
+
+                                 detail::instance::done( state, instance);
+                              }
+
+                              // each operation is coordinated as if it was replied by itself, in the order they were executed
+                              for( auto& operation : message.operations)
+                                 std::visit( [ &state]( auto& reply){ batch::coordinate( state, reply);}, operation);
+                           };
+                        }
+
+                     } // batch
+
                      namespace external
                      {
                         namespace detail
@@ -707,14 +731,14 @@ namespace casual
                            namespace send
                            {
                               template< typename M, typename C>
-                              bool reply( const M& message, C custom)
+                              bool reply( State& state, const M& message, C custom)
                               {
                                  auto reply = common::message::reverse::type( message);
                                  reply.trid = message.trid;
                                  reply.resource = message.resource;
                                  custom( reply);
 
-                                 return common::predicate::boolean( common::communication::ipc::flush::optional::send( message.process.ipc, reply));
+                                 return common::predicate::boolean( common::communication::ipc::send::optional::send( state.multiplex, message.process.ipc, reply));
                               }
                               
                            } // send
@@ -733,13 +757,13 @@ namespace casual
                                  // reply type, will be different for prepare and commit
                                  using Reply = decltype( common::message::reverse::type( message));
 
-                                 auto transaction = common::algorithm::find( state.transactions, message.trid);
+                                 auto transaction = state.transactions.find( message.trid);
 
                                  if( ! transaction || transaction->stage > decltype( transaction->stage())::involved)
                                  {
                                     // Either the transaction is absent (???) or we're already in at least the prepare stage.
                                     // Eitherway we reply with read_only
-                                    detail::send::reply( message, []( auto& reply)
+                                    detail::send::reply( state, message, []( auto& reply)
                                     {
                                        reply.statistics.start = platform::time::clock::type::now();
                                        reply.statistics.end = reply.statistics.start;
@@ -757,12 +781,14 @@ namespace casual
                                     {
                                        common::log::line( log, transaction->global, " no resources involved: ");
 
+                                       auto started = transaction->started;
+
                                        // We can remove this transaction
-                                       state.transactions.erase( std::begin( transaction));
+                                       state.transactions.erase( *transaction);
 
-                                       detail::send::reply( message, [ transaction]( auto& reply)
+                                       detail::send::reply( state, message, [ started]( auto& reply)
                                        { 
-                                          reply.statistics.start = transaction->started;
+                                          reply.statistics.start = started;
                                           reply.statistics.end = platform::time::clock::type::now();
                                           reply.state = decltype( reply.state)::read_only;
                                           
@@ -859,13 +885,13 @@ namespace casual
                                  Trace trace{ "transaction::manager::handle::local::resource::external::rollback::request"};
                                  common::log::line( verbose::log, "message: ", message);
 
-                                 auto transaction = common::algorithm::find( state.transactions, message.trid);
+                                 auto transaction = state.transactions.find( message.trid);
 
                                  if( ! transaction || transaction->stage > decltype( transaction->stage())::involved)
                                  {
                                     // Either the transaction is absent (???) or we're already in at least the prepare stage.
                                     // Eitherway we reply with read_only
-                                    detail::send::reply( message, []( auto& reply)
+                                    detail::send::reply( state, message, []( auto& reply)
                                     {
                                        reply.statistics.start = platform::time::clock::type::now();
                                        reply.statistics.end = reply.statistics.start;
@@ -1056,6 +1082,7 @@ namespace casual
                   local::commit::request( state),
                   local::rollback::request( state),
                   local::resource::involved::request( state),
+                  local::resource::involved::notify( state),
                   local::configuration::alias::request( state),
                   local::configuration::request( state),
                   local::resource::configuration::request( state),
@@ -1063,6 +1090,7 @@ namespace casual
                   local::resource::prepare::reply( state),
                   local::resource::commit::reply( state),
                   local::resource::rollback::reply( state),
+                  local::resource::batch::reply( state),
                   local::resource::external::involved::request( state),
                   local::resource::external::prepare::request( state),
                   local::resource::external::commit::request( state),
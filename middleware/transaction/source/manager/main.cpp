@@ -16,7 +16,9 @@
 #include "common/process.h"
 #include "common/exception/guard.h"
 #include "common/environment.h"
+#include "common/chronology.h"
 #include "common/communication/instance.h"
+#include "common/communication/select.h"
 
 
 
@@ -45,7 +47,16 @@ namespace casual
                   environment::variable::name::ipc::transaction::manager,
                   process::handle());
 
-               return transform::state( casual::domain::configuration::fetch());
+               auto state = transform::state( casual::domain::configuration::fetch());
+
+               state.batch.size = std::max( 
+                  environment::variable::get( environment::variable::name::transaction::resource::batch, state.batch.size), 
+                  platform::size::type{ 1});
+
+               if( environment::variable::exists( environment::variable::name::transaction::resource::linger))
+                  state.batch.linger = chronology::from::string( environment::variable::get( environment::variable::name::transaction::resource::linger));
+
+               return state;
             }
 
             void setup( State& state)
@@ -79,11 +90,74 @@ namespace casual
 
             }
 
+            namespace dispatch
+            {
+               template< typename H>
+               struct ipc
+               {
+                  ipc( H handler) : m_handler{ std::move( handler)} {}
+
+                  bool operator () ( communication::select::tag::consume)
+                  {
+                     // we consume the cache.
+                     return predicate::boolean( m_handler( manager::ipc::device().cached()));
+                  }
+
+                  bool operator() ( strong::file::descriptor::id descriptor, communication::select::tag::read)
+                  {
+                     if( manager::ipc::device().connector().descriptor() != descriptor)
+                        return false;
+
+                     m_handler( communication::device::non::blocking::next( manager::ipc::device()));
+                     return true;
+                  }
+
+               private:
+                  H m_handler;
+               };
+
+               //! sends the queued outbound messages, when the destinations are writable
+               struct multiplex
+               {
+                  multiplex( State& state) : m_state{ &state} {}
+
+                  bool operator() ( strong::file::descriptor::id descriptor, communication::select::tag::read)
+                  {
+                     if( m_state->multiplex.descriptor() != descriptor)
+                        return false;
+
+                     m_state->multiplex.send();
+                     return true;
+                  }
+
+               private:
+                  State* m_state;
+               };
+
+               //! sends the pending resource requests when the batch linger has passed
+               struct linger
+               {
+                  linger( State& state) : m_state{ &state} {}
+
+                  bool operator() ( strong::file::descriptor::id descriptor, communication::select::tag::read)
+                  {
+                     if( m_state->batch.timer.descriptor() != descriptor)
+                        return false;
+
+                     action::resource::batch::dispatch( *m_state);
+                     return true;
+                  }
+
+               private:
+                  State* m_state;
+               };
+            } // dispatch
+
             auto condition( State& state)
             {
-               return message::dispatch::condition::compose(
+               return communication::select::dispatch::condition::compose(
                   // if input device is 'idle', we persist and send persistent replies, if any.
-                  message::dispatch::condition::idle( [&state]() { manager::handle::persist::send( state);})
+                  communication::select::dispatch::condition::idle( [&state]() { manager::handle::persist::send( state);})
                );
             }
 
@@ -100,6 +174,10 @@ namespace casual
                   // prepare message dispatch handlers...
                auto handler = handle::handlers( state);
 
+               // we want to know about shutdown before we send more requests. process exit is consumed in
+               // arrival order, otherwise we could handle the exit before an earlier connect from the same pid.
+               manager::ipc::device().priorities( { common::message::Type::shutdown_request});
+
                // we can supply configuration
                casual::domain::configuration::supplier::registration();
 
@@ -109,10 +187,18 @@ namespace casual
                log::line( common::log::category::information, "casual-transaction-manager is on-line");
                log::line( verbose::log, "state: ", state);
 
-               message::dispatch::pump(
+               // queued outbound messages are sent when the multiplex descriptor signals that destinations are writable
+               communication::select::Directive directive;
+               directive.read.add( manager::ipc::device().connector().descriptor());
+               directive.read.add( state.multiplex.descriptor());
+               directive.read.add( state.batch.timer.descriptor());
+
+               communication::select::dispatch::pump(
                   local::condition( state),
-                  handler,
-                  manager::ipc::device());
+                  directive,
+                  local::dispatch::ipc{ std::move( handler)},
+                  local::dispatch::multiplex{ state},
+                  local::dispatch::linger{ state});
             }
 
             void main( int argc, char** argv)
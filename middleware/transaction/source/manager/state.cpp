@@ -74,11 +74,48 @@ namespace casual
                {
                   metrics += found->metrics;
                   instances.erase( std::begin( found));
+
+                  // the indexes has shifted, we rebuild the idle list from the remaining instances
+                  m_idle.clear();
+                  for( auto& instance : instances)
+                     if( instance.state() == Instance::State::idle)
+                        m_idle.push_back( std::distance( instances.data(), &instance));
+
                   return true;
                }
                return false;
             }
 
+            Proxy::Instance* Proxy::acquire()
+            {
+               while( ! m_idle.empty())
+               {
+                  auto index = m_idle.back();
+                  m_idle.pop_back();
+
+                  // the instance might have been shut down (or similar) since it was released
+                  if( index < range::size( instances) && instances[ index].state() == Instance::State::idle)
+                  {
+                     auto& instance = instances[ index];
+                     instance.state( Instance::State::busy);
+                     return &instance;
+                  }
+               }
+               return nullptr;
+            }
+
+            void Proxy::release( Instance& instance)
+            {
+               if( instance.state() == Instance::State::idle)
+                  return;
+
+               instance.state( Instance::State::idle);
+
+               // shutdown 'sticks'
+               if( instance.state() == Instance::State::idle)
+                  m_idle.push_back( std::distance( instances.data(), &instance));
+            }
+
             std::ostream& operator << ( std::ostream& out, const Proxy::Instance::State& value)
             {
                auto state_switch = [&]()
@@ -196,7 +233,7 @@ namespace casual
 
                casual::terminate( "invalid value for common::code::xa: ", cast::underlying( code));
             }
-            
+
          } // code::priority
 
          namespace transaction
@@ -230,6 +267,65 @@ namespace casual
             branches.erase( std::begin( erase), std::end( erase));
          }
 
+         namespace local
+         {
+            namespace
+            {
+               template< typename R>
+               std::string_view key( R&& range) noexcept
+               {
+                  return { reinterpret_cast< const char*>( range.data()), static_cast< std::string_view::size_type>( range.size())};
+               }
+            } // <unnamed>
+         } // local
+
+         Transaction* Transactions::find( const common::transaction::ID& trid) noexcept
+         {
+            return find( common::transaction::id::range::global( trid));
+         }
+
+         Transaction* Transactions::find( common::transaction::id::range::range_type global) noexcept
+         {
+            if( auto found = m_index.find( local::key( global)); found != std::end( m_index))
+               return &( *found->second);
+
+            return nullptr;
+         }
+
+         Transaction& Transactions::emplace( const common::transaction::ID& trid)
+         {
+            auto& transaction = m_transactions.emplace_back( trid);
+            auto [ position, inserted] = m_index.emplace( local::key( transaction.global()), std::prev( std::end( m_transactions)));
+
+            casual::assertion( inserted, "transaction already exists: ", position->second->global);
+
+            return transaction;
+         }
+
+         Transaction& Transactions::find_or_emplace( const common::transaction::ID& trid)
+         {
+            if( auto found = find( trid))
+               return *found;
+
+            return emplace( trid);
+         }
+
+         void Transactions::erase( const Transaction& transaction)
+         {
+            erase( transaction.global());
+         }
+
+         void Transactions::erase( common::transaction::id::range::range_type global)
+         {
+            if( auto found = m_index.find( local::key( global)); found != std::end( m_index))
+            {
+               // the key is a view of the transaction, we need to remove the index first
+               auto transaction = found->second;
+               m_index.erase( found);
+               m_transactions.erase( transaction);
+            }
+         }
+
       } // state
 
 
@@ -307,11 +403,14 @@ namespace casual
          }).empty();
       }
 
-      state::resource::Proxy::Instance* State::idle( common::strong::resource::id rm)
+      state::resource::Proxy::Instance* State::acquire( common::strong::resource::id rm)
       {
-         auto& resource = get_resource( rm);
+         return get_resource( rm).acquire();
+      }
 
-         return common::algorithm::find_if( resource.instances, []( auto& instance){ return instance.state() == decltype( instance.state())::idle;}).data();
+      void State::release( state::resource::Proxy::Instance& instance)
+      {
+         get_resource( instance.id).release( instance);
       }
 
       const state::resource::external::Proxy& State::get_external( common::strong::resource::id rm) const
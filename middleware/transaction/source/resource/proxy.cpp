@@ -56,33 +56,69 @@ namespace casual
                            communication::instance::outbound::transaction::manager::device(), ready);
                      }
 
-                     template< typename M, typename A> 
-                     void helper( State& state, M&& message, A&& action)
+                     namespace execute
                      {
-                        auto reply = common::message::reverse::type( message);
+                        template< typename M, typename A> 
+                        auto operation( State& state, M&& message, A&& action)
+                        {
+                           auto reply = common::message::reverse::type( message);
+
+                           reply.statistics.start = platform::time::clock::type::now();
+
+                           reply.process = common::process::handle();
+                           reply.resource = state.resource.id();
 
-                        reply.statistics.start = platform::time::clock::type::now();
+                           reply.state = action( state.resource, message.trid, message.flags);
+                           reply.trid = std::move( message.trid);
 
-                        reply.process = common::process::handle();
-                        reply.resource = state.resource.id();
+                           reply.statistics.end = platform::time::clock::type::now();
 
-                        reply.state = action( state.resource, message.trid, message.flags);
-                        reply.trid = std::move( message.trid);
+                           return reply;
+                        }
+
+                        auto prepare()
+                        {
+                           return []( auto& resource, auto& trid, auto flags)
+                           {
+                              return resource.prepare( trid, flags);
+                           };
+                        }
+
+                        auto commit()
+                        {
+                           return []( auto& resource, auto& trid, auto flags)
+                           {
+                              return resource.commit( trid, flags);
+                           };
+                        }
+
+                        auto rollback()
+                        {
+                           return []( auto& resource, auto& trid, auto flags)
+                           {
+                              return resource.rollback( trid, flags);
+                           };
+                        }
 
-                        reply.statistics.end = platform::time::clock::type::now();
+                        //! @returns the action for the request type
+                        auto action( const message::transaction::resource::prepare::Request&) { return execute::prepare();}
+                        auto action( const message::transaction::resource::commit::Request&) { return execute::commit();}
+                        auto action( const message::transaction::resource::rollback::Request&) { return execute::rollback();}
+                     } // execute
 
+                     template< typename M, typename A> 
+                     void helper( State& state, M&& message, A&& action)
+                     {
                         communication::device::blocking::send(
-                           communication::instance::outbound::transaction::manager::device(), reply);  
+                           communication::instance::outbound::transaction::manager::device(), 
+                           execute::operation( state, message, action));  
                      }
 
                      auto prepare( State& state)
                      {
                         return [&state]( common::message::transaction::resource::prepare::Request& message)
                         {
-                           helper( state, message, [](auto& resource, auto& trid, auto flags)
-                           {
-                              return resource.prepare( trid, flags);
-                           });
+                           helper( state, message, execute::prepare());
                         };
                      }
 
@@ -90,10 +126,7 @@ namespace casual
                      {
                         return [&state]( common::message::transaction::resource::commit::Request& message)
                         {
-                           helper( state, message, [](auto& resource, auto& trid, auto flags)
-                           {
-                              return resource.commit( trid, flags);
-                           });
+                           helper( state, message, execute::commit());
                         };
                      }
 
@@ -101,10 +134,34 @@ namespace casual
                      {
                         return [&state]( common::message::transaction::resource::rollback::Request& message)
                         {
-                           helper( state, message, [](auto& resource, auto& trid, auto flags)
+                           helper( state, message, execute::rollback());
+                        };
+                     }
+
+                     auto batch( State& state)
+                     {
+                        return [&state]( common::message::transaction::resource::batch::Request& message)
+                        {
+                           Trace trace{ "transaction::resource::proxy::handle::batch"};
+                           log::line( verbose::log, "message: ", message);
+
+                           auto reply = common::message::reverse::type( message);
+                           reply.process = common::process::handle();
+                           reply.resource = state.resource.id();
+
+                           reply.operations.reserve( message.operations.size());
+
+                           // each operation is executed, and replied to, as if it was a single request, in order
+                           for( auto& operation : message.operations)
                            {
-                              return resource.rollback( trid, flags);
-                           });
+                              std::visit( [ &state, &reply]( auto& request)
+                              {
+                                 reply.operations.emplace_back( execute::operation( state, request, execute::action( request)));
+                              }, operation);
+                           }
+
+                           communication::device::blocking::send(
+                              communication::instance::outbound::transaction::manager::device(), reply);
                         };
                      }
 
@@ -169,7 +226,8 @@ namespace casual
                common::message::handle::defaults( device),
                proxy::local::handle::prepare( m_state),
                proxy::local::handle::commit( m_state),
-               proxy::local::handle::rollback( m_state)
+               proxy::local::handle::rollback( m_state),
+               proxy::local::handle::batch( m_state)
             );
 
             proxy::local::handle::open( m_state);
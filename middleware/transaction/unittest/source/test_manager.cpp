@@ -481,6 +481,48 @@ domain:
          EXPECT_TRUE( rm1.name == "rm1");
          EXPECT_TRUE( rm1.metrics.resource.count == 1) << CASUAL_NAMED_VALUE( rm1);
       }
+      TEST( transaction_manager, begin_commit_transaction__1_resources_involved_notify__expect_involved_before_later_request__one_phase_commit_optimization)
+      {
+         common::unittest::Trace trace;
+
+         auto domain = local::domain( local::configuration::system, local::configuration::base);
+
+         EXPECT_TRUE( local::begin() == common::code::tx::ok);
+
+         // notify, no reply
+         {
+            common::message::transaction::resource::involved::Notify message;
+            message.trid = common::transaction::Context::instance().current().trid;
+            message.process = process::handle();
+            message.involved = { local::rm_1};
+
+            communication::device::blocking::send( common::communication::instance::outbound::transaction::manager::device(), message);
+         }
+
+         // the notification is handled before the request
+         {
+            common::message::transaction::resource::involved::Request message;
+            message.trid = common::transaction::Context::instance().current().trid;
+            message.process = process::handle();
+            message.involved = { local::rm_1};
+
+            auto reply = local::call::tm( message);
+            ASSERT_TRUE( reply.involved.size() == 1);
+            EXPECT_TRUE( reply.involved.at( 0) == local::rm_1);
+         }
+
+         EXPECT_TRUE( local::commit() == common::code::tx::ok);
+
+         auto state = unittest::state();
+         EXPECT_TRUE( state.transactions.empty());
+
+         auto proxies = local::accumulate_metrics( state);
+         auto& rm1 = proxies.at( 0);
+
+         EXPECT_TRUE( rm1.id == local::rm_1);
+         EXPECT_TRUE( rm1.metrics.resource.count == 1) << CASUAL_NAMED_VALUE( rm1);
+      }
+
       namespace local
       {
          namespace
@@ -587,6 +629,35 @@ domain:
          EXPECT_TRUE( local::commit() == common::code::tx::ok);
       }
 
+      TEST( transaction_manager, begin__2_resources_involved_notify__participant_dies_before_xa_start__prepare_XAER_NOTA___expect__TX_OK)
+      {
+         common::unittest::Trace trace;
+
+         // rm1 has never seen the xid, since the participant died after the notify, before xa_start
+         auto scope = common::environment::variable::scoped::set( "CASUAL_UNITTEST_OPEN_INFO_RM1", 
+            common::string::compose( "--prepare ", XAER_NOTA));
+
+         auto domain = local::domain( local::configuration::system, local::configuration::base);
+
+         EXPECT_TRUE( local::begin() == common::code::tx::ok);
+
+         // the participant notifies before xa_start, no reply
+         {
+            common::message::transaction::resource::involved::Notify message;
+            message.trid = common::transaction::Context::instance().current().trid;
+            message.process = process::handle();
+            message.involved = { local::rm_1, local::rm_2};
+
+            communication::device::blocking::send( common::communication::instance::outbound::transaction::manager::device(), message);
+         }
+
+         // XAER_NOTA is treated as read only, and rm2 is committed
+         EXPECT_TRUE( local::commit() == common::code::tx::ok);
+
+         auto state = unittest::state();
+         EXPECT_TRUE( state.transactions.empty());
+      }
+
       TEST( transaction_manager, begin_rollback_transaction__1_resources_involved__expect_XA_OK)
       {
          common::unittest::Trace trace;
@@ -1577,6 +1648,162 @@ domain:
          common::transaction::context().clear();
       }
 
+      TEST( transaction_manager_state, transactions__find_by_gtrid__stable_references)
+      {
+         common::unittest::Trace trace;
+
+         manager::state::Transactions transactions;
+
+         auto trid = common::transaction::id::create( process::handle());
+         auto& transaction = transactions.emplace( trid);
+
+         // add some more, the reference to the first should still be valid
+         for( auto count = 100; count > 0; --count)
+            transactions.emplace( common::transaction::id::create( process::handle()));
+
+         EXPECT_TRUE( transactions.size() == 101);
+         EXPECT_TRUE( transactions.find( trid) == &transaction);
+         EXPECT_TRUE( transactions.find( common::transaction::id::range::global( trid)) == &transaction);
+         EXPECT_TRUE( &transactions.find_or_emplace( trid) == &transaction);
+
+         // a branch of the same global transaction
+         auto branch = common::transaction::id::branch( trid);
+         EXPECT_TRUE( transactions.find( branch) == &transaction);
+
+         transactions.erase( transaction);
+         EXPECT_TRUE( ! transactions.find( trid));
+         EXPECT_TRUE( transactions.size() == 100);
+      }
+
+      TEST( transaction_manager_state, resource_proxy__acquire_release)
+      {
+         common::unittest::Trace trace;
+
+         manager::state::resource::Proxy proxy{ {}};
+         proxy.instances.resize( 3);
+         for( auto& instance : proxy.instances)
+            instance.id = proxy.id;
+
+         // nothing has been released (idle)
+         EXPECT_TRUE( ! proxy.acquire());
+
+         for( auto& instance : proxy.instances)
+            proxy.release( instance);
+
+         // the most recently released first
+         auto first = proxy.acquire();
+         ASSERT_TRUE( first == &proxy.instances.at( 2));
+         EXPECT_TRUE( first->state() == decltype( first->state())::busy);
+
+         // shutdown instances are not acquired
+         proxy.instances.at( 1).state( decltype( first->state())::shutdown);
+         EXPECT_TRUE( proxy.acquire() == &proxy.instances.at( 0));
+         EXPECT_TRUE( ! proxy.acquire());
+
+         proxy.release( *first);
+         EXPECT_TRUE( proxy.acquire() == first);
+      }
+
+      TEST( transaction_manager, benchmark__1000_concurrent_transactions__2_resources_involved__commit)
+      {
+         common::unittest::Trace trace;
+
+         auto domain = local::domain( local::configuration::system, local::configuration::base);
+
+         constexpr auto count = 1000;
+
+         std::vector< common::transaction::ID> trids;
+         for( auto index = 0; index < count; ++index)
+            trids.push_back( common::transaction::id::create( process::handle()));
+
+         auto start = platform::time::clock::type::now();
+
+         // all transactions are 'in flight' before the first commit
+         for( auto& trid : trids)
+         {
+            common::message::transaction::resource::involved::Notify message;
+            message.trid = trid;
+            message.process = process::handle();
+            message.involved = { local::rm_1, local::rm_2};
+
+            local::send::tm( message);
+         }
+
+         for( auto& trid : trids)
+         {
+            common::message::transaction::commit::Request message;
+            message.trid = trid;
+            message.process = process::handle();
+
+            local::send::tm( message);
+         }
+
+         for( auto index = 0; index < count; ++index)
+         {
+            common::message::transaction::commit::Reply reply;
+            communication::device::blocking::receive( communication::ipc::inbound::device(), reply);
+            EXPECT_TRUE( reply.state == decltype( reply.state)::ok) << CASUAL_NAMED_VALUE( reply);
+         }
+
+         auto elapsed = std::chrono::duration_cast< std::chrono::microseconds>( platform::time::clock::type::now() - start);
+         log::line( common::unittest::log, "transaction-manager - ", count, " transactions, 2 resources: ", elapsed.count() / count, "us/transaction");
+
+         auto state = unittest::state();
+         EXPECT_TRUE( state.transactions.empty());
+      }
+
+      TEST( transaction_manager, resource_batch__linger__100_concurrent_transactions__2_resources_involved__commit)
+      {
+         common::unittest::Trace trace;
+
+         // the TM waits for more operations to the same resource, and sends them in batches to the proxies
+         auto linger = common::environment::variable::scoped::set( environment::variable::name::transaction::resource::linger, "2ms");
+         auto batch = common::environment::variable::scoped::set( environment::variable::name::transaction::resource::batch, 8);
+
+         auto domain = local::domain( local::configuration::system, local::configuration::base);
+
+         constexpr auto count = 100;
+
+         std::vector< common::transaction::ID> trids;
+         for( auto index = 0; index < count; ++index)
+            trids.push_back( common::transaction::id::create( process::handle()));
+
+         for( auto& trid : trids)
+         {
+            common::message::transaction::resource::involved::Notify message;
+            message.trid = trid;
+            message.process = process::handle();
+            message.involved = { local::rm_1, local::rm_2};
+
+            local::send::tm( message);
+         }
+
+         for( auto& trid : trids)
+         {
+            common::message::transaction::commit::Request message;
+            message.trid = trid;
+            message.process = process::handle();
+
+            local::send::tm( message);
+         }
+
+         std::vector< common::transaction::ID> replied;
+
+         for( auto index = 0; index < count; ++index)
+         {
+            common::message::transaction::commit::Reply reply;
+            communication::device::blocking::receive( communication::ipc::inbound::device(), reply);
+            EXPECT_TRUE( reply.state == decltype( reply.state)::ok) << CASUAL_NAMED_VALUE( reply);
+            replied.push_back( reply.trid);
+         }
+
+         // every transaction got its own reply
+         EXPECT_TRUE( algorithm::sort( replied) == algorithm::sort( trids));
+
+         auto state = unittest::state();
+         EXPECT_TRUE( state.transactions.empty());
+      }
+
 /* TODO rewrite!
 
       TEST( transaction_manager, one_local_resource__configure)
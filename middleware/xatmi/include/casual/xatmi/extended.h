@@ -82,6 +82,51 @@ typedef int( *casual_instance_browse_callback)( const struct casual_browsed_serv
 extern void casual_instance_browse_services( casual_instance_browse_callback callback, void* context);
 
 
+/**
+ * one call in a scatter/gather batch
+ */
+struct casual_scatter_call
+{
+   /* in: the service to call */
+   const char* service;
+   /* in: the request buffer. out: the reply buffer, the request buffer is replaced (as in tpcall( service, data, len, &data, &len, flags)) */
+   char* data;
+   long len;
+   /* out: the call descriptor, -1 if the call could not be made or the reply is gathered */
+   int descriptor;
+   /* out: 0 if ok, otherwise the tperrno for this call */
+   int error;
+   /* out: the tpurcode of the reply */
+   long user;
+};
+
+/**
+ * Calls all services in `calls` as one batch. All service lookups are sent before any
+ * of them are awaited, and all calls share the same deadline, `timeout` milliseconds from now.
+ * A `timeout` of 0 means no deadline other than the transaction timeout, if any.
+ *
+ * A call that could not be made has `descriptor` -1 and `error` set, and does not affect the others.
+ *
+ * valid flags: TPNOTRAN, TPNOBLOCK, TPNOTIME, TPSIGRSTRT
+ *
+ * @returns the number of calls made, -1 on error (tperrno is set)
+ */
+extern int casual_service_scatter( struct casual_scatter_call* calls, long count, long timeout, long flags);
+
+/**
+ * Gathers replies for the outstanding calls (`descriptor` != -1) in `calls`, made by casual_service_scatter.
+ *
+ * with TPGETANY: waits for the first of the outstanding calls to reply.
+ *   @returns the index in `calls` of the gathered call
+ * otherwise: waits for all outstanding calls to reply.
+ *   @returns 0 if all calls succeeded, -1 otherwise, with tperrno set to the first failed `error`
+ *
+ * valid flags: TPGETANY, TPNOBLOCK, TPNOTIME, TPSIGRSTRT
+ *
+ * @returns -1 on error (tperrno is set), the outstanding calls are still outstanding
+ */
+extern int casual_service_gather( struct casual_scatter_call* calls, long count, long flags);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,10 +6,14 @@
 
 #include "casual/xatmi/extended.h"
 #include "casual/xatmi/internal/log.h"
+#include "casual/xatmi/internal/code.h"
 
 #include "common/instance.h"
 #include "common/server/context.h"
 #include "common/log/stream.h"
+#include "common/service/call/context.h"
+#include "common/buffer/pool.h"
+#include "common/algorithm.h"
 
 #include "common/execution.h"
 #include "common/uuid.h"
@@ -147,3 +151,150 @@ void casual_instance_browse_services( casual_instance_browse_callback callback,
       return callback( &state, context) == 0;
    });
 }
+
+int casual_service_scatter( casual_scatter_call* calls, long count, long timeout, long flags)
+{
+   using namespace casual;
+   xatmi::Trace trace{ "casual_service_scatter"};
+   xatmi::internal::clear();
+
+   if( ! calls || count < 0 || timeout < 0 || common::algorithm::any_of( common::range::make( calls, count), []( auto& call){ return ! call.service;}))
+   {
+      xatmi::internal::error::set( common::code::xatmi::argument);
+      return -1;
+   }
+
+   try
+   {
+      using Flag = common::service::call::async::Flag;
+
+      constexpr common::service::call::async::Flags valid_flags{
+         Flag::no_transaction,
+         Flag::no_block,
+         Flag::no_time,
+         Flag::signal_restart};
+
+      std::vector< common::service::call::scatter::Request> requests;
+      requests.reserve( count);
+
+      for( auto& call : common::range::make( calls, count))
+         requests.push_back( { call.service, common::buffer::pool::Holder::instance().get( call.data, call.len)});
+
+      std::optional< platform::time::point::type> deadline;
+      if( timeout > 0)
+         deadline = platform::time::clock::type::now() + std::chrono::milliseconds{ timeout};
+
+      auto result = common::service::call::Context::instance().scatter( std::move( requests), valid_flags.convert( flags), deadline);
+
+      int made = 0;
+
+      for( auto index = 0L; index < count; ++index)
+      {
+         auto& call = calls[ index];
+         call.user = 0;
+
+         if( result[ index])
+         {
+            call.descriptor = result[ index].descriptor;
+            call.error = 0;
+            ++made;
+         }
+         else
+         {
+            call.descriptor = -1;
+            call.error = static_cast< int>( xatmi::internal::exception::code( result[ index].code));
+         }
+      }
+
+      return made;
+   }
+   catch( ...)
+   {
+      xatmi::internal::error::set( xatmi::internal::exception::code());
+   }
+   return -1;
+}
+
+int casual_service_gather( casual_scatter_call* calls, long count, long flags)
+{
+   using namespace casual;
+   xatmi::Trace trace{ "casual_service_gather"};
+   xatmi::internal::clear();
+
+   if( ! calls || count < 0)
+   {
+      xatmi::internal::error::set( common::code::xatmi::argument);
+      return -1;
+   }
+
+   using Flag = common::service::call::reply::Flag;
+
+   constexpr common::service::call::reply::Flags valid_flags{
+      Flag::any,
+      Flag::no_block,
+      Flag::no_time,
+      Flag::signal_restart};
+
+   auto gather_flags = valid_flags.convert( flags);
+
+   auto outstanding = [&]()
+   {
+      std::vector< common::service::call::descriptor_type> result;
+      for( auto& call : common::range::make( calls, count))
+         if( call.descriptor != -1)
+            result.push_back( call.descriptor);
+      return result;
+   };
+
+   // gathers one reply and stores it in the corresponding call
+   auto gather = [&]( const std::vector< common::service::call::descriptor_type>& descriptors)
+   {
+      auto result = common::service::call::Context::instance().gather( descriptors, gather_flags);
+
+      auto index = std::distance( calls, common::algorithm::find_if( common::range::make( calls, count), [&]( auto& call)
+      { 
+         return call.descriptor == result.descriptor;
+      }).data());
+
+      auto& call = calls[ index];
+      call.descriptor = -1;
+      call.user = result.user;
+      call.error = static_cast< int>( xatmi::internal::exception::code( result.code));
+
+      // only ok and service-fail replies has a buffer from the service, otherwise the request buffer is kept
+      if( ! result.code || result.code == common::code::xatmi::service_fail)
+      {
+         common::buffer::pool::Holder::instance().deallocate( call.data);
+         std::tie( call.data, call.len) = common::buffer::pool::Holder::instance().insert( std::move( result.buffer));
+      }
+
+      return index;
+   };
+
+   try
+   {
+      auto descriptors = outstanding();
+
+      if( gather_flags.exist( Flag::any))
+         return gather( descriptors);
+
+      while( ! descriptors.empty())
+      {
+         gather( descriptors);
+         descriptors = outstanding();
+      }
+
+      if( auto failed = common::algorithm::find_if( common::range::make( calls, count), []( auto& call){ return call.error != 0;}))
+      {
+         xatmi::internal::error::set( static_cast< common::code::xatmi>( failed->error));
+         return -1;
+      }
+
+      return 0;
+   }
+   catch( ...)
+   {
+      xatmi::internal::error::set( xatmi::internal::exception::code());
+   }
+   return -1;
+}